@@ -176,7 +176,89 @@ function exeliusGenerator.GenerateEditorProject()
         }
 end
 
-function exeliusGenerator.LinkEngineToProject()
+function exeliusGenerator.GenerateBenchmarksProject()
+    project(defaultSettings.exeliusBenchmarksName)
+        defaultSettings.SetGlobalProjectDefaultSettings()
+
+        local benchmarksPath = os.realpath("../" .. defaultSettings.exeliusBenchmarksName)
+
+        -- Use a relative path here only because it logs nicer. Totally unnessesary.
+        local pathToLog = os.realpath("../" .. defaultSettings.exeliusBenchmarksName)
+        log.Log("[Premake] Generating Benchmarks at Path: " .. pathToLog)
+
+        location(benchmarksPath)
+
+        -- Headless, run from the command line and writes its results as JSON.
+        kind("ConsoleApp")
+
+        files
+        {
+            "../%{prj.name}/source/**.h",
+            "../%{prj.name}/source/**.cpp"
+        }
+
+        includedirs
+        {
+            "../%{prj.name}/source/"
+        }
+end
+
+function exeliusGenerator.GeneratePackerProject()
+    project(defaultSettings.exeliusPackerName)
+        defaultSettings.SetGlobalProjectDefaultSettings()
+
+        local packerPath = os.realpath("../" .. defaultSettings.exeliusPackerName)
+
+        -- Use a relative path here only because it logs nicer. Totally unnessesary.
+        local pathToLog = os.realpath("../" .. defaultSettings.exeliusPackerName)
+        log.Log("[Premake] Generating Packer at Path: " .. pathToLog)
+
+        location(packerPath)
+
+        -- Command line tool that builds .expak asset packs.
+        kind("ConsoleApp")
+
+        files
+        {
+            "../%{prj.name}/source/**.h",
+            "../%{prj.name}/source/**.cpp"
+        }
+
+        includedirs
+        {
+            "../%{prj.name}/source/"
+        }
+end
+
+function exeliusGenerator.GenerateCookerProject()
+    project(defaultSettings.exeliusCookerName)
+        defaultSettings.SetGlobalProjectDefaultSettings()
+
+        local cookerPath = os.realpath("../" .. defaultSettings.exeliusCookerName)
+
+        -- Use a relative path here only because it logs nicer. Totally unnessesary.
+        local pathToLog = os.realpath("../" .. defaultSettings.exeliusCookerName)
+        log.Log("[Premake] Generating Cooker at Path: " .. pathToLog)
+
+        location(cookerPath)
+
+        -- Command line tool that cooks source assets into load-ready binary forms.
+        kind("ConsoleApp")
+
+        files
+        {
+            "../%{prj.name}/source/**.h",
+            "../%{prj.name}/source/**.cpp"
+        }
+
+        includedirs
+        {
+            "../%{prj.name}/source/"
+        }
+end
+
+-- copyRuntimeFiles: Copy the engine config and assets next to the built binary. Defaults to true.
+function exeliusGenerator.LinkEngineToProject(copyRuntimeFiles)
     local engineIncludePath = os.realpath("../" .. defaultSettings.engineProjectName)
 
     -- Use a relative path here only because it logs nicer. Totally unnessesary.
@@ -193,8 +275,10 @@ function exeliusGenerator.LinkEngineToProject()
         engineIncludePath
     }
 
-    SetWindowsPostBuildCommands()
-    SetLinuxPostBuildCommands()
+    if copyRuntimeFiles ~= false then
+        SetWindowsPostBuildCommands()
+        SetLinuxPostBuildCommands()
+    end
 end
 
 return exeliusGenerator
\ No newline at end of file
@@ -75,4 +75,25 @@ engineGenerator.LinkEngineToProject()
 dependencyGenerator.LinkDependencies()
 log.Info("[Premake] ExeliusEditor Project Created.")
 
+log.Log("[Premake] Creating ExeliusBenchmarks Project.")
+engineGenerator.GenerateBenchmarksProject()
+dependencyGenerator.IncludeDependencies()
+engineGenerator.LinkEngineToProject(false)
+dependencyGenerator.LinkDependencies()
+log.Info("[Premake] ExeliusBenchmarks Project Created.")
+
+log.Log("[Premake] Creating ExeliusPacker Project.")
+engineGenerator.GeneratePackerProject()
+dependencyGenerator.IncludeDependencies()
+engineGenerator.LinkEngineToProject(false)
+dependencyGenerator.LinkDependencies()
+log.Info("[Premake] ExeliusPacker Project Created.")
+
+log.Log("[Premake] Creating ExeliusCooker Project.")
+engineGenerator.GenerateCookerProject()
+dependencyGenerator.IncludeDependencies()
+engineGenerator.LinkEngineToProject(false)
+dependencyGenerator.LinkDependencies()
+log.Info("[Premake] ExeliusCooker Project Created.")
+
 log.Info("[Premake] Engine Generation Complete!")
\ No newline at end of file
@@ -5,6 +5,9 @@ local exeliusDefaultSettings = premake.modules.exeliusDefaultSettingsClass
 exeliusDefaultSettings.workspaceName = "exeliusengine"
 exeliusDefaultSettings.engineProjectName = "exelius"
 exeliusDefaultSettings.exeliusEditorName = "exeliuseditor"
+exeliusDefaultSettings.exeliusBenchmarksName = "exeliusbenchmarks"
+exeliusDefaultSettings.exeliusPackerName = "exeliuspacker"
+exeliusDefaultSettings.exeliusCookerName = "exeliuscooker"
 exeliusDefaultSettings.startProjectName = exeliusDefaultSettings.exeliusEditorName
 
 exeliusDefaultSettings.precompiledHeader = "EXEPCH.h"
@@ -18,7 +21,7 @@ exeliusDefaultSettings.DependencyScriptLocation = path.getabsolute("../tools/thi
 exeliusDefaultSettings.DependencyBuildOutputDirectory = exeliusDefaultSettings.BuildOutputDirectory
 
 exeliusDefaultSettings.language = "C++"
-exeliusDefaultSettings.cppdialect = "C++17"
+exeliusDefaultSettings.cppdialect = "C++20"
 exeliusDefaultSettings.systemversion = "latest"
 exeliusDefaultSettings.warnings = "Extra"
 exeliusDefaultSettings.characterset = "Default"
@@ -0,0 +1,272 @@
+#include "EXEPCH.h"
+#include "AsyncLog.h"
+
+#include <EASTL/sort.h>
+
+#include <chrono>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// How long the log thread sleeps when there is nothing to write.
+	/// Threads wake it sooner when their buffer fills past half way.
+	/// </summary>
+	static constexpr std::chrono::milliseconds s_kAsyncLogIdleWait(2);
+
+	/// <summary>
+	/// Changes every time a writer starts, so a thread's buffer from a previous writer is never reused.
+	/// </summary>
+	static std::atomic<uint32_t> s_asyncLogWriterGeneration = 0;
+
+	/// <summary>
+	/// A thread's claim on its buffer. Gives the buffer back when the thread exits,
+	/// unless the writer it belongs to has already been stopped. Only the index
+	/// is used then, as the buffer may already be gone.
+	/// </summary>
+	struct AsyncLogThreadBufferHandle
+	{
+		AsyncLogWriter::ThreadBuffer* m_pBuffer = nullptr;
+		size_t m_bufferIndex = 0;
+		uint32_t m_writerGeneration = 0;
+
+		~AsyncLogThreadBufferHandle()
+		{
+			if (m_pBuffer)
+				AsyncLogWriter::ReleaseThreadBuffer(m_writerGeneration, m_bufferIndex);
+		}
+	};
+
+	static thread_local AsyncLogThreadBufferHandle s_asyncLogThreadBuffer;
+
+	AsyncLogWriter::AsyncLogWriter(LogOverflowPolicy overflowPolicy, spdlog::logger* pReportLog)
+		: m_overflowPolicy(overflowPolicy)
+		, m_pReportLog(pReportLog)
+		, m_generation(0)
+		, m_droppedCount(0)
+		, m_reportedDroppedCount(0)
+		, m_isRunning(false)
+	{
+		EXE_ASSERT(m_overflowPolicy < LogOverflowPolicy::kMax);
+	}
+
+	AsyncLogWriter::~AsyncLogWriter()
+	{
+		Stop();
+
+		for (ThreadBuffer* pBuffer : m_threadBuffers)
+		{
+			EXELIUS_DELETE(pBuffer);
+		}
+		m_threadBuffers.clear();
+	}
+
+	void AsyncLogWriter::Start()
+	{
+		EXE_ASSERT(!m_isRunning);
+
+		{
+			std::lock_guard<std::mutex> activeLock(s_activeWriterLock);
+
+			// Only one writer may be active, anything else would leave threads logging to the wrong buffers.
+			AsyncLogWriter* pExpected = nullptr;
+			const bool isOnlyWriter = s_pActiveWriter.compare_exchange_strong(pExpected, this, std::memory_order_acq_rel);
+			EXE_ASSERT(isOnlyWriter);
+			if (!isOnlyWriter)
+				return;
+
+			m_generation = s_asyncLogWriterGeneration.fetch_add(1, std::memory_order_acq_rel) + 1;
+		}
+
+		m_isRunning = true;
+		m_thread = std::thread(&AsyncLogWriter::Run, this);
+	}
+
+	void AsyncLogWriter::Stop()
+	{
+		if (!m_isRunning)
+			return;
+
+		{
+			// Once retired, exiting threads leave their buffers alone.
+			std::lock_guard<std::mutex> activeLock(s_activeWriterLock);
+			AsyncLogWriter* pExpected = this;
+			s_pActiveWriter.compare_exchange_strong(pExpected, nullptr, std::memory_order_acq_rel);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_wakeLock);
+			m_isRunning = false;
+		}
+		m_wakeSignal.notify_one();
+
+		if (m_thread.joinable())
+			m_thread.join();
+
+		// Anything queued after the log thread's last drain.
+		Drain();
+	}
+
+	void AsyncLogWriter::Flush()
+	{
+		Drain();
+	}
+
+	void AsyncLogWriter::Push(const AsyncLogRecord& record)
+	{
+		ThreadBuffer* pBuffer = GetThreadBuffer();
+		EXE_ASSERT(pBuffer);
+
+		while (!pBuffer->m_records.PushBack(record))
+		{
+			if (m_overflowPolicy != LogOverflowPolicy::kBlock)
+			{
+				m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			m_wakeSignal.notify_one();
+			std::this_thread::yield();
+		}
+
+		if (pBuffer->m_records.GetSizeApprox() >= s_kRecordsPerThread / 2)
+			m_wakeSignal.notify_one();
+	}
+
+	AsyncLogWriter::ThreadBuffer* AsyncLogWriter::GetThreadBuffer()
+	{
+		if (s_asyncLogThreadBuffer.m_pBuffer && s_asyncLogThreadBuffer.m_writerGeneration == m_generation)
+			return s_asyncLogThreadBuffer.m_pBuffer;
+
+		std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+
+		size_t bufferIndex = 0;
+		while (bufferIndex < m_threadBuffers.size() && m_threadBuffers[bufferIndex]->m_isClaimed)
+			++bufferIndex;
+
+		if (bufferIndex < m_threadBuffers.size())
+		{
+			m_threadBuffers[bufferIndex]->m_isClaimed = true;
+		}
+		else
+		{
+			ThreadBuffer* pNewBuffer = EXELIUS_NEW(ThreadBuffer());
+			EXE_ASSERT(pNewBuffer);
+			m_threadBuffers.emplace_back(pNewBuffer);
+		}
+
+		s_asyncLogThreadBuffer.m_pBuffer = m_threadBuffers[bufferIndex];
+		s_asyncLogThreadBuffer.m_bufferIndex = bufferIndex;
+		s_asyncLogThreadBuffer.m_writerGeneration = m_generation;
+		return m_threadBuffers[bufferIndex];
+	}
+
+	void AsyncLogWriter::ReleaseThreadBuffer(uint32_t writerGeneration, size_t bufferIndex)
+	{
+		// Stop() takes this lock to retire the writer, so it can't be destroyed while we hold it.
+		std::lock_guard<std::mutex> activeLock(s_activeWriterLock);
+
+		AsyncLogWriter* pWriter = s_pActiveWriter.load(std::memory_order_acquire);
+		if (!pWriter || pWriter->m_generation != writerGeneration)
+			return;
+
+		std::lock_guard<std::mutex> lock(pWriter->m_threadBuffersLock);
+		EXE_ASSERT(bufferIndex < pWriter->m_threadBuffers.size());
+		pWriter->m_threadBuffers[bufferIndex]->m_isClaimed = false;
+	}
+
+	void AsyncLogWriter::Run()
+	{
+		while (m_isRunning.load(std::memory_order_acquire))
+		{
+			if (Drain() > 0)
+				continue;
+
+			std::unique_lock<std::mutex> lock(m_wakeLock);
+			if (m_isRunning.load(std::memory_order_relaxed))
+				m_wakeSignal.wait_for(lock, s_kAsyncLogIdleWait);
+		}
+	}
+
+	size_t AsyncLogWriter::Drain()
+	{
+		static constexpr size_t s_kBatchSize = 32;
+
+		std::lock_guard<std::mutex> drainLock(m_drainLock);
+
+		m_drainedRecords.clear();
+		{
+			std::lock_guard<std::mutex> buffersLock(m_threadBuffersLock);
+			for (ThreadBuffer* pBuffer : m_threadBuffers)
+			{
+				AsyncLogRecord batch[s_kBatchSize];
+				size_t poppedCount = 0;
+				while ((poppedCount = pBuffer->m_records.PopBatch(batch, s_kBatchSize)) > 0)
+				{
+					for (size_t i = 0; i < poppedCount; ++i)
+						m_drainedRecords.emplace_back(batch[i]);
+				}
+			}
+		}
+
+		// Each buffer is already in order, interleave the threads by time.
+		m_sortedRecords.clear();
+		for (const AsyncLogRecord& record : m_drainedRecords)
+			m_sortedRecords.emplace_back(&record);
+
+		eastl::stable_sort(m_sortedRecords.begin(), m_sortedRecords.end(), [](const AsyncLogRecord* pLeft, const AsyncLogRecord* pRight)
+			{
+				return pLeft->m_time < pRight->m_time;
+			});
+
+		for (const AsyncLogRecord* pRecord : m_sortedRecords)
+			WriteRecord(*pRecord);
+
+		const uint64_t droppedCount = m_droppedCount.load(std::memory_order_relaxed);
+		if (droppedCount != m_reportedDroppedCount)
+		{
+			if (m_overflowPolicy == LogOverflowPolicy::kCount && m_pReportLog)
+				m_pReportLog->warn("Dropped {} log messages, the log buffers were full.", droppedCount - m_reportedDroppedCount);
+
+			m_reportedDroppedCount = droppedCount;
+		}
+
+		return m_drainedRecords.size();
+	}
+
+	void AsyncLogWriter::WriteRecord(const AsyncLogRecord& record)
+	{
+		EXE_ASSERT(record.m_pLog);
+		EXE_ASSERT(record.m_pFormatFunction);
+
+		const fmt::string_view format = record.GetFormat();
+
+		m_formatBuffer.clear();
+		try
+		{
+			record.m_pFormatFunction(format, record.GetPackedArguments(), m_formatBuffer);
+		}
+		catch (const std::exception& exception)
+		{
+			// Nothing on this thread can handle it, so log the failure in place of the message.
+			m_formatBuffer.clear();
+			fmt::format_to(fmt::appender(m_formatBuffer), "Failed to format log message \"{}\": {}", format, exception.what());
+		}
+
+		spdlog::details::log_msg message(record.m_time, spdlog::source_loc{}, record.m_pLog->name(), record.m_level, spdlog::string_view_t(m_formatBuffer.data(), m_formatBuffer.size()));
+		message.thread_id = record.m_threadID;
+
+		const bool shouldFlush = record.m_level >= record.m_pLog->flush_level();
+		for (const spdlog::sink_ptr& pSink : record.m_pLog->sinks())
+		{
+			if (!pSink->should_log(record.m_level))
+				continue;
+
+			pSink->log(message);
+			if (shouldFlush)
+				pSink->flush();
+		}
+	}
+}
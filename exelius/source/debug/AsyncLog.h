@@ -0,0 +1,379 @@
+#pragma once
+#include "source/utility/containers/RingBuffer.h"
+
+#include <spdlog/spdlog.h>
+#include <spdlog/details/os.h>
+#include <EASTL/vector.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// What a thread logging asynchronously does when its log buffer is full.
+	/// </summary>
+	enum class LogOverflowPolicy
+	{
+		kBlock,		/// Wait for the log thread to make room. Nothing is lost, but the logging thread may stall.
+		kDrop,		/// Drop the message.
+		kCount,		/// Drop the message, and log how many were dropped once there is room again.
+		kMax		/// Used for bounds checking. Not a valid policy.
+	};
+
+	/// <summary>
+	/// A log message waiting to be formatted and written by the log thread.
+	///
+	/// The format string is copied into the start of the record, as it may
+	/// have been built at runtime (fmt::runtime). The arguments follow it,
+	/// copied as they are. Strings are copied by value, and anything that isn't
+	/// a string, number, enum or pointer is formatted on the calling thread.
+	/// </summary>
+	struct AsyncLogRecord
+	{
+		using FormatFunction = void(*)(fmt::string_view format, const std::byte* pArguments, spdlog::memory_buf_t& output);
+
+		static constexpr size_t s_kArgumentCapacity = 464;
+
+		spdlog::logger* m_pLog;
+		spdlog::log_clock::time_point m_time;
+		size_t m_threadID;
+		FormatFunction m_pFormatFunction;
+		uint32_t m_formatLength;
+		spdlog::level::level_enum m_level;
+		std::byte m_arguments[s_kArgumentCapacity];	// The format string, then the packed arguments.
+
+		fmt::string_view GetFormat() const { return fmt::string_view(reinterpret_cast<const char*>(m_arguments), m_formatLength); }
+		const std::byte* GetPackedArguments() const { return m_arguments + m_formatLength; }
+	};
+
+	static_assert(sizeof(AsyncLogRecord) <= 512, "AsyncLogRecord should stay small enough to copy cheaply.");
+
+	/// <summary>
+	/// Packs a log argument into an AsyncLogRecord, and unpacks it on the log thread.
+	/// </summary>
+	template <typename T>
+	struct AsyncLogArgument
+	{
+		using Type = std::remove_cvref_t<T>;
+
+		static constexpr bool s_kIsString = std::is_convertible_v<const Type&, std::string_view>;
+		static constexpr bool s_kIsValue = !s_kIsString && (std::is_arithmetic_v<Type> || std::is_enum_v<Type> || std::is_pointer_v<Type>);
+
+		/// <summary>
+		/// The type handed to fmt on the log thread.
+		/// </summary>
+		using Unpacked = std::conditional_t<s_kIsValue, Type, std::string_view>;
+	};
+
+	/// <summary>
+	/// Writes packed log arguments into a record.
+	/// </summary>
+	class AsyncLogArgumentWriter
+	{
+		std::byte* m_pCurrent;
+		std::byte* m_pEnd;
+		bool m_hasOverflowed;
+
+	public:
+		AsyncLogArgumentWriter(std::byte* pBuffer, size_t bufferSize)
+			: m_pCurrent(pBuffer)
+			, m_pEnd(pBuffer + bufferSize)
+			, m_hasOverflowed(false)
+		{
+			//
+		}
+
+		template <typename T>
+		void Pack(const T& argument)
+		{
+			using Argument = AsyncLogArgument<T>;
+
+			if constexpr (Argument::s_kIsValue)
+			{
+				const typename Argument::Type value = argument;
+				Write(&value, sizeof(value));
+			}
+			else if constexpr (Argument::s_kIsString)
+			{
+				if constexpr (std::is_pointer_v<typename Argument::Type>)
+				{
+					// fmt refuses null strings, but there is no exception to throw at the caller here.
+					if (!argument)
+					{
+						WriteString(std::string_view());
+						return;
+					}
+				}
+
+				WriteString(std::string_view(argument));
+			}
+			else
+			{
+				spdlog::memory_buf_t formatted;
+				fmt::format_to(fmt::appender(formatted), "{}", argument);
+				WriteString(std::string_view(formatted.data(), formatted.size()));
+			}
+		}
+
+		bool HasOverflowed() const { return m_hasOverflowed; }
+
+	private:
+		void WriteString(std::string_view string)
+		{
+			const uint32_t length = static_cast<uint32_t>(string.size());
+			Write(&length, sizeof(length));
+			Write(string.data(), string.size());
+		}
+
+		void Write(const void* pData, size_t size)
+		{
+			if (m_hasOverflowed || static_cast<size_t>(m_pEnd - m_pCurrent) < size)
+			{
+				m_hasOverflowed = true;
+				return;
+			}
+
+			::memcpy(m_pCurrent, pData, size);
+			m_pCurrent += size;
+		}
+	};
+
+	/// <summary>
+	/// Reads packed log arguments back out of a record, in the order they were written.
+	/// </summary>
+	class AsyncLogArgumentReader
+	{
+		const std::byte* m_pCurrent;
+
+	public:
+		explicit AsyncLogArgumentReader(const std::byte* pBuffer)
+			: m_pCurrent(pBuffer)
+		{
+			//
+		}
+
+		template <typename Unpacked>
+		Unpacked Read()
+		{
+			if constexpr (std::is_same_v<Unpacked, std::string_view>)
+			{
+				uint32_t length = 0;
+				::memcpy(&length, m_pCurrent, sizeof(length));
+				const char* pString = reinterpret_cast<const char*>(m_pCurrent + sizeof(length));
+				m_pCurrent += sizeof(length) + length;
+				return std::string_view(pString, length);
+			}
+			else
+			{
+				Unpacked value;
+				::memcpy(&value, m_pCurrent, sizeof(value));
+				m_pCurrent += sizeof(value);
+				return value;
+			}
+		}
+	};
+
+	/// <summary>
+	/// Formats a record's packed arguments. One is instantiated for every
+	/// combination of argument types logged asynchronously.
+	/// </summary>
+	template <typename... Unpacked>
+	void FormatAsyncLogArguments(fmt::string_view format, const std::byte* pArguments, spdlog::memory_buf_t& output)
+	{
+		AsyncLogArgumentReader reader(pArguments);
+
+		// Braced initialization reads the arguments in order.
+		const std::tuple<Unpacked...> arguments{ reader.Read<Unpacked>()... };
+		std::apply([&format, &output](const auto&... unpackedArguments)
+			{
+				fmt::vformat_to(fmt::appender(output), format, fmt::make_format_args(unpackedArguments...));
+			}, arguments);
+	}
+
+	/// <summary>
+	/// Formats and writes log messages on a background thread.
+	///
+	/// Every thread that logs gets its own lock-free buffer of records, so
+	/// logging only copies the arguments and never waits on formatting, other
+	/// threads, or the disk. The log thread drains every buffer, orders the
+	/// records by time and writes them to their logs' sinks.
+	///
+	/// Fatal messages are written before the call returns, so they aren't
+	/// lost if the application goes down right after.
+	///
+	/// @note Owned by the LogManager. Only one may be active at a time.
+	/// </summary>
+	class AsyncLogWriter
+	{
+		friend struct AsyncLogThreadBufferHandle;
+
+	public:
+		static constexpr size_t s_kRecordsPerThread = 256;
+
+		/// <summary>
+		/// The records logged by one thread. Reused by another thread once the owner exits.
+		/// </summary>
+		struct ThreadBuffer
+		{
+			SPSCRingBuffer<AsyncLogRecord, s_kRecordsPerThread> m_records;
+			bool m_isClaimed = true;	// Guarded by m_threadBuffersLock.
+		};
+
+	private:
+		inline static std::atomic<AsyncLogWriter*> s_pActiveWriter = nullptr;
+
+		/// <summary>
+		/// Held while the active writer changes, so an exiting thread can
+		/// release its buffer without the writer being destroyed under it.
+		/// </summary>
+		inline static std::mutex s_activeWriterLock;
+
+		/// <summary>
+		/// Identifies this writer's buffers among those of every writer ever started.
+		/// </summary>
+		uint32_t m_generation;
+
+		LogOverflowPolicy m_overflowPolicy;
+
+		/// <summary>
+		/// The log that dropped messages are reported to.
+		/// </summary>
+		spdlog::logger* m_pReportLog;
+
+		std::atomic<uint64_t> m_droppedCount;
+		uint64_t m_reportedDroppedCount;
+
+		eastl::vector<ThreadBuffer*> m_threadBuffers;
+		std::mutex m_threadBuffersLock;
+
+		/// <summary>
+		/// Held while draining. The log thread is usually the only consumer,
+		/// but flushing drains from the calling thread.
+		/// </summary>
+		std::mutex m_drainLock;
+		eastl::vector<AsyncLogRecord> m_drainedRecords;
+		eastl::vector<const AsyncLogRecord*> m_sortedRecords;
+		spdlog::memory_buf_t m_formatBuffer;
+
+		std::thread m_thread;
+		std::atomic<bool> m_isRunning;
+		std::mutex m_wakeLock;
+		std::condition_variable m_wakeSignal;
+
+	public:
+		AsyncLogWriter(LogOverflowPolicy overflowPolicy, spdlog::logger* pReportLog);
+		AsyncLogWriter(const AsyncLogWriter&) = delete;
+		AsyncLogWriter(AsyncLogWriter&&) = delete;
+		AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+		AsyncLogWriter& operator=(AsyncLogWriter&&) = delete;
+
+		/// <summary>
+		/// Stops the log thread, writing everything still queued.
+		/// </summary>
+		~AsyncLogWriter();
+
+		/// <summary>
+		/// Start the log thread, and route all logging through this writer.
+		/// </summary>
+		void Start();
+
+		/// <summary>
+		/// Stop routing logging through this writer, and write everything still queued.
+		/// Other threads must not be logging while this is called.
+		/// </summary>
+		void Stop();
+
+		/// <summary>
+		/// The writer logging is currently routed through, or nullptr if logging synchronously.
+		/// </summary>
+		static AsyncLogWriter* GetActive() { return s_pActiveWriter.load(std::memory_order_acquire); }
+
+		/// <summary>
+		/// Queue a message to be formatted and written on the log thread.
+		/// If the format and arguments don't fit in a record, the message is written now instead.
+		/// </summary>
+		template <typename... Args>
+		void Write(spdlog::logger* pLog, spdlog::level::level_enum level, fmt::string_view format, const Args&... args)
+		{
+			AsyncLogRecord record;
+			record.m_pLog = pLog;
+			record.m_time = spdlog::log_clock::now();
+			record.m_threadID = spdlog::details::os::thread_id();
+			record.m_formatLength = static_cast<uint32_t>(format.size());
+			record.m_level = level;
+			record.m_pFormatFunction = &FormatAsyncLogArguments<typename AsyncLogArgument<Args>::Unpacked...>;
+
+			const bool doesFormatFit = format.size() <= AsyncLogRecord::s_kArgumentCapacity;
+			if (doesFormatFit)
+				::memcpy(record.m_arguments, format.data(), format.size());
+
+			AsyncLogArgumentWriter argumentWriter(record.m_arguments + (doesFormatFit ? format.size() : 0), doesFormatFit ? AsyncLogRecord::s_kArgumentCapacity - format.size() : 0);
+			if (doesFormatFit)
+				(argumentWriter.Pack(args), ...);
+
+			if (!doesFormatFit || argumentWriter.HasOverflowed())
+			{
+				// Write what this thread queued first, to keep its messages in order.
+				Flush();
+
+				spdlog::memory_buf_t formatted;
+				fmt::vformat_to(fmt::appender(formatted), format, fmt::make_format_args(args...));
+				pLog->log(level, spdlog::string_view_t(formatted.data(), formatted.size()));
+				return;
+			}
+
+			Push(record);
+
+			if (level == spdlog::level::critical)
+				Flush();
+		}
+
+		/// <summary>
+		/// Write every queued message before returning.
+		/// </summary>
+		void Flush();
+
+		/// <summary>
+		/// The number of messages dropped because a thread's buffer was full.
+		/// </summary>
+		uint64_t GetDroppedCount() const { return m_droppedCount.load(std::memory_order_relaxed); }
+
+		LogOverflowPolicy GetOverflowPolicy() const { return m_overflowPolicy; }
+
+	private:
+		void Push(const AsyncLogRecord& record);
+
+		/// <summary>
+		/// The calling thread's buffer, claimed the first time the thread logs.
+		/// </summary>
+		ThreadBuffer* GetThreadBuffer();
+
+		/// <summary>
+		/// Let another thread claim a buffer, if the writer it belongs to is still active.
+		/// Called when the thread that claimed it exits.
+		/// </summary>
+		static void ReleaseThreadBuffer(uint32_t writerGeneration, size_t bufferIndex);
+
+		void Run();
+
+		/// <summary>
+		/// Write every record queued so far.
+		/// </summary>
+		/// <returns>The number of records written.</returns>
+		size_t Drain();
+
+		void WriteRecord(const AsyncLogRecord& record);
+	};
+}
@@ -0,0 +1,154 @@
+#include "EXEPCH.h"
+#include "FrameTimeRecorder.h"
+
+#include <EASTL/sort.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	FrameTimeRecorder::FrameTimeRecorder(size_t frameCapacity)
+		: m_frameCapacity(frameCapacity)
+		, m_nextFrame(0)
+		, m_frameCount(0)
+		, m_frameBudget(s_kDefaultFrameBudget)
+		, m_totalHitchCount(0)
+		, m_wasLastFrameHitch(false)
+	{
+		EXE_ASSERT(m_frameCapacity > 0);
+		m_frameDurations.resize(m_frameCapacity, 0);
+		m_sortedDurations.reserve(m_frameCapacity);
+	}
+
+	void FrameTimeRecorder::RecordFrame(int64_t frameDuration, const eastl::vector<FrameStageTiming>& stageTimings)
+	{
+		if (stageTimings.size() != m_stageNames.size())
+		{
+			// Old rows would be read with the wrong stride, start over.
+			Reset();
+
+			m_stageNames.clear();
+			for (const FrameStageTiming& timing : stageTimings)
+				m_stageNames.emplace_back(timing.m_pName ? timing.m_pName : "");
+
+			m_stageDurations.clear();
+			m_stageDurations.resize(m_frameCapacity * m_stageNames.size(), 0);
+		}
+
+		m_frameDurations[m_nextFrame] = frameDuration;
+
+		int64_t* pStageRow = m_stageDurations.data() + m_nextFrame * m_stageNames.size();
+		for (size_t stageIndex = 0; stageIndex < stageTimings.size(); ++stageIndex)
+			pStageRow[stageIndex] = stageTimings[stageIndex].m_duration;
+
+		m_nextFrame = (m_nextFrame + 1) % m_frameCapacity;
+		m_frameCount = eastl::min(m_frameCount + 1, m_frameCapacity);
+
+		m_wasLastFrameHitch = frameDuration > m_frameBudget;
+		if (m_wasLastFrameHitch)
+			++m_totalHitchCount;
+	}
+
+	void FrameTimeRecorder::RecordFrame(int64_t frameDuration, const FrameGraph& frameGraph)
+	{
+		frameGraph.GetStageTimings(m_stageTimings);
+		RecordFrame(frameDuration, m_stageTimings);
+	}
+
+	void FrameTimeRecorder::Reset()
+	{
+		m_nextFrame = 0;
+		m_frameCount = 0;
+		m_totalHitchCount = 0;
+		m_wasLastFrameHitch = false;
+	}
+
+	void FrameTimeRecorder::SetFrameBudget(int64_t frameBudget)
+	{
+		EXE_ASSERT(frameBudget > 0);
+		m_frameBudget = frameBudget;
+	}
+
+	FrameTimeStats FrameTimeRecorder::GetFrameStats() const
+	{
+		m_sortedDurations.clear();
+		for (size_t frameIndex = 0; frameIndex < m_frameCount; ++frameIndex)
+			m_sortedDurations.push_back(GetFrameDuration(frameIndex));
+
+		FrameTimeStats stats = ComputeStats();
+		for (int64_t duration : m_sortedDurations)
+		{
+			if (duration > m_frameBudget)
+				++stats.m_hitchCount;
+		}
+
+		return stats;
+	}
+
+	FrameTimeStats FrameTimeRecorder::GetStageStats(size_t stageIndex) const
+	{
+		EXE_ASSERT(stageIndex < m_stageNames.size());
+
+		m_sortedDurations.clear();
+		for (size_t frameIndex = 0; frameIndex < m_frameCount; ++frameIndex)
+			m_sortedDurations.push_back(GetStageDuration(frameIndex, stageIndex));
+
+		return ComputeStats();
+	}
+
+	const char* FrameTimeRecorder::GetStageName(size_t stageIndex) const
+	{
+		EXE_ASSERT(stageIndex < m_stageNames.size());
+		return m_stageNames[stageIndex].c_str();
+	}
+
+	int64_t FrameTimeRecorder::GetFrameDuration(size_t frameIndex) const
+	{
+		return m_frameDurations[GetRingIndex(frameIndex)];
+	}
+
+	int64_t FrameTimeRecorder::GetStageDuration(size_t frameIndex, size_t stageIndex) const
+	{
+		EXE_ASSERT(stageIndex < m_stageNames.size());
+		return m_stageDurations[GetRingIndex(frameIndex) * m_stageNames.size() + stageIndex];
+	}
+
+	size_t FrameTimeRecorder::GetRingIndex(size_t frameIndex) const
+	{
+		EXE_ASSERT(frameIndex < m_frameCount);
+
+		// Until the ring fills, the oldest frame is at the start.
+		const size_t oldestFrame = (m_frameCount < m_frameCapacity) ? 0 : m_nextFrame;
+		return (oldestFrame + frameIndex) % m_frameCapacity;
+	}
+
+	FrameTimeStats FrameTimeRecorder::ComputeStats() const
+	{
+		FrameTimeStats stats;
+		stats.m_frameCount = m_sortedDurations.size();
+		if (m_sortedDurations.empty())
+			return stats;
+
+		eastl::sort(m_sortedDurations.begin(), m_sortedDurations.end());
+
+		// Nearest rank: the smallest duration at least the given percentage of frames are within.
+		auto getPercentile = [this](size_t percentile)
+		{
+			const size_t rank = (percentile * m_sortedDurations.size() + 99) / 100;
+			return m_sortedDurations[eastl::max(rank, static_cast<size_t>(1)) - 1];
+		};
+
+		stats.m_p50 = getPercentile(50);
+		stats.m_p95 = getPercentile(95);
+		stats.m_p99 = getPercentile(99);
+		stats.m_max = m_sortedDurations.back();
+
+		int64_t totalDuration = 0;
+		for (int64_t duration : m_sortedDurations)
+			totalDuration += duration;
+		stats.m_average = totalDuration / static_cast<int64_t>(m_sortedDurations.size());
+
+		return stats;
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+#include "source/os/threads/FrameGraph.h"
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Distribution of durations over the recorded frames, in microseconds.
+	/// Percentiles use the nearest rank, so are always a duration that was actually recorded.
+	/// </summary>
+	struct FrameTimeStats
+	{
+		int64_t m_p50 = 0;
+		int64_t m_p95 = 0;
+		int64_t m_p99 = 0;
+		int64_t m_max = 0;
+		int64_t m_average = 0;
+
+		/// <summary>
+		/// The number of frames the stats cover.
+		/// </summary>
+		size_t m_frameCount = 0;
+
+		/// <summary>
+		/// Frames over the frame budget. Only counted for whole frames, not stages.
+		/// </summary>
+		size_t m_hitchCount = 0;
+	};
+
+	/// <summary>
+	/// Rolling record of the last N frames' durations, broken down by frame graph stage.
+	///
+	/// Averages hide the frames players notice, so the recorder reports tail
+	/// percentiles and flags any frame over the budget as a hitch. Nothing here
+	/// depends on a window or ImGui, so automated runs can assert on it directly:
+	///
+	/// @code{.cpp}
+	/// const FrameTimeStats stats = Application::GetInstance()->GetFrameTimeRecorder().GetFrameStats();
+	/// EXE_ASSERT(stats.m_p99 < 16667);
+	/// @endcode
+	/// </summary>
+	class FrameTimeRecorder
+	{
+	public:
+		static constexpr size_t s_kDefaultFrameCapacity = 600;
+
+		/// <summary>
+		/// 60 frames per second, in microseconds.
+		/// </summary>
+		static constexpr int64_t s_kDefaultFrameBudget = 16667;
+
+	private:
+		/// <summary>
+		/// Ring of the last m_frameCapacity frame durations. m_nextFrame is the oldest once full.
+		/// </summary>
+		eastl::vector<int64_t> m_frameDurations;
+
+		/// <summary>
+		/// Ring of stage durations, one row of GetStageCount() entries per frame, parallel to m_frameDurations.
+		/// </summary>
+		eastl::vector<int64_t> m_stageDurations;
+		eastl::vector<eastl::string> m_stageNames;
+
+		size_t m_frameCapacity;
+		size_t m_nextFrame;
+		size_t m_frameCount;
+
+		int64_t m_frameBudget;
+		uint64_t m_totalHitchCount;
+		bool m_wasLastFrameHitch;
+
+		/// <summary>
+		/// Reused every frame when recording straight from a FrameGraph.
+		/// </summary>
+		eastl::vector<FrameStageTiming> m_stageTimings;
+
+		/// <summary>
+		/// Reused when computing percentiles.
+		/// </summary>
+		mutable eastl::vector<int64_t> m_sortedDurations;
+
+	public:
+		explicit FrameTimeRecorder(size_t frameCapacity = s_kDefaultFrameCapacity);
+		FrameTimeRecorder(const FrameTimeRecorder&) = delete;
+		FrameTimeRecorder(FrameTimeRecorder&&) = delete;
+		FrameTimeRecorder& operator=(const FrameTimeRecorder&) = delete;
+		FrameTimeRecorder& operator=(FrameTimeRecorder&&) = delete;
+
+		/// <summary>
+		/// Record a frame, overwriting the oldest once the ring is full.
+		/// If the number of stages changes, everything recorded so far is discarded.
+		/// </summary>
+		/// <param name="frameDuration">- The whole frame, in microseconds.</param>
+		/// <param name="stageTimings">- Every stage's timing, in the same order each frame.</param>
+		void RecordFrame(int64_t frameDuration, const eastl::vector<FrameStageTiming>& stageTimings);
+
+		/// <summary>
+		/// Record a frame, along with the last frame of the graph's stage timings.
+		/// Called by the Application once per frame.
+		/// </summary>
+		void RecordFrame(int64_t frameDuration, const FrameGraph& frameGraph);
+
+		/// <summary>
+		/// Discard every recorded frame and the hitch count.
+		/// </summary>
+		void Reset();
+
+		/// <summary>
+		/// Frames longer than the budget are hitches.
+		/// </summary>
+		/// <param name="frameBudget">- In microseconds.</param>
+		void SetFrameBudget(int64_t frameBudget);
+		int64_t GetFrameBudget() const { return m_frameBudget; }
+
+		bool WasLastFrameHitch() const { return m_wasLastFrameHitch; }
+
+		/// <summary>
+		/// Hitches since the recorder was created or last reset, including frames no longer in the ring.
+		/// </summary>
+		uint64_t GetTotalHitchCount() const { return m_totalHitchCount; }
+
+		/// <summary>
+		/// Stats for whole frames, over every frame in the ring.
+		/// </summary>
+		FrameTimeStats GetFrameStats() const;
+
+		/// <summary>
+		/// Stats for one stage, over every frame in the ring.
+		/// </summary>
+		FrameTimeStats GetStageStats(size_t stageIndex) const;
+
+		size_t GetStageCount() const { return m_stageNames.size(); }
+		const char* GetStageName(size_t stageIndex) const;
+
+		/// <summary>
+		/// The number of frames in the ring.
+		/// </summary>
+		size_t GetFrameCount() const { return m_frameCount; }
+		size_t GetFrameCapacity() const { return m_frameCapacity; }
+
+		/// <summary>
+		/// A recorded frame's duration in microseconds.
+		/// </summary>
+		/// <param name="frameIndex">- 0 is the oldest frame in the ring, GetFrameCount() - 1 the newest.</param>
+		int64_t GetFrameDuration(size_t frameIndex) const;
+
+		/// <summary>
+		/// A stage's duration in microseconds, during a recorded frame.
+		/// </summary>
+		/// <param name="frameIndex">- 0 is the oldest frame in the ring, GetFrameCount() - 1 the newest.</param>
+		int64_t GetStageDuration(size_t frameIndex, size_t stageIndex) const;
+
+	private:
+		/// <summary>
+		/// Ring position of a frame, 0 being the oldest.
+		/// </summary>
+		size_t GetRingIndex(size_t frameIndex) const;
+
+		/// <summary>
+		/// Compute stats over the durations already copied into m_sortedDurations.
+		/// </summary>
+		FrameTimeStats ComputeStats() const;
+	};
+}
@@ -16,7 +16,7 @@ namespace Exelius
 	/// log does not exist, it will be created.
 	/// </summary>
 	/// <param name="logName">- The optional name of the log to instantiate. Default is "Exelius".</param>
-	Log::Log(StringIntern logName /* = "Exelius" */)
+	Log::Log(StringIntern logName /* = EXE_STRING_ID("Exelius") */)
 		: m_logName(logName)
 		, m_pLog(GetOrCreateLog())
 	{
@@ -57,4 +57,20 @@ namespace Exelius
 		EXE_ASSERT(log);
 		return log;
 	}
-}
\ No newline at end of file
+
+	/// <summary>
+	/// Look the call site's log up again, creating it if needed.
+	/// The LogManager keeps the log alive until it is destroyed, even once
+	/// unregistered, as a call site may still be logging to it when it is
+	/// invalidated.
+	/// </summary>
+	void LogCallSite::Resolve()
+	{
+		// Read the generation first, so a log registered while resolving invalidates this one.
+		const uint32_t generation = s_logGeneration.load(std::memory_order_acquire);
+
+		Log log(m_logName);
+		m_pLog.store(log.m_pLog.get(), std::memory_order_relaxed);
+		m_generation.store(generation, std::memory_order_release);
+	}
+}
@@ -1,14 +1,158 @@
 #pragma once
+#include "source/debug/AsyncLog.h"
 #include "source/utility/generic/Macros.h"
 #include "source/utility/string/StringIntern.h"
+#include "source/utility/string/StringID.h"
 
 #include <spdlog/spdlog.h> // TODO: Figure out a way to remove this as this will likely become a public facing header.
 
+#include <atomic>
+#include <cstdint>
+
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	/// <summary>
+	/// Enum that is used to determine what the lowest priority message that will be logged.
+	/// Excluded log messages will simply be ignored and in release builds they will not be
+	/// a part of the compiled code and will be "free".
+	/// </summary>
+	enum class LogLevel
+	{
+		kFatal	= 0,	/// Sets the log level to Fatal. At this level, all other log levels will be ignored.
+		kTrace	= 1,	/// Sets the log level to Trace. At this level all other log levels will be logged as well.
+		kInfo	= 2,	/// Sets the log level to Info. At this level Trace logs will be ignored.
+		kWarn	= 3,	/// Sets the log level to Warn. At this level Trace and Info logs will be ignored.
+		kError	= 4,	/// Sets the log level to Error. At this level Trace, Info and Warn logs will be ignored.
+		kMax			/// Used for bounds checking. Not a valid level.
+	};
+
+	/// <summary>
+	/// Converts a LogLevel to spdlog's equivalent.
+	/// </summary>
+	constexpr spdlog::level::level_enum GetSpdlogLevel(LogLevel level)
+	{
+		switch (level)
+		{
+			case LogLevel::kTrace:	return spdlog::level::trace;
+			case LogLevel::kInfo:	return spdlog::level::info;
+			case LogLevel::kWarn:	return spdlog::level::warn;
+			case LogLevel::kError:	return spdlog::level::err;
+			case LogLevel::kFatal:	return spdlog::level::critical;
+			default:				return spdlog::level::off;
+		}
+	}
+
+	/// <summary>
+	/// The lowest level compiled into the build, for categories without their own.
+	/// Trace logs are stripped from Release builds. Override by defining
+	/// EXE_LOG_COMPILED_LEVEL as one of the LogLevel values.
+	/// </summary>
+#if defined(EXE_LOG_COMPILED_LEVEL)
+	inline constexpr LogLevel s_kDefaultCompiledLogLevel = EXE_LOG_COMPILED_LEVEL;
+#elif defined(EXE_DEBUG)
+	inline constexpr LogLevel s_kDefaultCompiledLogLevel = LogLevel::kTrace;
+#else
+	inline constexpr LogLevel s_kDefaultCompiledLogLevel = LogLevel::kInfo;
+#endif
+
+	/// <summary>
+	/// The lowest level compiled in for a category, keyed on the hash of its name.
+	/// Specialize with EXE_LOG_CATEGORY_COMPILED_LEVEL.
+	/// </summary>
+	template <uint64_t kCategoryHash>
+	struct LogCategoryCompiledLevel
+	{
+		static constexpr LogLevel s_kLevel = s_kDefaultCompiledLogLevel;
+	};
+
+	/// <summary>
+	/// True if messages of the given level, logged to the category, are compiled in.
+	/// </summary>
+	template <uint64_t kCategoryHash>
+	constexpr bool IsLogLevelCompiledIn(LogLevel level)
+	{
+		return GetSpdlogLevel(level) >= GetSpdlogLevel(LogCategoryCompiledLevel<kCategoryHash>::s_kLevel);
+	}
+
+	/// <summary>
+	/// The logger behind a single EXE_LOG_* call site. Resolved from the
+	/// LogManager the first time the call site logs, then reused, so logging
+	/// never looks the category up again.
+	///
+	/// Every call site re-resolves its logger whenever logs are registered or
+	/// unregistered. Unregistered loggers stay alive until the LogManager is
+	/// destroyed, so a call site that hasn't noticed yet can still use its own.
+	/// </summary>
+	class LogCallSite
+	{
+		/// <summary>
+		/// Bumped by the LogManager whenever the set of logs changes.
+		/// </summary>
+		inline static std::atomic<uint32_t> s_logGeneration = 1;
+
+		StringIntern m_logName;
+		std::atomic<spdlog::logger*> m_pLog;
+		std::atomic<uint32_t> m_generation;
+
+	public:
+		explicit LogCallSite(const StringIntern& logName)
+			: m_logName(logName)
+			, m_pLog(nullptr)
+			, m_generation(0)
+		{
+			//
+		}
+
+		LogCallSite(const LogCallSite&) = delete;
+		LogCallSite(LogCallSite&&) = delete;
+		LogCallSite& operator=(const LogCallSite&) = delete;
+		LogCallSite& operator=(LogCallSite&&) = delete;
+
+		spdlog::logger* GetLog()
+		{
+			if (m_generation.load(std::memory_order_acquire) != s_logGeneration.load(std::memory_order_acquire))
+				Resolve();
+
+			return m_pLog.load(std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Make every call site look its logger up again. Called by the LogManager.
+		/// </summary>
+		static void InvalidateAll() { s_logGeneration.fetch_add(1, std::memory_order_acq_rel); }
+
+	private:
+		void Resolve();
+	};
+
+	/// <summary>
+	/// Write a message to a log, on the log thread if asynchronous logging is enabled.
+	/// The log's level should already have been checked.
+	/// </summary>
+	template <typename... Args>
+	void WriteLog(spdlog::logger* pLog, spdlog::level::level_enum level, spdlog::format_string_t<Args...> format, Args&&... args)
+	{
+		if (AsyncLogWriter* pWriter = AsyncLogWriter::GetActive())
+			pWriter->Write(pLog, level, format, args...);
+		else
+			pLog->log(level, format, std::forward<Args>(args)...);
+	}
+
+	/// <summary>
+	/// Write a message that isn't a format string, like a string variable.
+	/// </summary>
+	template <typename T>
+	void WriteLog(spdlog::logger* pLog, spdlog::level::level_enum level, const T& message)
+	{
+		if (AsyncLogWriter* pWriter = AsyncLogWriter::GetActive())
+			pWriter->Write(pLog, level, "{}", message);
+		else
+			pLog->log(level, message);
+	}
+
 	/// <summary>
 	/// The Exelius Engine Logging class. This acts as a scoped log handle.
 	/// This interface will obtain a log with a given name or create one if
@@ -47,6 +191,8 @@ namespace Exelius
 	/// </summary>
 	class Log
 	{
+		friend class LogCallSite;
+
 		/// <summary>
 		/// The name of the log or the "category".
 		/// </summary>
@@ -65,7 +211,7 @@ namespace Exelius
 		/// log does not exist, it will be created.
 		/// </summary>
 		/// <param name="logName">- The optional name of the log to instantiate. Default is "Exelius".</param>
-		Log(StringIntern logName = "Exelius");
+		Log(StringIntern logName = EXE_STRING_ID("Exelius"));
 		Log(const Log&) = delete;
 		Log(Log&&) = default;
 		Log& operator=(const Log&) = delete;
@@ -97,15 +243,16 @@ namespace Exelius
 		/// easily be enabled or disabled when used in conjunction with the
 		/// configuration file engine_config.ini.
 		/// 
-		/// Trace is disabled in Release builds.
-		/// @todo The log will still be created and retrieved in release builds.
+		/// Trace is disabled in Release builds. When logged through the
+		/// EXE_LOG macros, the call is not compiled in at all.
 		/// </summary>
 		/// <param name="...args">- The message to log.</param>
 		template<typename... Args>
 		void Trace(Args&&...args) const
 		{
 			EXE_ASSERT(m_pLog);
-			m_pLog->trace(std::forward<Args>(args)...);
+			if (m_pLog->should_log(spdlog::level::trace))
+				WriteLog(m_pLog.get(), spdlog::level::trace, std::forward<Args>(args)...);
 		}
 
 		/// <summary>
@@ -133,7 +280,8 @@ namespace Exelius
 		void Info(Args&&...args) const
 		{
 			EXE_ASSERT(m_pLog);
-			m_pLog->info(std::forward<Args>(args)...);
+			if (m_pLog->should_log(spdlog::level::info))
+				WriteLog(m_pLog.get(), spdlog::level::info, std::forward<Args>(args)...);
 		}
 
 		/// <summary>
@@ -162,7 +310,8 @@ namespace Exelius
 		void Warn(Args&&...args) const
 		{
 			EXE_ASSERT(m_pLog);
-			m_pLog->warn(std::forward<Args>(args)...);
+			if (m_pLog->should_log(spdlog::level::warn))
+				WriteLog(m_pLog.get(), spdlog::level::warn, std::forward<Args>(args)...);
 		}
 
 		/// <summary>
@@ -188,7 +337,8 @@ namespace Exelius
 		void Error(Args&&...args) const
 		{
 			EXE_ASSERT(m_pLog);
-			m_pLog->error(std::forward<Args>(args)...);
+			if (m_pLog->should_log(spdlog::level::err))
+				WriteLog(m_pLog.get(), spdlog::level::err, std::forward<Args>(args)...);
 		}
 
 		/// <summary>
@@ -215,7 +365,8 @@ namespace Exelius
 		void Fatal(Args&&...args) const
 		{
 			EXE_ASSERT(m_pLog);
-			m_pLog->critical(std::forward<Args>(args)...);
+			if (m_pLog->should_log(spdlog::level::critical))
+				WriteLog(m_pLog.get(), spdlog::level::critical, std::forward<Args>(args)...);
 		}
 
 	private:
@@ -228,17 +379,45 @@ namespace Exelius
 	};
 }
 
-#define EXE_LOG_TRACE(...) {::Exelius::Log log; log.Trace(__VA_ARGS__);}
-#define EXE_LOG_CATEGORY_TRACE(CATEGORY, ...) {::Exelius::Log log(CATEGORY); log.Trace(__VA_ARGS__);}
+// Logs through a logger resolved once per call site. The arguments are only
+// evaluated if the logger's level lets the message through, and the whole
+// statement is compiled out if the level is below the category's compiled level.
+// Log categories must be string literals.
+#define EXE_LOG_CALL_SITE(CATEGORY, LEVEL, ...) \
+	{ \
+		if constexpr (::Exelius::IsLogLevelCompiledIn<::Exelius::StringID(CATEGORY).GetHash()>(LEVEL)) \
+		{ \
+			static ::Exelius::LogCallSite s_logCallSite(EXE_STRING_ID(CATEGORY)); \
+			if (spdlog::logger* pCallSiteLog = s_logCallSite.GetLog(); pCallSiteLog && pCallSiteLog->should_log(::Exelius::GetSpdlogLevel(LEVEL))) \
+				::Exelius::WriteLog(pCallSiteLog, ::Exelius::GetSpdlogLevel(LEVEL), __VA_ARGS__); \
+		} \
+	}
+
+// Set the lowest level compiled in for a category. Use at global scope, in a
+// header included before the category is logged to.
+#define EXE_LOG_CATEGORY_COMPILED_LEVEL(CATEGORY, LEVEL) \
+	template <> \
+	struct Exelius::LogCategoryCompiledLevel<::Exelius::StringID(CATEGORY).GetHash()> \
+	{ \
+		static constexpr ::Exelius::LogLevel s_kLevel = LEVEL; \
+	};
+
+#define EXE_LOG_TRACE(...) EXE_LOG_CALL_SITE("Exelius", ::Exelius::LogLevel::kTrace, __VA_ARGS__)
+#define EXE_LOG_CATEGORY_TRACE(CATEGORY, ...) EXE_LOG_CALL_SITE(CATEGORY, ::Exelius::LogLevel::kTrace, __VA_ARGS__)
+
+#define EXE_LOG_INFO(...) EXE_LOG_CALL_SITE("Exelius", ::Exelius::LogLevel::kInfo, __VA_ARGS__)
+#define EXE_LOG_CATEGORY_INFO(CATEGORY, ...) EXE_LOG_CALL_SITE(CATEGORY, ::Exelius::LogLevel::kInfo, __VA_ARGS__)
 
-#define EXE_LOG_INFO(...) {::Exelius::Log log; log.Info(__VA_ARGS__);}
-#define EXE_LOG_CATEGORY_INFO(CATEGORY, ...) {::Exelius::Log log(CATEGORY); log.Info(__VA_ARGS__);}
+#define EXE_LOG_WARN(...) EXE_LOG_CALL_SITE("Exelius", ::Exelius::LogLevel::kWarn, __VA_ARGS__)
+#define EXE_LOG_CATEGORY_WARN(CATEGORY, ...) EXE_LOG_CALL_SITE(CATEGORY, ::Exelius::LogLevel::kWarn, __VA_ARGS__)
 
-#define EXE_LOG_WARN(...) {::Exelius::Log log; log.Warn(__VA_ARGS__);}
-#define EXE_LOG_CATEGORY_WARN(CATEGORY, ...) {::Exelius::Log log(CATEGORY); log.Warn(__VA_ARGS__);}
+#define EXE_LOG_ERROR(...) EXE_LOG_CALL_SITE("Exelius", ::Exelius::LogLevel::kError, __VA_ARGS__)
+#define EXE_LOG_CATEGORY_ERROR(CATEGORY, ...) EXE_LOG_CALL_SITE(CATEGORY, ::Exelius::LogLevel::kError, __VA_ARGS__)
 
-#define EXE_LOG_ERROR(...) {::Exelius::Log log; log.Error(__VA_ARGS__);}
-#define EXE_LOG_CATEGORY_ERROR(CATEGORY, ...) {::Exelius::Log log(CATEGORY); log.Error(__VA_ARGS__);}
+#define EXE_LOG_FATAL(...) EXE_LOG_CALL_SITE("Exelius", ::Exelius::LogLevel::kFatal, __VA_ARGS__)
+#define EXE_LOG_CATEGORY_FATAL(CATEGORY, ...) EXE_LOG_CALL_SITE(CATEGORY, ::Exelius::LogLevel::kFatal, __VA_ARGS__)
 
-#define EXE_LOG_FATAL(...) {::Exelius::Log log; log.Fatal(__VA_ARGS__);}
-#define EXE_LOG_CATEGORY_FATAL(CATEGORY, ...) {::Exelius::Log log(CATEGORY); log.Fatal(__VA_ARGS__);}
\ No newline at end of file
+#ifdef EXE_LOG_CATEGORY_LEVELS_HEADER
+	// Per category compiled levels for the project, see EXE_LOG_CATEGORY_COMPILED_LEVEL.
+	#include EXE_LOG_CATEGORY_LEVELS_HEADER
+#endif
@@ -13,6 +13,7 @@ namespace Exelius
 {
 	LogManager::LogManager()
 		: m_defaultLog("Exelius")
+		, m_pAsyncWriter(nullptr)
 	{
 		//
 	}
@@ -22,6 +23,7 @@ namespace Exelius
 	/// </summary>
 	LogManager::~LogManager()
 	{
+		DisableAsyncLogging();
 		UnregisterAllLogs();
 
 		for (auto pDefinition : m_logDefinitions)
@@ -55,9 +57,10 @@ namespace Exelius
 	/// </summary>
 	/// <param name="fileDefinition">- The file definition data retrieved from the config file.</param>
 	/// <param name="consoleDefinition">- The console definition data retrieved from the config file.</param>
+	/// <param name="asyncDefinition">- The asynchronous logging settings retrieved from the config file.</param>
 	/// <param name="logData">- The log data retrieved from the config file.</param>
 	/// <returns>True if initialization was successful, false on failure.</returns>
-	bool LogManager::Initialize(const FileLogDefinition& fileDefinition, const ConsoleLogDefinition& consoleDefinition, const eastl::vector<LogData>& logData)
+	bool LogManager::Initialize(const FileLogDefinition& fileDefinition, const ConsoleLogDefinition& consoleDefinition, const AsyncLogDefinition& asyncDefinition, const eastl::vector<LogData>& logData)
 	{
 		Log defaultLog;
 		bool result = true;
@@ -83,6 +86,9 @@ namespace Exelius
 			}
 		}
 
+		if (asyncDefinition.m_isEnabled)
+			EnableAsyncLogging(asyncDefinition.m_overflowPolicy);
+
 		return true;
 	}
 
@@ -196,7 +202,65 @@ namespace Exelius
 	std::shared_ptr<spdlog::logger> LogManager::GetLog(StringIntern logName)
 	{
 		EXE_ASSERT(logName.IsValid());
-		return spdlog::get(logName.Get().c_str());
+
+		std::shared_lock<std::shared_mutex> lock(m_logsLock);
+		const auto found = m_logs.find(logName);
+		if (found == m_logs.end())
+			return nullptr;
+
+		return found->second;
+	}
+
+	/// <summary>
+	/// Format and write every message on a background thread. Logging threads
+	/// only copy the message's arguments into their own buffer.
+	/// </summary>
+	/// <param name="overflowPolicy">- What a thread does when its log buffer is full.</param>
+	void LogManager::EnableAsyncLogging(LogOverflowPolicy overflowPolicy)
+	{
+		if (m_pAsyncWriter)
+		{
+			if (m_pAsyncWriter->GetOverflowPolicy() == overflowPolicy)
+				return;
+
+			DisableAsyncLogging();
+		}
+
+		// Dropped messages are reported to the default log.
+		m_pAsyncWriter = EXELIUS_NEW(AsyncLogWriter(overflowPolicy, GetLog(m_defaultLog.name().c_str()).get()));
+		EXE_ASSERT(m_pAsyncWriter);
+		m_pAsyncWriter->Start();
+	}
+
+	/// <summary>
+	/// Go back to writing messages on the thread that logs them, after writing
+	/// everything still queued. Other threads must not be logging during this call.
+	/// </summary>
+	void LogManager::DisableAsyncLogging()
+	{
+		if (!m_pAsyncWriter)
+			return;
+
+		m_pAsyncWriter->Stop();
+		EXELIUS_DELETE(m_pAsyncWriter);
+		m_pAsyncWriter = nullptr;
+	}
+
+	/// <summary>
+	/// Write every queued message before returning. Does nothing when logging synchronously.
+	/// </summary>
+	void LogManager::FlushAsyncLogging()
+	{
+		if (m_pAsyncWriter)
+			m_pAsyncWriter->Flush();
+	}
+
+	/// <summary>
+	/// The number of messages dropped because a thread's log buffer was full.
+	/// </summary>
+	uint64_t LogManager::GetDroppedLogCount() const
+	{
+		return m_pAsyncWriter ? m_pAsyncWriter->GetDroppedCount() : 0;
 	}
 
 	/// <summary>
@@ -241,8 +305,16 @@ namespace Exelius
 	/// <param name="pLogToRegister">- The log to register with spdlog.</param>
 	void LogManager::RegisterLog(std::shared_ptr<spdlog::logger> pLogToRegister)
 	{
+		EXE_ASSERT(pLogToRegister);
+
 		// Register the loggers, this makes them accessible by the spdlog::get() function.
 		spdlog::register_logger(pLogToRegister);
+
+		std::unique_lock<std::shared_mutex> lock(m_logsLock);
+		m_logs[StringIntern(pLogToRegister->name().c_str())] = pLogToRegister;
+		lock.unlock();
+
+		LogCallSite::InvalidateAll();
 	}
 
 	/// <summary>
@@ -251,7 +323,21 @@ namespace Exelius
 	/// <param name="pLogToRegister">- The log to unregister with spdlog.</param>
 	void LogManager::UnregisterLog(StringIntern logName)
 	{
+		// Queued messages point at the log.
+		FlushAsyncLogging();
+
 		spdlog::drop(logName.Get().c_str());
+
+		std::unique_lock<std::shared_mutex> lock(m_logsLock);
+		const auto found = m_logs.find(logName);
+		if (found != m_logs.end())
+		{
+			m_retiredLogs.push_back(eastl::move(found->second));
+			m_logs.erase(found);
+		}
+		lock.unlock();
+
+		LogCallSite::InvalidateAll();
 	}
 
 	/// <summary>
@@ -259,7 +345,18 @@ namespace Exelius
 	/// </summary>
 	void LogManager::UnregisterAllLogs()
 	{
+		// Queued messages point at the logs.
+		FlushAsyncLogging();
+
 		spdlog::drop_all();
+
+		std::unique_lock<std::shared_mutex> lock(m_logsLock);
+		for (auto& logPair : m_logs)
+			m_retiredLogs.push_back(eastl::move(logPair.second));
+		m_logs.clear();
+		lock.unlock();
+
+		LogCallSite::InvalidateAll();
 	}
 
 	/// <summary>
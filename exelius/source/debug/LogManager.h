@@ -1,4 +1,5 @@
 #pragma once
+#include "source/debug/Log.h"
 #include "source/utility/string/StringIntern.h"
 #include "source/utility/generic/Singleton.h"
 
@@ -6,11 +7,13 @@
 
 #include <EASTL/array.h>
 #include <EASTL/unordered_map.h>
+#include <EASTL/vector.h>
 #include <EASTL/string.h>
 
 #include <rapidjson/document.h>
 
 #include <mutex>
+#include <shared_mutex>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
@@ -28,21 +31,6 @@ namespace Exelius
 		kMax					/// Used for bounds checking. Not a valid location.
 	};
 
-	/// <summary>
-	/// Enum that is used to determine what the lowest priority message that will be logged.
-	/// Excluded log messages will simply be ignored and in release builds they will not be
-	/// a part of the compiled code and will be "free".
-	/// </summary>
-	enum class LogLevel
-	{
-		kFatal	= 0,	/// Sets the log level to Fatal. At this level, all other log levels will be ignored.
-		kTrace	= 1,	/// Sets the log level to Trace. At this level all other log levels will be logged as well.
-		kInfo	= 2,	/// Sets the log level to Info. At this level Trace logs will be ignored.
-		kWarn	= 3,	/// Sets the log level to Warn. At this level Trace and Info logs will be ignored.
-		kError	= 4,	/// Sets the log level to Error. At this level Trace, Info and Warn logs will be ignored.
-		kMax			/// Used for bounds checking. Not a valid level.
-	};
-
 	/// <summary>
 	/// The structure containing the data necessary to define a log
 	/// that will output to a file.
@@ -113,6 +101,32 @@ namespace Exelius
 		}
 	};
 
+	/// <summary>
+	/// The structure containing the data necessary to set up asynchronous logging.
+	/// </summary>
+	struct AsyncLogDefinition
+	{
+		/// <summary>
+		/// Should messages be formatted and written on a background thread.
+		/// </summary>
+		bool m_isEnabled;
+
+		/// <summary>
+		/// What a thread does when its log buffer is full.
+		/// </summary>
+		LogOverflowPolicy m_overflowPolicy;
+
+		/// <summary>
+		/// Construct the definition with reasonable default values.
+		/// </summary>
+		AsyncLogDefinition()
+			: m_isEnabled(false)
+			, m_overflowPolicy(LogOverflowPolicy::kCount)
+		{
+			//
+		}
+	};
+
 	/// <summary>
 	/// The structure containing the data necessary to create a log.
 	/// </summary>
@@ -167,6 +181,26 @@ namespace Exelius
 		/// Contains the File log and the Console Log definition.
 		/// </summary>
 		eastl::array<spdlog::sink_ptr, 2> m_logDefinitions;
+
+		/// <summary>
+		/// Every registered log, keyed by its interned name, so finding one
+		/// only hashes a pointer instead of the whole name.
+		/// Mirrors the spdlog registry.
+		/// </summary>
+		eastl::unordered_map<StringIntern, std::shared_ptr<spdlog::logger>> m_logs;
+
+		/// <summary>
+		/// Logs that have been unregistered. Kept alive until the LogManager is
+		/// destroyed, as call sites on other threads may still be using them.
+		/// </summary>
+		eastl::vector<std::shared_ptr<spdlog::logger>> m_retiredLogs;
+
+		std::shared_mutex m_logsLock;	// Guards m_logs and m_retiredLogs.
+
+		/// <summary>
+		/// Formats and writes messages on a background thread, if asynchronous logging is enabled.
+		/// </summary>
+		AsyncLogWriter* m_pAsyncWriter;
 	public:
 		LogManager();
 		LogManager(const LogManager&) = delete;
@@ -194,9 +228,10 @@ namespace Exelius
 		/// </summary>
 		/// <param name="fileDefinition">- The file definition data retrieved from the config file.</param>
 		/// <param name="consoleDefinition">- The console definition data retrieved from the config file.</param>
+		/// <param name="asyncDefinition">- The asynchronous logging settings retrieved from the config file.</param>
 		/// <param name="logData">- The log data retrieved from the config file.</param>
 		/// <returns>True if initialization was successful, false on failure.</returns>
-		bool Initialize(const FileLogDefinition& fileDefinition, const ConsoleLogDefinition& consoleDefinition, const eastl::vector<LogData>& logData);
+		bool Initialize(const FileLogDefinition& fileDefinition, const ConsoleLogDefinition& consoleDefinition, const AsyncLogDefinition& asyncDefinition, const eastl::vector<LogData>& logData);
 
 		/// <summary>
 		/// Create a log catagory with the given name, log location, and log level.
@@ -215,14 +250,39 @@ namespace Exelius
 		/// Retrieve the log with the given name if it exists.
 		/// 
 		/// @note
-		/// Calling get can be expensive as it locks a mutex, so use with caution.
-		/// It is advisable to save the shared_ptr<spdlog::logger> returned and use it directly, at least in hot code paths.
+		/// Takes a shared lock, so it doesn't block other threads getting logs,
+		/// but it is still advisable to save the shared_ptr<spdlog::logger> returned and use it directly, at least in hot code paths.
 		/// @see https://github.com/gabime/spdlog/wiki/2.-Creating-loggers
 		/// </summary>
 		/// <param name="logName">- The name of the log to retrieve. Example: "Exelius" will retrieve the default log.</param>
 		/// <returns>The log with the given name if found, nullptr if not found.</returns>
 		std::shared_ptr<spdlog::logger> GetLog(StringIntern logName);
 
+		/// <summary>
+		/// Format and write every message on a background thread. Logging threads
+		/// only copy the message's arguments into their own buffer.
+		/// </summary>
+		/// <param name="overflowPolicy">- What a thread does when its log buffer is full.</param>
+		void EnableAsyncLogging(LogOverflowPolicy overflowPolicy);
+
+		/// <summary>
+		/// Go back to writing messages on the thread that logs them, after writing
+		/// everything still queued. Other threads must not be logging during this call.
+		/// </summary>
+		void DisableAsyncLogging();
+
+		bool IsAsyncLogging() const { return m_pAsyncWriter != nullptr; }
+
+		/// <summary>
+		/// Write every queued message before returning. Does nothing when logging synchronously.
+		/// </summary>
+		void FlushAsyncLogging();
+
+		/// <summary>
+		/// The number of messages dropped because a thread's log buffer was full.
+		/// </summary>
+		uint64_t GetDroppedLogCount() const;
+
 	private:
 		///100 <summary>
 		/// Create the default log definitions; the Console and File logs.
@@ -0,0 +1,294 @@
+#include "EXEPCH.h"
+#include "Profiler.h"
+#include "source/utility/io/File.h"
+
+#include <EASTL/sort.h>
+
+#include <chrono>
+#include <thread>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Changes every time a profiler is created, so a thread's buffer from a previous one is never reused.
+	/// </summary>
+	static std::atomic<uint32_t> s_profilerGeneration = 0;
+
+	/// <summary>
+	/// A thread's claim on its buffer. Gives the buffer back when the thread exits,
+	/// unless the profiler it belongs to has already been destroyed.
+	/// </summary>
+	struct ProfilerThreadBufferHandle
+	{
+		Profiler::ThreadBuffer* m_pBuffer = nullptr;
+		uint32_t m_profilerGeneration = 0;
+
+		~ProfilerThreadBufferHandle()
+		{
+			if (m_pBuffer && m_profilerGeneration == s_profilerGeneration.load(std::memory_order_acquire) && Profiler::GetInstance())
+				m_pBuffer->m_isClaimed.store(false, std::memory_order_release);
+		}
+	};
+
+	static thread_local ProfilerThreadBufferHandle s_profilerThreadBuffer;
+
+	Profiler::Profiler()
+		: m_frameStartNanoseconds(0)
+		, m_frameEndNanoseconds(0)
+		, m_maxCapturedEvents(s_kDefaultMaxCapturedEvents)
+		, m_isCapturing(false)
+		, m_droppedEventCount(0)
+	{
+		s_profilerGeneration.fetch_add(1, std::memory_order_acq_rel);
+	}
+
+	Profiler::~Profiler()
+	{
+		SetRecording(false);
+
+		// Threads exiting from now on must not give back buffers that are about to be freed.
+		s_profilerGeneration.fetch_add(1, std::memory_order_acq_rel);
+
+		for (ThreadBuffer* pBuffer : m_threadBuffers)
+		{
+			EXELIUS_DELETE(pBuffer);
+		}
+		m_threadBuffers.clear();
+	}
+
+	void Profiler::SetRecording(bool isRecording)
+	{
+		s_isRecording.store(isRecording, std::memory_order_relaxed);
+	}
+
+	uint64_t Profiler::GetTimeNanoseconds()
+	{
+		static const std::chrono::steady_clock::time_point s_kEpoch = std::chrono::steady_clock::now();
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - s_kEpoch).count());
+	}
+
+	void Profiler::SetThreadName(const char* pName)
+	{
+		EXE_ASSERT(pName);
+
+		ThreadBuffer* pBuffer = GetThreadBuffer();
+		EXE_ASSERT(pBuffer);
+
+		std::lock_guard<std::mutex> lock(m_threadsLock);
+		ProfileThread& thread = m_threads[pBuffer->m_threadIndex];
+		snprintf(thread.m_name, sizeof(thread.m_name), "%s", pName);
+	}
+
+	void Profiler::BeginFrame()
+	{
+		m_frameStartNanoseconds = GetTimeNanoseconds();
+	}
+
+	void Profiler::EndFrame()
+	{
+		static constexpr size_t s_kBatchSize = 256;
+
+		m_frameEndNanoseconds = GetTimeNanoseconds();
+		m_frameEvents.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(m_threadsLock);
+			for (ThreadBuffer* pBuffer : m_threadBuffers)
+			{
+				ProfileEvent batch[s_kBatchSize];
+				size_t poppedCount = 0;
+				while ((poppedCount = pBuffer->m_events.PopBatch(batch, s_kBatchSize)) > 0)
+				{
+					for (size_t i = 0; i < poppedCount; ++i)
+					{
+						batch[i].m_threadIndex = pBuffer->m_threadIndex;
+						m_frameEvents.emplace_back(batch[i]);
+					}
+				}
+			}
+
+			m_frameThreads = m_threads;
+		}
+
+		// Scopes are recorded as they end, so children come before their parents.
+		eastl::sort(m_frameEvents.begin(), m_frameEvents.end(), [](const ProfileEvent& left, const ProfileEvent& right)
+			{
+				if (left.m_threadIndex != right.m_threadIndex)
+					return left.m_threadIndex < right.m_threadIndex;
+				if (left.m_startNanoseconds != right.m_startNanoseconds)
+					return left.m_startNanoseconds < right.m_startNanoseconds;
+				return left.m_depth < right.m_depth;
+			});
+
+		if (m_isCapturing)
+		{
+			// Only whole frames are kept, so the capture never ends part way through one.
+			if (m_capturedEvents.size() + m_frameEvents.size() > m_maxCapturedEvents)
+			{
+				EXE_LOG_CATEGORY_WARN("Profiler", "Stopped the profile capture, it reached its limit of {} events.", m_maxCapturedEvents);
+				StopCapture();
+				return;
+			}
+
+			m_capturedEvents.insert(m_capturedEvents.end(), m_frameEvents.begin(), m_frameEvents.end());
+		}
+	}
+
+	void Profiler::RecordEvent(const ProfileEvent& event)
+	{
+		ThreadBuffer* pBuffer = GetThreadBuffer();
+		EXE_ASSERT(pBuffer);
+
+		if (!pBuffer->m_events.PushBack(event))
+			m_droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Profiler::StartCapture(size_t maxEventCount)
+	{
+		EXE_ASSERT(maxEventCount > 0);
+
+		m_capturedEvents.clear();
+		m_maxCapturedEvents = maxEventCount;
+		m_isCapturing = true;
+		SetRecording(true);
+	}
+
+	void Profiler::StopCapture()
+	{
+		m_isCapturing = false;
+	}
+
+	/// <summary>
+	/// Append a string to JSON output, escaping anything that would end it early.
+	/// </summary>
+	static void AppendJsonString(eastl::string& json, const char* pString)
+	{
+		json.push_back('"');
+		for (const char* pCharacter = pString; *pCharacter; ++pCharacter)
+		{
+			if (*pCharacter == '"' || *pCharacter == '\\')
+				json.push_back('\\');
+
+			if (static_cast<unsigned char>(*pCharacter) < 0x20)
+				continue;
+
+			json.push_back(*pCharacter);
+		}
+		json.push_back('"');
+	}
+
+	bool Profiler::ExportChromeTrace(const char* pFilePath)
+	{
+		EXE_ASSERT(pFilePath);
+
+		eastl::string json;
+		json.reserve(64 + m_capturedEvents.size() * 96);
+		json += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+		bool isFirstEvent = true;
+		auto beginEvent = [&json, &isFirstEvent]()
+		{
+			if (!isFirstEvent)
+				json += ",\n";
+			isFirstEvent = false;
+		};
+
+		// Every captured event was collected by EndFrame, so its thread is in the frame's copy.
+		// Threads are listed by index, system thread IDs can be too large for the viewers to read exactly.
+		for (size_t threadIndex = 0; threadIndex < m_frameThreads.size(); ++threadIndex)
+		{
+			beginEvent();
+			json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+			json += eastl::to_string(threadIndex);
+			json += ",\"args\":{\"name\":";
+			AppendJsonString(json, m_frameThreads[threadIndex].m_name);
+			json += "}}";
+		}
+
+		// Complete events, timestamps and durations in microseconds.
+		char number[32];
+		for (const ProfileEvent& event : m_capturedEvents)
+		{
+			beginEvent();
+			json += "{\"name\":";
+			AppendJsonString(json, event.m_pName);
+			json += ",\"cat\":\"Exelius\",\"ph\":\"X\",\"pid\":0,\"tid\":";
+			json += eastl::to_string(event.m_threadIndex);
+
+			snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.m_startNanoseconds) / 1000.0);
+			json += ",\"ts\":";
+			json += number;
+
+			snprintf(number, sizeof(number), "%.3f", static_cast<double>(event.m_endNanoseconds - event.m_startNanoseconds) / 1000.0);
+			json += ",\"dur\":";
+			json += number;
+			json += "}";
+		}
+
+		json += "]}\n";
+
+		File traceFile;
+		if (!traceFile.Open(pFilePath, File::AccessPermission::kWriteOnly, File::CreationType::kOverwriteFile))
+		{
+			EXE_LOG_CATEGORY_ERROR("Profiler", "Failed to open '{}' to export the trace.", pFilePath);
+			return false;
+		}
+
+		eastl::vector<std::byte> data(json.size());
+		::memcpy(data.data(), json.data(), json.size());
+		const size_t writtenBytes = traceFile.Write(data);
+		traceFile.Close();
+
+		if (writtenBytes != data.size())
+		{
+			EXE_LOG_CATEGORY_ERROR("Profiler", "Failed to write the trace to '{}'.", pFilePath);
+			return false;
+		}
+
+		EXE_LOG_CATEGORY_INFO("Profiler", "Exported {} profile events to '{}'.", m_capturedEvents.size(), pFilePath);
+		return true;
+	}
+
+	Profiler::ThreadBuffer* Profiler::GetThreadBuffer()
+	{
+		const uint32_t generation = s_profilerGeneration.load(std::memory_order_acquire);
+		if (s_profilerThreadBuffer.m_pBuffer && s_profilerThreadBuffer.m_profilerGeneration == generation)
+			return s_profilerThreadBuffer.m_pBuffer;
+
+		std::lock_guard<std::mutex> lock(m_threadsLock);
+
+		const uint64_t threadID = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+		ThreadBuffer* pClaimedBuffer = nullptr;
+		for (ThreadBuffer* pBuffer : m_threadBuffers)
+		{
+			bool isClaimed = false;
+			if (pBuffer->m_isClaimed.compare_exchange_strong(isClaimed, true, std::memory_order_acq_rel))
+			{
+				pClaimedBuffer = pBuffer;
+				break;
+			}
+		}
+
+		if (!pClaimedBuffer)
+		{
+			pClaimedBuffer = EXELIUS_NEW(ThreadBuffer());
+			EXE_ASSERT(pClaimedBuffer);
+			m_threadBuffers.emplace_back(pClaimedBuffer);
+		}
+
+		// A reused buffer is listed as a new thread. Events the last owner left in it are listed under this one.
+		pClaimedBuffer->m_threadIndex = static_cast<uint16_t>(m_threads.size());
+
+		ProfileThread& thread = m_threads.emplace_back();
+		snprintf(thread.m_name, sizeof(thread.m_name), "Thread %zu", m_threads.size() - 1);
+		thread.m_threadID = threadID;
+
+		s_profilerThreadBuffer.m_pBuffer = pClaimedBuffer;
+		s_profilerThreadBuffer.m_profilerGeneration = generation;
+		return pClaimedBuffer;
+	}
+}
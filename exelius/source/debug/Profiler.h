@@ -0,0 +1,252 @@
+#pragma once
+#include "source/utility/containers/RingBuffer.h"
+#include "source/utility/generic/Singleton.h"
+
+#include <EASTL/vector.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Set to 0 to compile every EXE_PROFILE_* macro out entirely.
+// When compiled in, a scope costs a single branch while the profiler isn't recording.
+#ifndef EXE_ENABLE_PROFILER
+	#define EXE_ENABLE_PROFILER 1
+#endif
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A single timed scope.
+	/// </summary>
+	struct ProfileEvent
+	{
+		/// <summary>
+		/// Must outlive the profiler's captures, so is expected to be a literal or otherwise static.
+		/// </summary>
+		const char* m_pName;
+
+		uint64_t m_startNanoseconds;
+		uint64_t m_endNanoseconds;
+
+		/// <summary>
+		/// How many scopes were open on the thread when this one began.
+		/// </summary>
+		uint16_t m_depth;
+
+		/// <summary>
+		/// Index into Profiler::GetThreads(). Set when the event is collected.
+		/// </summary>
+		uint16_t m_threadIndex;
+	};
+
+	/// <summary>
+	/// A thread that has recorded profile events.
+	/// </summary>
+	struct ProfileThread
+	{
+		char m_name[32];
+		uint64_t m_threadID;
+	};
+
+	/// <summary>
+	/// Hierarchical CPU profiler. Instrument code with EXE_PROFILE_SCOPE and
+	/// EXE_PROFILE_FUNCTION.
+	///
+	/// Each thread records finished scopes into its own lock-free buffer, so
+	/// recording never takes a lock. Once per frame, the main thread collects
+	/// every buffer into the last frame's events, for the editor's flame view,
+	/// and into the capture, if one is running. Captures export to the Chrome
+	/// trace event format, viewable in chrome://tracing or https://ui.perfetto.dev.
+	///
+	/// Recording is off until SetRecording(true) is called.
+	/// </summary>
+	class Profiler
+		: public Singleton<Profiler>
+	{
+	public:
+		static constexpr size_t s_kEventsPerThread = 8192;
+
+		/// <summary>
+		/// Events a capture holds by default before it stops itself. Roughly 32MB.
+		/// </summary>
+		static constexpr size_t s_kDefaultMaxCapturedEvents = 1024 * 1024;
+
+		/// <summary>
+		/// The events recorded by one thread. Reused by another thread once the owner exits.
+		/// </summary>
+		struct ThreadBuffer
+		{
+			SPSCRingBuffer<ProfileEvent, s_kEventsPerThread> m_events;
+			std::atomic<bool> m_isClaimed = true;
+			uint16_t m_threadIndex = 0;
+		};
+
+	private:
+		inline static std::atomic<bool> s_isRecording = false;
+
+		eastl::vector<ThreadBuffer*> m_threadBuffers;
+		eastl::vector<ProfileThread> m_threads;
+		std::mutex m_threadsLock;
+
+		/// <summary>
+		/// A copy of m_threads taken at the end of the frame, readable without the lock.
+		/// </summary>
+		eastl::vector<ProfileThread> m_frameThreads;
+
+		eastl::vector<ProfileEvent> m_frameEvents;
+		uint64_t m_frameStartNanoseconds;
+		uint64_t m_frameEndNanoseconds;
+
+		eastl::vector<ProfileEvent> m_capturedEvents;
+		size_t m_maxCapturedEvents;
+		bool m_isCapturing;
+
+		/// <summary>
+		/// Events lost because a thread's buffer filled before the frame ended.
+		/// </summary>
+		std::atomic<uint64_t> m_droppedEventCount;
+
+	public:
+		Profiler();
+		Profiler(const Profiler&) = delete;
+		Profiler(Profiler&&) = delete;
+		Profiler& operator=(const Profiler&) = delete;
+		Profiler& operator=(Profiler&&) = delete;
+		~Profiler();
+
+		static bool IsRecording() { return s_isRecording.load(std::memory_order_relaxed); }
+		void SetRecording(bool isRecording);
+
+		/// <summary>
+		/// Nanoseconds since an arbitrary, fixed point in time.
+		/// </summary>
+		static uint64_t GetTimeNanoseconds();
+
+		/// <summary>
+		/// Name the calling thread in the flame view and exported traces.
+		/// Threads are named "Thread N" until they name themselves.
+		/// </summary>
+		void SetThreadName(const char* pName);
+
+		/// <summary>
+		/// Called by the engine at the start of every frame.
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// Called by the engine at the end of every frame, on the main thread.
+		/// Collects every thread's events.
+		/// </summary>
+		void EndFrame();
+
+		/// <summary>
+		/// Record a finished scope on the calling thread. Use the EXE_PROFILE_* macros instead.
+		/// </summary>
+		void RecordEvent(const ProfileEvent& event);
+
+		/// <summary>
+		/// The events collected at the end of the last frame, grouped by thread, in the order they began.
+		/// Main thread only.
+		/// </summary>
+		const eastl::vector<ProfileEvent>& GetFrameEvents() const { return m_frameEvents; }
+		uint64_t GetFrameStartNanoseconds() const { return m_frameStartNanoseconds; }
+		uint64_t GetFrameEndNanoseconds() const { return m_frameEndNanoseconds; }
+
+		/// <summary>
+		/// Every thread that had recorded events by the end of the last frame.
+		/// Indexed by ProfileEvent::m_threadIndex. Main thread only.
+		/// </summary>
+		const eastl::vector<ProfileThread>& GetThreads() const { return m_frameThreads; }
+
+		uint64_t GetDroppedEventCount() const { return m_droppedEventCount.load(std::memory_order_relaxed); }
+
+		/// <summary>
+		/// Start keeping every frame's events, and start recording if needed.
+		/// The capture stops itself, with a warning, before the first frame that
+		/// would take it past maxEventCount events.
+		/// </summary>
+		/// <param name="maxEventCount">- The most events the capture may hold.</param>
+		void StartCapture(size_t maxEventCount = s_kDefaultMaxCapturedEvents);
+		void StopCapture();
+		bool IsCapturing() const { return m_isCapturing; }
+		size_t GetCapturedEventCount() const { return m_capturedEvents.size(); }
+
+		/// <summary>
+		/// Write the captured events as a Chrome trace event JSON file.
+		/// </summary>
+		/// <param name="pFilePath">- The file to write. Overwritten if it exists.</param>
+		/// <returns>True if the file was written.</returns>
+		bool ExportChromeTrace(const char* pFilePath);
+
+	private:
+		/// <summary>
+		/// The calling thread's buffer, claimed the first time the thread records an event.
+		/// </summary>
+		ThreadBuffer* GetThreadBuffer();
+	};
+
+	/// <summary>
+	/// Times the scope it is declared in. Use EXE_PROFILE_SCOPE or EXE_PROFILE_FUNCTION.
+	/// </summary>
+	class ScopedProfileEvent
+	{
+		const char* m_pName;
+		uint64_t m_startNanoseconds;
+		uint16_t m_depth;
+		bool m_isRecording;
+
+		/// <summary>
+		/// The number of scopes open on this thread.
+		/// </summary>
+		inline static thread_local uint16_t s_depth = 0;
+
+	public:
+		explicit ScopedProfileEvent(const char* pName)
+			: m_pName(pName)
+			, m_startNanoseconds(0)
+			, m_depth(0)
+			, m_isRecording(Profiler::IsRecording())
+		{
+			if (!m_isRecording)
+				return;
+
+			m_depth = s_depth++;
+			m_startNanoseconds = Profiler::GetTimeNanoseconds();
+		}
+
+		~ScopedProfileEvent()
+		{
+			if (!m_isRecording)
+				return;
+
+			const uint64_t endNanoseconds = Profiler::GetTimeNanoseconds();
+			--s_depth;
+
+			if (Profiler* pProfiler = Profiler::GetInstance())
+				pProfiler->RecordEvent({ m_pName, m_startNanoseconds, endNanoseconds, m_depth, 0 });
+		}
+
+		ScopedProfileEvent(const ScopedProfileEvent&) = delete;
+		ScopedProfileEvent(ScopedProfileEvent&&) = delete;
+		ScopedProfileEvent& operator=(const ScopedProfileEvent&) = delete;
+		ScopedProfileEvent& operator=(ScopedProfileEvent&&) = delete;
+	};
+}
+
+#define EXE_PROFILE_CONCATENATE_INTERNAL(LEFT, RIGHT) LEFT##RIGHT
+#define EXE_PROFILE_CONCATENATE(LEFT, RIGHT) EXE_PROFILE_CONCATENATE_INTERNAL(LEFT, RIGHT)
+
+#if EXE_ENABLE_PROFILER
+	// Times the rest of the enclosing scope. The name must be a string literal, or otherwise never freed.
+	#define EXE_PROFILE_SCOPE(NAME) ::Exelius::ScopedProfileEvent EXE_PROFILE_CONCATENATE(profileScope, __LINE__)(NAME)
+
+	// Times the rest of the enclosing function, named after it.
+	#define EXE_PROFILE_FUNCTION() EXE_PROFILE_SCOPE(__FUNCTION__)
+#else
+	#define EXE_PROFILE_SCOPE(NAME)
+	#define EXE_PROFILE_FUNCTION()
+#endif
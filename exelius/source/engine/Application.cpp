@@ -13,8 +13,10 @@
 #include "source/networking/NetworkingManager.h"
 
 #include "source/debug/LogManager.h"
+#include "source/debug/Profiler.h"
 
 #include "source/os/threads/JobSystem.h"
+#include "source/os/threads/Coroutines.h"
 
 #include "source/resource/ResourceLoader.h"
 
@@ -93,29 +95,46 @@ namespace Exelius
 		Renderer2D::GetInstance()->GetWindow().GetEventMessenger().RemoveObserver(*this);
 		Renderer2D::DestroySingleton();
 
+		// Queued coroutines may still hold resources.
+		CoroutineScheduler::DestroySingleton();
+
 		ResourceLoader::DestroySingleton();
 
 		NetworkingManager::DestroySingleton();
 
 		EXELIUS_DELETE(s_pGlobalJobSystem);
 
+		// Worker threads are gone, nothing is left to record into the profiler's buffers.
+		Profiler::DestroySingleton();
+
 		MessageServer::DestroySingleton();
 
 		LogManager::DestroySingleton();
 
 		StringIntern::_ClearStringInternSet();
 
+		MemoryManager::GetInstance()->GetTraceAllocator()->StopRecording();
 		MemoryManager::GetInstance()->GetGlobalAllocator()->DumpMemoryData();
 
 		MemoryManager::DestroySingleton();
 	}
 
 	bool Application::PreInitializeExelius()
+	{
+		// The allocator has to be chosen before anything is allocated,
+		// so this only reads the one setting, and only uses malloc.
+		GlobalAllocatorType globalAllocatorType = s_kDefaultGlobalAllocatorType;
+		ConfigFile::ReadGlobalAllocatorType(globalAllocatorType);
+
+		return PreInitializeExelius(globalAllocatorType);
+	}
+
+	bool Application::PreInitializeExelius(GlobalAllocatorType globalAllocatorType)
 	{
 		// Should be the only call to "new" inside any Exelius code.
 		MemoryManager::SetSingleton(new MemoryManager());
 		EXE_ASSERT(MemoryManager::GetInstance());
-		MemoryManager::GetInstance()->Initialize(true);
+		MemoryManager::GetInstance()->Initialize(globalAllocatorType);
 
 		LogManager::SetSingleton(EXELIUS_NEW(LogManager()));
 		EXE_ASSERT(LogManager::GetInstance());
@@ -126,6 +145,10 @@ namespace Exelius
 			return false;
 		}
 
+		Profiler::SetSingleton(EXELIUS_NEW(Profiler()));
+		EXE_ASSERT(Profiler::GetInstance());
+		Profiler::GetInstance()->SetThreadName("Main");
+
 		return true;
 	}
 
@@ -152,6 +175,20 @@ namespace Exelius
 		if (!InitializeLogManager(configFile))
 			return false;
 
+		//-----------------------------------------------
+		// Memory - Allocation Recording
+		//-----------------------------------------------
+
+		eastl::string allocationTracePath;
+		if (configFile.PopulateAllocationTracePath(allocationTracePath))
+		{
+			auto* pMemoryManager = MemoryManager::GetInstance();
+			if (pMemoryManager->GetGlobalAllocator() != pMemoryManager->GetTraceAllocator())
+				EXE_LOG_CATEGORY_WARN("Application", "Allocations are only recorded by the trace allocator. '{}' will not be written.", allocationTracePath.c_str());
+			else if (!pMemoryManager->GetTraceAllocator()->StartRecording(allocationTracePath.c_str()))
+				EXE_LOG_CATEGORY_WARN("Application", "Failed to open '{}' to record allocations.", allocationTracePath.c_str());
+		}
+
 		//-----------------------------------------------
 		// Messaging - Initialization
 		//-----------------------------------------------
@@ -167,6 +204,9 @@ namespace Exelius
 			s_pGlobalJobSystem = EXELIUS_NEW(JobSystem());
 		s_pGlobalJobSystem->Initialize();
 
+		CoroutineScheduler::SetSingleton(EXELIUS_NEW(CoroutineScheduler()));
+		EXE_ASSERT(CoroutineScheduler::GetInstance());
+
 		//-----------------------------------------------
 		// Networking System - Initialization
 		//-----------------------------------------------
@@ -219,6 +259,12 @@ namespace Exelius
 		if (!InitializeInputManager(configFile))
 			return false;
 
+		//-----------------------------------------------
+		// Frame Graph - Initialization
+		//-----------------------------------------------
+
+		BuildFrameGraph();
+
 		//-----------------------------------------------
 		// Client Application - Initialization
 		//-----------------------------------------------
@@ -234,37 +280,116 @@ namespace Exelius
 	{
 		while (m_isRunning)
 		{
+			Profiler::GetInstance()->BeginFrame();
+			Timer frameTimer(true);
+
+			// Last frame has fully finished, nothing can still be using its transient memory.
+			MemoryManager::GetInstance()->BeginFrame();
+
 			Time.RestartDeltaTime();
 
-			if (!m_hasLostFocus)
 			{
-				// Dispatch Messages
-				MessageServer::GetInstance()->DispatchMessages();
+				EXE_PROFILE_SCOPE("Frame");
+				m_frameGraph.Execute();
+			}
+
+			m_frameTimeRecorder.RecordFrame(frameTimer.GetElapsedTime(), m_frameGraph);
+
+			Profiler::GetInstance()->EndFrame();
+		}
+	}
+
+	/// <summary>
+	/// Declare the engine's frame stages and their dependencies.
+	/// Anything touching the window, renderer or ImGui must stay on the main thread.
+	/// </summary>
+	void Application::BuildFrameGraph()
+	{
+		// Deallocate any resources necessary. Resources queued for unload during
+		// the layer update are released at the start of the next frame instead.
+		// Resources may own GPU objects, so this stays on the main thread.
+		FrameStageHandle unloadStage = m_frameGraph.AddStage("ProcessUnloadQueue", [this]()
+			{
+				if (!m_hasLostFocus)
+					ResourceLoader::GetInstance()->ProcessUnloadQueue();
+			}, FrameStageAffinity::kMainThread);
+
+		// Measure allocation rates and check budgets. The counters are atomics
+		// and nothing else keeps the rates, so this overlaps the rest of the frame.
+		m_frameGraph.AddStage("UpdateMemoryStats", []()
+			{
+				MemoryManager::GetInstance()->GetMemoryStats()->Update(Time.DeltaTimeUnscaled);
+			}, FrameStageAffinity::kAnyThread);
+
+		// Hand the most urgent loads queued last frame to the workers.
+		m_frameGraph.AddStage("ProcessLoadQueue", []()
+			{
+				ResourceLoader::GetInstance()->ProcessLoadQueue();
+			}, FrameStageAffinity::kAnyThread);
+
+		// Finalize the resources the workers have decoded, such as uploading
+		// textures, within the loader's per-frame budget.
+		FrameStageHandle finalizeStage = m_frameGraph.AddStage("FinalizeLoads", []()
+			{
+				ResourceLoader::GetInstance()->ProcessFinalizeQueue();
+			}, FrameStageAffinity::kMainThread);
+
+		// Dispatch Messages.
+		// Receivers aren't guarded and may touch scene or resource state,
+		// so this stays on the main thread with the other stages that do.
+		FrameStageHandle messageStage = m_frameGraph.AddStage("DispatchMessages", [this]()
+			{
+				if (!m_hasLostFocus)
+					MessageServer::GetInstance()->DispatchMessages();
+			}, FrameStageAffinity::kMainThread);
+
+		// Continue coroutines waiting on the main thread or the next frame.
+		FrameStageHandle coroutineStage = m_frameGraph.AddStage("ResumeCoroutines", []()
+			{
+				CoroutineScheduler::GetInstance()->ProcessFrame();
+			}, FrameStageAffinity::kMainThread);
+
+		// Run work queued for the main thread by other threads.
+		FrameStageHandle mainThreadJobStage = m_frameGraph.AddStage("ProcessMainThreadJobs", []()
+			{
+				s_pGlobalJobSystem->ProcessMainThreadJobs();
+			}, FrameStageAffinity::kMainThread);
+
+		// Handle Layers.
+		FrameStageHandle updateStage = m_frameGraph.AddStage("UpdateLayers", [this]()
+			{
+				if (m_hasLostFocus)
+					return;
 
-				// Handle Layers.
 				for (Layer* pLayer : *m_pLayerStack)
 					pLayer->OnUpdate();
+			}, FrameStageAffinity::kMainThread, { unloadStage, finalizeStage, messageStage, coroutineStage, mainThreadJobStage });
 
-				// Deallocate any resources necessary.
-				ResourceLoader::GetInstance()->ProcessUnloadQueue();
-			}
-
-			// TODO: Move to render thread?
-			EXE_ASSERT(m_pImGuiLayer);
-			if (m_pImGuiLayer->Begin())
+		// TODO: Move to render thread?
+		FrameStageHandle imguiStage = m_frameGraph.AddStage("RenderImGui", [this]()
 			{
+				EXE_ASSERT(m_pImGuiLayer);
+				if (m_pImGuiLayer->Begin())
 				{
-					for (Layer* pLayer : *m_pLayerStack)
-						pLayer->OnImGuiRender();
+					{
+						for (Layer* pLayer : *m_pLayerStack)
+							pLayer->OnImGuiRender();
+					}
+					m_pImGuiLayer->End();
 				}
-				m_pImGuiLayer->End();
-			}
-			// Refresh Input State.
-			InputManager::GetInstance()->NextFrame();
+			}, FrameStageAffinity::kMainThread, { updateStage });
 
-			// Poll Window Events
-			Renderer2D::GetInstance()->Update();
-		}
+		// Refresh Input State.
+		FrameStageHandle inputStage = m_frameGraph.AddStage("NextInputFrame", []()
+			{
+				InputManager::GetInstance()->NextFrame();
+			}, FrameStageAffinity::kMainThread, { imguiStage });
+
+		// Poll Window Events
+		m_frameGraph.AddStage("UpdateWindow", []()
+			{
+				Renderer2D::GetInstance()->Update();
+			}, FrameStageAffinity::kMainThread, { inputStage });
 	}
 
 	/// <summary>
@@ -372,14 +497,15 @@ namespace Exelius
 	{
 		FileLogDefinition fileDefinition;
 		ConsoleLogDefinition consoleDefinition;
+		AsyncLogDefinition asyncDefinition;
 		eastl::vector<LogData> logData;
 
-		if (!configFile.PopulateLogData(fileDefinition, consoleDefinition, logData))
+		if (!configFile.PopulateLogData(fileDefinition, consoleDefinition, asyncDefinition, logData))
 		{
 			EXE_LOG_CATEGORY_WARN("Application", "Failed to populate log data correctly. Please verify config file.");
 		}
 
-		if (!LogManager::GetInstance()->Initialize(fileDefinition, consoleDefinition, logData))
+		if (!LogManager::GetInstance()->Initialize(fileDefinition, consoleDefinition, asyncDefinition, logData))
 		{
 			EXE_LOG_CATEGORY_FATAL("Application", "Exelius::LogManager::Initialize Failed.");
 			return false;
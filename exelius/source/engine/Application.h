@@ -2,6 +2,9 @@
 
 #include "source/utility/generic/Singleton.h"
 #include "source/os/events/EventManagement.h"
+#include "source/os/threads/FrameGraph.h"
+#include "source/os/memory/MemoryManager.h"
+#include "source/debug/FrameTimeRecorder.h"
 
 #include "source/engine/layers/imgui/ImGuiLayer.h"
 
@@ -30,7 +33,19 @@ namespace Exelius
 
 		LayerStack* m_pLayerStack;
 		ImGuiLayer* m_pImGuiLayer;
+
+		/// <summary>
+		/// The stages executed each frame by Run().
+		/// </summary>
+		FrameGraph m_frameGraph;
+
+		/// <summary>
+		/// Durations of the last frames run by Run(), per stage of m_frameGraph.
+		/// </summary>
+		FrameTimeRecorder m_frameTimeRecorder;
 	private:
+		static constexpr GlobalAllocatorType s_kDefaultGlobalAllocatorType = GlobalAllocatorType::kTrace;
+
 		float m_lastFrameTime;
 		bool m_isRunning;
 		bool m_hasLostFocus;
@@ -50,10 +65,19 @@ namespace Exelius
 
 		/// <summary>
 		/// Pre-Initialize the engine, this will spin up the default logging system to be used during initialization.
+		/// The global allocator is read from the "Memory" section of the config file,
+		/// and tracks allocations if the config file doesn't choose one.
 		/// </summary>
 		/// <returns>True on success, false on failure.</returns>
 		bool PreInitializeExelius();
 
+		/// <summary>
+		/// Pre-Initialize the engine, this will spin up the default logging system to be used during initialization.
+		/// </summary>
+		/// <param name="globalAllocatorType">- The allocator backing all engine allocations.</param>
+		/// <returns>True on success, false on failure.</returns>
+		bool PreInitializeExelius(GlobalAllocatorType globalAllocatorType);
+
 		/// <summary>
 		/// Initialize the engine, this will pull data from a config and initialize important systems.
 		/// </summary>
@@ -125,8 +149,27 @@ namespace Exelius
 
 		ImGuiLayer* GetImGuiLayer() const { return m_pImGuiLayer; }
 
+		/// <summary>
+		/// The graph of stages executed each frame. Clients may add their own
+		/// stages during Initialize(), depending on the engine stages by name.
+		/// @see FrameGraph::FindStage
+		/// </summary>
+		FrameGraph& GetFrameGraph() { return m_frameGraph; }
+
+		/// <summary>
+		/// Frame time percentiles and hitches over the last frames.
+		/// Usable without a window, so automated runs can check tail latency.
+		/// </summary>
+		FrameTimeRecorder& GetFrameTimeRecorder() { return m_frameTimeRecorder; }
+		const FrameTimeRecorder& GetFrameTimeRecorder() const { return m_frameTimeRecorder; }
+
 	private:
 		
+		/// <summary>
+		/// Declare the engine's frame stages and their dependencies.
+		/// </summary>
+		void BuildFrameGraph();
+		
 		/// <summary>
 		/// Initialize the LogManager using the config file data if necessary.
 		/// </summary>
@@ -30,7 +30,9 @@ namespace Exelius
 
 		eastl::string fileNameNoExtenstion = File::GetFileName(pScriptResource->GetResourceID().Get());
 
-		m_scriptData = pLuaState->script(pScriptResource->GetRawText().c_str(), pScriptResource->GetResourceID().Get().c_str());
+		// Cooked scripts are bytecode, which contains nulls, so pass the whole text rather than a c string.
+		const eastl::string& scriptText = pScriptResource->GetRawText();
+		m_scriptData = pLuaState->script(std::string_view(scriptText.data(), scriptText.size()), pScriptResource->GetResourceID().Get().c_str());
 		m_scriptData["gameObject"] = gameObject;
 
 		EXE_ASSERT(m_scriptData.valid());
@@ -6,6 +6,7 @@
 #include "source/engine/scenesystem/Scene.h"
 #include "source/engine/gameobjects/GameObject.h"
 #include "include/Time.h"
+#include "source/os/threads/ParallelFor.h"
 
 #include "source/engine/gameobjects/components/TransformComponent.h"
 #include "source/engine/gameobjects/components/RigidbodyComponent.h"
@@ -55,6 +56,8 @@ namespace Exelius
 
 	void PhysicsSystem::InitializeRuntimePhysics()
 	{
+		ScopedMemoryTag memoryTag(MemoryTag::kPhysics);
+
 		EXE_ASSERT(m_pOwningScene);
 
 		// Create new physics world. Since we are running on a copy of the scene from the editor.
@@ -144,6 +147,9 @@ namespace Exelius
 
 	void PhysicsSystem::UpdateRuntimePhysics()
 	{
+		EXE_PROFILE_FUNCTION();
+		ScopedMemoryTag memoryTag(MemoryTag::kPhysics);
+
 		EXE_ASSERT(m_pOwningScene);
 		EXE_ASSERT(m_pPhysicsWorld);
 
@@ -160,13 +166,12 @@ namespace Exelius
 		}
 
 		// Retrieve gameobject transforms from Box2D after the simulation.
-		auto view = m_pOwningScene->GetAllGameObjectsWith<RigidbodyComponent>();
-		for (auto gameObjectWithRigidBody : view)
+		// Each body writes only its own transform, so this can be split across the workers.
+		auto view = m_pOwningScene->GetAllGameObjectsWith<RigidbodyComponent, TransformComponent>();
+		ParallelForEach(view, [&view](auto gameObjectWithRigidBody)
 		{
-			GameObject gameObject = { gameObjectWithRigidBody, m_pOwningScene };
-			TransformComponent& transform = gameObject.GetComponent<TransformComponent>();
+			auto [rigidBody, transform] = view.template get<RigidbodyComponent, TransformComponent>(gameObjectWithRigidBody);
 			auto& translation = transform.m_translation;
-			RigidbodyComponent& rigidBody = gameObject.GetComponent<RigidbodyComponent>();
 
 			// Update the transform with Box2D simulated values.
 			b2Body* pBody = (b2Body*)rigidBody.m_pRuntimeBody;
@@ -176,7 +181,7 @@ namespace Exelius
 			translation.x = position.x;
 			translation.y = position.y;
 			transform.m_rotation.z = pBody->GetAngle();
-		}
+		});
 	}
 
 	void PhysicsSystem::StopRuntimePhysics()
@@ -0,0 +1,100 @@
+#include "EXEPCH.h"
+#include "QuadBatch.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	QuadBatch::QuadBatch()
+		: m_pVertexBufferBase(nullptr)
+		, m_pVertexBufferPtr(nullptr)
+		, m_indexCount(0)
+		, m_textureSlotIndex(1)
+	{
+		ScopedMemoryTag memoryTag(MemoryTag::kRendering);
+
+		m_pVertexBufferBase = EXELIUS_NEW_ARRAY(QuadVertex, s_kMaxVertices);
+		EXE_ASSERT(m_pVertexBufferBase);
+		m_pVertexBufferPtr = m_pVertexBufferBase;
+	}
+
+	QuadBatch::~QuadBatch()
+	{
+		EXELIUS_DELETE_ARRAY(m_pVertexBufferBase);
+		m_pVertexBufferPtr = nullptr;
+	}
+
+	void QuadBatch::Reset()
+	{
+		m_indexCount = 0;
+		m_pVertexBufferPtr = m_pVertexBufferBase;
+		m_textureSlotIndex = 1;
+	}
+
+	bool QuadBatch::AddQuad(const glm::mat4& transform, Color color, int gameObjectGUID)
+	{
+		if (m_indexCount >= s_kMaxIndices)
+			return false;
+
+		const float textureIndex = 0.0f; // White Texture
+		const float tilingFactor = 1.0f;
+
+		WriteQuad(transform, color.GetColorVector(), textureIndex, tilingFactor, gameObjectGUID);
+		return true;
+	}
+
+	bool QuadBatch::AddQuad(const glm::mat4& transform, const ResourceID& texture, float tilingFactor, Color tintColor, int gameObjectGUID)
+	{
+		if (m_indexCount >= s_kMaxIndices)
+			return false;
+
+		float textureIndex = 0.0f;
+		for (uint32_t i = 1; i < m_textureSlotIndex; ++i)
+		{
+			if (m_textureSlots[i] == texture)
+			{
+				textureIndex = (float)i;
+				break;
+			}
+		}
+
+		if (textureIndex == 0.0f)
+		{
+			if (m_textureSlotIndex >= s_kMaxTextureSlots)
+				return false;
+
+			textureIndex = (float)m_textureSlotIndex;
+			m_textureSlots[m_textureSlotIndex] = texture;
+			++m_textureSlotIndex;
+		}
+
+		WriteQuad(transform, tintColor.GetColorVector(), textureIndex, tilingFactor, gameObjectGUID);
+		return true;
+	}
+
+	void QuadBatch::WriteQuad(const glm::mat4& transform, const glm::vec4& color, float textureIndex, float tilingFactor, int gameObjectGUID)
+	{
+		constexpr size_t quadVertexCount = 4;
+		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		glm::vec4 vertexPositions[4];
+		vertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
+		vertexPositions[1] = { 0.5f, -0.5f, 0.0f, 1.0f };
+		vertexPositions[2] = { 0.5f,  0.5f, 0.0f, 1.0f };
+		vertexPositions[3] = { -0.5f,  0.5f, 0.0f, 1.0f };
+
+		for (size_t i = 0; i < quadVertexCount; ++i)
+		{
+			m_pVertexBufferPtr->m_position = transform * vertexPositions[i];
+			m_pVertexBufferPtr->m_color = color;
+			m_pVertexBufferPtr->m_textureCoord = textureCoords[i];
+			m_pVertexBufferPtr->m_textureIndex = textureIndex;
+			m_pVertexBufferPtr->m_tilingFactor = tilingFactor;
+			m_pVertexBufferPtr->m_gameObjectGUID = gameObjectGUID;
+			++m_pVertexBufferPtr;
+		}
+
+		m_indexCount += 6;
+	}
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "source/resource/ResourceHelpers.h"
+#include "source/utility/generic/Color.h"
+
+#include <EASTL/array.h>
+#include <glm/glm.hpp>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// One corner of a batched quad, laid out the way the quad shader reads it.
+	/// </summary>
+	struct QuadVertex
+	{
+		glm::vec3 m_position;
+		glm::vec4 m_color;
+		glm::vec2 m_textureCoord;
+		float m_textureIndex;
+		float m_tilingFactor;
+
+		// TODO: Editor-only
+		int m_gameObjectGUID;
+	};
+
+	/// <summary>
+	/// Builds a batch of quads on the CPU, ready to be uploaded and drawn
+	/// with a single call. Knows nothing of the graphics API, the Renderer2D
+	/// uploads and draws each batch, so quads can be batched without a window.
+	///
+	/// Texture slot 0 is always the white texture, used by untextured quads.
+	/// </summary>
+	class QuadBatch
+	{
+	public:
+		static constexpr uint32_t s_kMaxQuads = 20000;
+		static constexpr uint32_t s_kMaxVertices = s_kMaxQuads * 4;
+		static constexpr uint32_t s_kMaxIndices = s_kMaxQuads * 6;
+		static constexpr uint32_t s_kMaxTextureSlots = 32; // TODO: Determine maximum from hardware?
+
+	private:
+		QuadVertex* m_pVertexBufferBase;
+		QuadVertex* m_pVertexBufferPtr;
+		uint32_t m_indexCount;
+
+		eastl::array<ResourceID, s_kMaxTextureSlots> m_textureSlots;
+		uint32_t m_textureSlotIndex;
+
+	public:
+		QuadBatch();
+		QuadBatch(const QuadBatch&) = delete;
+		QuadBatch(QuadBatch&&) = delete;
+		QuadBatch& operator=(const QuadBatch&) = delete;
+		QuadBatch& operator=(QuadBatch&&) = delete;
+		~QuadBatch();
+
+		/// <summary>
+		/// Empty the batch, keeping only the white texture's slot.
+		/// </summary>
+		void Reset();
+
+		void SetWhiteTexture(const ResourceID& whiteTexture) { m_textureSlots[0] = whiteTexture; }
+
+		/// <summary>
+		/// Add an untextured quad.
+		/// </summary>
+		/// <returns>False if the batch is full. Draw it, Reset() and add the quad again.</returns>
+		bool AddQuad(const glm::mat4& transform, Color color, int gameObjectGUID);
+
+		/// <summary>
+		/// Add a textured quad, giving its texture a slot if it doesn't have one yet.
+		/// </summary>
+		/// <returns>False if the batch or its texture slots are full. Draw it, Reset() and add the quad again.</returns>
+		bool AddQuad(const glm::mat4& transform, const ResourceID& texture, float tilingFactor, Color tintColor, int gameObjectGUID);
+
+		const QuadVertex* GetVertices() const { return m_pVertexBufferBase; }
+		uint32_t GetVertexDataSize() const { return static_cast<uint32_t>(reinterpret_cast<const uint8_t*>(m_pVertexBufferPtr) - reinterpret_cast<const uint8_t*>(m_pVertexBufferBase)); }
+		uint32_t GetIndexCount() const { return m_indexCount; }
+
+		uint32_t GetTextureSlotCount() const { return m_textureSlotIndex; }
+		const ResourceID& GetTextureSlot(uint32_t slot) const { return m_textureSlots[slot]; }
+
+	private:
+		void WriteQuad(const glm::mat4& transform, const glm::vec4& color, float textureIndex, float tilingFactor, int gameObjectGUID);
+	};
+}
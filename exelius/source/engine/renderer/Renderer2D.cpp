@@ -27,16 +27,13 @@ namespace Exelius
 		, m_pRendererAPI(nullptr)
 		, m_pQuadVertexArray(nullptr)
 		, m_pQuadVertexBuffer(nullptr)
-		, m_quadShaderResource("assets/shaders/quadrenderer.glsl")
+		, m_quadShaderResource(EXE_STRING_ID("assets/shaders/quadrenderer.glsl"))
 		, m_pCircleVertexArray(nullptr)
 		, m_pCircleVertexBuffer(nullptr)
-		, m_circleShaderResource("assets/shaders/circlerenderer.glsl")
+		, m_circleShaderResource(EXE_STRING_ID("assets/shaders/circlerenderer.glsl"))
 		, m_pLineVertexArray(nullptr)
 		, m_pLineVertexBuffer(nullptr)
-		, m_lineShaderResource("assets/shaders/linerenderer.glsl")
-		, m_quadIndexCount(0)
-		, m_pQuadVertexBufferBase(nullptr)
-		, m_pQuadVertexBufferPtr(nullptr)
+		, m_lineShaderResource(EXE_STRING_ID("assets/shaders/linerenderer.glsl"))
 		, m_circleIndexCount(0)
 		, m_pCircleVertexBufferBase(nullptr)
 		, m_pCircleVertexBufferPtr(nullptr)
@@ -44,7 +41,6 @@ namespace Exelius
 		, m_pLineVertexBufferBase(nullptr)
 		, m_pLineVertexBufferPtr(nullptr)
 		, m_lineWidth(2.0f)
-		, m_textureSlotIndex(1)
 		, m_cameraBuffer()
 		, m_pCameraUniformBuffer(nullptr)
 	{
@@ -58,6 +54,8 @@ namespace Exelius
 
 	void Renderer2D::Initialize()
 	{
+		ScopedMemoryTag memoryTag(MemoryTag::kRendering);
+
 		SharedPtr<IndexBuffer> tpIndexBuffer = MakeIndexBuffer();
 
 		InitializeQuadRendering(tpIndexBuffer);
@@ -74,11 +72,9 @@ namespace Exelius
 	void Renderer2D::Shutdown()
 	{
 		EXELIUS_DELETE(m_pCameraUniformBuffer);
-		EXELIUS_DELETE_ARRAY(m_pQuadVertexBufferBase);
 		EXELIUS_DELETE_ARRAY(m_pCircleVertexBufferBase);
 		EXELIUS_DELETE_ARRAY(m_pLineVertexBufferBase);
 
-		m_pQuadVertexBufferPtr = nullptr;
 		m_pCircleVertexBufferPtr = nullptr;
 		m_pLineVertexBufferPtr = nullptr;
 	}
@@ -106,6 +102,7 @@ namespace Exelius
 
 	void Renderer2D::Flush()
 	{
+		EXE_PROFILE_FUNCTION();
 		FlushQuads();
 		FlushCircles();
 		FlushLines();
@@ -149,83 +146,23 @@ namespace Exelius
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, Color color, int m_gameObjectGUID)
 	{
-		constexpr size_t quadVertexCount = 4;
-		const float textureIndex = 0.0f; // White Texture
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-		const float tilingFactor = 1.0f;
-
-		if (m_quadIndexCount >= s_kMaxIndices)
-			NextBatch();
-
-		glm::vec4 vertexPositions[4];
-		vertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
-		vertexPositions[1] = { 0.5f, -0.5f, 0.0f, 1.0f };
-		vertexPositions[2] = { 0.5f,  0.5f, 0.0f, 1.0f };
-		vertexPositions[3] = { -0.5f,  0.5f, 0.0f, 1.0f };
-
-		for (size_t i = 0; i < quadVertexCount; ++i)
+		if (!m_quadBatch.AddQuad(transform, color, m_gameObjectGUID))
 		{
-			m_pQuadVertexBufferPtr->m_position = transform * vertexPositions[i];
-			m_pQuadVertexBufferPtr->m_color = color.GetColorVector();
-			m_pQuadVertexBufferPtr->m_textureCoord = textureCoords[i];
-			m_pQuadVertexBufferPtr->m_textureIndex = textureIndex;
-			m_pQuadVertexBufferPtr->m_tilingFactor = tilingFactor;
-			m_pQuadVertexBufferPtr->m_gameObjectGUID = m_gameObjectGUID;
-			++m_pQuadVertexBufferPtr;
+			NextBatch();
+			m_quadBatch.AddQuad(transform, color, m_gameObjectGUID);
 		}
 
-		m_quadIndexCount += 6;
-
 		++m_stats.m_quadCount;
 	}
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const ResourceID& texture, float tilingFactor, Color tintColor, int m_gameObjectGUID)
 	{
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
-
-		if (m_quadIndexCount >= s_kMaxIndices)
-			NextBatch();
-
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < m_textureSlotIndex; ++i)
-		{
-			if (m_textureSlots[i] == texture)
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
-
-		if (textureIndex == 0.0f)
+		if (!m_quadBatch.AddQuad(transform, texture, tilingFactor, tintColor, m_gameObjectGUID))
 		{
-			if (m_textureSlotIndex >= s_kMaxTextureSlots)
-				NextBatch();
-
-			textureIndex = (float)m_textureSlotIndex;
-			m_textureSlots[m_textureSlotIndex] = texture;
-			++m_textureSlotIndex;
-		}
-
-		glm::vec4 vertexPositions[4];
-		vertexPositions[0] = { -0.5f, -0.5f, 0.0f, 1.0f };
-		vertexPositions[1] = { 0.5f, -0.5f, 0.0f, 1.0f };
-		vertexPositions[2] = { 0.5f,  0.5f, 0.0f, 1.0f };
-		vertexPositions[3] = { -0.5f,  0.5f, 0.0f, 1.0f };
-
-		for (size_t i = 0; i < quadVertexCount; ++i)
-		{
-			m_pQuadVertexBufferPtr->m_position = transform * vertexPositions[i];
-			m_pQuadVertexBufferPtr->m_color = tintColor.GetColorVector();
-			m_pQuadVertexBufferPtr->m_textureCoord = textureCoords[i];
-			m_pQuadVertexBufferPtr->m_textureIndex = textureIndex;
-			m_pQuadVertexBufferPtr->m_tilingFactor = tilingFactor;
-			m_pQuadVertexBufferPtr->m_gameObjectGUID = m_gameObjectGUID;
-			++m_pQuadVertexBufferPtr;
+			NextBatch();
+			m_quadBatch.AddQuad(transform, texture, tilingFactor, tintColor, m_gameObjectGUID);
 		}
 
-		m_quadIndexCount += 6;
-
 		++m_stats.m_quadCount;
 	}
 
@@ -415,9 +352,6 @@ namespace Exelius
 				{ ShaderDataType::Int,		"a_gameObjectGUID" }
 			});
 		m_pQuadVertexArray->AddVertexBuffer(m_pQuadVertexBuffer);
-
-		m_pQuadVertexBufferBase = EXELIUS_NEW_ARRAY(QuadVertex, s_kMaxVertices);
-
 		m_pQuadVertexArray->SetIndexBuffer(pIndexBuffer);
 	}
 
@@ -473,7 +407,7 @@ namespace Exelius
 		}
 
 		// Set first texture slot to 0
-		m_textureSlots[0] = m_whiteTextureResource.GetID();
+		m_quadBatch.SetWhiteTexture(m_whiteTextureResource.GetID());
 	}
 
 	void Renderer2D::InitializeShaders()
@@ -493,16 +427,13 @@ namespace Exelius
 
 	void Renderer2D::StartBatch()
 	{
-		m_quadIndexCount = 0;
-		m_pQuadVertexBufferPtr = m_pQuadVertexBufferBase;
+		m_quadBatch.Reset();
 
 		m_circleIndexCount = 0;
 		m_pCircleVertexBufferPtr = m_pCircleVertexBufferBase;
 
 		m_lineVertexCount = 0;
 		m_pLineVertexBufferPtr = m_pLineVertexBufferBase;
-
-		m_textureSlotIndex = 1;
 	}
 
 	void Renderer2D::NextBatch()
@@ -513,16 +444,15 @@ namespace Exelius
 
 	void Renderer2D::FlushQuads()
 	{
-		if (m_quadIndexCount <= 0)
+		if (m_quadBatch.GetIndexCount() <= 0)
 			return;
 
-		uint32_t dataSize = (uint32_t)((uint8_t*)m_pQuadVertexBufferPtr - (uint8_t*)m_pQuadVertexBufferBase);
-		m_pQuadVertexBuffer->SetData(m_pQuadVertexBufferBase, dataSize);
+		m_pQuadVertexBuffer->SetData(m_quadBatch.GetVertices(), m_quadBatch.GetVertexDataSize());
 
 		// Bind textures
-		for (uint32_t i = 0; i < m_textureSlotIndex; i++)
+		for (uint32_t i = 0; i < m_quadBatch.GetTextureSlotCount(); i++)
 		{
-			ResourceHandle textureHandle(m_textureSlots[i]);
+			ResourceHandle textureHandle(m_quadBatch.GetTextureSlot(i));
 			TextureResource* pTextureResource = textureHandle.GetAs<TextureResource>();
 			if (!pTextureResource)
 				return;
@@ -535,7 +465,7 @@ namespace Exelius
 
 		BindShader(m_quadShaderResource);
 
-		m_pRendererAPI->DrawIndexed(m_pQuadVertexArray, m_quadIndexCount);
+		m_pRendererAPI->DrawIndexed(m_pQuadVertexArray, m_quadBatch.GetIndexCount());
 		m_stats.m_drawCalls++;
 	}
 
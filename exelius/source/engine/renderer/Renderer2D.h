@@ -2,6 +2,7 @@
 #include "source/utility/generic/Singleton.h"
 
 #include "source/render/Renderer.h"
+#include "source/engine/renderer/QuadBatch.h"
 #include "source/resource/ResourceHandle.h"
 #include "source/os/platform/PlatformForwardDeclarations.h"
 #include "source/utility/generic/Color.h"
@@ -29,10 +30,9 @@ namespace Exelius
 	class Renderer2D
 		: public Singleton<Renderer2D>, public Renderer
 	{
-		static const uint32_t s_kMaxQuads = 20000;
+		static const uint32_t s_kMaxQuads = QuadBatch::s_kMaxQuads;
 		static const uint32_t s_kMaxVertices = s_kMaxQuads * 4;
 		static const uint32_t s_kMaxIndices = s_kMaxQuads * 6;
-		static const uint32_t s_kMaxTextureSlots = 32; // TODO: Determine maximum from hardware?
 
 		struct CircleVertex
 		{
@@ -46,18 +46,6 @@ namespace Exelius
 			int m_gameObjectGUID;
 		};
 
-		struct QuadVertex
-		{
-			glm::vec3 m_position;
-			glm::vec4 m_color;
-			glm::vec2 m_textureCoord;
-			float m_textureIndex;
-			float m_tilingFactor;
-
-			// TODO: Editor-only
-			int m_gameObjectGUID;
-		};
-
 		struct LineVertex
 		{
 			glm::vec3 m_position;
@@ -87,9 +75,7 @@ namespace Exelius
 		SharedPtr<VertexBuffer> m_pLineVertexBuffer;
 		ResourceHandle m_lineShaderResource;
 
-		uint32_t m_quadIndexCount;
-		QuadVertex* m_pQuadVertexBufferBase;
-		QuadVertex* m_pQuadVertexBufferPtr;
+		QuadBatch m_quadBatch;
 
 		uint32_t m_circleIndexCount;
 		CircleVertex* m_pCircleVertexBufferBase;
@@ -101,9 +87,6 @@ namespace Exelius
 
 		float m_lineWidth;
 
-		eastl::array<ResourceID, s_kMaxTextureSlots> m_textureSlots;
-		uint32_t m_textureSlotIndex;
-
 		struct CameraData
 		{
 			glm::mat4 m_viewProjection;
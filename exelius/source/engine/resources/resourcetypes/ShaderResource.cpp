@@ -20,19 +20,23 @@ namespace Exelius
 
     Resource::LoadResult ShaderResource::Load(eastl::vector<std::byte>&& data)
     {
-        eastl::string shaderSourceText = eastl::string((const char*)data.begin(), (const char*)data.end());
-        if (shaderSourceText.empty())
+        m_source = eastl::string((const char*)data.begin(), (const char*)data.end());
+        if (m_source.empty())
         {
             EXE_LOG_CATEGORY_WARN("ShaderResource", "Failed to load resource, data is empty.");
             return LoadResult::kFailed;
         }
 
-        m_pShader = EXELIUS_NEW(Shader(GetResourceID().Get(), shaderSourceText));
+        return LoadResult::kDiscardRawData;
+    }
 
-        if (!m_pShader)
-            return LoadResult::kFailed;
+    bool ShaderResource::Finalize()
+    {
+        m_pShader = EXELIUS_NEW(Shader(GetResourceID().Get(), m_source));
+        m_source.clear();
+        m_source.shrink_to_fit();
 
-        return LoadResult::kKeptRawData;
+        return m_pShader != nullptr;
     }
 
     void ShaderResource::Unload()
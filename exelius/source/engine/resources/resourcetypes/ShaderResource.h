@@ -13,6 +13,11 @@ namespace Exelius
 		: public Resource
 	{
 		Shader* m_pShader;
+
+		/// <summary>
+		/// The source read by Load, held until Finalize compiles it.
+		/// </summary>
+		eastl::string m_source;
 	public:
 		ShaderResource(const ResourceID& id);
 		ShaderResource(const ShaderResource&) = delete;
@@ -21,6 +26,11 @@ namespace Exelius
 		virtual ~ShaderResource() final override;
 
 		virtual LoadResult Load(eastl::vector<std::byte>&& data) final override;
+
+		/// <summary>
+		/// Compiles the shader, on the main thread.
+		/// </summary>
+		virtual bool Finalize() final override;
 		virtual void Unload() final override;
 
 		Shader& GetShader() const { return *m_pShader; }
@@ -1,6 +1,10 @@
 #include "EXEPCH.h"
 #include "TextFileResource.h"
 
+#include "source/utility/io/CookedJson.h"
+
+#include <rapidjson/document.h>
+
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
@@ -8,12 +12,31 @@ namespace Exelius
 {
     TextFileResource::TextFileResource(const ResourceID& id)
         : Resource(id)
+        , m_pCookedDocument(nullptr)
     {
         //
     }
 
+    TextFileResource::~TextFileResource()
+    {
+        EXELIUS_DELETE(m_pCookedDocument);
+    }
+
     Resource::LoadResult TextFileResource::Load(eastl::vector<std::byte>&& data)
     {
+        if (CookedJson::IsCooked(data))
+        {
+            m_pCookedDocument = EXELIUS_NEW(rapidjson::Document());
+            if (!CookedJson::Read(data, *m_pCookedDocument))
+            {
+                EXE_LOG_CATEGORY_WARN("ResourceManager", "Failed to decode cooked JSON '{}'.", GetResourceID().Get().c_str());
+                EXELIUS_DELETE(m_pCookedDocument);
+                return LoadResult::kFailed;
+            }
+
+            return LoadResult::kDiscardRawData;
+        }
+
         m_text = eastl::string((const char*)data.begin(), (const char*)data.end());
         if (m_text.empty())
         {
@@ -24,6 +47,19 @@ namespace Exelius
         return LoadResult::kKeptRawData;
     }
 
+    void TextFileResource::Unload()
+    {
+        EXELIUS_DELETE(m_pCookedDocument);
+    }
+
+    void TextFileResource::SetRawText(const eastl::string& rawText)
+    {
+        m_text = rawText;
+
+        // The text replaces the cooked document, and is what gets saved.
+        EXELIUS_DELETE(m_pCookedDocument);
+    }
+
     eastl::vector<std::byte> TextFileResource::Save()
     {
         eastl::vector<std::byte> data(m_text.size() + 1);
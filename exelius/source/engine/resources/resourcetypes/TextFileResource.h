@@ -3,6 +3,7 @@
 #include "source/resource/Resource.h"
 
 #include <EASTL/string.h>
+#include <rapidjson/fwd.h>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
@@ -13,19 +14,38 @@ namespace Exelius
 		: public Resource
 	{
 		eastl::string m_text;
+
+		/// <summary>
+		/// Set instead of the text when the file is a cooked JSON document.
+		/// @see CookedJson
+		/// </summary>
+		rapidjson::Document* m_pCookedDocument;
 	public:
 		TextFileResource(const ResourceID& id);
 		TextFileResource(const TextFileResource&) = delete;
 		TextFileResource(TextFileResource&&) = delete;
 		TextFileResource& operator=(const TextFileResource&) = delete;
-		virtual ~TextFileResource() = default;
+		virtual ~TextFileResource() final override;
 
+		/// <summary>
+		/// Keeps the text, or decodes a cooked JSON document. Lua bytecode is
+		/// kept as is, and loaded by Lua the same as source.
+		/// </summary>
 		virtual LoadResult Load(eastl::vector<std::byte>&& data) final override;
-		virtual void Unload() final override {}
+		virtual void Unload() final override;
 
 		virtual eastl::vector<std::byte> Save() final override;
 
+		/// <summary>
+		/// The file's contents. Empty for a cooked JSON document, use GetCookedDocument instead.
+		/// May not be null terminated text if the file is Lua bytecode, so use its size.
+		/// </summary>
 		const eastl::string& GetRawText() const { return m_text; }
-		void SetRawText(const eastl::string& rawText) { m_text = rawText; }
+		void SetRawText(const eastl::string& rawText);
+
+		/// <summary>
+		/// The decoded document if the file was a cooked JSON document, nullptr otherwise.
+		/// </summary>
+		const rapidjson::Document* GetCookedDocument() const { return m_pCookedDocument; }
 	};
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "EXEPCH.h"
 #include "TextureResource.h"
 #include "source/render/Texture.h"
+#include "source/utility/io/CookedAssetStructs.h"
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
@@ -20,17 +21,78 @@ namespace Exelius
             m_pTexture->Unbind();
     }
 
+    /// <summary>
+    /// Take the pixels of an image cooked by the exeliuscooker tool. They are
+    /// already decoded, flipped and mipped, so only the header is checked.
+    /// </summary>
+    static bool ReadCookedImage(eastl::vector<std::byte>& data, TextureImage& image)
+    {
+        CookedTextureHeader header;
+        ::memcpy(&header, data.data(), sizeof(CookedTextureHeader));
+
+        if (header.m_version != CookedTextureHeader::kVersion || header.m_headerSize != sizeof(CookedTextureHeader))
+            return false;
+
+        // A full mip chain of the largest texture is at most 32 levels.
+        if (header.m_channels != 4 || header.m_width == 0 || header.m_height == 0 || header.m_mipCount == 0 || header.m_mipCount > 32)
+            return false;
+
+        image.m_width = header.m_width;
+        image.m_height = header.m_height;
+        image.m_channels = header.m_channels;
+        image.m_mipCount = header.m_mipCount;
+
+        if (header.m_pixelsSize != image.GetPixelsSize() || header.m_pixelsSize != data.size() - sizeof(CookedTextureHeader))
+            return false;
+
+        // Reuse the loaded data's allocation for the pixels.
+        data.erase(data.begin(), data.begin() + sizeof(CookedTextureHeader));
+        image.m_pixels = eastl::move(data);
+        return true;
+    }
+
     Resource::LoadResult TextureResource::Load(eastl::vector<std::byte>&& data)
     {
-        m_pTexture = EXELIUS_NEW(Texture(eastl::move(data)));
-        if (!m_pTexture)
+        uint32_t signature = 0;
+        if (data.size() >= sizeof(CookedTextureHeader))
+            ::memcpy(&signature, data.data(), sizeof(signature));
+
+        if (signature == CookedTextureHeader::kSignature)
+        {
+            if (!ReadCookedImage(data, m_image))
+            {
+                EXE_LOG_CATEGORY_WARN("TextureResource", "Failed to load resource, cooked image '{}' is invalid.", GetResourceID().Get().c_str());
+                m_image = TextureImage();
+                return LoadResult::kFailed;
+            }
+
+            return LoadResult::kDiscardRawData;
+        }
+
+        if (!Texture::DecodeImage(data, m_image))
+        {
+            EXE_LOG_CATEGORY_WARN("TextureResource", "Failed to load resource, image '{}' could not be decoded.", GetResourceID().Get().c_str());
+            return LoadResult::kFailed;
+        }
+
+        return LoadResult::kDiscardRawData;
+    }
+
+    bool TextureResource::Finalize()
+    {
+        m_pTexture = EXELIUS_NEW(Texture(m_image));
+
+        // The texture has its own copy now.
+        m_image = TextureImage();
+
+        if (!m_pTexture || !m_pTexture->IsLoaded())
         {
             EXE_LOG_CATEGORY_WARN("TextureResource", "Failed to load resource, texture was not successfully created.");
             EXELIUS_DELETE(m_pTexture);
-            return LoadResult::kFailed;
+            return false;
         }
 
-        return LoadResult::kKeptRawData;
+        return true;
     }
 
     void TextureResource::Unload()
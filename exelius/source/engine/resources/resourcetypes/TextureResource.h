@@ -1,18 +1,21 @@
 #pragma once
 #include "source/resource/Resource.h"
-#include "source/os/platform/PlatformForwardDeclarations.h"
+#include "source/render/Texture.h"
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
-	FORWARD_DECLARE(Texture);
-
 	class TextureResource
 		: public Resource
 	{
 		Texture* m_pTexture;
+
+		/// <summary>
+		/// The pixels decoded by Load, held until Finalize uploads them.
+		/// </summary>
+		TextureImage m_image;
 	public:
 		TextureResource(const ResourceID& id);
 		TextureResource(const TextureResource&) = delete;
@@ -20,7 +23,15 @@ namespace Exelius
 		TextureResource& operator=(const TextureResource&) = delete;
 		virtual ~TextureResource() final override;
 
+		/// <summary>
+		/// Decodes the image. Safe to run on a loader worker.
+		/// </summary>
 		virtual LoadResult Load(eastl::vector<std::byte>&& data) final override;
+
+		/// <summary>
+		/// Uploads the decoded image to the renderer, on the main thread.
+		/// </summary>
+		virtual bool Finalize() final override;
 		virtual void Unload() final override;
 
 		void SetTexture(Texture* pTextureToSet) { m_pTexture = pTextureToSet; }
@@ -7,6 +7,7 @@
 #include "tilemapinternals/TileLayer.h"
 #include "tilemapinternals/LayerGroup.h"
 
+#include "source/utility/io/CookedAssetStructs.h"
 #include "source/utility/string/StringTransformation.h"
 
 #include <EASTL/string.h>
@@ -33,6 +34,21 @@ namespace Exelius
 
     Resource::LoadResult TilemapResource::Load(eastl::vector<std::byte>&& data)
     {
+        uint32_t signature = 0;
+        if (data.size() >= sizeof(CookedTilemapHeader))
+            ::memcpy(&signature, data.data(), sizeof(signature));
+
+        if (signature == CookedTilemapHeader::kSignature)
+        {
+            if (!LoadMapFromCookedData(data, "assets"))
+            {
+                EXE_LOG_CATEGORY_WARN("Tilemap", "Failed to load cooked Tilemap '{}'.", GetResourceID().Get().c_str());
+                return LoadResult::kFailed;
+            }
+
+            return LoadResult::kDiscardRawData;
+        }
+
         eastl::string text = eastl::string((const char*)data.begin(), (const char*)data.end());
         if (text.empty())
         {
@@ -63,6 +79,78 @@ namespace Exelius
             return false;
         }
 
+        return ParseMapDocument(doc, workingDir);
+    }
+
+    bool TilemapResource::LoadMapFromCookedData(const eastl::vector<std::byte>& data, const eastl::string& workingDir)
+    {
+        ResetTilemapData();
+
+        CookedTilemapHeader header;
+        if (data.size() < sizeof(CookedTilemapHeader))
+            return false;
+
+        ::memcpy(&header, data.data(), sizeof(CookedTilemapHeader));
+        if (header.m_signature != CookedTilemapHeader::kSignature || header.m_version != CookedTilemapHeader::kVersion
+            || header.m_headerSize != sizeof(CookedTilemapHeader) || header.m_xmlSize > data.size() - sizeof(CookedTilemapHeader))
+        {
+            return false;
+        }
+
+        const std::byte* pXml = data.data() + sizeof(CookedTilemapHeader);
+        const std::byte* pTileArray = pXml + header.m_xmlSize;
+        const std::byte* pEnd = data.data() + data.size();
+
+        // Find every tile array up front, so layers can look theirs up by index.
+        m_cookedTileArrays.reserve(header.m_tileArrayCount);
+        for (uint32_t arrayIndex = 0; arrayIndex < header.m_tileArrayCount; ++arrayIndex)
+        {
+            uint32_t tileCount = 0;
+            if (static_cast<size_t>(pEnd - pTileArray) < sizeof(tileCount))
+                break;
+
+            ::memcpy(&tileCount, pTileArray, sizeof(tileCount));
+            pTileArray += sizeof(tileCount);
+
+            const size_t arraySize = static_cast<size_t>(tileCount) * sizeof(std::uint32_t);
+            if (static_cast<size_t>(pEnd - pTileArray) < arraySize)
+                break;
+
+            m_cookedTileArrays.emplace_back(pTileArray, arraySize);
+            pTileArray += arraySize;
+        }
+
+        if (m_cookedTileArrays.size() != header.m_tileArrayCount || pTileArray != pEnd)
+        {
+            m_cookedTileArrays.clear();
+            return false;
+        }
+
+        // Only the map's structure is left as XML, which is small next to its tiles.
+        pugi::xml_document doc;
+        bool hasSucceeded = doc.load_buffer(pXml, static_cast<size_t>(header.m_xmlSize));
+        if (hasSucceeded)
+            hasSucceeded = ParseMapDocument(doc, workingDir);
+
+        m_cookedTileArrays.clear();
+        return hasSucceeded;
+    }
+
+    bool TilemapResource::GetCookedTileIDs(std::uint32_t index, eastl::vector<std::uint32_t>& IDs) const
+    {
+        if (index >= m_cookedTileArrays.size())
+            return false;
+
+        const eastl::span<const std::byte>& tileArray = m_cookedTileArrays[index];
+        IDs.resize(tileArray.size() / sizeof(std::uint32_t));
+        if (!IDs.empty())
+            ::memcpy(IDs.data(), tileArray.data(), tileArray.size());
+
+        return true;
+    }
+
+    bool TilemapResource::ParseMapDocument(const pugi::xml_document& doc, const eastl::string& workingDir)
+    {
         //make sure we have consistent path separators
         m_workingDirectory = workingDir;
         String::ToFilepath(m_workingDirectory);
@@ -245,7 +333,7 @@ namespace Exelius
             else if (name == "layer")
             {
                 m_layers.emplace_back(MakeUnique<TileLayer>(m_tileCount.x * m_tileCount.y));
-                m_layers.back()->Parse(node);
+                m_layers.back()->Parse(node, this);
             }
             else if (name == "objectgroup")
             {
@@ -11,11 +11,17 @@
 #include "tilemapinternals/Property.h"
 #include "tilemapinternals/Object.h"
 
+#include <EASTL/span.h>
 #include <EASTL/vector.h>
 #include <EASTL/unordered_map.h>
 #include <EASTL/hash_map.h>
 #include <EASTL/string.h>
 
+namespace pugi
+{
+    class xml_document;
+}
+
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
@@ -107,6 +113,12 @@ namespace Exelius
         eastl::unordered_map<eastl::string, Object> m_templateObjects;
         eastl::unordered_map<eastl::string, Tileset> m_templateTilesets;
 
+        /// <summary>
+        /// The tile arrays of a cooked map, pointing into its data.
+        /// Only set while the cooked map is being parsed.
+        /// </summary>
+        eastl::vector<eastl::span<const std::byte>> m_cookedTileArrays;
+
 	public:
 		TilemapResource(const ResourceID& id);
 		TilemapResource(const TilemapResource&) = delete;
@@ -125,6 +137,25 @@ namespace Exelius
         /// <returns>true if successful, else false.</returns>
         bool LoadMapFromStringData(const eastl::string& data, const eastl::string& workingDir);
 
+        /// <summary>
+        /// Loads a map cooked by the exeliuscooker tool. Tile layers are read
+        /// from flat arrays, rather than decoded from CSV or base64 text.
+        /// @see CookedTilemapHeader
+        /// </summary>
+        /// <param name="data">The cooked map.</param>
+        /// <param name="workingDir">A eastl::string containing the working directory in which to find assets such as tile sets or images.</param>
+        /// <returns>true if successful, else false.</returns>
+        bool LoadMapFromCookedData(const eastl::vector<std::byte>& data, const eastl::string& workingDir);
+
+        /// <summary>
+        /// Copies one of the tile arrays of the cooked map being loaded.
+        /// Used by TileLayer when parsing a cooked map.
+        /// </summary>
+        /// <param name="index">The index of the array, from the layer's data node.</param>
+        /// <param name="IDs">Receives the global tile IDs, with their flip flags.</param>
+        /// <returns>true if the array exists, else false.</returns>
+        bool GetCookedTileIDs(std::uint32_t index, eastl::vector<std::uint32_t>& IDs) const;
+
         /// <summary>
         /// Returns the version of the tile map last parsed.
         /// If no tile map has yet been parsed the version will read 0, 0.
@@ -285,6 +316,12 @@ namespace Exelius
         /// <returns>True if sucessful, false otherwise.</returns>
         bool ParseRootMapNode(const pugi::xml_node&);
 
+        /// <summary>
+        /// Sets the working directory and parses the "map" node of a loaded document.
+        /// </summary>
+        /// <returns>True if sucessful, false otherwise.</returns>
+        bool ParseMapDocument(const pugi::xml_document& doc, const eastl::string& workingDir);
+
         //always returns false so we can return this
         //on load failure
 
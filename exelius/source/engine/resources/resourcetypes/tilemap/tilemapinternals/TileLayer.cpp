@@ -1,6 +1,7 @@
 #include "EXEPCH.h"
 #include "FreeFuncs.h"
 #include "TileLayer.h"
+#include "source/engine/resources/resourcetypes/tilemap/TilemapResource.h"
 
 #include <pugixml.hpp>
 #include <sstream>
@@ -18,7 +19,7 @@ namespace Exelius
     }
 
     //public
-    void TileLayer::Parse(const pugi::xml_node& node, TilemapResource*)
+    void TileLayer::Parse(const pugi::xml_node& node, TilemapResource* map)
     {
         std::string attribName = node.name();
         if (attribName != "layer")
@@ -39,7 +40,11 @@ namespace Exelius
             if (attribName == "data")
             {
                 attribName = child.attribute("encoding").as_string();
-                if (attribName == "base64")
+                if (attribName == "exelius")
+                {
+                    ParseCooked(child, map);
+                }
+                else if (attribName == "base64")
                 {
                     ParseBase64(child);
                 }
@@ -235,6 +240,37 @@ namespace Exelius
         CreateTiles(IDs, m_tiles);
     }
 
+    void TileLayer::ParseCooked(const pugi::xml_node& node, const TilemapResource* map)
+    {
+        // Only a cooked map can hold the tile arrays this refers to.
+        if (!map)
+            return;
+
+        eastl::vector<std::uint32_t> IDs;
+        if (node.attribute("index"))
+        {
+            if (map->GetCookedTileIDs(node.attribute("index").as_uint(), IDs))
+                CreateTiles(IDs, m_tiles);
+            return;
+        }
+
+        for (const auto& childNode : node.children("chunk"))
+        {
+            if (!map->GetCookedTileIDs(childNode.attribute("index").as_uint(), IDs) || IDs.empty())
+                continue;
+
+            Chunk chunk;
+            chunk.position.x = childNode.attribute("x").as_int();
+            chunk.position.y = childNode.attribute("y").as_int();
+
+            chunk.size.x = childNode.attribute("width").as_int();
+            chunk.size.y = childNode.attribute("height").as_int();
+
+            CreateTiles(IDs, chunk.tiles);
+            m_chunks.push_back(chunk);
+        }
+    }
+
     void TileLayer::CreateTiles(const eastl::vector<std::uint32_t>& IDs, eastl::vector<Tile>& destination)
     {
         //LOG(IDs.size() != m_tileCount, "Layer tile count does not match expected size. Found: "
@@ -76,6 +76,7 @@ namespace Exelius
         void ParseBase64(const pugi::xml_node&);
         void ParseCSV(const pugi::xml_node&);
         void ParseUnencoded(const pugi::xml_node&);
+        void ParseCooked(const pugi::xml_node&, const TilemapResource*);
 
         void CreateTiles(const eastl::vector<std::uint32_t>&, eastl::vector<Tile>& destination);
     };
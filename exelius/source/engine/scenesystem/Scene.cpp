@@ -5,6 +5,7 @@
 #include "source/engine/scripting/ScriptingSystem.h"
 #include "source/engine/gameobjects/GameObject.h"
 #include "source/engine/renderer/Renderer2D.h"
+#include "source/os/threads/ParallelFor.h"
 
 #include "source/engine/gameobjects/components/RigidbodyComponent.h"
 #include "source/engine/gameobjects/components/BoxColliderComponent.h"
@@ -183,6 +184,7 @@ namespace Exelius
 
 	void Scene::OnRuntimeUpdate()
 	{
+		EXE_PROFILE_FUNCTION();
 		EXE_ASSERT(m_pPhysicsSystem);
 		EXE_ASSERT(m_pScriptingSystem);
 
@@ -236,7 +238,7 @@ namespace Exelius
 
 	eastl::vector<GameObject> Scene::GetAllGameObjects()
 	{
-		eastl::vector<GameObject> gameObjects;
+		eastl::vector<GameObject> gameObjects(GetFrameEASTLAllocator("Scene::GetAllGameObjects"));
 		m_registry.each([&](auto gameObjectID)
 			{
 				gameObjects.emplace_back(GameObject{ gameObjectID , this });
@@ -276,6 +278,8 @@ namespace Exelius
 
 	bool Scene::DeserializeScene(const ResourceID& sceneResourceID)
 	{
+		ScopedMemoryTag memoryTag(MemoryTag::kScene);
+
 		EXE_LOG_CATEGORY_INFO("SceneDeserialization", "Attempting to deserialize Scene: '{}'", sceneResourceID.Get().c_str());
 
 		// We are attempting to deserialize a scene into this scene, which
@@ -308,15 +312,20 @@ namespace Exelius
 			return false;
 		}
 
-		eastl::string rawText = pTextFileResource->GetRawText();
-
-		// Parse the text as JSON data.
-		rapidjson::Document jsonDoc;
-		if (jsonDoc.Parse(rawText.c_str()).HasParseError())
+		// Cooked scenes were decoded when they loaded, otherwise parse the text as JSON data.
+		rapidjson::Document parsedDoc;
+		const rapidjson::Document* pJsonDoc = pTextFileResource->GetCookedDocument();
+		if (!pJsonDoc)
 		{
-			EXE_LOG_CATEGORY_ERROR("SceneDeserialization", "Failed to Parse JSON text: rapidjson error '{0}'", jsonDoc.GetParseError());
-			return false;
+			if (parsedDoc.Parse(pTextFileResource->GetRawText().c_str()).HasParseError())
+			{
+				EXE_LOG_CATEGORY_ERROR("SceneDeserialization", "Failed to Parse JSON text: rapidjson error '{0}'", parsedDoc.GetParseError());
+				return false;
+			}
+
+			pJsonDoc = &parsedDoc;
 		}
+		const rapidjson::Document& jsonDoc = *pJsonDoc;
 
 		auto sceneMember = jsonDoc.FindMember("Scene");
 
@@ -449,11 +458,27 @@ namespace Exelius
 	void Scene::SubmitSprites()
 	{
 		auto group = m_registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
+
+		m_spriteGameObjects.clear();
 		for (auto gameObject : group)
 		{
-			auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(gameObject);
+			m_spriteGameObjects.emplace_back(gameObject);
+		}
 
-			Renderer2D::GetInstance()->DrawSprite(transform.GetTransform(), sprite, (int)gameObject);
+		// Building the matrices is independent per sprite, so do it across the workers.
+		// Submission to the renderer stays on this thread, in the original order.
+		m_spriteTransforms.resize(m_spriteGameObjects.size());
+		ParallelFor(0, m_spriteGameObjects.size(), [this, &group](size_t i)
+		{
+			m_spriteTransforms[i] = group.get<TransformComponent>(m_spriteGameObjects[i]).GetTransform();
+		});
+
+		for (size_t i = 0; i < m_spriteGameObjects.size(); ++i)
+		{
+			const entt::entity gameObject = m_spriteGameObjects[i];
+			SpriteRendererComponent& sprite = group.get<SpriteRendererComponent>(gameObject);
+
+			Renderer2D::GetInstance()->DrawSprite(m_spriteTransforms[i], sprite, (int)gameObject);
 		}
 	}
 
@@ -605,15 +630,20 @@ namespace Exelius
 			return {};
 		}
 
-		eastl::string rawText = pTextFileResource->GetRawText();
-
-		// Parse the text as JSON data.
-		rapidjson::Document jsonDoc;
-		if (jsonDoc.Parse(rawText.c_str()).HasParseError())
+		// Cooked prefabs were decoded when they loaded, otherwise parse the text as JSON data.
+		rapidjson::Document parsedDoc;
+		const rapidjson::Document* pJsonDoc = pTextFileResource->GetCookedDocument();
+		if (!pJsonDoc)
 		{
-			EXE_LOG_CATEGORY_ERROR("PrefabDeserialization", "Failed to Parse JSON text: rapidjson error '{0}'", jsonDoc.GetParseError());
-			return {};
+			if (parsedDoc.Parse(pTextFileResource->GetRawText().c_str()).HasParseError())
+			{
+				EXE_LOG_CATEGORY_ERROR("PrefabDeserialization", "Failed to Parse JSON text: rapidjson error '{0}'", parsedDoc.GetParseError());
+				return {};
+			}
+
+			pJsonDoc = &parsedDoc;
 		}
+		const rapidjson::Document& jsonDoc = *pJsonDoc;
 
 		auto prefabMember = jsonDoc.FindMember("Prefab");
 
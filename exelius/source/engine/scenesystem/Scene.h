@@ -30,6 +30,10 @@ namespace Exelius
 		PhysicsSystem* m_pPhysicsSystem;
 		ScriptingSystem* m_pScriptingSystem;
 
+		// Scratch storage for SubmitSprites, kept to avoid reallocating every frame.
+		eastl::vector<entt::entity> m_spriteGameObjects;
+		eastl::vector<glm::mat4> m_spriteTransforms;
+
 		// TODO: Remove these, as they belong to Cameras
 		uint32_t m_viewportWidth;
 		uint32_t m_viewportHeight;
@@ -55,6 +59,10 @@ namespace Exelius
 		void OnUpdateEditor(EditorCamera& camera);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
+		/// <summary>
+		/// Gather every GameObject in the scene. The vector uses the frame
+		/// allocator, so it must not be kept past the end of the current frame.
+		/// </summary>
 		eastl::vector<GameObject> GetAllGameObjects();
 
 		template<typename... Components>
@@ -26,6 +26,7 @@
 #include "source/utility/random/noise/PerlinNoise.h"
 #include "source/utility/random/noise/SquirrelNoise.h"
 #include "source/utility/math/Math.h"
+#include "source/os/memory/MemoryManager.h"
 
 #include <box2d/box2d.h>
 #include <sol/sol.hpp>
@@ -55,6 +56,8 @@ namespace Exelius
 
 	void ScriptingSystem::InitializeRuntimeScripting(Scene* pOwningScene)
 	{
+		ScopedMemoryTag memoryTag(MemoryTag::kScripting);
+
 		EXE_ASSERT(pOwningScene);
 		m_pLuaState = EXELIUS_NEW(sol::state());
 		EXE_ASSERT(m_pLuaState);
@@ -64,6 +67,7 @@ namespace Exelius
 		SetGlobalTimeTable();
 		SetGlobalLogTable();
 		SetGlobalMathTable();
+		SetGlobalMemoryTable();
 		SetGlobalUtilities();
 		SetupLuaComponents();
 		SetupLuaGameObject(pOwningScene);
@@ -74,6 +78,9 @@ namespace Exelius
 
 	void ScriptingSystem::UpdateRuntimeScripting(Scene* pOwningScene)
 	{
+		EXE_PROFILE_FUNCTION();
+		ScopedMemoryTag memoryTag(MemoryTag::kScripting);
+
 		EXE_ASSERT(pOwningScene);
 		EXE_ASSERT(m_pLuaState);
 
@@ -459,6 +466,72 @@ namespace Exelius
 		mathTable[sol::metatable_key] = mathMetaTable;
 	}
 
+	static bool TryGetMemoryTag(const char* pTagName, MemoryTag& tag)
+	{
+		if (!pTagName)
+			return false;
+
+		for (uint8_t tagIndex = 0; tagIndex < static_cast<uint8_t>(MemoryTag::kCount); ++tagIndex)
+		{
+			if (strcmp(GetMemoryTagName(static_cast<MemoryTag>(tagIndex)), pTagName) == 0)
+			{
+				tag = static_cast<MemoryTag>(tagIndex);
+				return true;
+			}
+		}
+
+		EXE_LOG_CATEGORY_ERROR("Lua", "Unknown memory tag: '{}'.", pTagName);
+		return false;
+	}
+
+	void ScriptingSystem::SetGlobalMemoryTable()
+	{
+		sol::table memoryTable = m_pLuaState->create_named_table("Memory");
+		sol::table memoryMetaTable = m_pLuaState->create_table_with();
+
+		memoryMetaTable.set_function("IsTracking", []() { return MemoryManager::GetInstance()->GetMemoryStats()->IsTracking(); });
+
+		memoryMetaTable.set_function("GetTagNames", [](sol::this_state state)
+			{
+				sol::state_view luaState(state);
+				sol::table tagNames = luaState.create_table();
+				for (uint8_t tagIndex = 0; tagIndex < static_cast<uint8_t>(MemoryTag::kCount); ++tagIndex)
+					tagNames.add(GetMemoryTagName(static_cast<MemoryTag>(tagIndex)));
+				return tagNames;
+			});
+
+		memoryMetaTable.set_function("GetTagStats", [](const char* pTagName, sol::this_state state)
+			{
+				sol::state_view luaState(state);
+				MemoryTag tag;
+				if (!TryGetMemoryTag(pTagName, tag))
+					return sol::make_object(luaState, sol::nil);
+
+				const MemoryTagStats stats = MemoryManager::GetInstance()->GetMemoryStats()->GetTagStats(tag);
+				sol::table statsTable = luaState.create_table_with(
+					"LiveBytes", stats.m_liveBytes,
+					"PeakBytes", stats.m_peakBytes,
+					"LiveAllocations", stats.m_liveAllocations,
+					"TotalAllocations", stats.m_totalAllocations,
+					"AllocationsPerSecond", stats.m_allocationsPerSecond,
+					"BudgetBytes", stats.m_budgetBytes
+					);
+				return sol::make_object(luaState, statsTable);
+			});
+
+		memoryMetaTable.set_function("SetBudget", [](const char* pTagName, size_t budgetBytes)
+			{
+				MemoryTag tag;
+				if (TryGetMemoryTag(pTagName, tag))
+					MemoryManager::GetInstance()->GetMemoryStats()->SetBudget(tag, budgetBytes);
+			});
+
+		memoryMetaTable[sol::meta_function::new_index] = [](lua_State* pLuaState) {return luaL_error(pLuaState, "Modifying 'Memory' table is restricted."); };
+		memoryMetaTable[sol::meta_function::index] = memoryMetaTable;
+
+		memoryTable[sol::metatable_key] = memoryMetaTable;
+	}
+
 	void ScriptingSystem::SetGlobalUtilities()
 	{
 		m_pLuaState->new_usertype<GUID>("GUID");
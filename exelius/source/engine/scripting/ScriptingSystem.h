@@ -39,6 +39,8 @@ namespace Exelius
 
 		void SetGlobalMathTable();
 
+		void SetGlobalMemoryTable();
+
 		void SetGlobalUtilities();
 
 		void SetupLuaComponents();
@@ -2,9 +2,12 @@
 
 #include "source/engine/settings/ConfigFile.h"
 #include "source/debug/LogManager.h"
+#include "source/os/memory/MemoryManager.h"
 #include "source/utility/io/File.h"
 
+#include <rapidjson/filereadstream.h>
 #include <EASTL/vector.h>
+#include <cstdio>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
@@ -12,12 +15,44 @@
 namespace Exelius
 {
 	ConfigFile::ConfigFile()
-		: m_pFileName("engine_config.ini")
+		: m_pFileName(s_kFileName)
 		, m_isOpen(false)
 	{
 		//
 	}
 
+	bool ConfigFile::ReadGlobalAllocatorType(GlobalAllocatorType& globalAllocatorType)
+	{
+		FILE* pConfigFile = ::fopen(s_kFileName, "rb");
+		if (!pConfigFile)
+			return false;
+
+		// The document's own allocator is rapidjson's CrtAllocator, which calls malloc.
+		char readBuffer[4096];
+		rapidjson::FileReadStream readStream(pConfigFile, readBuffer, sizeof(readBuffer));
+		rapidjson::Document parsedData;
+		parsedData.ParseStream(readStream);
+		::fclose(pConfigFile);
+
+		if (parsedData.HasParseError() || !parsedData.IsObject())
+			return false;
+
+		auto memoryMember = parsedData.FindMember("Memory");
+		if (memoryMember == parsedData.MemberEnd() || !memoryMember->value.IsObject())
+			return false;
+
+		auto allocatorMember = memoryMember->value.FindMember("GlobalAllocator");
+		if (allocatorMember == memoryMember->value.MemberEnd() || !allocatorMember->value.IsUint())
+			return false;
+
+		const unsigned int allocatorType = allocatorMember->value.GetUint();
+		if (allocatorType >= static_cast<unsigned int>(GlobalAllocatorType::kMax))
+			return false;
+
+		globalAllocatorType = static_cast<GlobalAllocatorType>(allocatorType);
+		return true;
+	}
+
 	bool ConfigFile::OpenConfigFile()
 	{
 		EXE_ASSERT(m_pFileName);
@@ -56,7 +91,7 @@ namespace Exelius
 		return true;
 	}
 
-	bool ConfigFile::PopulateLogData(FileLogDefinition& fileLog, ConsoleLogDefinition& consoleLog, eastl::vector<LogData>& logData) const
+	bool ConfigFile::PopulateLogData(FileLogDefinition& fileLog, ConsoleLogDefinition& consoleLog, AsyncLogDefinition& asyncLog, eastl::vector<LogData>& logData) const
 	{
 		if (!m_isOpen)
 		{
@@ -75,6 +110,11 @@ namespace Exelius
 			EXE_LOG_WARN("Failed to populate the console log definition. Some defaults may have been used.");
 			populationResult = false;
 		}
+		if (!PopulateAsyncLogDefinition(asyncLog))
+		{
+			EXE_LOG_WARN("Failed to populate the async log definition. Some defaults may have been used.");
+			populationResult = false;
+		}
 		if (!PopulateLogs(logData, "EngineLogs"))
 		{
 			EXE_LOG_WARN("Failed to populate Engine logs correctly. Some defaults may have been used.");
@@ -117,6 +157,26 @@ namespace Exelius
 		return true;
 	}
 
+	bool ConfigFile::PopulateAllocationTracePath(eastl::string& allocationTracePath) const
+	{
+		// Recording is optional, so a missing path isn't worth a warning.
+		if (!m_isOpen || !m_parsedData.HasMember("Memory") || !m_parsedData["Memory"].IsObject())
+			return false;
+
+		auto allocationTraceMember = m_parsedData["Memory"].FindMember("AllocationTrace");
+		if (allocationTraceMember == m_parsedData["Memory"].MemberEnd())
+			return false;
+
+		if (!allocationTraceMember->value.IsString())
+		{
+			EXE_LOG_WARN("'AllocationTrace' member in 'Memory' is not a String. Allocations will not be recorded.");
+			return false;
+		}
+
+		allocationTracePath = allocationTraceMember->value.GetString();
+		return !allocationTracePath.empty();
+	}
+
 	//---------------------------------------------------------------------------------------------------------------
 	// Private
 	//---------------------------------------------------------------------------------------------------------------
@@ -273,6 +333,79 @@ namespace Exelius
 		return true;
 	}
 
+	bool ConfigFile::PopulateAsyncLogDefinition(AsyncLogDefinition& asyncLog) const
+	{
+		// Traverse tree to "Log".
+		if (!m_parsedData.HasMember("Log"))
+		{
+			EXE_LOG_WARN("'Log' member not found in config file. Defaulting Async Logging to: {}", asyncLog.m_isEnabled);
+			return false;
+		}
+		if (!m_parsedData["Log"].IsObject())
+		{
+			EXE_LOG_WARN("'Log' member in config file is not an Object. Defaulting Async Logging to: {}", asyncLog.m_isEnabled);
+			return false;
+		}
+
+		// Traverse tree to "Definitions".
+		if (!m_parsedData["Log"].HasMember("Definitions"))
+		{
+			EXE_LOG_WARN("'Definitions' member not found in 'Log'. Defaulting Async Logging to: {}", asyncLog.m_isEnabled);
+			return false;
+		}
+		auto definitionsMember = m_parsedData["Log"].FindMember("Definitions");
+		EXE_ASSERT(definitionsMember != m_parsedData["Log"].MemberEnd());
+		if (!definitionsMember->value.IsObject())
+		{
+			EXE_LOG_WARN("'Definitions' member in 'Log' is not an Object. Defaulting Async Logging to: {}", asyncLog.m_isEnabled);
+			return false;
+		}
+
+		// Traverse tree to "Async". It is optional, older config files log synchronously.
+		if (!definitionsMember->value.HasMember("Async"))
+			return true;
+
+		auto asyncMember = definitionsMember->value.FindMember("Async");
+		EXE_ASSERT(asyncMember != definitionsMember->value.MemberEnd());
+		if (!asyncMember->value.IsObject())
+		{
+			EXE_LOG_WARN("'Async' member in 'Definitions' is not an Object. Defaulting Async Logging to: {}", asyncLog.m_isEnabled);
+			return false;
+		}
+
+		bool successResult = true;
+		if (asyncMember->value.HasMember("Enabled") && asyncMember->value["Enabled"].IsBool())
+		{
+			asyncLog.m_isEnabled = asyncMember->value["Enabled"].GetBool();
+		}
+		else
+		{
+			EXE_LOG_WARN("'Enabled' member in 'Async' was not found or is not a boolean type. Defaulting Async Logging to: {}", asyncLog.m_isEnabled);
+			successResult = false;
+		}
+
+		if (asyncMember->value.HasMember("OverflowPolicy") && asyncMember->value["OverflowPolicy"].IsUint())
+		{
+			const unsigned int overflowPolicy = asyncMember->value["OverflowPolicy"].GetUint();
+			if (static_cast<LogOverflowPolicy>(overflowPolicy) < LogOverflowPolicy::kMax)
+			{
+				asyncLog.m_overflowPolicy = static_cast<LogOverflowPolicy>(overflowPolicy);
+			}
+			else
+			{
+				EXE_LOG_WARN("'OverflowPolicy' member in 'Async' is out of bounds. Defaulting Overflow Policy to: {}", static_cast<int>(asyncLog.m_overflowPolicy));
+				successResult = false;
+			}
+		}
+		else
+		{
+			EXE_LOG_WARN("'OverflowPolicy' member in 'Async' was not found or is not an unsigned integer type. Defaulting Overflow Policy to: {}", static_cast<int>(asyncLog.m_overflowPolicy));
+			successResult = false;
+		}
+
+		return successResult;
+	}
+
 	bool ConfigFile::PopulateLogs(eastl::vector<LogData>& logData, const char* pCategoryName) const
 	{
 		// Traverse tree to "Log".
@@ -13,10 +13,14 @@ namespace Exelius
 {
 	struct FileLogDefinition;
 	struct ConsoleLogDefinition;
+	struct AsyncLogDefinition;
 	struct LogData;
+	enum class GlobalAllocatorType : uint8_t;
 
 	class ConfigFile
 	{
+		static constexpr const char* s_kFileName = "engine_config.ini";
+
 		const char* m_pFileName;
 		rapidjson::Document m_parsedData;
 		bool m_isOpen;
@@ -24,17 +28,35 @@ namespace Exelius
 	public:
 		ConfigFile();
 
+		/// <summary>
+		/// Read the global allocator from the "Memory" section of the config file.
+		/// This runs before the MemoryManager or the logs exist, so it only uses malloc,
+		/// and doesn't report a missing or invalid setting.
+		/// </summary>
+		/// <param name="globalAllocatorType">- Receives the allocator, left untouched if the config file doesn't set a valid one.</param>
+		/// <returns>True if the config file set the allocator.</returns>
+		static bool ReadGlobalAllocatorType(GlobalAllocatorType& globalAllocatorType);
+
 		bool OpenConfigFile();
 
-		bool PopulateLogData(FileLogDefinition& fileLog, ConsoleLogDefinition& consoleLog, eastl::vector<LogData>& logData) const;
+		bool PopulateLogData(FileLogDefinition& fileLog, ConsoleLogDefinition& consoleLog, AsyncLogDefinition& asyncLog, eastl::vector<LogData>& logData) const;
 
 		bool PopulateWindowData(WindowProperties& windowProperties) const;
 
+		/// <summary>
+		/// The file the trace allocator should record allocations to, from the "Memory" section.
+		/// </summary>
+		/// <param name="allocationTracePath">- Receives the path, left untouched if the config file doesn't set one.</param>
+		/// <returns>True if the config file set a path.</returns>
+		bool PopulateAllocationTracePath(eastl::string& allocationTracePath) const;
+
 	private:
 		bool PopulateFileLogDefinition(FileLogDefinition& fileLog) const;
 
 		bool PopulateConsoleLogDefiniton(ConsoleLogDefinition& consoleLog) const;
 
+		bool PopulateAsyncLogDefinition(AsyncLogDefinition& asyncLog) const;
+
 		bool PopulateLogs(eastl::vector<LogData>& logData, const char* pCategoryName) const;
 
 		bool PopulateWindowTitle(eastl::string& windowTitle) const;
@@ -44,23 +44,28 @@ namespace Exelius
 	
 	void MessageServer::DispatchMessages()
 	{
-		Message* pMessage = nullptr;
-		while (m_messages.PopFront(pMessage))
+		// Messages pushed by the callbacks are dispatched in this call as well.
+		Message* messages[64];
+		size_t messageCount = 0;
+		while ((messageCount = m_messages.PopBatch(messages, 64)) > 0)
 		{
-			if (!pMessage)
-				continue;
+			for (size_t i = 0; i < messageCount; ++i)
+			{
+				Message* pMessage = messages[i];
+				if (!pMessage)
+					continue;
 
-			pMessage->ExecuteMessageCallback();
+				pMessage->ExecuteMessageCallback();
 
-			// TODO: Clone receivers here and protect with mutex, as recievers are added from multiple threads.
-			for (const auto& entry : m_receivers[pMessage->GetMessageID()])
-			{
-				if (entry)
-					entry->InvokeCallback(pMessage);
-			}
+				// TODO: Clone receivers here and protect with mutex, as recievers are added from multiple threads.
+				for (const auto& entry : m_receivers[pMessage->GetMessageID()])
+				{
+					if (entry)
+						entry->InvokeCallback(pMessage);
+				}
 
-			EXELIUS_DELETE(pMessage);
-			pMessage = nullptr;
+				EXELIUS_DELETE(pMessage);
+			}
 		}
 	}
 }
@@ -19,7 +19,7 @@ namespace Exelius
 	{
 		using ReceiverList = eastl::vector<SharedPtr<MessageReceiver>>;
 		eastl::unordered_map<MessageID, ReceiverList> m_receivers;
-		RingBufferMT<Message*, 4096> m_messages;
+		MPMCRingBuffer<Message*, 4096> m_messages;
 	public:
 		~MessageServer();
 
@@ -27,6 +27,8 @@ namespace Exelius
 	
 	bool NetworkingManager::Initialize(MessageFactory* pMessageFactory)
 	{
+		ScopedMemoryTag memoryTag(MemoryTag::kNetworking);
+
 		EXE_ASSERT(pMessageFactory);
 		m_pMessageFactory = pMessageFactory;
 
@@ -8,11 +8,21 @@ namespace Exelius
 {
 	EASTLAllocatorWrapper::EASTLAllocatorWrapper(const char* pName)
 		: m_pName(pName)
+		, m_pAllocator(nullptr)
+	{
+	}
+
+	EASTLAllocatorWrapper::EASTLAllocatorWrapper(ExeliusAllocator* pAllocator, const char* pName)
+		: m_pName(pName)
+		, m_pAllocator(pAllocator)
 	{
 	}
 
 	void* EASTLAllocatorWrapper::allocate(size_t n, int /* flags = 0 */)
 	{
+		if (m_pAllocator)
+			return m_pAllocator->Allocate(n, 16, m_pName, 0);
+
 		auto pMemManager = Exelius::MemoryManager::GetInstance();
 		EXE_ASSERT(pMemManager);
 		auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
@@ -22,6 +32,9 @@ namespace Exelius
 
 	void* EASTLAllocatorWrapper::allocate(size_t n, size_t alignment, size_t /* offset */, int /* flags = 0 */)
 	{
+		if (m_pAllocator)
+			return m_pAllocator->Allocate(n, alignment, m_pName, 0);
+
 		auto pMemManager = Exelius::MemoryManager::GetInstance();
 		EXE_ASSERT(pMemManager);
 		auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
@@ -34,9 +47,12 @@ namespace Exelius
 		if (!p)
 			return;
 
+		if (m_pAllocator)
+			return m_pAllocator->Free(p, n);
+
 		auto pMemManager = Exelius::MemoryManager::GetInstance();
 		if (!pMemManager)
-			return free(p); // Triggers on Application Delete.
+			return Exelius::MemoryManager::FreeAfterShutdown(p); // Triggers on Application Delete.
 
 		auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
 		if (!pGlobalAllocator)
@@ -44,4 +60,18 @@ namespace Exelius
 
 		pGlobalAllocator->Free(p, n);
 	}
+
+	EASTLAllocatorWrapper GetFrameEASTLAllocator(const char* pName)
+	{
+		auto pMemManager = Exelius::MemoryManager::GetInstance();
+		EXE_ASSERT(pMemManager);
+		return EASTLAllocatorWrapper(pMemManager->GetFrameAllocator(), pName);
+	}
+
+	EASTLAllocatorWrapper GetDoubleBufferedFrameEASTLAllocator(const char* pName)
+	{
+		auto pMemManager = Exelius::MemoryManager::GetInstance();
+		EXE_ASSERT(pMemManager);
+		return EASTLAllocatorWrapper(pMemManager->GetDoubleBufferedFrameAllocator(), pName);
+	}
 }
\ No newline at end of file
@@ -6,12 +6,21 @@
 /// </summary>
 namespace Exelius
 {
+	class ExeliusAllocator;
+
 	class EASTLAllocatorWrapper
 	{
 		const char* m_pName;
+
+		/// <summary>
+		/// The allocator to use, or nullptr for the global allocator.
+		/// </summary>
+		ExeliusAllocator* m_pAllocator;
 	public:
 		EASTLAllocatorWrapper(const char* pName = nullptr);
 
+		EASTLAllocatorWrapper(ExeliusAllocator* pAllocator, const char* pName = nullptr);
+
 		void* allocate(size_t n, int flags = 0);
 
 		void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
@@ -20,18 +29,33 @@ namespace Exelius
 
 		const char* get_name() const { return m_pName; }
 		void set_name(const char* pName) { m_pName = pName; }
+
+		ExeliusAllocator* GetAllocator() const { return m_pAllocator; }
 	};
 
-	inline bool operator==(const EASTLAllocatorWrapper&, const EASTLAllocatorWrapper&) noexcept
+	inline bool operator==(const EASTLAllocatorWrapper& left, const EASTLAllocatorWrapper& right) noexcept
 	{
-		return true;
+		return left.GetAllocator() == right.GetAllocator();
 	}
 
-	inline bool operator!=(const EASTLAllocatorWrapper&, const EASTLAllocatorWrapper&) noexcept
+	inline bool operator!=(const EASTLAllocatorWrapper& left, const EASTLAllocatorWrapper& right) noexcept
 	{
-		return false;
+		return !(left == right);
 	}
 
 	inline static EASTLAllocatorWrapper s_EASTLAllocatorWrapper;
 	inline static constexpr EASTLAllocatorWrapper* GetEASTLAllocatorWrapper() { return &s_EASTLAllocatorWrapper; }
+
+	/// <summary>
+	/// For temporary containers. The memory is only valid until the end of the current frame.
+	/// @code{.cpp}
+	/// eastl::vector<GameObject> gameObjects(Exelius::GetFrameEASTLAllocator("Visible GameObjects"));
+	/// @endcode
+	/// </summary>
+	EASTLAllocatorWrapper GetFrameEASTLAllocator(const char* pName = nullptr);
+
+	/// <summary>
+	/// For containers handed to the next frame. The memory is valid until the end of the next frame.
+	/// </summary>
+	EASTLAllocatorWrapper GetDoubleBufferedFrameEASTLAllocator(const char* pName = nullptr);
 }
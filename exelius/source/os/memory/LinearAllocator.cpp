@@ -0,0 +1,116 @@
+#include "EXEPCH.h"
+#include "LinearAllocator.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static uintptr_t AlignAddress(uintptr_t address, size_t alignment)
+	{
+		return (address + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+	}
+
+	LinearAllocator::LinearAllocator()
+		: m_pParentAllocator(nullptr)
+		, m_pBuffer(0)
+		, m_capacity(0)
+		, m_offset(0)
+		, m_pOverflowBlocks(nullptr)
+		, m_overflowBytes(0)
+		, m_highWaterMark(0)
+	{
+		//
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		Release();
+	}
+
+	bool LinearAllocator::Initialize(ExeliusAllocator* pParentAllocator, size_t capacity)
+	{
+		EXE_ASSERT(pParentAllocator);
+		EXE_ASSERT(m_pBuffer == 0);
+
+		m_pParentAllocator = pParentAllocator;
+		m_pBuffer = reinterpret_cast<uintptr_t>(m_pParentAllocator->Allocate(capacity, alignof(std::max_align_t), "LinearAllocator", __LINE__));
+		if (!m_pBuffer)
+			return false;
+
+		m_capacity = capacity;
+		m_offset.store(0, std::memory_order_relaxed);
+		return true;
+	}
+
+	void LinearAllocator::Release()
+	{
+		if (!m_pParentAllocator)
+			return;
+
+		Reset();
+
+		m_pParentAllocator->Free(reinterpret_cast<void*>(m_pBuffer));
+		m_pBuffer = 0;
+		m_capacity = 0;
+		m_pParentAllocator = nullptr;
+	}
+
+	void* LinearAllocator::Allocate(size_t sizeToAllocate, size_t memoryAlignment, const char* pFileName, int lineNum)
+	{
+		EXE_ASSERT(m_pBuffer);
+
+		if (memoryAlignment == 0)
+			memoryAlignment = alignof(std::max_align_t);
+		EXE_ASSERT((memoryAlignment & (memoryAlignment - 1)) == 0);
+
+		size_t offset = m_offset.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			const uintptr_t address = AlignAddress(m_pBuffer + offset, memoryAlignment);
+			const size_t end = (address - m_pBuffer) + sizeToAllocate;
+
+			if (end > m_capacity)
+				return AllocateOverflow(sizeToAllocate, memoryAlignment, pFileName, lineNum);
+
+			if (m_offset.compare_exchange_weak(offset, end, std::memory_order_relaxed))
+				return reinterpret_cast<void*>(address);
+		}
+	}
+
+	void LinearAllocator::Reset()
+	{
+		const size_t usedBytes = m_offset.exchange(0, std::memory_order_relaxed);
+		if (usedBytes > m_highWaterMark)
+			m_highWaterMark = usedBytes;
+
+		std::lock_guard<std::mutex> lock(m_overflowLock);
+		while (m_pOverflowBlocks)
+		{
+			OverflowBlock* pBlock = m_pOverflowBlocks;
+			m_pOverflowBlocks = pBlock->m_pNext;
+			m_pParentAllocator->Free(pBlock);
+		}
+		m_overflowBytes = 0;
+	}
+
+	void* LinearAllocator::AllocateOverflow(size_t sizeToAllocate, size_t memoryAlignment, const char* pFileName, int lineNum)
+	{
+		// Leave room for the list link and enough slack to align the returned memory.
+		const size_t blockSize = sizeof(OverflowBlock) + memoryAlignment + sizeToAllocate;
+		void* pMemory = m_pParentAllocator->Allocate(blockSize, alignof(OverflowBlock), pFileName, lineNum);
+		if (!pMemory)
+			return nullptr;
+
+		OverflowBlock* pBlock = static_cast<OverflowBlock*>(pMemory);
+
+		{
+			std::lock_guard<std::mutex> lock(m_overflowLock);
+			pBlock->m_pNext = m_pOverflowBlocks;
+			m_pOverflowBlocks = pBlock;
+			m_overflowBytes += blockSize;
+		}
+
+		return reinterpret_cast<void*>(AlignAddress(reinterpret_cast<uintptr_t>(pBlock + 1), memoryAlignment));
+	}
+}
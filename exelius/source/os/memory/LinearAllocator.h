@@ -0,0 +1,93 @@
+#pragma once
+#include "source/os/memory/ExeliusAllocator.h"
+
+#include <atomic>
+#include <mutex>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Bump allocator over a single fixed-size buffer.
+	///
+	/// Allocating is a single atomic add on an offset, so it may be called from
+	/// any thread. Free() does nothing; all memory is reclaimed at once by Reset().
+	/// Allocations that don't fit in the buffer fall back to the parent allocator
+	/// and are also released by Reset(), so running out of space is slow but safe.
+	/// </summary>
+	class LinearAllocator
+		: public ExeliusAllocator
+	{
+		/// <summary>
+		/// Prepended to every allocation that overflowed the buffer.
+		/// </summary>
+		struct OverflowBlock
+		{
+			OverflowBlock* m_pNext;
+		};
+
+		ExeliusAllocator* m_pParentAllocator;
+
+		uintptr_t m_pBuffer;
+		size_t m_capacity;
+		std::atomic<size_t> m_offset;
+
+		OverflowBlock* m_pOverflowBlocks;
+		size_t m_overflowBytes;
+		std::mutex m_overflowLock;
+
+		/// <summary>
+		/// The most bytes used by the buffer between two resets.
+		/// </summary>
+		size_t m_highWaterMark;
+
+	public:
+		LinearAllocator();
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator(LinearAllocator&&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(LinearAllocator&&) = delete;
+		virtual ~LinearAllocator();
+
+		/// <summary>
+		/// Request the buffer from the parent allocator.
+		/// </summary>
+		/// <param name="pParentAllocator">- Allocator for the buffer and for any overflow.</param>
+		/// <param name="capacity">- Size of the buffer in bytes.</param>
+		/// <returns>True on success.</returns>
+		bool Initialize(ExeliusAllocator* pParentAllocator, size_t capacity);
+
+		/// <summary>
+		/// Return the buffer, and any overflow, to the parent allocator.
+		/// </summary>
+		void Release();
+
+		virtual void* Allocate(size_t sizeToAllocate, size_t memoryAlignment = 16, const char* pFileName = nullptr, int lineNum = -1) final override;
+
+		/// <summary>
+		/// Does nothing, memory is reclaimed by Reset().
+		/// </summary>
+		virtual void Free(void*, size_t, bool) final override {}
+
+		/// <summary>
+		/// Invalidate every allocation made since the last reset.
+		/// Must not be called while other threads may be allocating.
+		/// </summary>
+		void Reset();
+
+		size_t GetCapacity() const { return m_capacity; }
+		size_t GetUsedBytes() const { return m_offset.load(std::memory_order_relaxed); }
+		size_t GetHighWaterMark() const { return m_highWaterMark; }
+
+		/// <summary>
+		/// Bytes that didn't fit in the buffer since the last reset.
+		/// Anything but zero means the buffer should be larger.
+		/// </summary>
+		size_t GetOverflowBytes() const { return m_overflowBytes; }
+
+	private:
+		void* AllocateOverflow(size_t sizeToAllocate, size_t memoryAlignment, const char* pFileName, int lineNum);
+	};
+}
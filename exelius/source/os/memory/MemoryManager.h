@@ -2,32 +2,138 @@
 #include "source/utility/generic/Singleton.h"
 #include "source/os/memory/SystemAllocator.h"
 #include "source/os/memory/TraceAllocator.h"
+#include "source/os/memory/LinearAllocator.h"
+#include "source/os/memory/SizeClassAllocator.h"
+#include "source/os/memory/MemoryStats.h"
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	/// <summary>
+	/// The allocators the MemoryManager can use as the global allocator.
+	/// </summary>
+	enum class GlobalAllocatorType : uint8_t
+	{
+		kSystem,	// malloc/free.
+		kTrace,		// malloc/free, tracking every allocation to report leaks.
+		kSizeClass,	// Size classes with per-thread caches. Scales with many threads allocating at once.
+		kMax
+	};
+
 	class MemoryManager
 		: public Singleton<MemoryManager>
 	{
-		SystemAllocator m_systemAllocator;	// Root allocator, calls malloc/free.
-		TraceAllocator m_traceAllocator;	// Optional Debug Wrapper for root allocator.
+		static constexpr size_t s_kDefaultFrameAllocatorSize = 1024 * 1024;
+
+		/// <summary>
+		/// False once a global allocator that doesn't hand out malloc'd memory has been used.
+		/// Outlives the MemoryManager, as memory may still be freed after it is destroyed.
+		/// </summary>
+		inline static bool s_isGlobalMemoryFromMalloc = true;
+
+		SystemAllocator m_systemAllocator;			// Root allocator, calls malloc/free.
+		TraceAllocator m_traceAllocator;			// Optional Debug Wrapper for root allocator.
+		SizeClassAllocator m_sizeClassAllocator;	// Optional scalable allocator, spans come from the system.
 
 		ExeliusAllocator* m_pGlobalAllocator;
+
+		// Transient allocations. The buffers come straight from the system
+		// allocator, so they don't show up as leaks in the trace allocator.
+		LinearAllocator m_frameAllocator;					// Reset every frame.
+		LinearAllocator m_doubleBufferedFrameAllocators[2];	// Each reset every other frame.
+		uint32_t m_doubleBufferedFrameIndex;
+
+		MemoryStats m_stats;	// Per tag usage, fed by the trace or size class allocator.
+
 	public:
+		MemoryManager()
+			: m_pGlobalAllocator(nullptr)
+			, m_doubleBufferedFrameIndex(0)
+		{
+			//
+		}
+
 		virtual ~MemoryManager() { m_pGlobalAllocator = nullptr; }
 
-		void Initialize(bool useTraceAllocator)
+		void Initialize(GlobalAllocatorType globalAllocatorType, size_t frameAllocatorSize = s_kDefaultFrameAllocatorSize)
 		{
 			m_traceAllocator.SetParentAllocator(&m_systemAllocator);
 
-			if (useTraceAllocator)
+			switch (globalAllocatorType)
+			{
+			case GlobalAllocatorType::kTrace:
+				m_traceAllocator.SetMemoryStats(&m_stats);
+				m_stats.SetTracking(true);
+				m_traceAllocator.Reserve();
 				m_pGlobalAllocator = &m_traceAllocator;
-			else
+				break;
+			case GlobalAllocatorType::kSizeClass:
+				m_sizeClassAllocator.SetMemoryStats(&m_stats);
+				m_stats.SetTracking(true);
+				m_pGlobalAllocator = &m_sizeClassAllocator;
+				s_isGlobalMemoryFromMalloc = false;
+				break;
+			default:
 				m_pGlobalAllocator = &m_systemAllocator;
+				break;
+			}
+
+			m_frameAllocator.Initialize(&m_systemAllocator, frameAllocatorSize);
+			m_doubleBufferedFrameAllocators[0].Initialize(&m_systemAllocator, frameAllocatorSize);
+			m_doubleBufferedFrameAllocators[1].Initialize(&m_systemAllocator, frameAllocatorSize);
+		}
+
+		/// <summary>
+		/// Reclaim the frame allocators. Called by the Application at the top
+		/// of each frame, while no other thread may be allocating from them.
+		/// </summary>
+		void BeginFrame()
+		{
+			m_frameAllocator.Reset();
+
+			// The other buffer still holds last frame's allocations.
+			m_doubleBufferedFrameIndex ^= 1;
+			m_doubleBufferedFrameAllocators[m_doubleBufferedFrameIndex].Reset();
 		}
 
 		ExeliusAllocator* GetGlobalAllocator() { return m_pGlobalAllocator; }
+
+		/// <summary>
+		/// The trace allocator, for configuring call stack sampling.
+		/// Only tracks allocations if it is the global allocator.
+		/// </summary>
+		TraceAllocator* GetTraceAllocator() { return &m_traceAllocator; }
+
+		/// <summary>
+		/// Live usage and budgets per MemoryTag.
+		/// Only tracking when the trace or size class allocator is the global allocator.
+		/// </summary>
+		MemoryStats* GetMemoryStats() { return &m_stats; }
+
+		/// <summary>
+		/// Free memory from the global allocator once the MemoryManager is gone.
+		/// Only malloc'd memory can still be freed, anything else was released
+		/// along with its allocator.
+		/// </summary>
+		static void FreeAfterShutdown(void* pMemoryToFree)
+		{
+			if (s_isGlobalMemoryFromMalloc)
+				free(pMemoryToFree);
+		}
+
+		/// <summary>
+		/// Allocations from this are only valid until the end of the current frame.
+		/// Freeing them is optional and does nothing.
+		/// </summary>
+		LinearAllocator* GetFrameAllocator() { return &m_frameAllocator; }
+
+		/// <summary>
+		/// Allocations from this are valid until the end of the next frame,
+		/// for data handed from one frame to the next.
+		/// Freeing them is optional and does nothing.
+		/// </summary>
+		LinearAllocator* GetDoubleBufferedFrameAllocator() { return &m_doubleBufferedFrameAllocators[m_doubleBufferedFrameIndex]; }
 	};
-}
\ No newline at end of file
+}
@@ -63,7 +63,7 @@ void operator delete(void* pMemoryToFree)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -79,7 +79,7 @@ void operator delete[](void* pMemoryToFree)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -95,7 +95,7 @@ void operator delete(void* pMemoryToFree, const char*, int)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -111,7 +111,7 @@ void operator delete[](void* pMemoryToFree, const char*, int)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -127,7 +127,7 @@ void operator delete(void* pMemoryToFree, std::align_val_t, const char*, int)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -143,7 +143,7 @@ void operator delete[](void* pMemoryToFree, std::align_val_t, const char*, int)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -159,7 +159,7 @@ void operator delete(void* pMemoryToFree, size_t, const char*, int)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -175,7 +175,7 @@ void operator delete[](void* pMemoryToFree, size_t, const char*, int)
 
     auto pMemManager = Exelius::MemoryManager::GetInstance();
     if (!pMemManager)
-        return free(pMemoryToFree); // Triggers on Application Delete.
+        return Exelius::MemoryManager::FreeAfterShutdown(pMemoryToFree); // Triggers on Application Delete.
 
     auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
     if (!pGlobalAllocator)
@@ -1,4 +1,6 @@
 #pragma once
+#include "source/os/memory/MemoryTag.h"
+
 #include <new>
 
 /// <summary>
@@ -139,4 +141,9 @@ void operator delete[](void* pMemoryToFree, size_t memoryAlignment, const char*
 	#define EXELIUS_NEW_ARRAY(object, size) new object[size]
 	#define EXELIUS_DELETE(objectPointer) delete objectPointer; objectPointer = nullptr
 	#define EXELIUS_DELETE_ARRAY(objectPointer) delete[] objectPointer; objectPointer = nullptr
-#endif // EXE_DEBUG
\ No newline at end of file
+#endif // EXE_DEBUG
+
+// Tags the allocation, and any made by the constructor, with a MemoryTag.
+// The ScopedMemoryTag temporary lives until the end of the full expression.
+#define EXELIUS_NEW_TAGGED(tag, object) (::Exelius::ScopedMemoryTag(tag), EXELIUS_NEW(object))
+#define EXELIUS_NEW_ARRAY_TAGGED(tag, object, size) (::Exelius::ScopedMemoryTag(tag), EXELIUS_NEW_ARRAY(object, size))
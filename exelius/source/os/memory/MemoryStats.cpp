@@ -0,0 +1,94 @@
+#include "EXEPCH.h"
+#include "MemoryStats.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	MemoryStats::MemoryStats()
+		: m_isTracking(false)
+	{
+		//
+	}
+
+	void MemoryStats::RecordAllocation(MemoryTag tag, size_t sizeInBytes)
+	{
+		EXE_ASSERT(tag < MemoryTag::kCount);
+		TagCounters& counters = m_tagCounters[static_cast<size_t>(tag)];
+
+		const size_t liveBytes = counters.m_liveBytes.fetch_add(sizeInBytes, std::memory_order_relaxed) + sizeInBytes;
+		counters.m_liveAllocations.fetch_add(1, std::memory_order_relaxed);
+		counters.m_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+		size_t peakBytes = counters.m_peakBytes.load(std::memory_order_relaxed);
+		while (liveBytes > peakBytes && !counters.m_peakBytes.compare_exchange_weak(peakBytes, liveBytes, std::memory_order_relaxed))
+		{
+			//
+		}
+
+		// Assert here, so the offending allocation is on the call stack.
+		const size_t budgetBytes = counters.m_budgetBytes.load(std::memory_order_relaxed);
+		if (budgetBytes > 0 && liveBytes > budgetBytes && counters.m_budgetAction.load(std::memory_order_relaxed) == MemoryBudgetAction::kAssert)
+			EXE_ASSERT(false); // This allocation exceeded the memory budget of its tag.
+	}
+
+	void MemoryStats::RecordFree(MemoryTag tag, size_t sizeInBytes)
+	{
+		EXE_ASSERT(tag < MemoryTag::kCount);
+		TagCounters& counters = m_tagCounters[static_cast<size_t>(tag)];
+
+		counters.m_liveBytes.fetch_sub(sizeInBytes, std::memory_order_relaxed);
+		counters.m_liveAllocations.fetch_sub(1, std::memory_order_relaxed);
+	}
+
+	void MemoryStats::SetBudget(MemoryTag tag, size_t budgetBytes, MemoryBudgetAction action)
+	{
+		EXE_ASSERT(tag < MemoryTag::kCount);
+		TagCounters& counters = m_tagCounters[static_cast<size_t>(tag)];
+
+		counters.m_budgetAction.store(action, std::memory_order_relaxed);
+		counters.m_budgetBytes.store(budgetBytes, std::memory_order_relaxed);
+	}
+
+	MemoryTagStats MemoryStats::GetTagStats(MemoryTag tag) const
+	{
+		EXE_ASSERT(tag < MemoryTag::kCount);
+		const TagCounters& counters = m_tagCounters[static_cast<size_t>(tag)];
+
+		MemoryTagStats stats;
+		stats.m_liveBytes = counters.m_liveBytes.load(std::memory_order_relaxed);
+		stats.m_peakBytes = counters.m_peakBytes.load(std::memory_order_relaxed);
+		stats.m_liveAllocations = counters.m_liveAllocations.load(std::memory_order_relaxed);
+		stats.m_totalAllocations = counters.m_totalAllocations.load(std::memory_order_relaxed);
+		stats.m_allocationsPerSecond = counters.m_allocationsPerSecond.load(std::memory_order_relaxed);
+		stats.m_budgetBytes = counters.m_budgetBytes.load(std::memory_order_relaxed);
+		return stats;
+	}
+
+	void MemoryStats::Update(float deltaSeconds)
+	{
+		if (!m_isTracking)
+			return;
+
+		for (size_t tag = 0; tag < static_cast<size_t>(MemoryTag::kCount); ++tag)
+		{
+			TagCounters& counters = m_tagCounters[tag];
+
+			const uint64_t totalAllocations = counters.m_totalAllocations.load(std::memory_order_relaxed);
+			if (deltaSeconds > 0.0f)
+				counters.m_allocationsPerSecond.store(static_cast<float>(totalAllocations - counters.m_totalAllocationsAtLastUpdate) / deltaSeconds, std::memory_order_relaxed);
+			counters.m_totalAllocationsAtLastUpdate = totalAllocations;
+
+			const size_t budgetBytes = counters.m_budgetBytes.load(std::memory_order_relaxed);
+			const size_t liveBytes = counters.m_liveBytes.load(std::memory_order_relaxed);
+			const bool isOverBudget = budgetBytes > 0 && liveBytes > budgetBytes;
+
+			// Only warn when crossing the budget, not every frame spent over it.
+			if (isOverBudget && !counters.m_wasOverBudget)
+				EXE_LOG_CATEGORY_WARN("Memory", "{} memory is over budget: {} of {} bytes.", GetMemoryTagName(static_cast<MemoryTag>(tag)), liveBytes, budgetBytes);
+
+			counters.m_wasOverBudget = isOverBudget;
+		}
+	}
+}
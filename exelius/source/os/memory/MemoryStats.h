@@ -0,0 +1,103 @@
+#pragma once
+#include "source/os/memory/MemoryTag.h"
+
+#include <atomic>
+#include <cstddef>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// What happens when a tag's live bytes exceed its budget.
+	/// </summary>
+	enum class MemoryBudgetAction : uint8_t
+	{
+		kWarn,		// Logged once each time the budget is crossed, at the start of the next frame.
+		kAssert		// Asserts inside the allocation that crossed the budget.
+	};
+
+	/// <summary>
+	/// A snapshot of one tag's usage.
+	/// </summary>
+	struct MemoryTagStats
+	{
+		size_t m_liveBytes;
+		size_t m_peakBytes;
+		size_t m_liveAllocations;
+		uint64_t m_totalAllocations;
+		float m_allocationsPerSecond;	// Measured over the last frame.
+		size_t m_budgetBytes;			// 0 if there is no budget.
+	};
+
+	/// <summary>
+	/// Live memory usage and budgets per MemoryTag.
+	///
+	/// Counters are updated by the trace and size class allocators, which both
+	/// know the size and tag of every allocation they free. The size class
+	/// allocator counts small allocations in whole blocks. No stats are
+	/// gathered while the system allocator is the global allocator.
+	/// </summary>
+	class MemoryStats
+	{
+		struct TagCounters
+		{
+			std::atomic<size_t> m_liveBytes = 0;
+			std::atomic<size_t> m_peakBytes = 0;
+			std::atomic<size_t> m_liveAllocations = 0;
+			std::atomic<uint64_t> m_totalAllocations = 0;
+
+			// Written by Update(), read by anyone.
+			std::atomic<float> m_allocationsPerSecond = 0.0f;
+
+			// Only touched by Update().
+			uint64_t m_totalAllocationsAtLastUpdate = 0;
+			bool m_wasOverBudget = false;
+
+			std::atomic<size_t> m_budgetBytes = 0;
+			std::atomic<MemoryBudgetAction> m_budgetAction = MemoryBudgetAction::kWarn;
+		};
+
+		TagCounters m_tagCounters[static_cast<size_t>(MemoryTag::kCount)];
+
+		bool m_isTracking;
+
+	public:
+		MemoryStats();
+		MemoryStats(const MemoryStats&) = delete;
+		MemoryStats(MemoryStats&&) = delete;
+		MemoryStats& operator=(const MemoryStats&) = delete;
+		MemoryStats& operator=(MemoryStats&&) = delete;
+
+		/// <summary>
+		/// Called by the allocator feeding these stats. May be called from any thread.
+		/// </summary>
+		void RecordAllocation(MemoryTag tag, size_t sizeInBytes);
+		void RecordFree(MemoryTag tag, size_t sizeInBytes);
+
+		/// <summary>
+		/// Set the most live bytes a tag should use.
+		/// </summary>
+		/// <param name="tag">- The tag to budget.</param>
+		/// <param name="budgetBytes">- The budget in bytes, 0 to remove it.</param>
+		/// <param name="action">- What happens when the budget is exceeded.</param>
+		void SetBudget(MemoryTag tag, size_t budgetBytes, MemoryBudgetAction action = MemoryBudgetAction::kWarn);
+
+		MemoryTagStats GetTagStats(MemoryTag tag) const;
+
+		/// <summary>
+		/// Measure allocation rates and warn about exceeded budgets.
+		/// Called by the Application once per frame. May run on any thread,
+		/// but never on two at once.
+		/// </summary>
+		/// <param name="deltaSeconds">- Time since the last update.</param>
+		void Update(float deltaSeconds);
+
+		/// <summary>
+		/// True if an allocator is feeding these stats.
+		/// </summary>
+		bool IsTracking() const { return m_isTracking; }
+		void SetTracking(bool isTracking) { m_isTracking = isTracking; }
+	};
+}
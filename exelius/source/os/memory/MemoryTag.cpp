@@ -0,0 +1,45 @@
+#include "EXEPCH.h"
+#include "MemoryTag.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static thread_local MemoryTag s_currentMemoryTag = MemoryTag::kUntagged;
+
+	const char* GetMemoryTagName(MemoryTag tag)
+	{
+		switch (tag)
+		{
+		case MemoryTag::kUntagged: return "Untagged";
+		case MemoryTag::kCore: return "Core";
+		case MemoryTag::kRendering: return "Rendering";
+		case MemoryTag::kResources: return "Resources";
+		case MemoryTag::kScripting: return "Scripting";
+		case MemoryTag::kPhysics: return "Physics";
+		case MemoryTag::kAudio: return "Audio";
+		case MemoryTag::kNetworking: return "Networking";
+		case MemoryTag::kScene: return "Scene";
+		case MemoryTag::kEditor: return "Editor";
+		default: return "Invalid";
+		}
+	}
+
+	MemoryTag GetCurrentMemoryTag()
+	{
+		return s_currentMemoryTag;
+	}
+
+	ScopedMemoryTag::ScopedMemoryTag(MemoryTag tag)
+		: m_previousTag(s_currentMemoryTag)
+	{
+		EXE_ASSERT(tag < MemoryTag::kCount);
+		s_currentMemoryTag = tag;
+	}
+
+	ScopedMemoryTag::~ScopedMemoryTag()
+	{
+		s_currentMemoryTag = m_previousTag;
+	}
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// The subsystem an allocation was made on behalf of.
+	/// Set for the calling thread with ScopedMemoryTag.
+	/// </summary>
+	enum class MemoryTag : uint8_t
+	{
+		kUntagged,
+		kCore,
+		kRendering,
+		kResources,
+		kScripting,
+		kPhysics,
+		kAudio,
+		kNetworking,
+		kScene,
+		kEditor,
+		kCount
+	};
+
+	/// <summary>
+	/// Readable name of a tag, for reports.
+	/// </summary>
+	const char* GetMemoryTagName(MemoryTag tag);
+
+	/// <summary>
+	/// The tag applied to allocations made by the calling thread.
+	/// </summary>
+	MemoryTag GetCurrentMemoryTag();
+
+	/// <summary>
+	/// Tags every allocation made by the calling thread while in scope.
+	/// Scopes may nest, the innermost wins.
+	///
+	/// @code{.cpp}
+	/// {
+	///		Exelius::ScopedMemoryTag tag(Exelius::MemoryTag::kScripting);
+	///		m_pLuaState = EXELIUS_NEW(sol::state());
+	/// }
+	/// @endcode
+	/// </summary>
+	class ScopedMemoryTag
+	{
+		MemoryTag m_previousTag;
+
+	public:
+		explicit ScopedMemoryTag(MemoryTag tag);
+		ScopedMemoryTag(const ScopedMemoryTag&) = delete;
+		ScopedMemoryTag(ScopedMemoryTag&&) = delete;
+		ScopedMemoryTag& operator=(const ScopedMemoryTag&) = delete;
+		ScopedMemoryTag& operator=(ScopedMemoryTag&&) = delete;
+		~ScopedMemoryTag();
+	};
+}
@@ -2,97 +2,272 @@
 #include "source/os/memory/ExeliusAllocator.h"
 #include "source/os/memory/MemoryManager.h"
 
+#include <EASTL/algorithm.h>
 #include <EASTL/vector.h>
-#include <EASTL/stack.h>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
 #include <new>
 
+// Fill freed blocks with a known pattern so use-after-free is easy to spot.
+// On by default in Debug builds, define EXE_POOL_DEBUG_FILL to 0 or 1 to override.
+#ifndef EXE_POOL_DEBUG_FILL
+	#ifdef EXE_DEBUG
+		#define EXE_POOL_DEBUG_FILL 1
+	#else
+		#define EXE_POOL_DEBUG_FILL 0
+	#endif // EXE_DEBUG
+#endif // EXE_POOL_DEBUG_FILL
+
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	/// <summary>
+	/// A snapshot of a PoolAllocator's usage.
+	/// </summary>
+	struct PoolAllocatorStats
+	{
+		size_t m_liveBlocks;		// Blocks currently allocated.
+		size_t m_highWaterMark;		// The most blocks that have been allocated at once.
+		size_t m_chunkCount;		// Chunks requested from the global allocator.
+		size_t m_blockSize;			// Size of each block, including padding.
+		size_t m_blocksPerChunk;
+	};
+
+	/// <summary>
+	/// Thread-safe allocator for blocks of a single size.
+	///
+	/// Freed blocks are kept on an intrusive, lock-free free list: the link to
+	/// the next free block is stored in the first bytes of the block itself,
+	/// so neither allocating nor freeing ever touches another allocator, and
+	/// both are O(1). The list head packs a tag into the unused upper bits of
+	/// the block address, which protects it against ABA.
+	///
+	/// The global allocator is only used, under a lock, when the free list is
+	/// empty. Chunks are never returned until the pool is destroyed.
+	/// </summary>
 	template <size_t TypeSize, size_t ChunkSize>
 	class PoolAllocator
 		: public ExeliusAllocator
 	{
 		/// <summary>
-		/// Vector of memory pages.
+		/// Blocks are padded so every block is suitably aligned for any type.
+		/// </summary>
+		static constexpr size_t s_kBlockAlignment = alignof(std::max_align_t);
+		static constexpr size_t s_kBlockSize = ((eastl::max(TypeSize, sizeof(uintptr_t)) + s_kBlockAlignment - 1) / s_kBlockAlignment) * s_kBlockAlignment;
+		static constexpr size_t s_kBlocksPerChunk = ChunkSize / s_kBlockSize;
+
+		static_assert(s_kBlocksPerChunk > 0, "ChunkSize must fit at least one block.");
+		static_assert(sizeof(uintptr_t) == sizeof(uint64_t), "The tagged free list head requires 64 bit addresses.");
+
+		/// <summary>
+		/// User space addresses fit in the low 48 bits on every supported platform,
+		/// the upper 16 bits of the head hold the tag.
 		/// </summary>
-		eastl::vector<uintptr_t> m_pooledMemory;
+		static constexpr uint64_t s_kAddressBits = 48;
+		static constexpr uint64_t s_kAddressMask = (uint64_t(1) << s_kAddressBits) - 1;
 
-		eastl::stack<void*> m_freeMemory;
+		/// <summary>
+		/// The address of the first free block, tagged with a counter that is
+		/// bumped on every change, so a stale head can never be swapped back in.
+		/// </summary>
+		std::atomic<uint64_t> m_freeListHead;
+
+		/// <summary>
+		/// Every chunk this pool has allocated, released on destruction.
+		/// </summary>
+		eastl::vector<void*> m_chunks;
+		std::mutex m_chunkLock;
 
-		// Internal block pointers.
-		uintptr_t m_pAllocationFront;
-		uintptr_t m_pAllocationCurrent;
-		uintptr_t m_pAllocationEnd;
+		std::atomic<size_t> m_chunkCount;
+		std::atomic<size_t> m_liveBlocks;
+		std::atomic<size_t> m_highWaterMark;
 
 	public:
 		PoolAllocator()
-			: m_pAllocationFront(0)
-			, m_pAllocationCurrent(0)
-			, m_pAllocationEnd(0)
+			: m_freeListHead(0)
+			, m_chunkCount(0)
+			, m_liveBlocks(0)
+			, m_highWaterMark(0)
 		{
+			std::lock_guard<std::mutex> lock(m_chunkLock);
 			AllocateNewChunk("PoolAllocatorConstructor", 0);
 		}
 
+		PoolAllocator(const PoolAllocator&) = delete;
+		PoolAllocator(PoolAllocator&&) = delete;
+		PoolAllocator& operator=(const PoolAllocator&) = delete;
+		PoolAllocator& operator=(PoolAllocator&&) = delete;
+
 		~PoolAllocator()
 		{
-			m_pAllocationFront = 0;
-			m_pAllocationCurrent = 0;
-			m_pAllocationEnd = 0;
+			m_freeListHead.store(0, std::memory_order_relaxed);
 
 			auto pMemManager = Exelius::MemoryManager::GetInstance();
 			EXE_ASSERT(pMemManager);
 			auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
 			EXE_ASSERT(pGlobalAllocator);
 
-			for (auto pool : m_pooledMemory)
+			for (void* pChunk : m_chunks)
 			{
-				pGlobalAllocator->Free(reinterpret_cast<void*>(pool));
-				pool = 0;
+				pGlobalAllocator->Free(pChunk);
 			}
+			m_chunks.clear();
 		}
 
-		virtual void* Allocate(size_t sizeToAllocate, size_t , const char* pFileName, int lineNum) final override
+		/// <summary>
+		/// Retrieve a block. May be called from any thread.
+		/// </summary>
+		virtual void* Allocate([[maybe_unused]] size_t sizeToAllocate, size_t, const char* pFileName, int lineNum) final override
 		{
-			if (!m_freeMemory.empty())
+			EXE_ASSERT(sizeToAllocate <= TypeSize);
+
+			void* pBlock = PopFreeBlock();
+			if (!pBlock)
 			{
-				void* pMem = m_freeMemory.top();
-				m_freeMemory.pop();
-				return pMem;
+				std::lock_guard<std::mutex> lock(m_chunkLock);
+
+				// Another thread may have added a chunk while this one waited for the lock,
+				// and other threads may drain a new chunk before this one gets a block.
+				while ((pBlock = PopFreeBlock()) == nullptr)
+				{
+					if (!AllocateNewChunk(pFileName, lineNum))
+						return nullptr;
+				}
 			}
 
-			if ((int)sizeToAllocate > m_pAllocationEnd - m_pAllocationCurrent)
+			TrackAllocation();
+			return pBlock;
+		}
+
+		/// <summary>
+		/// Return a block to the pool. May be called from any thread.
+		/// </summary>
+		virtual void Free(void* pMemoryToFree, size_t, bool) final override
+		{
+			if (!pMemoryToFree)
+				return;
+
+			const uintptr_t block = reinterpret_cast<uintptr_t>(pMemoryToFree);
+
+#if EXE_POOL_DEBUG_FILL
+			// Fill the block before it is published, once it is on the free list another
+			// thread may pop it. The link is skipped, a thread holding a stale head may
+			// still be reading it, and PushFreeBlocks writes it atomically.
+			memset(reinterpret_cast<std::byte*>(block) + sizeof(uintptr_t), 0xCD, s_kBlockSize - sizeof(uintptr_t));
+#endif // EXE_POOL_DEBUG_FILL
+
+			PushFreeBlocks(block, block);
+
+			m_liveBlocks.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Retrieve a snapshot of the pool's usage. Values are read
+		/// independently, so may be slightly out of step with each other.
+		/// </summary>
+		PoolAllocatorStats GetStats() const
+		{
+			PoolAllocatorStats stats;
+			stats.m_liveBlocks = m_liveBlocks.load(std::memory_order_relaxed);
+			stats.m_highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+			stats.m_chunkCount = m_chunkCount.load(std::memory_order_relaxed);
+			stats.m_blockSize = s_kBlockSize;
+			stats.m_blocksPerChunk = s_kBlocksPerChunk;
+			return stats;
+		}
+
+	private:
+		/// <summary>
+		/// The link to the next free block, stored in the block itself.
+		/// Another thread may read it while racing to pop the same block,
+		/// in which case the tag makes its exchange fail, so access it atomically.
+		/// </summary>
+		static std::atomic_ref<uintptr_t> GetNextLink(uintptr_t block)
+		{
+			return std::atomic_ref<uintptr_t>(*reinterpret_cast<uintptr_t*>(block));
+		}
+
+		static uint64_t MakeHead(uintptr_t block, uint64_t previousHead)
+		{
+			EXE_ASSERT((block & ~s_kAddressMask) == 0);
+			const uint64_t tag = (previousHead >> s_kAddressBits) + 1;
+			return (tag << s_kAddressBits) | block;
+		}
+
+		void* PopFreeBlock()
+		{
+			uint64_t head = m_freeListHead.load(std::memory_order_acquire);
+			for (;;)
 			{
-				// We've ran out of space in our current chunk.
-				AllocateNewChunk(pFileName, lineNum);
+				const uintptr_t block = static_cast<uintptr_t>(head & s_kAddressMask);
+				if (block == 0)
+					return nullptr;
+
+				// If another thread pops this block first the link may be garbage,
+				// but the tag will have moved on and the exchange fails.
+				const uintptr_t next = GetNextLink(block).load(std::memory_order_relaxed);
+				if (m_freeListHead.compare_exchange_weak(head, MakeHead(next & s_kAddressMask, head), std::memory_order_acquire, std::memory_order_acquire))
+					return reinterpret_cast<void*>(block);
 			}
+		}
 
-			m_pAllocationCurrent += TypeSize;
-			return reinterpret_cast<void*>(m_pAllocationCurrent - TypeSize);
+		/// <summary>
+		/// Push an already linked run of blocks onto the free list.
+		/// </summary>
+		void PushFreeBlocks(uintptr_t firstBlock, uintptr_t lastBlock)
+		{
+			uint64_t head = m_freeListHead.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				GetNextLink(lastBlock).store(static_cast<uintptr_t>(head & s_kAddressMask), std::memory_order_relaxed);
+				if (m_freeListHead.compare_exchange_weak(head, MakeHead(firstBlock, head), std::memory_order_release, std::memory_order_relaxed))
+					return;
+			}
 		}
 
-		virtual void Free(void* memoryToFree, size_t, bool) final override
+		void TrackAllocation()
 		{
-			memset(memoryToFree, 0xCDCDCDCD, TypeSize);
-			m_freeMemory.push(memoryToFree);
-			memoryToFree = nullptr;
+			const size_t liveBlocks = m_liveBlocks.fetch_add(1, std::memory_order_relaxed) + 1;
+
+			size_t highWaterMark = m_highWaterMark.load(std::memory_order_relaxed);
+			while (liveBlocks > highWaterMark && !m_highWaterMark.compare_exchange_weak(highWaterMark, liveBlocks, std::memory_order_relaxed))
+			{
+				//
+			}
 		}
 
-	private:
-		void AllocateNewChunk(const char* pFileName, int lineNum)
+		/// <summary>
+		/// Request a chunk from the global allocator and push all of its blocks
+		/// onto the free list. Must be called with m_chunkLock held.
+		/// </summary>
+		/// <returns>False if the global allocator is out of memory.</returns>
+		bool AllocateNewChunk(const char* pFileName, int lineNum)
 		{
 			auto pMemManager = Exelius::MemoryManager::GetInstance();
 			EXE_ASSERT(pMemManager);
 			auto pGlobalAllocator = pMemManager->GetGlobalAllocator();
 			EXE_ASSERT(pGlobalAllocator);
-			auto* pMem = pGlobalAllocator->Allocate(ChunkSize, 16U, pFileName, lineNum);
-			m_pooledMemory.emplace_back(reinterpret_cast<uintptr_t>(pMem));
+			auto* pMem = pGlobalAllocator->Allocate(s_kBlocksPerChunk * s_kBlockSize, s_kBlockAlignment, pFileName, lineNum);
+			EXE_ASSERT(pMem);
+			if (!pMem)
+				return false;
+
+			m_chunks.emplace_back(pMem);
+			m_chunkCount.store(m_chunks.size(), std::memory_order_relaxed);
+
+			// Link the chunk's blocks in address order, then publish them all at once.
+			const uintptr_t firstBlock = reinterpret_cast<uintptr_t>(pMem);
+			const uintptr_t lastBlock = firstBlock + (s_kBlocksPerChunk - 1) * s_kBlockSize;
+			for (uintptr_t block = firstBlock; block < lastBlock; block += s_kBlockSize)
+			{
+				GetNextLink(block).store(block + s_kBlockSize, std::memory_order_relaxed);
+			}
 
-			m_pAllocationFront = reinterpret_cast<uintptr_t>(pMem);
-			m_pAllocationEnd = m_pAllocationFront + ChunkSize;
-			m_pAllocationCurrent = m_pAllocationFront;
+			PushFreeBlocks(firstBlock, lastBlock);
+			return true;
 		}
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,501 @@
+#include "EXEPCH.h"
+#include "SizeClassAllocator.h"
+
+#include <bit>
+#include <cstdlib>
+#include <iostream>
+
+#ifdef EXE_WINDOWS
+	#include <malloc.h>
+#endif // EXE_WINDOWS
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Free blocks owned by a single thread. Blocks are returned to the owning
+	/// allocator when the thread exits, unless the allocator is destroyed first.
+	/// </summary>
+	struct SizeClassAllocator::ThreadCache
+	{
+		SizeClassAllocator* m_pOwner = nullptr;
+		ThreadCache* m_pNextCache = nullptr;
+
+		FreeBlock* m_pFreeLists[s_kTagCount][s_kSizeClassCount] = {};
+		size_t m_freeCounts[s_kTagCount][s_kSizeClassCount] = {};
+
+		~ThreadCache();
+
+		/// <summary>
+		/// Drop every cached block without returning it.
+		/// </summary>
+		void Clear()
+		{
+			for (size_t tagIndex = 0; tagIndex < s_kTagCount; ++tagIndex)
+			{
+				for (uint32_t sizeClass = 0; sizeClass < s_kSizeClassCount; ++sizeClass)
+				{
+					m_pFreeLists[tagIndex][sizeClass] = nullptr;
+					m_freeCounts[tagIndex][sizeClass] = 0;
+				}
+			}
+		}
+	};
+
+	/// <summary>
+	/// Guards every allocator's list of thread caches. Shared, rather than
+	/// per allocator, as a thread may exit after its allocator is destroyed.
+	/// </summary>
+	static std::mutex& GetThreadCacheLock()
+	{
+		static std::mutex s_threadCacheLock;
+		return s_threadCacheLock;
+	}
+
+	static void* AllocateSpanMemory(size_t size)
+	{
+#ifdef EXE_WINDOWS
+		return _aligned_malloc(size, SizeClassAllocator::s_kSpanSize);
+#else
+		// Unlike aligned_alloc, large allocation spans don't have to be a multiple of the alignment.
+		void* pSpan = nullptr;
+		if (posix_memalign(&pSpan, SizeClassAllocator::s_kSpanSize, size) != 0)
+			return nullptr;
+		return pSpan;
+#endif // EXE_WINDOWS
+	}
+
+	static void FreeSpanMemory(void* pSpan)
+	{
+#ifdef EXE_WINDOWS
+		_aligned_free(pSpan);
+#else
+		free(pSpan);
+#endif // EXE_WINDOWS
+	}
+
+	SizeClassAllocator::ThreadCache::~ThreadCache()
+	{
+		std::lock_guard<std::mutex> lock(GetThreadCacheLock());
+
+		if (!m_pOwner)
+			return;
+
+		for (size_t tagIndex = 0; tagIndex < s_kTagCount; ++tagIndex)
+		{
+			for (uint32_t sizeClass = 0; sizeClass < s_kSizeClassCount; ++sizeClass)
+			{
+				FreeBlock* pFirst = m_pFreeLists[tagIndex][sizeClass];
+				if (!pFirst)
+					continue;
+
+				FreeBlock* pLast = pFirst;
+				while (pLast->m_pNext)
+					pLast = pLast->m_pNext;
+
+				m_pOwner->ReturnBatch(sizeClass, static_cast<MemoryTag>(tagIndex), pFirst, pLast, m_freeCounts[tagIndex][sizeClass]);
+			}
+		}
+		Clear();
+
+		ThreadCache** ppCache = &m_pOwner->m_pThreadCaches;
+		while (*ppCache != this)
+			ppCache = &(*ppCache)->m_pNextCache;
+		*ppCache = m_pNextCache;
+
+		m_pOwner = nullptr;
+	}
+
+	SizeClassAllocator::SizeClassAllocator()
+		: m_pageMap()
+		, m_pThreadCaches(nullptr)
+		, m_spanCount(0)
+		, m_pStats(nullptr)
+	{
+		//
+	}
+
+	SizeClassAllocator::~SizeClassAllocator()
+	{
+		{
+			std::lock_guard<std::mutex> lock(GetThreadCacheLock());
+
+			// Cached blocks live in our spans, which are about to be released.
+			while (m_pThreadCaches)
+			{
+				ThreadCache* pCache = m_pThreadCaches;
+				m_pThreadCaches = pCache->m_pNextCache;
+
+				pCache->Clear();
+				pCache->m_pNextCache = nullptr;
+				pCache->m_pOwner = nullptr;
+			}
+		}
+
+		for (size_t high = 0; high < s_kPageMapSize; ++high)
+		{
+			uint8_t* pLevel = m_pageMap[high].load(std::memory_order_relaxed);
+			if (!pLevel)
+				continue;
+
+			for (size_t low = 0; low < s_kPageMapSize; ++low)
+			{
+				if (pLevel[low] != 0)
+					FreeSpanMemory(reinterpret_cast<void*>((high << 32) | (low << s_kPageMapBits)));
+			}
+
+			free(pLevel);
+			m_pageMap[high].store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	void* SizeClassAllocator::Allocate(size_t sizeToAllocate, size_t memoryAlignment, const char*, int)
+	{
+		if (memoryAlignment == 0)
+			memoryAlignment = 16;
+		EXE_ASSERT((memoryAlignment & (memoryAlignment - 1)) == 0);
+
+		const MemoryTag tag = m_pStats ? GetCurrentMemoryTag() : MemoryTag::kUntagged;
+		const size_t tagIndex = static_cast<size_t>(tag);
+
+		uint32_t sizeClass = GetSizeClass(eastl::max(sizeToAllocate, memoryAlignment));
+
+		// Blocks start at a multiple of their size from the span, which is aligned to s_kSpanSize.
+		while (sizeClass < s_kSizeClassCount && GetSizeClassBlockSize(sizeClass) % memoryAlignment != 0)
+			++sizeClass;
+
+		void* pMemory = nullptr;
+		if (sizeClass >= s_kSizeClassCount)
+		{
+			// Only malloc'd when it doesn't need counting, as it can't be told apart from C runtime memory when freed.
+			if (m_pStats)
+				return AllocateLarge(sizeToAllocate, memoryAlignment, tag);
+
+			// Like the SystemAllocator, large allocations only get malloc's alignment.
+			pMemory = malloc(sizeToAllocate);
+		}
+		else if (ThreadCache* pCache = GetThreadCache())
+		{
+			FreeBlock*& pFreeList = pCache->m_pFreeLists[tagIndex][sizeClass];
+			size_t& freeCount = pCache->m_freeCounts[tagIndex][sizeClass];
+
+			if (!pFreeList)
+				freeCount = FetchBatch(sizeClass, tag, pFreeList, GetBatchSize(sizeClass));
+
+			FreeBlock* pBlock = pFreeList;
+			if (pBlock)
+			{
+				pFreeList = pBlock->m_pNext;
+				--freeCount;
+			}
+			pMemory = pBlock;
+		}
+		else
+		{
+			FreeBlock* pBlock = nullptr;
+			FetchBatch(sizeClass, tag, pBlock, 1);
+			pMemory = pBlock;
+		}
+
+		EXE_ASSERT(pMemory);
+		if (!pMemory)
+			return nullptr;
+
+		// Match the SystemAllocator, which hands out zeroed memory.
+		memset(pMemory, 0, sizeToAllocate);
+
+		if (m_pStats)
+			m_pStats->RecordAllocation(tag, GetSizeClassBlockSize(sizeClass));
+
+		return pMemory;
+	}
+
+	void SizeClassAllocator::Free(void* pMemoryToFree, size_t, bool)
+	{
+		if (!pMemoryToFree)
+			return;
+
+		const uintptr_t address = reinterpret_cast<uintptr_t>(pMemoryToFree);
+		const uint32_t spanClass = LookupSpanClass(address);
+		if (spanClass == 0)
+		{
+			// An uncounted large allocation, or memory from the C runtime.
+			free(pMemoryToFree);
+			return;
+		}
+
+		if (spanClass == s_kLargeSpanClass)
+		{
+			// The header is within the first span's worth of the allocation, at the start of its span.
+			const uintptr_t spanAddress = address & ~(uintptr_t(s_kSpanSize) - 1);
+			if (m_pStats)
+				m_pStats->RecordFree(LookupSpanTag(address), reinterpret_cast<const LargeAllocationHeader*>(spanAddress)->m_size);
+
+			SetPageMapEntry(spanAddress, 0, MemoryTag::kUntagged);
+			FreeSpanMemory(reinterpret_cast<void*>(spanAddress));
+			return;
+		}
+
+		const uint32_t sizeClass = spanClass - 1;
+		const MemoryTag tag = m_pStats ? LookupSpanTag(address) : MemoryTag::kUntagged;
+		FreeBlock* pBlock = static_cast<FreeBlock*>(pMemoryToFree);
+
+		if (m_pStats)
+			m_pStats->RecordFree(tag, GetSizeClassBlockSize(sizeClass));
+
+		ThreadCache* pCache = GetThreadCache();
+		if (!pCache)
+		{
+			pBlock->m_pNext = nullptr;
+			ReturnBatch(sizeClass, tag, pBlock, pBlock, 1);
+			return;
+		}
+
+		FreeBlock*& pFreeList = pCache->m_pFreeLists[static_cast<size_t>(tag)][sizeClass];
+		size_t& freeCount = pCache->m_freeCounts[static_cast<size_t>(tag)][sizeClass];
+
+		pBlock->m_pNext = pFreeList;
+		pFreeList = pBlock;
+		++freeCount;
+
+		// Keep one batch cached for the next allocations, and hand the rest back.
+		const size_t batchSize = GetBatchSize(sizeClass);
+		if (freeCount >= batchSize * 2)
+		{
+			FreeBlock* pFirst = pFreeList;
+			FreeBlock* pLast = pFirst;
+			for (size_t i = 1; i < batchSize; ++i)
+				pLast = pLast->m_pNext;
+
+			pFreeList = pLast->m_pNext;
+			freeCount -= batchSize;
+
+			pLast->m_pNext = nullptr;
+			ReturnBatch(sizeClass, tag, pFirst, pLast, batchSize);
+		}
+	}
+
+	void SizeClassAllocator::DumpMemoryData()
+	{
+		const size_t spanCount = m_spanCount.load(std::memory_order_relaxed);
+
+		std::cout << "\n----------------------------------------------------\n";
+		std::cout << "Size Class Allocator Data Dump";
+		std::cout << "\n----------------------------------------------------\n";
+		std::cout << "Span Count: " << spanCount << "\n";
+		std::cout << "Span Memory (bytes): " << spanCount * s_kSpanSize << "\n";
+
+		for (size_t tagIndex = 0; tagIndex < s_kTagCount; ++tagIndex)
+		{
+			for (uint32_t sizeClass = 0; sizeClass < s_kSizeClassCount; ++sizeClass)
+			{
+				CentralFreeList& centralList = m_centralFreeLists[tagIndex][sizeClass];
+				std::lock_guard<std::mutex> lock(centralList.m_lock);
+				if (centralList.m_count > 0)
+					std::cout << "Size Class " << GetSizeClassBlockSize(sizeClass) << " bytes Tagged " << GetMemoryTagName(static_cast<MemoryTag>(tagIndex)) << ": " << centralList.m_count << " blocks free in the central list\n";
+			}
+		}
+	}
+
+	void SizeClassAllocator::SetMemoryStats(MemoryStats* pStats)
+	{
+		// Blocks handed out before this would be freed against stats that never counted them.
+		EXE_ASSERT(m_spanCount.load(std::memory_order_relaxed) == 0);
+		m_pStats = pStats;
+	}
+
+	uint32_t SizeClassAllocator::GetSizeClass(size_t size)
+	{
+		if (size <= 128)
+			return size == 0 ? 0 : static_cast<uint32_t>((size + 15) / 16 - 1);
+
+		if (size > s_kMaxSmallSize)
+			return static_cast<uint32_t>(s_kSizeClassCount);
+
+		// Size is in (2^shift, 2^(shift + 1)], which is split into four classes.
+		const uint32_t shift = static_cast<uint32_t>(std::bit_width(size - 1)) - 1;
+		const size_t offset = (size - 1) - (size_t(1) << shift);
+		return 8 + (shift - 7) * 4 + static_cast<uint32_t>(offset >> (shift - 2));
+	}
+
+	size_t SizeClassAllocator::GetSizeClassBlockSize(uint32_t sizeClass)
+	{
+		EXE_ASSERT(sizeClass < s_kSizeClassCount);
+
+		if (sizeClass < 8)
+			return (size_t(sizeClass) + 1) * 16;
+
+		const uint32_t shift = 7 + (sizeClass - 8) / 4;
+		const size_t step = size_t(1) << (shift - 2);
+		return (size_t(1) << shift) + ((sizeClass - 8) % 4 + 1) * step;
+	}
+
+	size_t SizeClassAllocator::GetBatchSize(uint32_t sizeClass)
+	{
+		// Roughly a quarter of a span, so small classes move many blocks at once and large classes only a couple.
+		return eastl::max(size_t(2), eastl::min(s_kSpanSize / 4 / GetSizeClassBlockSize(sizeClass), size_t(64)));
+	}
+
+	SizeClassAllocator::ThreadCache* SizeClassAllocator::GetThreadCache()
+	{
+		static thread_local ThreadCache s_threadCache;
+
+		if (s_threadCache.m_pOwner == this)
+			return &s_threadCache;
+
+		// Each thread only caches for one allocator, others use the central lists.
+		if (s_threadCache.m_pOwner)
+			return nullptr;
+
+		std::lock_guard<std::mutex> lock(GetThreadCacheLock());
+		s_threadCache.m_pOwner = this;
+		s_threadCache.m_pNextCache = m_pThreadCaches;
+		m_pThreadCaches = &s_threadCache;
+		return &s_threadCache;
+	}
+
+	uint32_t SizeClassAllocator::LookupSpanClass(uintptr_t address) const
+	{
+		// Outside of the 48 bits the page map covers, so can't be ours.
+		if ((address >> (s_kPageMapBits * 3)) != 0)
+			return 0;
+
+		const uint8_t* pLevel = m_pageMap[(address >> (s_kPageMapBits * 2)) & (s_kPageMapSize - 1)].load(std::memory_order_acquire);
+		if (!pLevel)
+			return 0;
+
+		return pLevel[(address >> s_kPageMapBits) & (s_kPageMapSize - 1)];
+	}
+
+	MemoryTag SizeClassAllocator::LookupSpanTag(uintptr_t address) const
+	{
+		const uint8_t* pLevel = m_pageMap[(address >> (s_kPageMapBits * 2)) & (s_kPageMapSize - 1)].load(std::memory_order_acquire);
+		EXE_ASSERT(pLevel);
+
+		return static_cast<MemoryTag>(pLevel[s_kPageMapSize + ((address >> s_kPageMapBits) & (s_kPageMapSize - 1))]);
+	}
+
+	size_t SizeClassAllocator::FetchBatch(uint32_t sizeClass, MemoryTag tag, FreeBlock*& pList, size_t maxCount)
+	{
+		EXE_ASSERT(!pList);
+
+		CentralFreeList& centralList = m_centralFreeLists[static_cast<size_t>(tag)][sizeClass];
+		std::lock_guard<std::mutex> lock(centralList.m_lock);
+
+		if (!centralList.m_pHead)
+		{
+			uint8_t* pSpan = static_cast<uint8_t*>(AllocateSpan(sizeClass, tag));
+			if (!pSpan)
+				return 0;
+
+			// Carve the whole span up front, in address order.
+			const size_t blockSize = GetSizeClassBlockSize(sizeClass);
+			const size_t blockCount = s_kSpanSize / blockSize;
+			for (size_t block = 0; block < blockCount; ++block)
+			{
+				FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(pSpan + block * blockSize);
+				pBlock->m_pNext = (block + 1 < blockCount) ? reinterpret_cast<FreeBlock*>(pSpan + (block + 1) * blockSize) : nullptr;
+			}
+
+			centralList.m_pHead = reinterpret_cast<FreeBlock*>(pSpan);
+			centralList.m_count = blockCount;
+		}
+
+		FreeBlock* pFirst = centralList.m_pHead;
+		FreeBlock* pLast = pFirst;
+		size_t count = 1;
+		while (count < maxCount && pLast->m_pNext)
+		{
+			pLast = pLast->m_pNext;
+			++count;
+		}
+
+		centralList.m_pHead = pLast->m_pNext;
+		centralList.m_count -= count;
+
+		pLast->m_pNext = nullptr;
+		pList = pFirst;
+		return count;
+	}
+
+	void SizeClassAllocator::ReturnBatch(uint32_t sizeClass, MemoryTag tag, FreeBlock* pFirst, FreeBlock* pLast, size_t count)
+	{
+		CentralFreeList& centralList = m_centralFreeLists[static_cast<size_t>(tag)][sizeClass];
+		std::lock_guard<std::mutex> lock(centralList.m_lock);
+
+		pLast->m_pNext = centralList.m_pHead;
+		centralList.m_pHead = pFirst;
+		centralList.m_count += count;
+	}
+
+	void* SizeClassAllocator::AllocateSpan(uint32_t sizeClass, MemoryTag tag)
+	{
+		void* pSpan = AllocateSpanMemory(s_kSpanSize);
+		if (!pSpan)
+			return nullptr;
+
+		if (!SetPageMapEntry(reinterpret_cast<uintptr_t>(pSpan), sizeClass + 1, tag))
+		{
+			FreeSpanMemory(pSpan);
+			return nullptr;
+		}
+
+		m_spanCount.fetch_add(1, std::memory_order_relaxed);
+		return pSpan;
+	}
+
+	void* SizeClassAllocator::AllocateLarge(size_t sizeToAllocate, size_t memoryAlignment, MemoryTag tag)
+	{
+		EXE_ASSERT(m_pStats);
+
+		// The allocation follows the header, at the requested alignment.
+		const size_t headerSize = eastl::max(sizeof(LargeAllocationHeader), memoryAlignment);
+		EXE_ASSERT(headerSize < s_kSpanSize);
+
+		uint8_t* pSpan = static_cast<uint8_t*>(AllocateSpanMemory(headerSize + sizeToAllocate));
+		EXE_ASSERT(pSpan);
+		if (!pSpan)
+			return nullptr;
+
+		reinterpret_cast<LargeAllocationHeader*>(pSpan)->m_size = sizeToAllocate;
+		if (!SetPageMapEntry(reinterpret_cast<uintptr_t>(pSpan), s_kLargeSpanClass, tag))
+		{
+			FreeSpanMemory(pSpan);
+			return nullptr;
+		}
+
+		void* pMemory = pSpan + headerSize;
+		memset(pMemory, 0, sizeToAllocate);
+
+		m_pStats->RecordAllocation(tag, sizeToAllocate);
+		return pMemory;
+	}
+
+	bool SizeClassAllocator::SetPageMapEntry(uintptr_t address, uint32_t spanClass, MemoryTag tag)
+	{
+		EXE_ASSERT((address >> (s_kPageMapBits * 3)) == 0);
+
+		std::atomic<uint8_t*>& levelEntry = m_pageMap[(address >> (s_kPageMapBits * 2)) & (s_kPageMapSize - 1)];
+		uint8_t* pLevel = levelEntry.load(std::memory_order_acquire);
+		if (!pLevel)
+		{
+			std::lock_guard<std::mutex> lock(m_pageMapLock);
+			pLevel = levelEntry.load(std::memory_order_acquire);
+			if (!pLevel)
+			{
+				// Size classes, then tags.
+				pLevel = static_cast<uint8_t*>(calloc(s_kPageMapSize * 2, sizeof(uint8_t)));
+				if (!pLevel)
+					return false;
+				levelEntry.store(pLevel, std::memory_order_release);
+			}
+		}
+
+		const size_t entry = (address >> s_kPageMapBits) & (s_kPageMapSize - 1);
+		pLevel[s_kPageMapSize + entry] = static_cast<uint8_t>(tag);
+		pLevel[entry] = static_cast<uint8_t>(spanClass);
+		return true;
+	}
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include "source/os/memory/ExeliusAllocator.h"
+#include "source/os/memory/MemoryTag.h"
+#include "source/os/memory/MemoryStats.h"
+
+#include <atomic>
+#include <mutex>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// General purpose allocator built for many threads allocating at once.
+	///
+	/// Requests up to s_kMaxSmallSize bytes are rounded up to one of a fixed
+	/// set of size classes. Each class carves its blocks out of 64kB spans,
+	/// and every thread keeps a small cache of free blocks per class, so most
+	/// allocations and frees are a push or pop on a thread-local list with no
+	/// synchronization at all. Caches trade blocks with a per-class central
+	/// list, one batch at a time, when they run dry or grow too large.
+	///
+	/// Larger requests go straight to malloc. So does freeing any pointer that
+	/// didn't come from a span, which keeps memory from the C runtime (freed
+	/// through the global delete overloads) working.
+	///
+	/// Spans are only returned to the system when the allocator is destroyed.
+	///
+	/// Once given MemoryStats, every span only holds blocks of a single
+	/// MemoryTag, so frees are counted against the right tag without a header
+	/// on each block. Small allocations are counted in whole blocks. Large
+	/// allocations get their own span sized to fit, with a small header
+	/// holding the requested size, so they can be told apart from memory
+	/// that came from the C runtime.
+	/// </summary>
+	class SizeClassAllocator
+		: public ExeliusAllocator
+	{
+	public:
+		static constexpr size_t s_kSpanSize = 64 * 1024;
+		static constexpr size_t s_kMaxSmallSize = 32 * 1024;
+
+		/// <summary>
+		/// 16 byte steps up to 128 bytes, then four classes per power of two up to s_kMaxSmallSize.
+		/// </summary>
+		static constexpr size_t s_kSizeClassCount = 8 + 8 * 4;
+
+	private:
+		struct FreeBlock
+		{
+			FreeBlock* m_pNext;
+		};
+
+		/// <summary>
+		/// Free blocks of one size class shared by every thread.
+		/// </summary>
+		struct CentralFreeList
+		{
+			FreeBlock* m_pHead = nullptr;
+			size_t m_count = 0;
+			std::mutex m_lock;
+		};
+
+		/// <summary>
+		/// Starts each large allocation's span, while stats are being gathered.
+		/// </summary>
+		struct alignas(16) LargeAllocationHeader
+		{
+			size_t m_size;
+		};
+
+		struct ThreadCache;
+
+		static constexpr size_t s_kTagCount = static_cast<size_t>(MemoryTag::kCount);
+
+		/// <summary>
+		/// Span class of a large allocation's span, in the page map.
+		/// </summary>
+		static constexpr uint32_t s_kLargeSpanClass = static_cast<uint32_t>(s_kSizeClassCount) + 1;
+
+		CentralFreeList m_centralFreeLists[s_kTagCount][s_kSizeClassCount];
+
+		/// <summary>
+		/// Maps each 64kB span of the address space to the size class + 1 of the
+		/// span there, or 0 if it isn't one of ours. Two levels, 16 bits each,
+		/// covering 48 bit addresses. Second levels are created on demand, and
+		/// hold the MemoryTag of each span after the size classes.
+		/// </summary>
+		static constexpr size_t s_kPageMapBits = 16;
+		static constexpr size_t s_kPageMapSize = size_t(1) << s_kPageMapBits;
+		std::atomic<uint8_t*> m_pageMap[s_kPageMapSize];
+
+		/// <summary>
+		/// Guards creating second levels of the page map.
+		/// </summary>
+		std::mutex m_pageMapLock;
+
+		/// <summary>
+		/// Caches of every thread that has used this allocator.
+		/// Guarded by a lock shared by all instances, as threads may outlive the allocator.
+		/// </summary>
+		ThreadCache* m_pThreadCaches;
+
+		std::atomic<size_t> m_spanCount;
+
+		MemoryStats* m_pStats;
+
+	public:
+		SizeClassAllocator();
+		SizeClassAllocator(const SizeClassAllocator&) = delete;
+		SizeClassAllocator(SizeClassAllocator&&) = delete;
+		SizeClassAllocator& operator=(const SizeClassAllocator&) = delete;
+		SizeClassAllocator& operator=(SizeClassAllocator&&) = delete;
+		virtual ~SizeClassAllocator();
+
+		virtual void* Allocate(size_t sizeToAllocate, size_t memoryAlignment = 16, const char* pFileName = nullptr, int lineNum = -1) final override;
+
+		virtual void Free(void* pMemoryToFree, size_t sizeToFree = 0, bool isAligned = false) final override;
+
+		virtual void DumpMemoryData() final override;
+
+		/// <summary>
+		/// Feed per tag usage to these stats. Must be set before the first allocation.
+		/// </summary>
+		void SetMemoryStats(MemoryStats* pStats);
+
+		/// <summary>
+		/// The size class a request of this many bytes is rounded up to.
+		/// </summary>
+		static uint32_t GetSizeClass(size_t size);
+
+		/// <summary>
+		/// The size of each block in a size class.
+		/// </summary>
+		static size_t GetSizeClassBlockSize(uint32_t sizeClass);
+
+	private:
+		ThreadCache* GetThreadCache();
+
+		/// <summary>
+		/// The size class + 1 of the span containing the address, or 0 if it isn't in a span.
+		/// </summary>
+		uint32_t LookupSpanClass(uintptr_t address) const;
+
+		/// <summary>
+		/// The tag of the span containing the address. Only valid for addresses in a span.
+		/// </summary>
+		MemoryTag LookupSpanTag(uintptr_t address) const;
+
+		/// <summary>
+		/// The number of blocks moved between a thread cache and the central list at once.
+		/// </summary>
+		static size_t GetBatchSize(uint32_t sizeClass);
+
+		/// <summary>
+		/// Move up to maxCount blocks from the central list into the empty list
+		/// passed in, carving a new span if the central list is empty.
+		/// </summary>
+		/// <returns>The number of blocks moved.</returns>
+		size_t FetchBatch(uint32_t sizeClass, MemoryTag tag, FreeBlock*& pList, size_t maxCount);
+
+		/// <summary>
+		/// Return a linked run of blocks to the central list.
+		/// </summary>
+		void ReturnBatch(uint32_t sizeClass, MemoryTag tag, FreeBlock* pFirst, FreeBlock* pLast, size_t count);
+
+		/// <summary>
+		/// Request a span from the system and register it in the page map.
+		/// </summary>
+		/// <returns>The span, or nullptr if the system is out of memory.</returns>
+		void* AllocateSpan(uint32_t sizeClass, MemoryTag tag);
+
+		/// <summary>
+		/// Give a large allocation a span of its own, so its tag and size can be found when it is freed.
+		/// </summary>
+		/// <returns>The allocation, or nullptr if the system is out of memory.</returns>
+		void* AllocateLarge(size_t sizeToAllocate, size_t memoryAlignment, MemoryTag tag);
+
+		/// <summary>
+		/// Set the page map entry of the span starting at the address, creating its second level if needed.
+		/// </summary>
+		/// <returns>False if the second level couldn't be created.</returns>
+		bool SetPageMapEntry(uintptr_t address, uint32_t spanClass, MemoryTag tag);
+	};
+}
@@ -3,17 +3,45 @@
 
 #include <iostream>
 
+#ifdef EXE_WINDOWS
+	#include <Windows.h>
+#else
+	#include <execinfo.h>
+#endif // EXE_WINDOWS
+
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	static uint32_t CaptureCallStack(void** ppFrames, uint32_t maxFrames)
+	{
+#ifdef EXE_WINDOWS
+		// Skip this function and TraceAllocator::Allocate.
+		return static_cast<uint32_t>(RtlCaptureStackBackTrace(2, maxFrames, ppFrames, nullptr));
+#else
+		return static_cast<uint32_t>(backtrace(ppFrames, static_cast<int>(maxFrames)));
+#endif // EXE_WINDOWS
+	}
+
 	TraceAllocator::TraceAllocator()
 		: m_pParentAllocator(nullptr)
 		, m_allocationCount(0)
 		, m_totalAllocatedBytes(0)
 		, m_deallocationCount(0)
 		, m_totalDeallocatedBytes(0)
+		, m_untrackedAllocationCount(0)
+		, m_pReservedRegion(nullptr)
+		, m_pTrackedMemory(nullptr)
+		, m_tableCapacity(0)
+		, m_maxTrackedAllocations(0)
+		, m_trackedAllocationCount(0)
+		, m_pCallStacks(nullptr)
+		, m_freeCallStack(s_kNoCallStack)
+		, m_callStackSampleRate(0)
+		, m_callStackSampleCounter(0)
+		, m_pStats(nullptr)
+		, m_pRecordingFile(nullptr)
 	{
 		//
 	}
@@ -24,15 +52,107 @@ namespace Exelius
 		, m_totalAllocatedBytes(0)
 		, m_deallocationCount(0)
 		, m_totalDeallocatedBytes(0)
+		, m_untrackedAllocationCount(0)
+		, m_pReservedRegion(nullptr)
+		, m_pTrackedMemory(nullptr)
+		, m_tableCapacity(0)
+		, m_maxTrackedAllocations(0)
+		, m_trackedAllocationCount(0)
+		, m_pCallStacks(nullptr)
+		, m_freeCallStack(s_kNoCallStack)
+		, m_callStackSampleRate(0)
+		, m_callStackSampleCounter(0)
+		, m_pStats(nullptr)
+		, m_pRecordingFile(nullptr)
 	{
 		EXE_ASSERT(m_pParentAllocator);
 	}
 
+	TraceAllocator::~TraceAllocator()
+	{
+		StopRecording();
+
+		if (m_pReservedRegion)
+			m_pParentAllocator->Free(m_pReservedRegion);
+
+		m_pReservedRegion = nullptr;
+		m_pTrackedMemory = nullptr;
+		m_pCallStacks = nullptr;
+	}
+
 	void TraceAllocator::SetParentAllocator(ExeliusAllocator* pParentAllocator)
 	{
 		m_pParentAllocator = pParentAllocator;
 	}
-	
+
+	bool TraceAllocator::StartRecording(const char* pFilePath)
+	{
+		EXE_ASSERT(pFilePath);
+
+		// Opened outside the lock, the C runtime may allocate through us.
+		FILE* pRecordingFile = ::fopen(pFilePath, "wb");
+		if (!pRecordingFile)
+			return false;
+
+		FILE* pPreviousFile = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			pPreviousFile = m_pRecordingFile;
+			m_pRecordingFile = pRecordingFile;
+		}
+
+		if (pPreviousFile)
+			::fclose(pPreviousFile);
+		return true;
+	}
+
+	void TraceAllocator::StopRecording()
+	{
+		FILE* pRecordingFile = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(m_lock);
+			pRecordingFile = m_pRecordingFile;
+			m_pRecordingFile = nullptr;
+		}
+
+		if (pRecordingFile)
+			::fclose(pRecordingFile);
+	}
+
+	bool TraceAllocator::Reserve(size_t maxTrackedAllocations)
+	{
+		EXE_ASSERT(m_pParentAllocator);
+		EXE_ASSERT(!m_pReservedRegion);
+
+		// Keep the table at most 3/4 full, so probe sequences stay short.
+		size_t tableCapacity = 1;
+		while (tableCapacity * 3 < maxTrackedAllocations * 4)
+			tableCapacity <<= 1;
+
+		const size_t tableBytes = tableCapacity * sizeof(AllocationData);
+		const size_t callStackBytes = s_kMaxCapturedCallStacks * sizeof(CallStack);
+
+		m_pReservedRegion = m_pParentAllocator->Allocate(tableBytes + callStackBytes, alignof(AllocationData), "TraceAllocator", __LINE__);
+		if (!m_pReservedRegion)
+			return false;
+
+		m_pTrackedMemory = static_cast<AllocationData*>(m_pReservedRegion);
+		for (size_t slot = 0; slot < tableCapacity; ++slot)
+			new (&m_pTrackedMemory[slot]) AllocationData();
+
+		m_pCallStacks = reinterpret_cast<CallStack*>(static_cast<uint8_t*>(m_pReservedRegion) + tableBytes);
+		for (uint32_t callStack = 0; callStack < s_kMaxCapturedCallStacks; ++callStack)
+		{
+			m_pCallStacks[callStack].m_frameCount = 0;
+			m_pCallStacks[callStack].m_nextFree = (callStack + 1 < s_kMaxCapturedCallStacks) ? callStack + 1 : s_kNoCallStack;
+		}
+		m_freeCallStack = 0;
+
+		m_tableCapacity = tableCapacity;
+		m_maxTrackedAllocations = maxTrackedAllocations;
+		return true;
+	}
+
 	void* TraceAllocator::Allocate(size_t sizeToAllocate, size_t memoryAlignment, const char* pFileName, int lineNum)
 	{
 		if (!pFileName)
@@ -41,27 +161,61 @@ namespace Exelius
 		EXE_ASSERT(m_pParentAllocator);
 		void* allocatedMemory = m_pParentAllocator->Allocate(sizeToAllocate, memoryAlignment, pFileName, lineNum);
 		EXE_ASSERT(allocatedMemory);
+		if (!allocatedMemory)
+			return nullptr;
+
+		// Capture outside the lock, walking the stack is the slow part.
+		void* callStackFrames[s_kMaxCallStackDepth];
+		uint32_t callStackDepth = 0;
+		const uint32_t sampleRate = m_callStackSampleRate;
+		if (sampleRate > 0 && m_callStackSampleCounter.fetch_add(1, std::memory_order_relaxed) % sampleRate == 0)
+			callStackDepth = CaptureCallStack(callStackFrames, s_kMaxCallStackDepth);
 
-		++m_allocationCount;
-		m_totalAllocatedBytes += sizeToAllocate;
+		const MemoryTag tag = GetCurrentMemoryTag();
 
-		// O(n) loop through array. I could take the BleachLeakDetector route and use a
-		// hashmap and hash the line+filename, but that would also allocate memory in some cases.
-		// This route will never allocate memory while this tracer is in effect.
-		for (auto& entry : m_trackedMemory)
 		{
-			// If memory in this entry is nullptr, fill the entry.
-			if (entry.memoryAddress == 0)
+			std::lock_guard<std::mutex> lock(m_lock);
+
+			if (!m_pReservedRegion && !Reserve())
+				return allocatedMemory;
+
+			++m_allocationCount;
+			m_totalAllocatedBytes += sizeToAllocate;
+
+			if (m_trackedAllocationCount >= m_maxTrackedAllocations)
 			{
-				entry.memoryAddress = reinterpret_cast<uintptr_t>(allocatedMemory);
-				entry.allocationSize = sizeToAllocate;
-				entry.pAllocationFile = pFileName;
-				entry.lineNumber = lineNum;
+				// We have allocated and traced more memory than we reserved room for.
+				++m_untrackedAllocationCount;
 				return allocatedMemory;
 			}
+
+			const uintptr_t memoryAddress = reinterpret_cast<uintptr_t>(allocatedMemory);
+			size_t slot = GetHomeSlot(memoryAddress);
+			while (m_pTrackedMemory[slot].memoryAddress != 0)
+			{
+				// The parent should never hand out memory that's still live.
+				EXE_ASSERT(m_pTrackedMemory[slot].memoryAddress != memoryAddress);
+				slot = (slot + 1) & (m_tableCapacity - 1);
+			}
+
+			AllocationData& entry = m_pTrackedMemory[slot];
+			entry.memoryAddress = memoryAddress;
+			entry.allocationSize = sizeToAllocate;
+			entry.pAllocationFile = pFileName;
+			entry.lineNumber = lineNum;
+			entry.tag = tag;
+			entry.callStackIndex = (callStackDepth > 0) ? StoreCallStack(callStackFrames, callStackDepth) : s_kNoCallStack;
+
+			++m_trackedAllocationCount;
+
+			if (m_pRecordingFile)
+				RecordTraceEvent(memoryAddress, sizeToAllocate, memoryAlignment, tag, false);
 		}
 
-		EXE_ASSERT(false); // We have allocated and traced more memory than we currently allow.
+		// Outside the lock, a budget assert may allocate.
+		if (m_pStats)
+			m_pStats->RecordAllocation(tag, sizeToAllocate);
+
 		return allocatedMemory;
 	}
 
@@ -70,38 +224,63 @@ namespace Exelius
 		if (!memoryToFree)
 			return;
 
-		// O(n) loop through array. I could take the BleachLeakDetector route and use a
-		// hashmap and hash the line+filename, but that would also allocate memory in some cases.
-		// This route will never allocate memory while this tracer is in effect.
-		for (auto& entry : m_trackedMemory)
+		EXE_ASSERT(m_pParentAllocator);
+
+		bool wasTracked = false;
+		size_t trackedSize = 0;
+		MemoryTag trackedTag = MemoryTag::kUntagged;
 		{
-			if (entry.memoryAddress == reinterpret_cast<uintptr_t>(memoryToFree))
+			std::lock_guard<std::mutex> lock(m_lock);
+
+			if (m_pTrackedMemory)
 			{
-				// We only track the memory we allocated.
-				++m_deallocationCount;
-				if (sizeToFree <= 0)
-					m_totalDeallocatedBytes += entry.allocationSize;
-				else
-					m_totalDeallocatedBytes += sizeToFree;
-
-				// Zero out the entry.
-				entry.memoryAddress = 0;
-				entry.pAllocationFile = nullptr;
-				entry.lineNumber = 0;
-				entry.allocationSize = 0;
-
-				// This was one of Exelius's allocations, so we can free it (aligned).
-				m_pParentAllocator->Free(memoryToFree, sizeToFree, true);
-				return;
+				const uintptr_t memoryAddress = reinterpret_cast<uintptr_t>(memoryToFree);
+				for (size_t slot = GetHomeSlot(memoryAddress); m_pTrackedMemory[slot].memoryAddress != 0; slot = (slot + 1) & (m_tableCapacity - 1))
+				{
+					AllocationData& entry = m_pTrackedMemory[slot];
+					if (entry.memoryAddress != memoryAddress)
+						continue;
+
+					// We only track the memory we allocated.
+					++m_deallocationCount;
+					if (sizeToFree <= 0)
+						m_totalDeallocatedBytes += entry.allocationSize;
+					else
+						m_totalDeallocatedBytes += sizeToFree;
+
+					trackedSize = entry.allocationSize;
+					trackedTag = entry.tag;
+
+					if (m_pRecordingFile)
+						RecordTraceEvent(memoryAddress, 0, 0, trackedTag, true);
+
+					ReleaseCallStack(entry.callStackIndex);
+					RemoveSlot(slot);
+					--m_trackedAllocationCount;
+
+					wasTracked = true;
+					break;
+				}
 			}
 		}
 
-		EXE_ASSERT(m_pParentAllocator);
+		if (wasTracked)
+		{
+			if (m_pStats)
+				m_pStats->RecordFree(trackedTag, trackedSize);
+
+			// This was one of Exelius's allocations, so we can free it (aligned).
+			m_pParentAllocator->Free(memoryToFree, sizeToFree, true);
+			return;
+		}
+
 		m_pParentAllocator->Free(memoryToFree, sizeToFree);
 	}
 
 	void TraceAllocator::DumpMemoryData()
 	{
+		std::lock_guard<std::mutex> lock(m_lock);
+
 		std::cout << "\n----------------------------------------------------\n";
 		std::cout << "Debug Memory Manager Data Dump";
 		std::cout << "\n----------------------------------------------------\n";
@@ -113,15 +292,106 @@ namespace Exelius
 		std::cout << "Current Total Memory Deallocated: " << m_totalDeallocatedBytes << "\n";
 		std::cout << "Difference: " << m_totalAllocatedBytes - m_totalDeallocatedBytes << "\n";
 
-		for (auto& entry : m_trackedMemory)
+		if (m_untrackedAllocationCount > 0)
+			std::cout << "Untracked Allocations (reserve more tracking space): " << m_untrackedAllocationCount << "\n";
+
+		if (!m_pTrackedMemory)
+			return;
+
+		size_t liveBytesByTag[static_cast<size_t>(MemoryTag::kCount)] = {};
+		for (size_t slot = 0; slot < m_tableCapacity; ++slot)
 		{
+			const AllocationData& entry = m_pTrackedMemory[slot];
 			if (entry.memoryAddress != 0)
+				liveBytesByTag[static_cast<size_t>(entry.tag)] += entry.allocationSize;
+		}
+
+		for (size_t tag = 0; tag < static_cast<size_t>(MemoryTag::kCount); ++tag)
+		{
+			if (liveBytesByTag[tag] > 0)
+				std::cout << "Live Memory (bytes) Tagged " << GetMemoryTagName(static_cast<MemoryTag>(tag)) << ": " << liveBytesByTag[tag] << "\n";
+		}
+
+		for (size_t slot = 0; slot < m_tableCapacity; ++slot)
+		{
+			const AllocationData& entry = m_pTrackedMemory[slot];
+			if (entry.memoryAddress == 0 || !entry.pAllocationFile)
+				continue;
+
+			std::cout << "Leak Detected: Address: " << entry.memoryAddress << ", Size (bytes): " << entry.allocationSize << ", Tag: " << GetMemoryTagName(entry.tag) << ", Filename: " << entry.pAllocationFile << ", Line Number: " << entry.lineNumber << "\n";
+
+			if (entry.callStackIndex != s_kNoCallStack)
 			{
-				if (entry.pAllocationFile)
-				{
-					std::cout << "Leak Detected: Address: " << entry.memoryAddress << ", Size (bytes): " << entry.allocationSize  << ", Filename: " << entry.pAllocationFile << ", Line Number: " << entry.lineNumber << "\n";
-				}
+				const CallStack& callStack = m_pCallStacks[entry.callStackIndex];
+				for (uint32_t frame = 0; frame < callStack.m_frameCount; ++frame)
+					std::cout << "    at " << callStack.m_frames[frame] << "\n";
+			}
+		}
+	}
+
+	size_t TraceAllocator::GetHomeSlot(uintptr_t memoryAddress) const
+	{
+		// The low bits are mostly alignment, mix them out with a Fibonacci hash.
+		const uint64_t hash = static_cast<uint64_t>(memoryAddress) * 0x9E3779B97F4A7C15ull;
+		return static_cast<size_t>(hash >> 32) & (m_tableCapacity - 1);
+	}
+
+	void TraceAllocator::RemoveSlot(size_t slot)
+	{
+		const size_t mask = m_tableCapacity - 1;
+
+		size_t emptySlot = slot;
+		for (size_t nextSlot = (slot + 1) & mask; m_pTrackedMemory[nextSlot].memoryAddress != 0; nextSlot = (nextSlot + 1) & mask)
+		{
+			// Move the entry back if the empty slot lies between its home slot and where it is now.
+			const size_t homeSlot = GetHomeSlot(m_pTrackedMemory[nextSlot].memoryAddress);
+			const size_t distanceToEntry = (nextSlot - homeSlot) & mask;
+			const size_t distanceToEmpty = (emptySlot - homeSlot) & mask;
+			if (distanceToEmpty < distanceToEntry)
+			{
+				m_pTrackedMemory[emptySlot] = m_pTrackedMemory[nextSlot];
+				emptySlot = nextSlot;
 			}
 		}
+
+		m_pTrackedMemory[emptySlot] = AllocationData();
+	}
+
+	uint32_t TraceAllocator::StoreCallStack(void* const* ppFrames, uint32_t frameCount)
+	{
+		const uint32_t callStackIndex = m_freeCallStack;
+		if (callStackIndex == s_kNoCallStack)
+			return s_kNoCallStack;
+
+		CallStack& callStack = m_pCallStacks[callStackIndex];
+		m_freeCallStack = callStack.m_nextFree;
+
+		callStack.m_frameCount = frameCount;
+		for (uint32_t frame = 0; frame < frameCount; ++frame)
+			callStack.m_frames[frame] = ppFrames[frame];
+
+		return callStackIndex;
+	}
+
+	void TraceAllocator::ReleaseCallStack(uint32_t callStackIndex)
+	{
+		if (callStackIndex == s_kNoCallStack)
+			return;
+
+		m_pCallStacks[callStackIndex].m_frameCount = 0;
+		m_pCallStacks[callStackIndex].m_nextFree = m_freeCallStack;
+		m_freeCallStack = callStackIndex;
+	}
+
+	void TraceAllocator::RecordTraceEvent(uintptr_t memoryAddress, size_t size, size_t memoryAlignment, MemoryTag tag, bool isFree)
+	{
+		AllocationTraceRecord record = {};
+		record.m_address = static_cast<uint64_t>(memoryAddress);
+		record.m_size = static_cast<uint64_t>(size);
+		record.m_alignment = static_cast<uint32_t>(memoryAlignment);
+		record.m_tag = tag;
+		record.m_isFree = isFree;
+
+		::fwrite(&record, sizeof(record), 1, m_pRecordingFile);
 	}
-}
\ No newline at end of file
+}
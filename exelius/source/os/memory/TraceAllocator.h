@@ -1,15 +1,51 @@
 #pragma once
 #include "source/os/memory/ExeliusAllocator.h"
+#include "source/os/memory/MemoryTag.h"
+#include "source/os/memory/MemoryStats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	/// <summary>
+	/// One allocation or free, as written by TraceAllocator::StartRecording.
+	/// </summary>
+	struct AllocationTraceRecord
+	{
+		uint64_t m_address;
+		uint64_t m_size;		// 0 for a free.
+		uint32_t m_alignment;
+		MemoryTag m_tag;
+		bool m_isFree;
+	};
+
+	/// <summary>
+	/// Debug wrapper that records every live allocation made through it, to
+	/// report leaks and usage per subsystem.
+	///
+	/// Allocations are tracked in an open addressing hash table keyed on the
+	/// address, so tracking is O(1) no matter how many allocations are live.
+	/// The table, and the storage for sampled call stacks, come from a single
+	/// region reserved up front from the parent allocator. Tracking never
+	/// allocates after that, and allocations past the reserved capacity are
+	/// passed through untracked and counted.
+	/// </summary>
 	class TraceAllocator
 		: public ExeliusAllocator
 	{
-		static constexpr uint32_t s_kMaxTrackedAllocationCount = 4096;
+	public:
+		static constexpr size_t s_kDefaultMaxTrackedAllocations = 256 * 1024;
+		static constexpr uint32_t s_kMaxCallStackDepth = 16;
+		static constexpr uint32_t s_kMaxCapturedCallStacks = 8 * 1024;
+
+	private:
+		static constexpr uint32_t s_kNoCallStack = UINT32_MAX;
+
 		ExeliusAllocator* m_pParentAllocator;
 
 		int32_t m_allocationCount;
@@ -17,12 +53,16 @@ namespace Exelius
 		int32_t m_deallocationCount;
 		size_t m_totalDeallocatedBytes;
 
+		/// <summary>
+		/// Allocations that didn't fit in the table.
+		/// </summary>
+		size_t m_untrackedAllocationCount;
+
 		/// <summary>
 		/// The data we track for each memory allocation.
-		/// 
-		/// Size stats (I think):
-		///		x86: 16 bytes
-		///		x64: 28 bytes
+		///
+		/// Size stats:
+		///		x64: 40 bytes
 		/// </summary>
 		struct AllocationData
 		{
@@ -31,27 +71,122 @@ namespace Exelius
 
 			const char* pAllocationFile = nullptr;
 			uint32_t lineNumber = 0;
+
+			uint32_t callStackIndex = s_kNoCallStack;
+			MemoryTag tag = MemoryTag::kUntagged;
+		};
+
+		struct CallStack
+		{
+			void* m_frames[s_kMaxCallStackDepth];
+			uint32_t m_frameCount;
+			uint32_t m_nextFree;
 		};
 
 		/// <summary>
-		/// Staticly allocated array of memory allocations.
-		/// Currently the size of this array is:
-		///		x86: 4098 x 16 =  65,568 bytes ||  65kB
-		///		x64: 4098 x 28 = 114,744 bytes || 114kB
+		/// The reserved region, holding the hash table followed by the call stacks.
+		/// </summary>
+		void* m_pReservedRegion;
+
+		/// <summary>
+		/// Open addressing hash table of live allocations, linear probing.
+		/// Entries with a memoryAddress of 0 are empty. Capacity is a power of two.
+		/// </summary>
+		AllocationData* m_pTrackedMemory;
+		size_t m_tableCapacity;
+		size_t m_maxTrackedAllocations;
+		size_t m_trackedAllocationCount;
+
+		CallStack* m_pCallStacks;
+		uint32_t m_freeCallStack;
+
+		/// <summary>
+		/// Capture the call stack of one in every N allocations, 0 to disable.
+		/// </summary>
+		uint32_t m_callStackSampleRate;
+		std::atomic<uint32_t> m_callStackSampleCounter;
+
+		/// <summary>
+		/// Fed with every tracked allocation and free, if set.
+		/// </summary>
+		MemoryStats* m_pStats;
+
+		/// <summary>
+		/// Every tracked allocation and free is written here while recording.
 		/// </summary>
-		AllocationData m_trackedMemory[s_kMaxTrackedAllocationCount];
+		FILE* m_pRecordingFile;
+
+		std::mutex m_lock;
 
 	public:
 		TraceAllocator();
 
 		TraceAllocator(ExeliusAllocator* pParentAllocator);
 
+		TraceAllocator(const TraceAllocator&) = delete;
+		TraceAllocator(TraceAllocator&&) = delete;
+		TraceAllocator& operator=(const TraceAllocator&) = delete;
+		TraceAllocator& operator=(TraceAllocator&&) = delete;
+
+		virtual ~TraceAllocator();
+
 		void SetParentAllocator(ExeliusAllocator* pParentAllocator);
 
+		/// <summary>
+		/// Reserve the tracking region from the parent allocator. Done with the
+		/// default capacity on the first allocation if not called before then.
+		/// </summary>
+		/// <param name="maxTrackedAllocations">- The most allocations that can be tracked at once.</param>
+		/// <returns>True on success.</returns>
+		bool Reserve(size_t maxTrackedAllocations = s_kDefaultMaxTrackedAllocations);
+
+		/// <summary>
+		/// Capture the call stack of one in every sampleRate allocations,
+		/// reported alongside leaks. 0 disables capturing, 1 captures all.
+		/// </summary>
+		void SetCallStackSampleRate(uint32_t sampleRate) { m_callStackSampleRate = sampleRate; }
+
+		/// <summary>
+		/// Report the size and tag of tracked allocations to the stats.
+		/// Set before the first allocation.
+		/// </summary>
+		void SetMemoryStats(MemoryStats* pStats) { m_pStats = pStats; }
+
+		/// <summary>
+		/// Write every tracked allocation and free to a file of AllocationTraceRecords,
+		/// in the order they happen, until StopRecording is called. The benchmarks
+		/// replay these traces to compare allocators on the engine's real workload.
+		/// </summary>
+		/// <param name="pFilePath">- The file to write, overwritten if it exists.</param>
+		/// <returns>True if the file was opened.</returns>
+		bool StartRecording(const char* pFilePath);
+		void StopRecording();
+
 		virtual void* Allocate(size_t sizeToAllocate, size_t memoryAlignment, const char* pFileName, int lineNum) final override;
 
 		virtual void Free(void* memoryToFree, size_t sizeToFree, bool) final override;
 
 		virtual void DumpMemoryData() final override;
+
+	private:
+		size_t GetHomeSlot(uintptr_t memoryAddress) const;
+
+		/// <summary>
+		/// Remove the entry in the slot, shifting back any entries that probed past it.
+		/// </summary>
+		void RemoveSlot(size_t slot);
+
+		/// <summary>
+		/// Capture the calling thread's stack into a free call stack slot.
+		/// Must be called with m_lock held.
+		/// </summary>
+		/// <returns>The slot, or s_kNoCallStack if none are free.</returns>
+		uint32_t StoreCallStack(void* const* ppFrames, uint32_t frameCount);
+		void ReleaseCallStack(uint32_t callStackIndex);
+
+		/// <summary>
+		/// Must be called with m_lock held, so records are written in the order the table changes.
+		/// </summary>
+		void RecordTraceEvent(uintptr_t memoryAddress, size_t size, size_t memoryAlignment, MemoryTag tag, bool isFree);
 	};
-}
\ No newline at end of file
+}
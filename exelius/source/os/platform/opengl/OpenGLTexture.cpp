@@ -39,54 +39,107 @@ namespace Exelius
 		, m_internalFormat(0)
 		, m_dataFormat(0)
 	{
+		TextureImage image;
+		if (DecodeImage(data, image))
+			Create(image);
+	}
+
+	OpenGLTexture::OpenGLTexture(const TextureImage& image)
+		: m_isLoaded(false)
+		, m_width(0)
+		, m_height(0)
+		, m_rendererID(0)
+		, m_internalFormat(0)
+		, m_dataFormat(0)
+	{
+		Create(image);
+	}
+
+	bool OpenGLTexture::DecodeImage(const eastl::vector<std::byte>& data, TextureImage& image)
+	{
+		// The flag is global to stb_image, so set it once rather than on every decoding thread.
+		static const bool s_kFlipOnLoad = []()
+			{
+				stbi_set_flip_vertically_on_load(1);
+				return true;
+			}();
+		(void)s_kFlipOnLoad;
+
 		int width, height, channels;
-		stbi_set_flip_vertically_on_load(1);
-		stbi_uc* stbiData = nullptr;
+		stbi_uc* stbiData = stbi_load_from_memory((const stbi_uc*)(data.data()), (int)data.size(), &width, &height, &channels, 0);
+		if (!stbiData)
+			return false;
+
+		if (channels != 3 && channels != 4)
 		{
-			stbiData = (stbi_uc*)(data.data());
-			stbiData = stbi_load_from_memory(stbiData, (int)data.size(), &width, &height, &channels, 0);
+			EXE_LOG_CATEGORY_WARN("OpenGLTexture", "Format not supported! Images must have 3 or 4 channels, not {}.", channels);
+			stbi_image_free(stbiData);
+			return false;
 		}
 
-		if (stbiData)
+		image.m_width = width;
+		image.m_height = height;
+		image.m_channels = channels;
+
+		const size_t pixelBytes = (size_t)width * (size_t)height * (size_t)channels;
+		image.m_pixels.resize(pixelBytes);
+		::memcpy(image.m_pixels.data(), stbiData, pixelBytes);
+
+		stbi_image_free(stbiData);
+		return true;
+	}
+
+	void OpenGLTexture::Create(const TextureImage& image)
+	{
+		GLenum internalFormat = 0, dataFormat = 0;
+		if (image.m_channels == 4)
+		{
+			internalFormat = GL_RGBA8;
+			dataFormat = GL_RGBA;
+		}
+		else if (image.m_channels == 3)
 		{
-			m_isLoaded = true;
+			internalFormat = GL_RGB8;
+			dataFormat = GL_RGB;
+		}
 
-			m_width = width;
-			m_height = height;
+		if (!(internalFormat & dataFormat))
+		{
+			EXE_LOG_CATEGORY_FATAL("OpenGLTexture", "Format not supported!");
+			EXE_ASSERT(false);
+			return;
+		}
 
-			GLenum internalFormat = 0, dataFormat = 0;
-			if (channels == 4)
-			{
-				internalFormat = GL_RGBA8;
-				dataFormat = GL_RGBA;
-			}
-			else if (channels == 3)
-			{
-				internalFormat = GL_RGB8;
-				dataFormat = GL_RGB;
-			}
+		m_isLoaded = true;
 
-			m_internalFormat = internalFormat;
-			m_dataFormat = dataFormat;
+		m_width = image.m_width;
+		m_height = image.m_height;
 
-			if (!(internalFormat & dataFormat))
-			{
-				EXE_LOG_CATEGORY_FATAL("OpenGLTexture", "Format not supported!");
-				EXE_ASSERT(false);
-			}
+		m_internalFormat = internalFormat;
+		m_dataFormat = dataFormat;
 
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererID);
-			glTextureStorage2D(m_rendererID, 1, internalFormat, m_width, m_height);
+		const uint32_t mipCount = eastl::max(image.m_mipCount, 1u);
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_rendererID);
+		glTextureStorage2D(m_rendererID, mipCount, internalFormat, m_width, m_height);
 
-			glTextureParameteri(m_rendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTextureParameteri(m_rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTextureParameteri(m_rendererID, GL_TEXTURE_MIN_FILTER, mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+		glTextureParameteri(m_rendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-			glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_rendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-			glTextureSubImage2D(m_rendererID, 0, 0, 0, m_width, m_height, dataFormat, GL_UNSIGNED_BYTE, stbiData);
+		// Cooked images carry their mip levels, back to back after the full size image.
+		const std::byte* pLevelPixels = image.m_pixels.data();
+		uint32_t levelWidth = m_width;
+		uint32_t levelHeight = m_height;
+		for (uint32_t mipLevel = 0; mipLevel < mipCount; ++mipLevel)
+		{
+			glTextureSubImage2D(m_rendererID, mipLevel, 0, 0, levelWidth, levelHeight, dataFormat, GL_UNSIGNED_BYTE, pLevelPixels);
 
-			stbi_image_free(stbiData);
+			pLevelPixels += static_cast<size_t>(levelWidth) * levelHeight * image.m_channels;
+			levelWidth = eastl::max(levelWidth / 2, 1u);
+			levelHeight = eastl::max(levelHeight / 2, 1u);
 		}
 	}
 
@@ -13,6 +13,7 @@ typedef unsigned int GLenum;
 namespace Exelius
 {
 	FORWARD_DECLARE(Texture);
+	struct TextureImage;
 
 	class OpenGLTexture
 	{
@@ -27,8 +28,11 @@ namespace Exelius
 	public:
 		OpenGLTexture(uint32_t width, uint32_t height);
 		OpenGLTexture(eastl::vector<std::byte>&& data);
+		OpenGLTexture(const TextureImage& image);
 		~OpenGLTexture();
 
+		static bool DecodeImage(const eastl::vector<std::byte>& data, TextureImage& image);
+
 		uint32_t GetWidth() const;
 		uint32_t GetHeight() const;
 		uint32_t GetRendererID() const;
@@ -41,5 +45,8 @@ namespace Exelius
 		bool IsLoaded() const;
 
 		bool operator==(const Texture& other) const;
+
+	private:
+		void Create(const TextureImage& image);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "EXEPCH.h"
+#include "Coroutines.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+    CoroutineScheduler::CoroutineScheduler()
+        : m_mainThreadID(std::this_thread::get_id())
+    {
+        //
+    }
+
+    CoroutineScheduler::~CoroutineScheduler()
+    {
+        std::lock_guard<std::mutex> lock(m_queueLock);
+
+        for (std::coroutine_handle<> handle : m_mainThreadQueue)
+            handle.destroy();
+        m_mainThreadQueue.clear();
+
+        for (ScheduledCoroutine& scheduled : m_nextFrameQueue)
+            scheduled.m_handle.destroy();
+        m_nextFrameQueue.clear();
+    }
+
+    void CoroutineScheduler::Resume(std::coroutine_handle<> handle, ResumeOn resumeOn)
+    {
+        EXE_ASSERT(handle);
+
+        if (resumeOn == ResumeOn::kWorker && s_pGlobalJobSystem)
+        {
+            s_pGlobalJobSystem->PushJob([handle]() { handle.resume(); });
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_mainThreadQueue.emplace_back(handle);
+    }
+
+    void CoroutineScheduler::ResumeNextFrame(std::coroutine_handle<> handle, ResumeOn resumeOn)
+    {
+        EXE_ASSERT(handle);
+
+        std::lock_guard<std::mutex> lock(m_queueLock);
+        m_nextFrameQueue.push_back({ handle, resumeOn });
+    }
+
+    void CoroutineScheduler::ProcessFrame()
+    {
+        EXE_ASSERT(IsMainThread());
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueLock);
+            m_activeNextFrameQueue.swap(m_nextFrameQueue);
+        }
+
+        // Anything that awaits the next frame again from here lands in the fresh queue.
+        for (ScheduledCoroutine& scheduled : m_activeNextFrameQueue)
+        {
+            Resume(scheduled.m_handle, scheduled.m_resumeOn);
+        }
+        m_activeNextFrameQueue.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(m_queueLock);
+            m_activeMainThreadQueue.swap(m_mainThreadQueue);
+        }
+
+        for (std::coroutine_handle<> handle : m_activeMainThreadQueue)
+        {
+            handle.resume();
+        }
+        m_activeMainThreadQueue.clear();
+    }
+}
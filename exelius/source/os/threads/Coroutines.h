@@ -0,0 +1,249 @@
+#pragma once
+#include "source/os/threads/JobSystem.h"
+#include "source/utility/generic/Singleton.h"
+
+#include <EASTL/vector.h>
+#include <coroutine>
+#include <mutex>
+#include <thread>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Where a suspended coroutine continues once the thing it awaited is ready.
+	/// </summary>
+	enum class ResumeOn : uint8_t
+	{
+		kWorker,		// Pushed to the job system as a job. Usually picked up by a worker, but any thread helping the job system may run it.
+		kMainThread		// Resumed by the main thread, at the start of the next frame.
+	};
+
+	/// <summary>
+	/// Return type for fire-and-forget coroutines.
+	///
+	/// The coroutine starts executing immediately on the calling thread, runs
+	/// until its first suspension, and destroys itself when it completes.
+	/// Anything it references must outlive it.
+	///
+	/// @code{.cpp}
+	/// Exelius::Task SpawnLevel()
+	/// {
+	///		Exelius::ResourceHandle texture = co_await Exelius::LoadResourceAsync("Textures/Tiles.png", Exelius::ResumeOn::kWorker);
+	///		Exelius::JobCounter counter;
+	///		BuildAtlas(texture, counter);
+	///		co_await Exelius::WaitForCounterAsync(counter, Exelius::ResumeOn::kMainThread);
+	///		SpawnObjects();
+	/// }
+	/// @endcode
+	/// </summary>
+	class Task
+	{
+	public:
+		struct promise_type
+		{
+			Task get_return_object() noexcept { return Task(); }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() noexcept {}
+
+			void unhandled_exception() noexcept
+			{
+				// Exceptions are not used by the engine.
+				EXE_ASSERT(false);
+			}
+		};
+	};
+
+	/// <summary>
+	/// Resumes suspended coroutines on the requested thread.
+	///
+	/// Worker resumes are pushed straight to the job system. Main thread
+	/// resumes are queued and run by ProcessFrame(), which the Application
+	/// calls once at the start of every frame.
+	/// </summary>
+	class CoroutineScheduler
+		: public Singleton<CoroutineScheduler>
+	{
+		struct ScheduledCoroutine
+		{
+			std::coroutine_handle<> m_handle;
+			ResumeOn m_resumeOn;
+		};
+
+		/// <summary>
+		/// Coroutines waiting for the main thread.
+		/// </summary>
+		eastl::vector<std::coroutine_handle<>> m_mainThreadQueue;
+
+		/// <summary>
+		/// Coroutines waiting for the next frame to begin.
+		/// </summary>
+		eastl::vector<ScheduledCoroutine> m_nextFrameQueue;
+
+		std::mutex m_queueLock;
+
+		/// <summary>
+		/// Swapped with the queues each frame, so resumed coroutines can queue again.
+		/// </summary>
+		eastl::vector<std::coroutine_handle<>> m_activeMainThreadQueue;
+		eastl::vector<ScheduledCoroutine> m_activeNextFrameQueue;
+
+		std::thread::id m_mainThreadID;
+
+	public:
+		/// <summary>
+		/// Must be constructed on the main thread.
+		/// </summary>
+		CoroutineScheduler();
+		CoroutineScheduler(const CoroutineScheduler&) = delete;
+		CoroutineScheduler(CoroutineScheduler&&) = delete;
+		CoroutineScheduler& operator=(const CoroutineScheduler&) = delete;
+		CoroutineScheduler& operator=(CoroutineScheduler&&) = delete;
+
+		/// <summary>
+		/// Destroys any coroutines that are still queued.
+		/// </summary>
+		~CoroutineScheduler();
+
+		/// <summary>
+		/// Resume a suspended coroutine on the requested thread. May be called from any thread.
+		/// </summary>
+		void Resume(std::coroutine_handle<> handle, ResumeOn resumeOn);
+
+		/// <summary>
+		/// Resume a suspended coroutine on the requested thread once the next frame begins.
+		/// </summary>
+		void ResumeNextFrame(std::coroutine_handle<> handle, ResumeOn resumeOn);
+
+		/// <summary>
+		/// Release the coroutines waiting on the frame, then resume the
+		/// coroutines waiting on the main thread. Called by the Application
+		/// once per frame, on the main thread.
+		/// </summary>
+		void ProcessFrame();
+
+		/// <summary>
+		/// True if called from the thread that constructed the scheduler.
+		/// </summary>
+		bool IsMainThread() const { return std::this_thread::get_id() == m_mainThreadID; }
+	};
+
+	/// <summary>
+	/// Awaits a JobCounter without blocking a thread.
+	/// @see WaitForCounterAsync
+	/// </summary>
+	class JobCounterAwaiter
+		: private JobCounterWaiter
+	{
+		JobCounter& m_counter;
+		std::coroutine_handle<> m_handle;
+		ResumeOn m_resumeOn;
+
+	public:
+		JobCounterAwaiter(JobCounter& counter, ResumeOn resumeOn)
+			: m_counter(counter)
+			, m_handle()
+			, m_resumeOn(resumeOn)
+		{
+			//
+		}
+
+		bool await_ready() const { return m_counter.IsComplete(); }
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			m_handle = handle;
+			m_pResume = &JobCounterAwaiter::ResumeWaiter;
+
+			// If the counter completed in the meantime, continue without suspending.
+			return m_counter.TryAddWaiter(*this);
+		}
+
+		void await_resume() const {}
+
+	private:
+		static void ResumeWaiter(JobCounterWaiter* pWaiter)
+		{
+			JobCounterAwaiter* pAwaiter = static_cast<JobCounterAwaiter*>(pWaiter);
+			CoroutineScheduler::GetInstance()->Resume(pAwaiter->m_handle, pAwaiter->m_resumeOn);
+		}
+	};
+
+	/// <summary>
+	/// Suspends until the next frame begins.
+	/// @see NextFrame
+	/// </summary>
+	class NextFrameAwaiter
+	{
+		ResumeOn m_resumeOn;
+
+	public:
+		explicit NextFrameAwaiter(ResumeOn resumeOn)
+			: m_resumeOn(resumeOn)
+		{
+			//
+		}
+
+		bool await_ready() const { return false; }
+		void await_suspend(std::coroutine_handle<> handle) const { CoroutineScheduler::GetInstance()->ResumeNextFrame(handle, m_resumeOn); }
+		void await_resume() const {}
+	};
+
+	/// <summary>
+	/// Moves the coroutine onto the requested thread, or continues
+	/// without suspending if it is already there.
+	/// @see SwitchTo
+	/// </summary>
+	class SwitchThreadAwaiter
+	{
+		ResumeOn m_resumeOn;
+
+	public:
+		explicit SwitchThreadAwaiter(ResumeOn resumeOn)
+			: m_resumeOn(resumeOn)
+		{
+			//
+		}
+
+		bool await_ready() const
+		{
+			if (m_resumeOn == ResumeOn::kMainThread)
+				return CoroutineScheduler::GetInstance()->IsMainThread();
+			return s_pGlobalJobSystem && s_pGlobalJobSystem->IsWorkerThread();
+		}
+
+		void await_suspend(std::coroutine_handle<> handle) const { CoroutineScheduler::GetInstance()->Resume(handle, m_resumeOn); }
+		void await_resume() const {}
+	};
+
+	/// <summary>
+	/// co_await until every job pushed with the counter has completed.
+	/// </summary>
+	/// <param name="counter">- The counter to wait on. Must outlive the wait.</param>
+	/// <param name="resumeOn">- The thread to continue on.</param>
+	inline JobCounterAwaiter WaitForCounterAsync(JobCounter& counter, ResumeOn resumeOn = ResumeOn::kWorker)
+	{
+		return JobCounterAwaiter(counter, resumeOn);
+	}
+
+	/// <summary>
+	/// co_await until the start of the next frame.
+	/// </summary>
+	/// <param name="resumeOn">- The thread to continue on.</param>
+	inline NextFrameAwaiter NextFrame(ResumeOn resumeOn = ResumeOn::kMainThread)
+	{
+		return NextFrameAwaiter(resumeOn);
+	}
+
+	/// <summary>
+	/// co_await to continue on a worker, or on the main thread.
+	/// </summary>
+	/// <param name="resumeOn">- The thread to continue on.</param>
+	inline SwitchThreadAwaiter SwitchTo(ResumeOn resumeOn)
+	{
+		return SwitchThreadAwaiter(resumeOn);
+	}
+}
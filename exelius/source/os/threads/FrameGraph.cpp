@@ -0,0 +1,207 @@
+#include "EXEPCH.h"
+#include "FrameGraph.h"
+
+#include <thread>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+    FrameGraph::FrameGraph()
+        : m_remainingStages(0)
+        , m_lastFrameDuration(0)
+        , m_logCriticalPath(false)
+    {
+        //
+    }
+
+    FrameStageHandle FrameGraph::AddStage(const char* pName, StageFunction function, FrameStageAffinity affinity, std::initializer_list<FrameStageHandle> dependencies)
+    {
+        EXE_ASSERT(pName);
+        EXE_ASSERT(function);
+        EXE_ASSERT(m_remainingStages.load(std::memory_order_relaxed) == 0);
+
+        const FrameStageHandle handle = static_cast<FrameStageHandle>(m_stages.size());
+
+        UniquePtr<Stage> pStage = MakeUnique<Stage>();
+        pStage->m_name = pName;
+        pStage->m_function = eastl::move(function);
+        pStage->m_affinity = affinity;
+
+        for (FrameStageHandle dependency : dependencies)
+        {
+            // Only existing stages can be depended on, which keeps the graph acyclic.
+            EXE_ASSERT(dependency < handle);
+            pStage->m_dependencies.emplace_back(dependency);
+            m_stages[dependency]->m_dependents.emplace_back(handle);
+        }
+
+        m_stages.emplace_back(eastl::move(pStage));
+        return handle;
+    }
+
+    FrameStageHandle FrameGraph::FindStage(const char* pName) const
+    {
+        EXE_ASSERT(pName);
+
+        for (FrameStageHandle handle = 0; handle < static_cast<FrameStageHandle>(m_stages.size()); ++handle)
+        {
+            if (m_stages[handle]->m_name == pName)
+                return handle;
+        }
+
+        return s_kInvalidStage;
+    }
+
+    void FrameGraph::Execute()
+    {
+        if (m_stages.empty())
+            return;
+
+        m_frameTimer.Start();
+        m_remainingStages.store(static_cast<uint32_t>(m_stages.size()), std::memory_order_relaxed);
+
+        for (auto& pStage : m_stages)
+        {
+            pStage->m_pendingDependencies.store(static_cast<uint32_t>(pStage->m_dependencies.size()), std::memory_order_relaxed);
+            pStage->m_startTime = 0;
+            pStage->m_endTime = 0;
+        }
+
+        for (FrameStageHandle handle = 0; handle < static_cast<FrameStageHandle>(m_stages.size()); ++handle)
+        {
+            if (m_stages[handle]->m_dependencies.empty())
+                ScheduleStage(handle);
+        }
+
+        while (m_remainingStages.load(std::memory_order_acquire) != 0)
+        {
+            const FrameStageHandle handle = PopReadyMainThreadStage();
+            if (handle != s_kInvalidStage)
+            {
+                RunStage(handle);
+            }
+            else if (s_pGlobalJobSystem)
+            {
+                // Nothing for the main thread yet, help with the any-thread stages.
+                s_pGlobalJobSystem->CycleThread();
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        // The last any-thread stage signals completion from inside its job,
+        // so let the job retire before the counter is reused next frame.
+        if (s_pGlobalJobSystem)
+            s_pGlobalJobSystem->WaitForCounter(m_jobCounter);
+
+        m_lastFrameDuration = m_frameTimer.GetElapsedTime();
+
+        if (m_logCriticalPath)
+            LogCriticalPath();
+    }
+
+    void FrameGraph::GetStageTimings(eastl::vector<FrameStageTiming>& stageTimings) const
+    {
+        stageTimings.clear();
+        for (const auto& pStage : m_stages)
+            stageTimings.push_back({ pStage->m_name.c_str(), pStage->m_startTime, pStage->m_endTime - pStage->m_startTime });
+    }
+
+    eastl::vector<FrameStageTiming> FrameGraph::GetCriticalPath() const
+    {
+        eastl::vector<FrameStageTiming> criticalPath;
+        if (m_stages.empty())
+            return criticalPath;
+
+        // Start from whichever stage finished last. Ties go to the later stage,
+        // as it may depend on the earlier one but never the other way around.
+        FrameStageHandle current = 0;
+        for (FrameStageHandle handle = 1; handle < static_cast<FrameStageHandle>(m_stages.size()); ++handle)
+        {
+            if (m_stages[handle]->m_endTime >= m_stages[current]->m_endTime)
+                current = handle;
+        }
+
+        while (current != s_kInvalidStage)
+        {
+            const Stage& stage = *m_stages[current];
+            criticalPath.push_back({ stage.m_name.c_str(), stage.m_startTime, stage.m_endTime - stage.m_startTime });
+
+            // The dependency that finished last is the one that held this stage back.
+            FrameStageHandle gatingDependency = s_kInvalidStage;
+            for (FrameStageHandle dependency : stage.m_dependencies)
+            {
+                if (gatingDependency == s_kInvalidStage || m_stages[dependency]->m_endTime > m_stages[gatingDependency]->m_endTime)
+                    gatingDependency = dependency;
+            }
+
+            current = gatingDependency;
+        }
+
+        eastl::reverse(criticalPath.begin(), criticalPath.end());
+        return criticalPath;
+    }
+
+    void FrameGraph::LogCriticalPath() const
+    {
+        const eastl::vector<FrameStageTiming> criticalPath = GetCriticalPath();
+
+        EXE_LOG_CATEGORY_INFO("FrameGraph", "Critical path: {} stages, frame took {}us.", criticalPath.size(), m_lastFrameDuration);
+        for (const FrameStageTiming& timing : criticalPath)
+        {
+            EXE_LOG_CATEGORY_INFO("FrameGraph", "    {} started at {}us, took {}us.", timing.m_pName, timing.m_startTime, timing.m_duration);
+        }
+    }
+
+    void FrameGraph::ScheduleStage(FrameStageHandle handle)
+    {
+        EXE_ASSERT(handle < m_stages.size());
+
+        if (m_stages[handle]->m_affinity == FrameStageAffinity::kMainThread || !s_pGlobalJobSystem)
+        {
+            std::lock_guard<std::mutex> lock(m_readyMainThreadLock);
+            m_readyMainThreadStages.emplace_back(handle);
+            return;
+        }
+
+        // The frame can't end until every stage has run.
+        s_pGlobalJobSystem->PushJob([this, handle]() { RunStage(handle); }, &m_jobCounter, JobPriority::kFrameCritical);
+    }
+
+    void FrameGraph::RunStage(FrameStageHandle handle)
+    {
+        Stage& stage = *m_stages[handle];
+
+        stage.m_startTime = m_frameTimer.GetElapsedTime();
+        {
+            // Stages live as long as the graph, so the name outlives the frame's events.
+            ScopedProfileEvent stageEvent(stage.m_name.c_str());
+            stage.m_function();
+        }
+        stage.m_endTime = m_frameTimer.GetElapsedTime();
+
+        for (FrameStageHandle dependent : stage.m_dependents)
+        {
+            if (m_stages[dependent]->m_pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                ScheduleStage(dependent);
+        }
+
+        m_remainingStages.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    FrameStageHandle FrameGraph::PopReadyMainThreadStage()
+    {
+        std::lock_guard<std::mutex> lock(m_readyMainThreadLock);
+        if (m_readyMainThreadStages.empty())
+            return s_kInvalidStage;
+
+        // Oldest first, so stages run in the order they became ready.
+        const FrameStageHandle handle = m_readyMainThreadStages.front();
+        m_readyMainThreadStages.erase(m_readyMainThreadStages.begin());
+        return handle;
+    }
+}
@@ -0,0 +1,193 @@
+#pragma once
+#include "source/utility/generic/SmartPointers.h"
+#include "source/utility/generic/Timing.h"
+#include "source/os/threads/JobSystem.h"
+
+#include <EASTL/functional.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Identifies a stage within a FrameGraph. Returned by FrameGraph::AddStage.
+	/// </summary>
+	using FrameStageHandle = uint32_t;
+
+	/// <summary>
+	/// Which threads a frame stage is allowed to execute on.
+	/// </summary>
+	enum class FrameStageAffinity : uint8_t
+	{
+		kAnyThread,		// Pushed to the job system. May run on any worker, or on the main thread while it waits.
+		kMainThread		// Only ever run on the thread calling FrameGraph::Execute. Use for windowing, rendering and ImGui.
+	};
+
+	/// <summary>
+	/// Timing of a single stage during the last executed frame.
+	/// Times are in microseconds, relative to the start of the frame.
+	/// </summary>
+	struct FrameStageTiming
+	{
+		const char* m_pName = nullptr;
+		int64_t m_startTime = 0;
+		int64_t m_duration = 0;
+	};
+
+	/// <summary>
+	/// Declarative graph of the work executed each frame.
+	///
+	/// Each stage declares the stages it depends on, and runs as soon as all of
+	/// them have completed. Stages with no dependency between them may overlap,
+	/// any-thread stages running on the job system while the main thread works
+	/// through the main-thread stages.
+	///
+	/// Dependencies must be added before the stages that depend on them, so a
+	/// graph can never contain a cycle.
+	///
+	/// After each frame the graph can report its critical path: starting at the
+	/// stage that finished last, follow the dependency that finished last, back
+	/// to the start of the frame. That chain is what actually bounded the frame.
+	///
+	/// @code{.cpp}
+	/// FrameGraph graph;
+	/// FrameStageHandle update = graph.AddStage("Update", [&]() { Update(); }, FrameStageAffinity::kMainThread);
+	/// graph.AddStage("Audio", [&]() { MixAudio(); }, FrameStageAffinity::kAnyThread);
+	/// graph.AddStage("Render", [&]() { Render(); }, FrameStageAffinity::kMainThread, { update });
+	/// graph.Execute();
+	/// @endcode
+	/// </summary>
+	class FrameGraph
+	{
+	public:
+		using StageFunction = eastl::function<void()>;
+
+		static constexpr FrameStageHandle s_kInvalidStage = static_cast<FrameStageHandle>(-1);
+
+	private:
+		struct Stage
+		{
+			eastl::string m_name;
+			StageFunction m_function;
+			FrameStageAffinity m_affinity = FrameStageAffinity::kAnyThread;
+
+			eastl::vector<FrameStageHandle> m_dependencies;
+			eastl::vector<FrameStageHandle> m_dependents;
+
+			/// <summary>
+			/// Dependencies that have not completed yet this frame.
+			/// </summary>
+			std::atomic<uint32_t> m_pendingDependencies = 0;
+
+			int64_t m_startTime = 0;
+			int64_t m_endTime = 0;
+		};
+
+		/// <summary>
+		/// Stages are heap allocated as they hold atomics, which cannot be moved.
+		/// </summary>
+		eastl::vector<UniquePtr<Stage>> m_stages;
+
+		/// <summary>
+		/// Main-thread stages whose dependencies have all completed.
+		/// </summary>
+		eastl::vector<FrameStageHandle> m_readyMainThreadStages;
+		std::mutex m_readyMainThreadLock;
+
+		/// <summary>
+		/// Stages that have not completed yet this frame.
+		/// </summary>
+		std::atomic<uint32_t> m_remainingStages;
+
+		/// <summary>
+		/// Tracks the any-thread stages pushed to the job system.
+		/// </summary>
+		JobCounter m_jobCounter;
+
+		Timer m_frameTimer;
+		int64_t m_lastFrameDuration;
+		bool m_logCriticalPath;
+
+	public:
+		FrameGraph();
+		FrameGraph(const FrameGraph&) = delete;
+		FrameGraph(FrameGraph&&) = delete;
+		FrameGraph& operator=(const FrameGraph&) = delete;
+		FrameGraph& operator=(FrameGraph&&) = delete;
+
+		/// <summary>
+		/// Add a stage to the graph. Must not be called while the graph is executing.
+		/// </summary>
+		/// <param name="pName">- Name used when reporting timings.</param>
+		/// <param name="function">- The work to execute once per frame.</param>
+		/// <param name="affinity">- The threads the stage is allowed to run on.</param>
+		/// <param name="dependencies">- Stages that must complete before this one starts.</param>
+		/// <returns>Handle used to depend on this stage.</returns>
+		FrameStageHandle AddStage(const char* pName, StageFunction function, FrameStageAffinity affinity, std::initializer_list<FrameStageHandle> dependencies = {});
+
+		/// <summary>
+		/// Find a stage by name.
+		/// </summary>
+		/// <returns>The stage handle, or s_kInvalidStage if not found.</returns>
+		FrameStageHandle FindStage(const char* pName) const;
+
+		/// <summary>
+		/// Execute every stage once, blocking until all have completed.
+		/// Main-thread stages run on the calling thread, which also helps
+		/// the job system while it waits for any-thread stages.
+		/// </summary>
+		void Execute();
+
+		/// <summary>
+		/// The timing of every stage during the last executed frame, in the order they were added.
+		/// </summary>
+		/// <param name="stageTimings">- Cleared, then filled. Pass the same vector every frame to avoid allocating.</param>
+		void GetStageTimings(eastl::vector<FrameStageTiming>& stageTimings) const;
+
+		size_t GetStageCount() const { return m_stages.size(); }
+
+		/// <summary>
+		/// The critical path of the last executed frame, in execution order.
+		/// </summary>
+		eastl::vector<FrameStageTiming> GetCriticalPath() const;
+
+		/// <summary>
+		/// Log the critical path of the last executed frame.
+		/// </summary>
+		void LogCriticalPath() const;
+
+		/// <summary>
+		/// Log the critical path after every executed frame.
+		/// </summary>
+		void SetCriticalPathLoggingEnabled(bool enabled) { m_logCriticalPath = enabled; }
+		bool IsCriticalPathLoggingEnabled() const { return m_logCriticalPath; }
+
+		/// <summary>
+		/// Duration of the last executed frame in microseconds.
+		/// </summary>
+		int64_t GetLastFrameDuration() const { return m_lastFrameDuration; }
+
+	private:
+		/// <summary>
+		/// Queue a stage whose dependencies have all completed.
+		/// </summary>
+		void ScheduleStage(FrameStageHandle handle);
+
+		/// <summary>
+		/// Run a stage, then schedule any dependents it was the last dependency of.
+		/// </summary>
+		void RunStage(FrameStageHandle handle);
+
+		/// <summary>
+		/// Pop a ready main-thread stage.
+		/// </summary>
+		/// <returns>The stage handle, or s_kInvalidStage if none are ready.</returns>
+		FrameStageHandle PopReadyMainThreadStage();
+	};
+}
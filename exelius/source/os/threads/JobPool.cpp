@@ -0,0 +1,80 @@
+#include "EXEPCH.h"
+#include "JobPool.h"
+#include "JobSystem.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+    JobPool::JobPool()
+        : m_pLocalFreeList(nullptr)
+        , m_pRemoteFreeList(nullptr)
+    {
+        //
+    }
+
+    JobPool::~JobPool()
+    {
+        m_pLocalFreeList = nullptr;
+        m_pRemoteFreeList = nullptr;
+
+        for (Job* pChunk : m_chunks)
+        {
+            EXELIUS_DELETE_ARRAY(pChunk);
+        }
+        m_chunks.clear();
+    }
+
+    Job* JobPool::Allocate()
+    {
+        if (!m_pLocalFreeList)
+        {
+            // Reclaim everything other threads have handed back in one go.
+            // Taking the whole list avoids the ABA problem of popping single nodes.
+            m_pLocalFreeList = m_pRemoteFreeList.exchange(nullptr, std::memory_order_acquire);
+
+            if (!m_pLocalFreeList)
+                AllocateNewChunk();
+        }
+
+        Job* pJob = m_pLocalFreeList;
+        m_pLocalFreeList = pJob->m_pNext;
+        pJob->m_pNext = nullptr;
+        return pJob;
+    }
+
+    void JobPool::Free(Job* pJob, bool isOwningThread)
+    {
+        EXE_ASSERT(pJob);
+        EXE_ASSERT(pJob->m_pOwnerPool == this);
+
+        if (isOwningThread)
+        {
+            pJob->m_pNext = m_pLocalFreeList;
+            m_pLocalFreeList = pJob;
+            return;
+        }
+
+        Job* pHead = m_pRemoteFreeList.load(std::memory_order_relaxed);
+        do
+        {
+            pJob->m_pNext = pHead;
+        } while (!m_pRemoteFreeList.compare_exchange_weak(pHead, pJob, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    void JobPool::AllocateNewChunk()
+    {
+        Job* pChunk = EXELIUS_NEW_ARRAY(Job, s_kJobsPerChunk);
+        EXE_ASSERT(pChunk);
+        m_chunks.emplace_back(pChunk);
+
+        // Thread the new jobs onto the local free list.
+        for (size_t i = 0; i < s_kJobsPerChunk; ++i)
+        {
+            pChunk[i].m_pOwnerPool = this;
+            pChunk[i].m_pNext = m_pLocalFreeList;
+            m_pLocalFreeList = &pChunk[i];
+        }
+    }
+}
\ No newline at end of file
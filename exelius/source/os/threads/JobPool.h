@@ -0,0 +1,68 @@
+#pragma once
+#include <EASTL/vector.h>
+#include <atomic>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	class Job;
+
+	/// <summary>
+	/// Recycled pool of fixed-size Job objects owned by a single thread.
+	///
+	/// Only the owning thread allocates from the pool. Jobs are usually
+	/// executed (and freed) on a different thread than the one that pushed
+	/// them, so frees from other threads are pushed onto a lock-free
+	/// "remote" list. The owner reclaims that whole list in one exchange
+	/// when its local free list runs dry. Memory is only requested from the
+	/// global allocator when both lists are empty, one chunk at a time.
+	/// </summary>
+	class JobPool
+	{
+		/// <summary>
+		/// The number of jobs in each chunk requested from the global allocator.
+		/// </summary>
+		static constexpr size_t s_kJobsPerChunk = 256;
+
+		/// <summary>
+		/// Jobs freed by the owning thread. Only touched by the owner.
+		/// </summary>
+		Job* m_pLocalFreeList;
+
+		/// <summary>
+		/// Jobs freed by any other thread.
+		/// </summary>
+		std::atomic<Job*> m_pRemoteFreeList;
+
+		/// <summary>
+		/// Every chunk this pool has allocated, released on destruction.
+		/// </summary>
+		eastl::vector<Job*> m_chunks;
+
+	public:
+		JobPool();
+		JobPool(const JobPool&) = delete;
+		JobPool(JobPool&&) = delete;
+		JobPool& operator=(const JobPool&) = delete;
+		JobPool& operator=(JobPool&&) = delete;
+		~JobPool();
+
+		/// <summary>
+		/// Retrieve an unused job. Must only be called by the owning thread.
+		/// </summary>
+		/// <returns>A job owned by this pool. Never nullptr.</returns>
+		Job* Allocate();
+
+		/// <summary>
+		/// Return a job to this pool. May be called from any thread.
+		/// </summary>
+		/// <param name="pJob">- The job to return. Must have been allocated from this pool.</param>
+		/// <param name="isOwningThread">- True if the caller is the thread that owns this pool.</param>
+		void Free(Job* pJob, bool isOwningThread);
+
+	private:
+		void AllocateNewChunk();
+	};
+}
\ No newline at end of file
@@ -1,52 +1,303 @@
 #include "EXEPCH.h"
 #include "JobSystem.h"
 
+#ifdef EXE_WINDOWS
+#include <Windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+    /// <summary>
+    /// Index of the worker owning the calling thread. -1 for threads that are not workers.
+    /// </summary>
+    static thread_local int32_t s_workerIndex = -1;
+
+    /// <summary>
+    /// Changes every time a job system is created, so a thread never mistakes
+    /// a new job system for a destroyed one that had the same address.
+    /// </summary>
+    static std::atomic<uint32_t> s_jobSystemGeneration = 0;
+
+    /// <summary>
+    /// The calling thread's job pool, and the generation of the job system that owns it.
+    /// </summary>
+    static thread_local uint32_t s_threadJobPoolGeneration = 0;
+    static thread_local JobPool* s_pThreadJobPool = nullptr;
+
+    /// <summary>
+    /// Open batches on the calling thread, and the jobs pushed within them.
+    /// </summary>
+    static thread_local uint32_t s_batchDepth = 0;
+    static thread_local uint32_t s_batchedJobCount = 0;
+
+    /// <summary>
+    /// How many times an idle worker searches for work before parking.
+    /// Long enough to catch jobs pushed back to back, short enough not to burn a core.
+    /// </summary>
+    static constexpr uint32_t s_kIdleSpinCount = 64;
+
+    /// <summary>
+    /// Restrict the thread to a single core.
+    /// </summary>
+    /// <returns>True on success, false otherwise.</returns>
+    static bool PinThreadToCore(std::thread& thread, uint32_t core)
+    {
+    #ifdef EXE_WINDOWS
+        const DWORD_PTR affinityMask = static_cast<DWORD_PTR>(1) << core;
+        return SetThreadAffinityMask(thread.native_handle(), affinityMask) != 0;
+    #else
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(core, &cpuSet);
+        return pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &cpuSet) == 0;
+    #endif // EXE_WINDOWS
+    }
+
+    bool JobCounter::TryAddWaiter(JobCounterWaiter& waiter)
+    {
+        // Take the waiter lock, unless the counter is already complete.
+        uint32_t count = m_count.load(std::memory_order_acquire);
+        while (true)
+        {
+            if ((count & s_kCountMask) == 0)
+                return false;
+
+            if (count & s_kWaiterLockBit)
+            {
+                std::this_thread::yield();
+                count = m_count.load(std::memory_order_acquire);
+                continue;
+            }
+
+            if (m_count.compare_exchange_weak(count, count | s_kWaiterLockBit, std::memory_order_acquire, std::memory_order_acquire))
+                break;
+        }
+
+        // The final decrement can't happen while we hold the lock.
+        waiter.m_pNext = m_pWaiters;
+        m_pWaiters = &waiter;
+
+        count = m_count.load(std::memory_order_relaxed);
+        while (!m_count.compare_exchange_weak(count, (count | s_kHasWaitersBit) & ~s_kWaiterLockBit, std::memory_order_release, std::memory_order_relaxed))
+        {
+            //
+        }
+
+        return true;
+    }
+
+    void JobCounter::Increment()
+    {
+        m_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void JobCounter::Decrement()
+    {
+        uint32_t count = m_count.load(std::memory_order_relaxed);
+        while (true)
+        {
+            const bool isFinal = (count & s_kCountMask) == 1;
+
+            if (!isFinal || !(count & (s_kHasWaitersBit | s_kWaiterLockBit)))
+            {
+                // The common case, no waiters to hand off.
+                if (m_count.compare_exchange_weak(count, count - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    return;
+                continue;
+            }
+
+            if (count & s_kWaiterLockBit)
+            {
+                // A waiter is being added, let it finish.
+                std::this_thread::yield();
+                count = m_count.load(std::memory_order_relaxed);
+                continue;
+            }
+
+            if (m_count.compare_exchange_weak(count, count | s_kWaiterLockBit, std::memory_order_acquire, std::memory_order_relaxed))
+                break;
+        }
+
+        // We hold the waiter lock. Jobs may still have been pushed in the meantime.
+        JobCounterWaiter* pWaiters = m_pWaiters;
+        count = m_count.load(std::memory_order_relaxed);
+        while (true)
+        {
+            if ((count & s_kCountMask) == 1)
+            {
+                m_pWaiters = nullptr;
+
+                // Clears the count, flag and lock at once. The counter must not be touched after this.
+                if (m_count.compare_exchange_weak(count, 0, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    break;
+                m_pWaiters = pWaiters;
+            }
+            else
+            {
+                // More work arrived, the waiters stay until it completes.
+                if (m_count.compare_exchange_weak(count, (count - 1) & ~s_kWaiterLockBit, std::memory_order_acq_rel, std::memory_order_relaxed))
+                    return;
+            }
+        }
+
+        while (pWaiters)
+        {
+            // Resuming may destroy the waiter.
+            JobCounterWaiter* pNext = pWaiters->m_pNext;
+            EXE_ASSERT(pWaiters->m_pResume);
+            pWaiters->m_pResume(pWaiters);
+            pWaiters = pNext;
+        }
+    }
+
+    void JobSystem::JobList::Push(Job* pJob)
+    {
+        EXE_ASSERT(pJob);
+
+        std::lock_guard<std::mutex> lock(m_lock);
+        pJob->m_pNext = nullptr;
+        if (m_pTail)
+            m_pTail->m_pNext = pJob;
+        else
+            m_pHead = pJob;
+        m_pTail = pJob;
+    }
+
+    Job* JobSystem::JobList::Pop()
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        Job* pJob = m_pHead;
+        if (!pJob)
+            return nullptr;
+
+        m_pHead = pJob->m_pNext;
+        if (!m_pHead)
+            m_pTail = nullptr;
+        pJob->m_pNext = nullptr;
+        return pJob;
+    }
+
+    void JobSystem::SharedJobQueue::Push(Job* pJob)
+    {
+        EXE_ASSERT(pJob);
+
+        if (m_jobs.PushBack(pJob))
+            return;
+
+        m_overflowCount.fetch_add(1, std::memory_order_relaxed);
+        m_overflow.Push(pJob);
+    }
+
+    Job* JobSystem::SharedJobQueue::Pop()
+    {
+        Job* pJob = nullptr;
+        if (m_jobs.PopFront(pJob))
+            return pJob;
+
+        // Only take the lock if something has actually spilled.
+        if (m_overflowCount.load(std::memory_order_relaxed) == 0)
+            return nullptr;
+
+        pJob = m_overflow.Pop();
+        if (pJob)
+            m_overflowCount.fetch_sub(1, std::memory_order_relaxed);
+        return pJob;
+    }
+
+    size_t JobSystem::SharedJobQueue::GetSizeApprox() const
+    {
+        return m_jobs.GetSizeApprox() + m_overflowCount.load(std::memory_order_relaxed);
+    }
+
     JobSystem::JobSystem()
-        : m_jobCounter(0)
+        : m_mainThreadID(std::this_thread::get_id())
+        , m_generation(s_jobSystemGeneration.fetch_add(1, std::memory_order_relaxed) + 1)
+        , m_wakeEpoch(0)
+        , m_sleepingWorkers(0)
+        , m_runningBackgroundJobs(0)
+        , m_maxBackgroundJobs(0)
+        , m_isRunning(false)
+        , m_jobCounter(0)
         , m_threadCount(0)
     {
         //
     }
 
-    bool JobSystem::Initialize()
+    JobSystem::~JobSystem()
     {
-        m_threadCount = static_cast<uint8_t>(std::thread::hardware_concurrency() - 1);
+        WaitForAllJobs();
 
+        m_isRunning.store(false, std::memory_order_seq_cst);
+        m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+        m_wakeEpoch.notify_all();
+
+        for (std::thread& worker : m_workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+        m_workers.clear();
+    }
+
+    bool JobSystem::Initialize(bool pinWorkersToCores)
+    {
+        m_mainThreadID = std::this_thread::get_id();
+
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        m_threadCount = static_cast<uint8_t>((hardwareThreads > 1) ? eastl::min(hardwareThreads - 1, 255U) : 1U);
+
+        // Always leave a worker free for frame work, unless there is only one.
+        m_maxBackgroundJobs = (m_threadCount > 1) ? m_threadCount - 1U : 1U;
+
+        // All the deques must exist before any worker starts stealing.
+        for (auto& workerQueues : m_workerQueues)
+        {
+            workerQueues.reserve(m_threadCount);
+            for (uint8_t threadID = 0; threadID < m_threadCount; ++threadID)
+            {
+                workerQueues.emplace_back(MakeUnique<JobQueue>());
+            }
+        }
+
+        m_isRunning.store(true, std::memory_order_release);
+
+        m_workers.reserve(m_threadCount);
         for (uint8_t threadID = 0; threadID < m_threadCount; ++threadID)
         {
-            std::thread worker(&JobSystem::ExecuteJob, this);
+            m_workers.emplace_back(&JobSystem::ExecuteJob, this, threadID);
 
-            // Not super ideal, might be better to create
-            // and size a fixed sized array of threads.
-            worker.detach();
+            // Core 0 is left to the main thread.
+            if (pinWorkersToCores && hardwareThreads > 1)
+            {
+                if (!PinThreadToCore(m_workers.back(), (threadID + 1U) % hardwareThreads))
+                    EXE_LOG_CATEGORY_WARN("JobSystem", "Failed to pin worker {} to a core.", threadID);
+            }
         }
 
         return true;
     }
 
-    const SharedPtr<Job> JobSystem::PushJob(const eastl::function<void()>& jobToPush, SharedPtr<Job> pParentJob /* = nullptr */)
+    void JobSystem::ProcessMainThreadJobs()
     {
-        SharedPtr<Job> pNewJob = MakeShared<Job>();
-        pNewJob->m_pParentJob = pParentJob;
-        ++pNewJob->m_jobCounter;
-        pNewJob->m_job = jobToPush;
-        if (pParentJob)
-            ++pParentJob->m_jobCounter;
-        ++m_jobCounter;
+        EXE_ASSERT(IsMainThread());
 
-        while (!m_jobPool.PushBack(pNewJob))
+        // Only the jobs queued so far, jobs that queue more run next time.
+        size_t jobsToRun = m_mainThreadQueue.GetSizeApprox();
+        while (jobsToRun > 0)
         {
-            CycleThread();
-        }
-
-        m_jobSignal.notify_one();
+            Job* pJob = m_mainThreadQueue.Pop();
+            if (!pJob)
+                break;
 
-        return pNewJob;
+            RunJob(pJob, JobPriority::kNormal);
+            --jobsToRun;
+        }
     }
 
     bool JobSystem::JobsAreExecuting()
@@ -54,9 +305,9 @@ namespace Exelius
         return (m_jobCounter != 0);
     }
 
-    void JobSystem::WaitForJob(uint64_t jobToWaitFor)
+    void JobSystem::WaitForCounter(const JobCounter& counter)
     {
-        while (jobToWaitFor != m_jobCounter)
+        while (!counter.IsComplete())
         {
             CycleThread();
         }
@@ -70,36 +321,252 @@ namespace Exelius
         }
     }
 
+    Job* JobSystem::AllocateJob()
+    {
+        return GetThreadJobPool().Allocate();
+    }
+
+    void JobSystem::SubmitJob(Job* pJob, JobCounter* pCounter, JobPriority priority)
+    {
+        EXE_ASSERT(pJob);
+        EXE_ASSERT(priority < JobPriority::kCount);
+
+        pJob->m_pCounter = pCounter;
+        if (pCounter)
+            pCounter->Increment();
+        m_jobCounter.fetch_add(1, std::memory_order_relaxed);
+
+        const size_t priorityIndex = static_cast<size_t>(priority);
+        if (s_workerIndex >= 0)
+        {
+            // Workers keep the jobs they spawn local, others can steal them if idle.
+            m_workerQueues[priorityIndex][s_workerIndex]->Push(pJob);
+        }
+        else
+        {
+            m_injectionQueues[priorityIndex].Push(pJob);
+        }
+
+        if (s_batchDepth > 0)
+            ++s_batchedJobCount;
+        else
+            WakeWorkers(1);
+    }
+
+    void JobSystem::SubmitMainThreadJob(Job* pJob, JobCounter* pCounter)
+    {
+        EXE_ASSERT(pJob);
+
+        pJob->m_pCounter = pCounter;
+        if (pCounter)
+            pCounter->Increment();
+        m_jobCounter.fetch_add(1, std::memory_order_relaxed);
+
+        // No need to wake anyone, the main thread checks every frame and while it waits.
+        m_mainThreadQueue.Push(pJob);
+    }
+
+    void JobSystem::BeginBatch()
+    {
+        ++s_batchDepth;
+    }
+
+    void JobSystem::EndBatch()
+    {
+        EXE_ASSERT(s_batchDepth > 0);
+        if (--s_batchDepth > 0)
+            return;
+
+        const uint32_t jobCount = s_batchedJobCount;
+        s_batchedJobCount = 0;
+        if (jobCount > 0)
+            WakeWorkers(jobCount);
+    }
+
+    JobPool& JobSystem::GetThreadJobPool()
+    {
+        if (s_threadJobPoolGeneration != m_generation)
+        {
+            std::lock_guard<std::mutex> lock(m_jobPoolLock);
+            m_jobPools.emplace_back(MakeUnique<JobPool>());
+            s_pThreadJobPool = m_jobPools.back().get();
+            s_threadJobPoolGeneration = m_generation;
+        }
+
+        EXE_ASSERT(s_pThreadJobPool);
+        return *s_pThreadJobPool;
+    }
+
     void JobSystem::CycleThread()
     {
-        m_jobSignal.notify_one();
+        // The main thread may be waiting on a job only it can run.
+        if (IsMainThread())
+        {
+            if (Job* pJob = m_mainThreadQueue.Pop())
+            {
+                RunJob(pJob, JobPriority::kNormal);
+                return;
+            }
+        }
+
+        // Help out rather than idle, the job we are waiting on may still be queued.
+        JobPriority priority = JobPriority::kNormal;
+        if (Job* pJob = FindJob(s_workerIndex, priority))
+        {
+            RunJob(pJob, priority);
+            return;
+        }
+
         std::this_thread::yield();
     }
 
-    void JobSystem::ExecuteJob()
+    bool JobSystem::IsWorkerThread() const
     {
-        SharedPtr<Job> pJobToExecute;
+        return s_workerIndex >= 0;
+    }
 
-        while (true)
+    void JobSystem::ExecuteJob(uint8_t workerIndex)
+    {
+        s_workerIndex = workerIndex;
+
+        if (Profiler* pProfiler = Profiler::GetInstance())
+        {
+            char threadName[32];
+            snprintf(threadName, sizeof(threadName), "Worker %u", static_cast<uint32_t>(workerIndex));
+            pProfiler->SetThreadName(threadName);
+        }
+
+        while (m_isRunning.load(std::memory_order_acquire))
+        {
+            JobPriority priority = JobPriority::kNormal;
+            Job* pJob = FindJob(workerIndex, priority);
+            if (!pJob)
+                pJob = WaitForJob(workerIndex, priority);
+
+            if (pJob)
+                RunJob(pJob, priority);
+        }
+    }
+
+    Job* JobSystem::WaitForJob(uint8_t workerIndex, JobPriority& priority)
+    {
+        for (uint32_t spin = 0; spin < s_kIdleSpinCount; ++spin)
+        {
+            if (Job* pJob = FindJob(workerIndex, priority))
+                return pJob;
+
+            std::this_thread::yield();
+        }
+
+        // Announce that we are about to sleep, then look one last time.
+        // A push either lands before this final search and is found, or it
+        // sees m_sleepingWorkers and bumps the epoch, so the wait returns.
+        const uint32_t epoch = m_wakeEpoch.load(std::memory_order_seq_cst);
+        m_sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        Job* pJob = FindJob(workerIndex, priority);
+        if (!pJob && m_isRunning.load(std::memory_order_seq_cst))
+            m_wakeEpoch.wait(epoch, std::memory_order_seq_cst);
+
+        m_sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+        return pJob;
+    }
+
+    void JobSystem::WakeWorkers(uint32_t jobCount)
+    {
+        // Pairs with the announcement in WaitForJob, so either the push is
+        // visible to the worker's final search or we see it sleeping.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const uint32_t sleepingWorkers = m_sleepingWorkers.load(std::memory_order_seq_cst);
+        if (sleepingWorkers == 0)
+            return;
+
+        m_wakeEpoch.fetch_add(1, std::memory_order_seq_cst);
+        if (jobCount >= sleepingWorkers)
+        {
+            m_wakeEpoch.notify_all();
+        }
+        else
         {
-            if (m_jobPool.PopFront(pJobToExecute))
+            for (uint32_t i = 0; i < jobCount; ++i)
+                m_wakeEpoch.notify_one();
+        }
+    }
+
+    Job* JobSystem::FindJob(int32_t workerIndex, JobPriority& priority)
+    {
+        Job* pJob = nullptr;
+
+        for (size_t priorityIndex = 0; priorityIndex < s_kPriorityCount; ++priorityIndex)
+        {
+            if (static_cast<JobPriority>(priorityIndex) == JobPriority::kBackground)
             {
-                pJobToExecute->m_job();
-                RecurseCounterDecrement(pJobToExecute);
+                // Threads helping while they wait would stall on a long background job.
+                if (workerIndex < 0)
+                    return nullptr;
+
+                // Keep a worker free for anything the frame pushes next.
+                if (m_runningBackgroundJobs.load(std::memory_order_relaxed) >= m_maxBackgroundJobs)
+                    return nullptr;
             }
-            else
+
+            priority = static_cast<JobPriority>(priorityIndex);
+            const auto& workerQueues = m_workerQueues[priorityIndex];
+
+            // Own deque first, newest job first.
+            if (workerIndex >= 0 && workerQueues[workerIndex]->Pop(pJob))
+                return pJob;
+
+            // Then anything pushed from outside the workers.
+            pJob = m_injectionQueues[priorityIndex].Pop();
+            if (pJob)
+                return pJob;
+
+            // Finally steal the oldest job from another worker, starting with our neighbour.
+            const uint8_t queueCount = static_cast<uint8_t>(workerQueues.size());
+            for (uint8_t i = 1; i <= queueCount; ++i)
             {
-                std::unique_lock<std::mutex> lock(m_jobLock);
-                m_jobSignal.wait(lock);
+                const uint8_t victim = static_cast<uint8_t>((workerIndex + i) % queueCount);
+                if (victim == workerIndex)
+                    continue;
+
+                if (workerQueues[victim]->Steal(pJob))
+                    return pJob;
             }
         }
+
+        return nullptr;
     }
 
-    void JobSystem::RecurseCounterDecrement(SharedPtr<Job> pJob)
+    void JobSystem::RunJob(Job* pJob, JobPriority priority)
     {
-        --pJob->m_jobCounter;
-        if (pJob->m_pParentJob)
-            RecurseCounterDecrement(pJob->m_pParentJob);
-        --m_jobCounter;
+        EXE_ASSERT(pJob);
+        EXE_ASSERT(pJob->m_pInvoke);
+
+        const bool isBackground = (priority == JobPriority::kBackground);
+        if (isBackground)
+            m_runningBackgroundJobs.fetch_add(1, std::memory_order_relaxed);
+
+        {
+            EXE_PROFILE_SCOPE("Job");
+            pJob->m_pInvoke(pJob->m_closure);
+        }
+        pJob->m_pInvoke = nullptr;
+
+        if (isBackground)
+            m_runningBackgroundJobs.fetch_sub(1, std::memory_order_relaxed);
+
+        JobCounter* pCounter = pJob->m_pCounter;
+        pJob->m_pCounter = nullptr;
+
+        // Recycle the job before signalling, the counter may be destroyed the moment it hits zero.
+        JobPool* pOwnerPool = pJob->m_pOwnerPool;
+        pOwnerPool->Free(pJob, pOwnerPool == s_pThreadJobPool && s_threadJobPoolGeneration == m_generation);
+
+        if (pCounter)
+            pCounter->Decrement();
+        m_jobCounter.fetch_sub(1, std::memory_order_acq_rel);
     }
 }
@@ -1,57 +1,490 @@
 #pragma once
+#include "source/os/threads/JobPool.h"
+#include "source/utility/containers/WorkStealingQueue.h"
 #include "source/utility/containers/RingBuffer.h"
 #include "source/utility/generic/SmartPointers.h"
 
-#include <EASTL/functional.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/utility.h>
 #include <EASTL/vector.h>
-#include <condition_variable>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
-	struct Job
+	/// <summary>
+	/// Intrusive node used to be notified when a JobCounter completes,
+	/// without blocking a thread. Used by the coroutine awaitables.
+	/// @see JobCounter::TryAddWaiter
+	/// </summary>
+	struct JobCounterWaiter
 	{
-		SharedPtr<Job> m_pParentJob;
-		eastl::function<void()> m_job;
-		std::atomic<uint16_t> m_jobCounter;
+		using ResumeFunction = void(*)(JobCounterWaiter* pWaiter);
 
-		Job& operator=(const Job& other)
+		/// <summary>
+		/// Called once, from whichever thread completes the counter.
+		/// </summary>
+		ResumeFunction m_pResume = nullptr;
+		JobCounterWaiter* m_pNext = nullptr;
+	};
+
+	/// <summary>
+	/// Counts the outstanding jobs that were pushed with it.
+	///
+	/// Counters are plain objects owned by the caller, typically on the stack
+	/// or as a member, and must outlive every job pushed with them. Pushing
+	/// a job increments the counter and the job completing decrements it,
+	/// so a job that pushes more work with the same counter extends the wait
+	/// of anyone waiting on that counter.
+	///
+	/// @code{.cpp}
+	/// Exelius::JobCounter counter;
+	/// s_pGlobalJobSystem->PushJob([&]() { DoWork(); }, &counter);
+	/// s_pGlobalJobSystem->WaitForCounter(counter);
+	/// @endcode
+	/// </summary>
+	class JobCounter
+	{
+		friend class JobSystem;
+
+		/// <summary>
+		/// The upper bits of the count guard and flag the waiter list, so the
+		/// final decrement can hand off the waiters and publish completion in a
+		/// single store. Once a counter reads as complete it is never touched
+		/// again by the job system, so its owner is free to destroy it.
+		/// </summary>
+		static constexpr uint32_t s_kHasWaitersBit = 1U << 31;
+		static constexpr uint32_t s_kWaiterLockBit = 1U << 30;
+		static constexpr uint32_t s_kCountMask = s_kWaiterLockBit - 1;
+
+		std::atomic<uint32_t> m_count;
+
+		/// <summary>
+		/// Guarded by s_kWaiterLockBit.
+		/// </summary>
+		JobCounterWaiter* m_pWaiters;
+
+	public:
+		JobCounter()
+			: m_count(0)
+			, m_pWaiters(nullptr)
 		{
-			m_pParentJob = other.m_pParentJob;
-			m_job = other.m_job;
-			m_jobCounter = other.m_jobCounter.load();
-			return *this;
+			//
 		}
+
+		JobCounter(const JobCounter&) = delete;
+		JobCounter(JobCounter&&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+		JobCounter& operator=(JobCounter&&) = delete;
+
+		/// <summary>
+		/// The number of jobs pushed with this counter that have not completed.
+		/// </summary>
+		uint32_t GetCount() const { return m_count.load(std::memory_order_acquire) & s_kCountMask; }
+
+		/// <summary>
+		/// True if every job pushed with this counter has completed.
+		/// </summary>
+		bool IsComplete() const { return GetCount() == 0; }
+
+		/// <summary>
+		/// Register a waiter to be resumed when the count next reaches zero.
+		/// The waiter must stay alive until it is resumed.
+		/// </summary>
+		/// <param name="waiter">- The waiter to register.</param>
+		/// <returns>True if registered, false if the counter was already complete and the waiter will not be called.</returns>
+		bool TryAddWaiter(JobCounterWaiter& waiter);
+
+	private:
+		void Increment();
+
+		/// <summary>
+		/// Decrement the count, resuming any waiters if it reaches zero.
+		/// </summary>
+		void Decrement();
 	};
 
+	/// <summary>
+	/// A unit of work. Jobs are fixed size and recycled through a JobPool,
+	/// and the closure is stored inline, so pushing a job never allocates.
+	/// </summary>
+	class Job
+	{
+		friend class JobSystem;
+		friend class JobPool;
+
+	public:
+		/// <summary>
+		/// Size of a job in bytes. Two cache lines.
+		/// </summary>
+		static constexpr size_t s_kJobSize = 128;
+
+		/// <summary>
+		/// Alignment guaranteed for the inline closure.
+		/// </summary>
+		static constexpr size_t s_kClosureAlignment = 16;
+
+	private:
+		/// <summary>
+		/// Calls the stored closure, then destroys it.
+		/// </summary>
+		using InvokeFunction = void(*)(void* pClosure);
+
+		InvokeFunction m_pInvoke = nullptr;
+		JobCounter* m_pCounter = nullptr;
+		JobPool* m_pOwnerPool = nullptr;
+
+		/// <summary>
+		/// Intrusive link, used by the pool's free lists and the injection queue.
+		/// </summary>
+		Job* m_pNext = nullptr;
+
+		static constexpr size_t s_kHeaderSize = sizeof(InvokeFunction) + sizeof(JobCounter*) + sizeof(JobPool*) + sizeof(Job*);
+		static constexpr size_t s_kPaddedHeaderSize = (s_kHeaderSize + s_kClosureAlignment - 1) & ~(s_kClosureAlignment - 1);
+
+	public:
+		/// <summary>
+		/// Bytes available to store a closure's captures.
+		/// </summary>
+		static constexpr size_t s_kClosureSize = s_kJobSize - s_kPaddedHeaderSize;
+
+	private:
+		alignas(s_kClosureAlignment) std::byte m_closure[s_kClosureSize];
+	};
+
+	static_assert(sizeof(Job) == Job::s_kJobSize, "Job layout has changed, update s_kJobSize.");
+
+	/// <summary>
+	/// The order in which queued jobs are picked up.
+	/// </summary>
+	enum class JobPriority : uint8_t
+	{
+		kFrameCritical,		// The current frame is waiting on this job. Always picked first.
+		kNormal,			// The default.
+		kBackground,		// Long running work, such as streaming. Only run by workers, and never by all of them at once.
+		kCount
+	};
+
+	/// <summary>
+	/// Work stealing job system.
+	///
+	/// Each worker thread owns a Chase-Lev deque per priority. Jobs pushed
+	/// from a worker go onto that worker's deque and are popped LIFO by the
+	/// owner, keeping recently produced (cache-hot) work local. Idle workers
+	/// steal FIFO from the other deques, taking the oldest and typically
+	/// largest work first.
+	///
+	/// Jobs pushed from any thread that is not a worker (the main thread)
+	/// go onto a global injection queue per priority, which workers drain
+	/// before stealing.
+	///
+	/// Every source of higher priority work is exhausted before any lower
+	/// priority work is considered. Background jobs are never picked up by
+	/// threads helping while they wait, and at least one worker is always
+	/// left free of them, so a burst of background work can't hold up a frame.
+	///
+	/// Jobs that must touch state that is not thread safe can be pushed to
+	/// the main thread queue instead, which only the main thread drains.
+	///
+	/// @see WorkStealingQueue
+	/// @see JobPool
+	/// </summary>
 	class JobSystem
 	{
-		RingBufferMT<SharedPtr<Job>, 256> m_jobPool;
+		using JobQueue = WorkStealingQueue<Job*>;
+
+		static constexpr size_t s_kPriorityCount = static_cast<size_t>(JobPriority::kCount);
+		static constexpr size_t s_kSharedQueueCapacity = 1024;
+
+		/// <summary>
+		/// Intrusive FIFO of jobs, guarded by a mutex.
+		/// </summary>
+		struct JobList
+		{
+			Job* m_pHead = nullptr;
+			Job* m_pTail = nullptr;
+			std::mutex m_lock;
+
+			void Push(Job* pJob);
+			Job* Pop();
+		};
+
+		/// <summary>
+		/// Queue of jobs any thread may push to and pop from.
+		/// Lock-free until the ring fills, jobs past that spill into a locked list
+		/// so pushes never fail. Jobs are not kept in order once they spill.
+		/// </summary>
+		struct SharedJobQueue
+		{
+			MPMCRingBuffer<Job*, s_kSharedQueueCapacity> m_jobs;
+			JobList m_overflow;
+			std::atomic<uint32_t> m_overflowCount = 0;
+
+			void Push(Job* pJob);
+			Job* Pop();
+			size_t GetSizeApprox() const;
+		};
+
+		/// <summary>
+		/// One deque per worker for each priority, indexed by [priority][worker index].
+		/// </summary>
+		eastl::vector<UniquePtr<JobQueue>> m_workerQueues[s_kPriorityCount];
+
+		/// <summary>
+		/// Jobs pushed from non-worker threads, one list per priority.
+		/// </summary>
+		SharedJobQueue m_injectionQueues[s_kPriorityCount];
+
+		/// <summary>
+		/// Jobs only ever run by the main thread.
+		/// </summary>
+		SharedJobQueue m_mainThreadQueue;
+
+		/// <summary>
+		/// A job pool for every thread that has pushed a job.
+		/// </summary>
+		eastl::vector<UniquePtr<JobPool>> m_jobPools;
+		std::mutex m_jobPoolLock;
+
+		eastl::vector<std::thread> m_workers;
+		std::thread::id m_mainThreadID;
+
+		/// <summary>
+		/// Identifies this job system's pools in each thread's cache. Never repeats, unlike its address.
+		/// </summary>
+		uint32_t m_generation;
+
+		/// <summary>
+		/// Idle workers park on this with std::atomic::wait.
+		/// Bumped whenever sleeping workers need to re-check the queues.
+		/// </summary>
+		std::atomic<uint32_t> m_wakeEpoch;
+
+		/// <summary>
+		/// The number of workers parked, or about to park, on m_wakeEpoch.
+		/// Lets pushes skip the wake entirely while every worker is busy.
+		/// </summary>
+		std::atomic<uint32_t> m_sleepingWorkers;
+
+		/// <summary>
+		/// Workers currently running a background job, and how many may at once.
+		/// The limit is soft, as workers check it before taking a job.
+		/// </summary>
+		std::atomic<uint32_t> m_runningBackgroundJobs;
+		uint32_t m_maxBackgroundJobs;
+
+		std::atomic<bool> m_isRunning;
 		std::atomic<uint32_t> m_jobCounter;
-		std::condition_variable m_jobSignal;
-		std::mutex m_jobLock;
 		uint8_t m_threadCount;
 
 	public:
 		JobSystem();
+		JobSystem(const JobSystem&) = delete;
+		JobSystem(JobSystem&&) = delete;
+		JobSystem& operator=(const JobSystem&) = delete;
+		JobSystem& operator=(JobSystem&&) = delete;
+
+		/// <summary>
+		/// Finishes any queued jobs, then wakes and joins every worker.
+		/// </summary>
+		~JobSystem();
+
+		/// <summary>
+		/// Start the workers. Must be called from the main thread.
+		/// </summary>
+		/// <param name="pinWorkersToCores">- Pin each worker to its own core, leaving the first core to the main thread.</param>
+		bool Initialize(bool pinWorkersToCores = false);
+
+		/// <summary>
+		/// Push a job to be executed by the workers.
+		///
+		/// The callable is moved into the job's inline storage and must fit
+		/// within Job::s_kClosureSize bytes. Capture large state by reference
+		/// or pointer instead of by value.
+		/// </summary>
+		/// <param name="callable">- The work to execute. Invoked with no arguments.</param>
+		/// <param name="pCounter">- Optional counter to track completion with. Must outlive the job.</param>
+		/// <param name="priority">- When the job is picked up relative to other queued jobs.</param>
+		template <typename Callable>
+		void PushJob(Callable&& callable, JobCounter* pCounter = nullptr, JobPriority priority = JobPriority::kNormal)
+		{
+			SubmitJob(CreateJob(eastl::forward<Callable>(callable)), pCounter, priority);
+		}
 
-		bool Initialize();
+		/// <summary>
+		/// Push a job to be executed by the main thread, either in
+		/// ProcessMainThreadJobs or while the main thread waits on a counter.
+		/// Use for work that touches state that is not thread safe.
+		/// </summary>
+		/// <param name="callable">- The work to execute. Invoked with no arguments.</param>
+		/// <param name="pCounter">- Optional counter to track completion with. Must outlive the job.</param>
+		template <typename Callable>
+		void PushMainThreadJob(Callable&& callable, JobCounter* pCounter = nullptr)
+		{
+			SubmitMainThreadJob(CreateJob(eastl::forward<Callable>(callable)), pCounter);
+		}
 
-		const SharedPtr<Job> PushJob(const eastl::function<void()>& jobToPush, SharedPtr<Job> pParentJob = nullptr);
+		/// <summary>
+		/// Run every job currently in the main thread queue.
+		/// Called by the Application once per frame.
+		/// </summary>
+		void ProcessMainThreadJobs();
 
 		bool JobsAreExecuting();
 
-		void WaitForJob(uint64_t jobToWaitFor);
+		/// <summary>
+		/// Block until every job pushed with the counter has completed.
+		/// The calling thread executes queued jobs while it waits.
+		/// </summary>
+		/// <param name="counter">- The counter to wait on.</param>
+		void WaitForCounter(const JobCounter& counter);
 
 		void WaitForAllJobs();
 
-	private:
+		/// <summary>
+		/// Run one queued job on the calling thread if there is one, otherwise yield.
+		/// For threads that wait on work the job system can't see, such as the FrameGraph.
+		/// The main thread also runs main thread jobs here.
+		/// </summary>
 		void CycleThread();
-		void ExecuteJob();
-		void RecurseCounterDecrement(SharedPtr<Job> pJob);
+
+		/// <summary>
+		/// Defer waking workers for jobs pushed by the calling thread until
+		/// the matching EndBatch, then wake as many as there are new jobs.
+		/// Batches may nest. Prefer ScopedJobBatch.
+		/// </summary>
+		void BeginBatch();
+		void EndBatch();
+
+		/// <summary>
+		/// True if the calling thread is one of this job system's workers.
+		/// </summary>
+		bool IsWorkerThread() const;
+
+		/// <summary>
+		/// True if the calling thread is the one that initialized the job system.
+		/// </summary>
+		bool IsMainThread() const { return std::this_thread::get_id() == m_mainThreadID; }
+
+		/// <summary>
+		/// The number of worker threads, not counting threads that help while waiting.
+		/// </summary>
+		uint8_t GetWorkerCount() const { return m_threadCount; }
+
+	private:
+		/// <summary>
+		/// Retrieve an unused job from the calling thread's pool.
+		/// </summary>
+		Job* AllocateJob();
+
+		/// <summary>
+		/// Allocate a job and move the callable into it.
+		/// </summary>
+		template <typename Callable>
+		Job* CreateJob(Callable&& callable)
+		{
+			using ClosureType = eastl::decay_t<Callable>;
+			static_assert(sizeof(ClosureType) <= Job::s_kClosureSize, "Job closure is too large. Capture by reference or pointer instead.");
+			static_assert(alignof(ClosureType) <= Job::s_kClosureAlignment, "Job closure is over-aligned.");
+
+			Job* pJob = AllocateJob();
+			new (pJob->m_closure) ClosureType(eastl::forward<Callable>(callable));
+			pJob->m_pInvoke = [](void* pClosure)
+			{
+				ClosureType* pCallable = std::launder(static_cast<ClosureType*>(pClosure));
+				(*pCallable)();
+				pCallable->~ClosureType();
+			};
+
+			return pJob;
+		}
+
+		/// <summary>
+		/// Count the job and queue it for execution.
+		/// </summary>
+		void SubmitJob(Job* pJob, JobCounter* pCounter, JobPriority priority);
+
+		/// <summary>
+		/// Count the job and queue it for the main thread.
+		/// </summary>
+		void SubmitMainThreadJob(Job* pJob, JobCounter* pCounter);
+
+		/// <summary>
+		/// Retrieve the calling thread's job pool, creating it on first use.
+		/// </summary>
+		JobPool& GetThreadJobPool();
+
+		void ExecuteJob(uint8_t workerIndex);
+
+		/// <summary>
+		/// Spin briefly looking for work, then park until woken.
+		/// </summary>
+		/// <returns>A job found before parking, or nullptr if the worker parked and should search again.</returns>
+		Job* WaitForJob(uint8_t workerIndex, JobPriority& priority);
+
+		/// <summary>
+		/// Wake up to jobCount parked workers. Cheap when none are parked.
+		/// </summary>
+		void WakeWorkers(uint32_t jobCount);
+
+		/// <summary>
+		/// Find a job to run. For each priority in turn, searches the calling
+		/// worker's own deque, then the injection queue, then the other
+		/// workers' deques.
+		/// </summary>
+		/// <param name="workerIndex">- Index of the calling worker, or -1 if the caller is not a worker.</param>
+		/// <param name="priority">- Set to the priority of the returned job.</param>
+		/// <returns>The job to run, or nullptr if none were found.</returns>
+		Job* FindJob(int32_t workerIndex, JobPriority& priority);
+
+		/// <summary>
+		/// Run the job, signal its counter, and return it to its pool.
+		/// </summary>
+		void RunJob(Job* pJob, JobPriority priority);
+	};
+
+	/// <summary>
+	/// Batches the wakeups of every job pushed by the calling thread while
+	/// in scope, so a bulk push wakes the workers once instead of per job.
+	///
+	/// @code{.cpp}
+	/// {
+	///		Exelius::ScopedJobBatch batch(*s_pGlobalJobSystem);
+	///		for (auto& chunk : chunks)
+	///			s_pGlobalJobSystem->PushJob([&chunk]() { Process(chunk); }, &counter);
+	/// }
+	/// @endcode
+	/// </summary>
+	class ScopedJobBatch
+	{
+		JobSystem& m_jobSystem;
+
+	public:
+		explicit ScopedJobBatch(JobSystem& jobSystem)
+			: m_jobSystem(jobSystem)
+		{
+			m_jobSystem.BeginBatch();
+		}
+
+		ScopedJobBatch(const ScopedJobBatch&) = delete;
+		ScopedJobBatch(ScopedJobBatch&&) = delete;
+		ScopedJobBatch& operator=(const ScopedJobBatch&) = delete;
+		ScopedJobBatch& operator=(ScopedJobBatch&&) = delete;
+
+		~ScopedJobBatch()
+		{
+			m_jobSystem.EndBatch();
+		}
 	};
 
-	inline static JobSystem* s_pGlobalJobSystem = nullptr;
+	/// <summary>
+	/// Not static, so every translation unit shares the one the Application creates.
+	/// </summary>
+	inline JobSystem* s_pGlobalJobSystem = nullptr;
 }
\ No newline at end of file
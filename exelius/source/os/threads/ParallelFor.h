@@ -0,0 +1,182 @@
+#pragma once
+#include "source/os/threads/JobSystem.h"
+
+#include <EASTL/algorithm.h>
+#include <EASTL/iterator.h>
+#include <EASTL/type_traits.h>
+#include <EASTL/vector.h>
+#include <iterator>
+#include <type_traits>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// The default minimum number of iterations given to a single job.
+	/// Lower this for loops with expensive bodies, raise it for trivial ones.
+	/// </summary>
+	inline constexpr size_t s_kDefaultParallelGrainSize = 64;
+
+	namespace Internal
+	{
+		/// <summary>
+		/// How many chunks each worker should receive, so work stealing
+		/// has something to balance when iterations take uneven time.
+		/// </summary>
+		inline constexpr size_t s_kParallelChunksPerWorker = 4;
+
+		/// <summary>
+		/// Choose a chunk size for the given iteration count. Chunks are never
+		/// smaller than the grain size, and shrink towards it as the number of
+		/// workers grows.
+		/// </summary>
+		inline size_t GetParallelChunkSize(size_t count, size_t grainSize)
+		{
+			EXE_ASSERT(s_pGlobalJobSystem);
+			const size_t chunkCount = (static_cast<size_t>(s_pGlobalJobSystem->GetWorkerCount()) + 1) * s_kParallelChunksPerWorker;
+			const size_t adaptiveSize = (count + chunkCount - 1) / chunkCount;
+			return eastl::max(eastl::max(grainSize, adaptiveSize), static_cast<size_t>(1));
+		}
+
+		template <typename Iterator>
+		inline constexpr bool IsRandomAccessIterator = std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Iterator>::iterator_category>;
+	}
+
+	/// <summary>
+	/// Split the index range [begin, end) into chunks and push a job for each.
+	/// Returns immediately; wait on the counter before touching the results.
+	///
+	/// The function is copied into every job, so it must fit in a job's closure
+	/// (Job::s_kClosureSize) and anything it references must stay alive until
+	/// the counter completes.
+	/// </summary>
+	/// <param name="counter">- Counter that will track the pushed jobs.</param>
+	/// <param name="begin">- First index, inclusive.</param>
+	/// <param name="end">- Last index, exclusive.</param>
+	/// <param name="function">- Called once per index as function(size_t index).</param>
+	/// <param name="grainSize">- The minimum number of indices handled by a single job.</param>
+	/// <param name="priority">- The priority of the pushed jobs.</param>
+	template <typename Function>
+	void ParallelFor(JobCounter& counter, size_t begin, size_t end, const Function& function, size_t grainSize = s_kDefaultParallelGrainSize, JobPriority priority = JobPriority::kNormal)
+	{
+		EXE_ASSERT(s_pGlobalJobSystem);
+		if (begin >= end)
+			return;
+
+		const size_t chunkSize = Internal::GetParallelChunkSize(end - begin, grainSize);
+
+		// Wake the workers once for all the chunks, rather than once per chunk.
+		ScopedJobBatch batch(*s_pGlobalJobSystem);
+		for (size_t chunkBegin = begin; chunkBegin < end; chunkBegin += chunkSize)
+		{
+			const size_t chunkEnd = eastl::min(chunkBegin + chunkSize, end);
+			s_pGlobalJobSystem->PushJob([function, chunkBegin, chunkEnd]()
+			{
+				for (size_t i = chunkBegin; i < chunkEnd; ++i)
+					function(i);
+			}, &counter, priority);
+
+			// Guard against overflow on the final chunk.
+			if (chunkEnd == end)
+				break;
+		}
+	}
+
+	/// <summary>
+	/// Split the index range [begin, end) into chunks, execute them on the
+	/// job system and block until every index has been processed. The
+	/// calling thread executes jobs while it waits. Ranges no larger than
+	/// the grain size are executed directly on the calling thread.
+	/// </summary>
+	/// <param name="begin">- First index, inclusive.</param>
+	/// <param name="end">- Last index, exclusive.</param>
+	/// <param name="function">- Called once per index as function(size_t index).</param>
+	/// <param name="grainSize">- The minimum number of indices handled by a single job.</param>
+	template <typename Function>
+	void ParallelFor(size_t begin, size_t end, const Function& function, size_t grainSize = s_kDefaultParallelGrainSize)
+	{
+		if (begin >= end)
+			return;
+
+		if (!s_pGlobalJobSystem || end - begin <= grainSize)
+		{
+			for (size_t i = begin; i < end; ++i)
+				function(i);
+			return;
+		}
+
+		// We block, so the jobs can safely refer to the function instead of copying it.
+		// The caller is stalled until they finish, so they go ahead of other queued work.
+		const Function* pFunction = &function;
+		JobCounter counter;
+		ParallelFor(counter, begin, end, [pFunction](size_t i) { (*pFunction)(i); }, grainSize, JobPriority::kFrameCritical);
+		s_pGlobalJobSystem->WaitForCounter(counter);
+	}
+
+	/// <summary>
+	/// Call the function for every element of a random access range, such as an
+	/// eastl::vector. Returns immediately; wait on the counter before touching
+	/// the results. The range must stay alive until the counter completes.
+	/// </summary>
+	/// <param name="counter">- Counter that will track the pushed jobs.</param>
+	/// <param name="range">- The range to iterate.</param>
+	/// <param name="function">- Called once per element as function(element).</param>
+	/// <param name="grainSize">- The minimum number of elements handled by a single job.</param>
+	/// <param name="priority">- The priority of the pushed jobs.</param>
+	template <typename Range, typename Function>
+	void ParallelForEach(JobCounter& counter, Range& range, const Function& function, size_t grainSize = s_kDefaultParallelGrainSize, JobPriority priority = JobPriority::kNormal)
+	{
+		using Iterator = decltype(eastl::begin(range));
+		static_assert(Internal::IsRandomAccessIterator<Iterator>, "Non-blocking ParallelForEach requires a random access range. Use the blocking overload.");
+
+		Iterator first = eastl::begin(range);
+		const size_t count = static_cast<size_t>(eastl::end(range) - first);
+		ParallelFor(counter, 0, count, [first, function](size_t i) { function(first[i]); }, grainSize, priority);
+	}
+
+	/// <summary>
+	/// Call the function for every element of a range and block until done.
+	///
+	/// Random access ranges, such as an eastl::vector, are split directly.
+	/// Other ranges, such as a Scene::GetAllGameObjectsWith() view, are first
+	/// gathered into a temporary array on the calling thread. For views this
+	/// means the function receives the entity identifier, and should fetch
+	/// components through the view, as views are safe to read concurrently.
+	///
+	/// @code{.cpp}
+	/// auto view = pScene->GetAllGameObjectsWith<TransformComponent, RigidbodyComponent>();
+	/// Exelius::ParallelForEach(view, [&view](auto gameObject)
+	/// {
+	///		auto [transform, rigidbody] = view.get<TransformComponent, RigidbodyComponent>(gameObject);
+	/// });
+	/// @endcode
+	///
+	/// The function must not add or remove elements, entities or components.
+	/// </summary>
+	/// <param name="range">- The range to iterate.</param>
+	/// <param name="function">- Called once per element as function(element).</param>
+	/// <param name="grainSize">- The minimum number of elements handled by a single job.</param>
+	template <typename Range, typename Function>
+	void ParallelForEach(Range& range, const Function& function, size_t grainSize = s_kDefaultParallelGrainSize)
+	{
+		using Iterator = decltype(eastl::begin(range));
+
+		if constexpr (Internal::IsRandomAccessIterator<Iterator>)
+		{
+			Iterator first = eastl::begin(range);
+			const size_t count = static_cast<size_t>(eastl::end(range) - first);
+			ParallelFor(0, count, [first, &function](size_t i) { function(first[i]); }, grainSize);
+		}
+		else
+		{
+			using ValueType = eastl::decay_t<decltype(*eastl::begin(range))>;
+			eastl::vector<ValueType> elements;
+			for (auto&& element : range)
+				elements.emplace_back(element);
+
+			ParallelFor(0, elements.size(), [&elements, &function](size_t i) { function(elements[i]); }, grainSize);
+		}
+	}
+}
\ No newline at end of file
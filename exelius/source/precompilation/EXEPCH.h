@@ -32,6 +32,7 @@
 #include <source/utility/containers/Vector2.h>
 #include <source/utility/generic/Macros.h>
 #include <source/debug/Log.h>
+#include <source/debug/Profiler.h>
 #include <source/os/memory/MemoryManager.h>
 
 #ifdef EXE_PLATFORM_WINDOWS
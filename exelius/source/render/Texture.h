@@ -12,6 +12,40 @@ namespace Exelius
 {
 	FORWARD_DECLARE(Texture);
 
+	/// <summary>
+	/// Pixels decoded from an image file, waiting to be uploaded to a texture.
+	/// Decoding doesn't touch the renderer, so it can happen on any thread.
+	/// </summary>
+	struct TextureImage
+	{
+		/// <summary>
+		/// Every mip level, largest first, back to back. Each level is half
+		/// the size of the one before it, rounded down, to a minimum of 1.
+		/// </summary>
+		eastl::vector<std::byte> m_pixels;
+		uint32_t m_width = 0;
+		uint32_t m_height = 0;
+		uint32_t m_channels = 0;
+		uint32_t m_mipCount = 1;
+
+		/// <summary>
+		/// The size m_pixels should be, for every mip level together.
+		/// </summary>
+		size_t GetPixelsSize() const
+		{
+			size_t pixelsSize = 0;
+			uint32_t levelWidth = m_width;
+			uint32_t levelHeight = m_height;
+			for (uint32_t mipLevel = 0; mipLevel < m_mipCount; ++mipLevel)
+			{
+				pixelsSize += static_cast<size_t>(levelWidth) * levelHeight * m_channels;
+				levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+				levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+			}
+			return pixelsSize;
+		}
+	};
+
 	/// <summary>
 	/// Templated window class using CRTP.
 	/// https://en.wikipedia.org/wiki/Curiously_recurring_template_pattern
@@ -33,6 +67,24 @@ namespace Exelius
 			//
 		}
 
+		/// <summary>
+		/// Upload pixels decoded by DecodeImage.
+		/// </summary>
+		_Texture(const TextureImage& image)
+			: m_impl(image)
+		{
+			//
+		}
+
+		/// <summary>
+		/// Decode an image file into pixels, without touching the renderer.
+		/// Safe to call from any thread.
+		/// </summary>
+		/// <param name="data">- The contents of the image file.</param>
+		/// <param name="image">- Receives the decoded pixels.</param>
+		/// <returns>True if the image was decoded, false otherwise.</returns>
+		static bool DecodeImage(const eastl::vector<std::byte>& data, TextureImage& image) { return ImplTexture::DecodeImage(data, image); }
+
 		uint32_t GetWidth() const { return m_impl.GetWidth(); }
 		uint32_t GetHeight() const { return m_impl.GetHeight(); }
 		uint32_t GetRendererID() const { return m_impl.GetRendererID(); }
@@ -0,0 +1,236 @@
+#include "EXEPCH.h"
+#include "source/resource/ExpakArchive.h"
+
+#include <EASTL/algorithm.h>
+
+#include <lz4.h>
+#include <zstd.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A zstd decompression context for each thread, reused for every entry it decompresses.
+	/// </summary>
+	struct ZstdDecompressionContext
+	{
+		ZSTD_DCtx* m_pContext = ZSTD_createDCtx();
+
+		~ZstdDecompressionContext()
+		{
+			ZSTD_freeDCtx(m_pContext);
+		}
+	};
+
+	static thread_local ZstdDecompressionContext s_zstdContext;
+
+	ExpakArchive::ExpakArchive()
+		: m_pEntries(nullptr)
+		, m_entryCount(0)
+		, m_pNames(nullptr)
+	{
+		//
+	}
+
+	bool ExpakArchive::Open(const char* pArchivePath)
+	{
+		EXE_ASSERT(pArchivePath);
+		Close();
+
+		if (!m_file.Open(pArchivePath))
+			return false;
+
+		m_archivePath = pArchivePath;
+
+		const std::byte* pPack = m_file.GetData();
+		const size_t packSize = m_file.GetSize();
+
+		ExpakHeader header;
+		if (packSize < sizeof(ExpakHeader))
+		{
+			EXE_LOG_CATEGORY_WARN("ExpakArchive", "'{}' is too small to be an asset pack.", pArchivePath);
+			Close();
+			return false;
+		}
+
+		::memcpy(&header, pPack, sizeof(ExpakHeader));
+		if (header.m_signature != ExpakHeader::kSignature || header.m_version != ExpakHeader::kVersion || header.m_headerSize != sizeof(ExpakHeader))
+		{
+			EXE_LOG_CATEGORY_WARN("ExpakArchive", "'{}' is not a version {} asset pack.", pArchivePath, ExpakHeader::kVersion);
+			Close();
+			return false;
+		}
+
+		const uint64_t tocSize = static_cast<uint64_t>(header.m_entryCount) * sizeof(ExpakEntry);
+		if (header.m_tocOffset > packSize || tocSize > packSize - header.m_tocOffset
+			|| header.m_namesOffset > packSize || header.m_namesSize > packSize - header.m_namesOffset)
+		{
+			EXE_LOG_CATEGORY_WARN("ExpakArchive", "'{}' is truncated.", pArchivePath);
+			Close();
+			return false;
+		}
+
+		m_pEntries = reinterpret_cast<const ExpakEntry*>(pPack + header.m_tocOffset);
+		m_entryCount = header.m_entryCount;
+		m_pNames = reinterpret_cast<const char*>(pPack + header.m_namesOffset);
+
+		if (!ValidateTableOfContents())
+		{
+			EXE_LOG_CATEGORY_WARN("ExpakArchive", "'{}' has an invalid table of contents.", pArchivePath);
+			Close();
+			return false;
+		}
+
+		EXE_LOG_CATEGORY_INFO("ExpakArchive", "Opened '{}' with {} entries.", pArchivePath, m_entryCount);
+		return true;
+	}
+
+	void ExpakArchive::Close()
+	{
+		m_pEntries = nullptr;
+		m_entryCount = 0;
+		m_pNames = nullptr;
+		m_archivePath.clear();
+		m_file.Close();
+	}
+
+	bool ExpakArchive::ReadResource(const ResourceID& resourceID, eastl::vector<std::byte>& resourceData) const
+	{
+		const ExpakEntry* pEntry = FindEntry(resourceID);
+		if (!pEntry)
+			return false;
+
+		if (pEntry->m_size == 0)
+		{
+			EXE_LOG_CATEGORY_WARN("ExpakArchive", "'{}' is empty in '{}'.", resourceID.Get().c_str(), m_archivePath.c_str());
+			return true;
+		}
+
+		resourceData.resize(static_cast<size_t>(pEntry->m_size));
+		if (!Extract(*pEntry, eastl::span<std::byte>(resourceData.data(), resourceData.size())))
+		{
+			EXE_LOG_CATEGORY_WARN("ExpakArchive", "Failed to extract '{}' from '{}'.", resourceID.Get().c_str(), m_archivePath.c_str());
+			resourceData.clear();
+		}
+
+		return true;
+	}
+
+	const ExpakEntry* ExpakArchive::FindEntry(const ResourceID& resourceID) const
+	{
+		EXE_ASSERT(resourceID.IsValid());
+
+		const uint64_t nameHash = resourceID.GetHash();
+		const eastl::string& name = resourceID.Get();
+
+		const ExpakEntry* pEnd = m_pEntries + m_entryCount;
+		const ExpakEntry* pEntry = eastl::lower_bound(m_pEntries, pEnd, nameHash, [](const ExpakEntry& entry, uint64_t hash)
+			{
+				return entry.m_nameHash < hash;
+			});
+
+		// Different names can share a hash, so compare the names too.
+		for (; pEntry != pEnd && pEntry->m_nameHash == nameHash; ++pEntry)
+		{
+			if (pEntry->m_nameLength == name.size() && ::memcmp(m_pNames + pEntry->m_nameOffset, name.data(), name.size()) == 0)
+				return pEntry;
+		}
+
+		return nullptr;
+	}
+
+	eastl::span<const std::byte> ExpakArchive::GetStoredData(const ExpakEntry& entry) const
+	{
+		if (entry.m_compression != ExpakCompression::kNone)
+			return eastl::span<const std::byte>();
+
+		return eastl::span<const std::byte>(m_file.GetData() + entry.m_offset, static_cast<size_t>(entry.m_size));
+	}
+
+	bool ExpakArchive::Extract(const ExpakEntry& entry, eastl::span<std::byte> destination) const
+	{
+		EXE_ASSERT(destination.size() == entry.m_size);
+
+		const std::byte* pSource = m_file.GetData() + entry.m_offset;
+		const size_t storedSize = static_cast<size_t>(entry.m_storedSize);
+
+		switch (entry.m_compression)
+		{
+			case ExpakCompression::kNone:
+			{
+				::memcpy(destination.data(), pSource, destination.size());
+				return true;
+			}
+
+			case ExpakCompression::kLZ4:
+			{
+				const int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(pSource), reinterpret_cast<char*>(destination.data()),
+					static_cast<int>(storedSize), static_cast<int>(destination.size()));
+
+				if (decompressedSize < 0 || static_cast<size_t>(decompressedSize) != destination.size())
+				{
+					EXE_LOG_CATEGORY_WARN("ExpakArchive", "Failed to decompress an LZ4 entry in '{}'.", m_archivePath.c_str());
+					return false;
+				}
+
+				return true;
+			}
+
+			case ExpakCompression::kZstd:
+			{
+				if (!s_zstdContext.m_pContext)
+					return false;
+
+				const size_t decompressedSize = ZSTD_decompressDCtx(s_zstdContext.m_pContext, destination.data(), destination.size(), pSource, storedSize);
+				if (ZSTD_isError(decompressedSize) || decompressedSize != destination.size())
+				{
+					EXE_LOG_CATEGORY_WARN("ExpakArchive", "Failed to decompress a zstd entry in '{}': {}", m_archivePath.c_str(),
+						ZSTD_isError(decompressedSize) ? ZSTD_getErrorName(decompressedSize) : "Wrong size.");
+					return false;
+				}
+
+				return true;
+			}
+
+			default:
+				EXE_ASSERT(false);
+				return false;
+		}
+	}
+
+	bool ExpakArchive::ValidateTableOfContents() const
+	{
+		const uint64_t packSize = m_file.GetSize();
+
+		ExpakHeader header;
+		::memcpy(&header, m_file.GetData(), sizeof(ExpakHeader));
+
+		for (uint32_t entryIndex = 0; entryIndex < m_entryCount; ++entryIndex)
+		{
+			const ExpakEntry& entry = m_pEntries[entryIndex];
+
+			if (entryIndex > 0 && m_pEntries[entryIndex - 1].m_nameHash > entry.m_nameHash)
+				return false;
+
+			if (entry.m_compression >= ExpakCompression::kMax)
+				return false;
+
+			if (static_cast<uint64_t>(entry.m_nameOffset) + entry.m_nameLength > header.m_namesSize)
+				return false;
+
+			if (entry.m_offset > packSize || entry.m_storedSize > packSize - entry.m_offset)
+				return false;
+
+			// LZ4 blocks are limited to 2GB.
+			if (entry.m_compression == ExpakCompression::kLZ4 && (entry.m_size > INT32_MAX || entry.m_storedSize > INT32_MAX))
+				return false;
+
+			if (entry.m_compression == ExpakCompression::kNone && entry.m_storedSize != entry.m_size)
+				return false;
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include "source/resource/ResourceArchive.h"
+#include "source/utility/io/ExpakStructs.h"
+#include "source/utility/io/MappedFile.h"
+
+#include <EASTL/span.h>
+#include <EASTL/string.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A read-only Exelius asset pack (.expak), built by the exeliuspacker tool.
+	/// @see ExpakStructs.h
+	///
+	/// The pack is memory mapped once when it is opened, and its table of
+	/// contents is used in place: it is sorted by the hash of each name, which
+	/// every ResourceID already has, so a lookup is a binary search that
+	/// neither hashes nor allocates. Each entry is page aligned, and stored
+	/// as is, as LZ4 or as zstd, whichever the packer chose for it.
+	///
+	/// Once opened, a pack can be read from any number of threads at once.
+	/// @see ResourceLoader
+	/// </summary>
+	class ExpakArchive
+		: public ResourceArchive
+	{
+		MappedFile m_file;
+		const ExpakEntry* m_pEntries;
+		uint32_t m_entryCount;
+		const char* m_pNames;
+		eastl::string m_archivePath;
+
+	public:
+		ExpakArchive();
+		ExpakArchive(const ExpakArchive&) = delete;
+		ExpakArchive(ExpakArchive&&) = delete;
+		ExpakArchive& operator=(const ExpakArchive&) = delete;
+		ExpakArchive& operator=(ExpakArchive&&) = delete;
+		virtual ~ExpakArchive() = default;
+
+		/// <summary>
+		/// Map the pack and validate its header and table of contents.
+		/// </summary>
+		/// <param name="pArchivePath">- The pack to open.</param>
+		/// <returns>True if the pack was opened and is valid.</returns>
+		virtual bool Open(const char* pArchivePath) final override;
+
+		/// <summary>
+		/// Close the pack. Spans returned by GetStoredData are no longer valid.
+		/// </summary>
+		virtual void Close() final override;
+
+		bool IsOpen() const { return m_file.IsOpen(); }
+		virtual const eastl::string& GetArchivePath() const final override { return m_archivePath; }
+		uint32_t GetEntryCount() const { return m_entryCount; }
+
+		/// <summary>
+		/// Copy or decompress a resource's entry into newly allocated data.
+		/// Safe to call from several threads at once.
+		/// </summary>
+		/// <param name="resourceID">- The resource, as its path inside the pack.</param>
+		/// <param name="resourceData">- Set to the resource's data. Left empty if it could not be read.</param>
+		/// <returns>True if the pack contains the resource, whether or not it could be read.</returns>
+		virtual bool ReadResource(const ResourceID& resourceID, eastl::vector<std::byte>& resourceData) const final override;
+
+		/// <summary>
+		/// Find the entry for a resource.
+		/// </summary>
+		/// <param name="resourceID">- The resource, as its path inside the pack.</param>
+		/// <returns>The entry, or nullptr if the pack doesn't contain it.</returns>
+		const ExpakEntry* FindEntry(const ResourceID& resourceID) const;
+
+		/// <summary>
+		/// View the data of an uncompressed entry in place, without copying it.
+		/// The span is valid until the pack is closed.
+		/// </summary>
+		/// <param name="entry">- An entry of this pack.</param>
+		/// <returns>The entry's data. Empty if the entry is compressed.</returns>
+		eastl::span<const std::byte> GetStoredData(const ExpakEntry& entry) const;
+
+		/// <summary>
+		/// Copy or decompress an entry straight into the destination.
+		/// Safe to call from several threads at once.
+		/// </summary>
+		/// <param name="entry">- An entry of this pack.</param>
+		/// <param name="destination">- Exactly m_size bytes to write the entry to.</param>
+		/// <returns>True if the whole entry was written.</returns>
+		bool Extract(const ExpakEntry& entry, eastl::span<std::byte> destination) const;
+
+	private:
+		/// <summary>
+		/// Check that the table of contents is sorted and everything it points to is inside the pack.
+		/// </summary>
+		bool ValidateTableOfContents() const;
+	};
+}
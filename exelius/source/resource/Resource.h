@@ -18,9 +18,11 @@ namespace Exelius
 	/// which should then handle what happens with the raw binary
 	/// data that the engine obtains.
 	/// 
-	/// You must take care that the Load and Unload functions are
-	/// thread safe, as these functions are typically called from
-	/// the resource loading thread.
+	/// Load is typically called from a resource loading worker, many
+	/// at once, and so must be thread safe. Anything that has to happen
+	/// on the main thread, such as creating GPU objects, belongs in
+	/// Finalize, which the loader calls on the main thread once Load
+	/// has succeeded.
 	/// </summary>
 	class Resource
 	{
@@ -53,13 +55,20 @@ namespace Exelius
 		/// Load the asset. This will call the Subclass specific load funcion.
 		/// 
 		/// @note
-		/// This function is typically called from the resource thread
+		/// This function is typically called from a resource loading worker
 		/// and thus should be made thread safe.
 		/// </summary>
 		/// <param name="data">- The raw byte data of the loaded asset.</param>
 		/// <returns>The result of the load operation.</returns>
 		virtual LoadResult Load(eastl::vector<std::byte>&& data) = 0;
 
+		/// <summary>
+		/// Finish loading the asset on the main thread, after Load has succeeded.
+		/// Resources that only need their data decoded have nothing to do here.
+		/// </summary>
+		/// <returns>True if the resource is ready to use, false if loading failed.</returns>
+		virtual bool Finalize() { return true; }
+
 		/// <summary>
 		/// Unload the asset. This will call the Subclass specific unloading function.
 		/// </summary>
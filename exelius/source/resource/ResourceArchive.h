@@ -0,0 +1,46 @@
+#pragma once
+#include "source/resource/ResourceHelpers.h"
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A read-only file containing packed resources, mounted by the
+	/// ResourceLoader when it is not using raw assets.
+	///
+	/// Once opened, an archive must be readable from any number of
+	/// threads at once.
+	/// @see ResourceLoader
+	/// @see ZipArchive
+	/// @see ExpakArchive
+	/// </summary>
+	class ResourceArchive
+	{
+	public:
+		virtual ~ResourceArchive() = default;
+
+		/// <summary>
+		/// Map the archive and read its table of contents.
+		/// </summary>
+		/// <param name="pArchivePath">- The archive to open.</param>
+		/// <returns>True if the archive was opened and is valid.</returns>
+		virtual bool Open(const char* pArchivePath) = 0;
+
+		virtual void Close() = 0;
+
+		virtual const eastl::string& GetArchivePath() const = 0;
+
+		/// <summary>
+		/// Read the raw data of a resource out of the archive.
+		/// </summary>
+		/// <param name="resourceID">- The resource, as its path inside the archive.</param>
+		/// <param name="resourceData">- Set to the resource's data. Left empty if it could not be read.</param>
+		/// <returns>True if the archive contains the resource, whether or not it could be read.</returns>
+		virtual bool ReadResource(const ResourceID& resourceID, eastl::vector<std::byte>& resourceData) const = 0;
+	};
+}
@@ -0,0 +1,119 @@
+#pragma once
+#include "source/os/threads/Coroutines.h"
+#include "source/resource/ResourceHandle.h"
+#include "source/resource/ResourceListener.h"
+#include "source/resource/ResourceLoader.h"
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Awaits a resource load without blocking a thread, as an alternative
+	/// to subclassing ResourceListener. Results in a ResourceHandle holding
+	/// a reference to the loaded resource.
+	/// @see LoadResourceAsync
+	/// </summary>
+	class ResourceLoadAwaiter
+	{
+		/// <summary>
+		/// Resumes the awaiting coroutine when the loader reports completion.
+		/// </summary>
+		class Listener
+			: public ResourceListener
+		{
+			std::coroutine_handle<> m_handle;
+			ResumeOn m_resumeOn;
+
+			/// <summary>
+			/// Set by whichever comes first, the load completing or the coroutine finishing
+			/// its suspend. The second resumes it, so it is never resumed while suspending.
+			/// </summary>
+			std::atomic<bool> m_isHalfDone;
+
+		public:
+			Listener(std::coroutine_handle<> handle, ResumeOn resumeOn)
+				: m_handle(handle)
+				, m_resumeOn(resumeOn)
+				, m_isHalfDone(false)
+			{
+				//
+			}
+
+			virtual bool OnResourceLoaded([[maybe_unused]] const ResourceID& resourceID) final override
+			{
+				if (m_isHalfDone.exchange(true, std::memory_order_acq_rel))
+					CoroutineScheduler::GetInstance()->Resume(m_handle, m_resumeOn);
+				return false;
+			}
+
+			/// <summary>
+			/// Called once the coroutine has finished suspending.
+			/// </summary>
+			/// <returns>False if the load has already completed, and the coroutine should continue without suspending.</returns>
+			bool FinishSuspend()
+			{
+				return !m_isHalfDone.exchange(true, std::memory_order_acq_rel);
+			}
+		};
+
+		ResourceID m_resourceID;
+		SharedPtr<Listener> m_pListener;
+		ResumeOn m_resumeOn;
+
+		/// <summary>
+		/// True if queueing the load took a reference, which this awaiter then owns.
+		/// No reference is taken if the resource was already loaded.
+		/// </summary>
+		bool m_queuedLoad;
+
+	public:
+		ResourceLoadAwaiter(const ResourceID& resourceID, ResumeOn resumeOn)
+			: m_resourceID(resourceID)
+			, m_resumeOn(resumeOn)
+			, m_queuedLoad(false)
+		{
+			EXE_ASSERT(m_resourceID.IsValid());
+		}
+
+		bool await_ready() const
+		{
+			// Already loaded, no need to suspend.
+			return ResourceLoader::GetInstance()->GetResource(m_resourceID) != nullptr;
+		}
+
+		bool await_suspend(std::coroutine_handle<> handle)
+		{
+			m_pListener = MakeShared<Listener>(handle, m_resumeOn);
+			m_queuedLoad = ResourceLoader::GetInstance()->QueueLoad(m_resourceID, true, m_pListener);
+
+			// If the load completed in the meantime, continue without suspending.
+			// Otherwise the listener resumes the coroutine, which may destroy this awaiter.
+			SharedPtr<Listener> pListener = m_pListener;
+			return pListener->FinishSuspend();
+		}
+
+		ResourceHandle await_resume()
+		{
+			ResourceHandle handle(m_resourceID);
+
+			// The handle took its own reference, release the one taken when the load was queued.
+			if (m_queuedLoad)
+				ResourceLoader::GetInstance()->ReleaseResource(m_resourceID);
+
+			return handle;
+		}
+	};
+
+	/// <summary>
+	/// co_await the load of a resource, resulting in a ResourceHandle to it.
+	/// Resources that are already loaded continue without suspending.
+	/// </summary>
+	/// <param name="resourceID">- The resource to load.</param>
+	/// <param name="resumeOn">- The thread to continue on once loaded.</param>
+	inline ResourceLoadAwaiter LoadResourceAsync(const ResourceID& resourceID, ResumeOn resumeOn = ResumeOn::kMainThread)
+	{
+		return ResourceLoadAwaiter(resourceID, resumeOn);
+	}
+}
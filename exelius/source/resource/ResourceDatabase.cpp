@@ -28,11 +28,23 @@ namespace Exelius
 	/// This happens once per frame.
 	/// Resources can unload more resources, so this acts as a
 	/// double buffered queue.
+	/// 
+	/// Entries that were referenced or locked again since they
+	/// were queued are left alone. Entries that are still loading
+	/// stay queued until their load finishes.
 	/// </summary>
 	void ResourceDatabase::ProcessUnloadQueue()
 	{
-		while (!m_unloadQueue.empty())
-			InternalProcessUnloadQueue();
+		eastl::vector<ResourceID> stillLoading;
+		while (HasQueuedUnloads())
+			InternalProcessUnloadQueue(stillLoading);
+
+		if (stillLoading.empty())
+			return;
+
+		m_unloaderLock.lock();
+		m_unloadQueue.insert(m_unloadQueue.end(), stillLoading.begin(), stillLoading.end());
+		m_unloaderLock.unlock();
 	}
 
 	/// <summary>
@@ -41,7 +53,8 @@ namespace Exelius
 	/// Resources can unload more resources, so this acts as a
 	/// double buffered queue.
 	/// </summary>
-	void ResourceDatabase::InternalProcessUnloadQueue()
+	/// <param name="stillLoading">- Collects the entries that were still loading, to be queued again.</param>
+	void ResourceDatabase::InternalProcessUnloadQueue(eastl::vector<ResourceID>& stillLoading)
 	{
 		// Create the second buffer.
 		eastl::vector<ResourceID> m_activeUnloader;
@@ -51,29 +64,56 @@ namespace Exelius
 
 		for (auto& resourceID : m_activeUnloader)
 		{
-			EXE_LOG_CATEGORY_INFO("ResourceDatabase", "Unloading Resource: {}", resourceID.Get().c_str());
-			if (!IsFound(resourceID))
+			// Decide and remove the entry under one lock, so nothing
+			// can acquire or start loading it in between.
+			m_mapLock.lock();
+			ResourceEntry* pResourceEntry = IsFound(resourceID) ? &m_resourceMap.at(resourceID) : nullptr;
+			if (!pResourceEntry || pResourceEntry->IsHeld())
+			{
+				m_mapLock.unlock();
 				continue;
+			}
 
-			// TODO: Verify that the ResourceEntry is in fact unloadable.
-
-			Resource* pResource = InternalGetEntryResource(resourceID);
-			InternalSetLoadStatus(resourceID, ResourceLoadStatus::kUnloading);
-			if (pResource)
+			// A loader worker still owns this entry.
+			if (pResourceEntry->GetStatus() == ResourceLoadStatus::kLoading)
 			{
-				pResource->Unload();
-				InternalSetLoadStatus(resourceID, ResourceLoadStatus::kUnloaded);
+				m_mapLock.unlock();
+				stillLoading.emplace_back(resourceID);
+				continue;
 			}
 
-			m_mapLock.lock();
+			EXE_LOG_CATEGORY_INFO("ResourceDatabase", "Unloading Resource: {}", resourceID.Get().c_str());
+
+			pResourceEntry->SetStatus(ResourceLoadStatus::kUnloading);
+			Resource* pResource = pResourceEntry->DetachResource();
 			m_resourceMap.erase(resourceID);
 			m_mapLock.unlock();
 
+			// Unloading may release other resources, so the lock can't be held here.
+			if (pResource)
+			{
+				pResource->Unload();
+				delete pResource;
+			}
+
 			EXE_LOG_CATEGORY_INFO("ResourceDatabase", "Unloaded Resource '{}'", resourceID.Get().c_str());
 		}
 		m_activeUnloader.clear();
 	}
 
+	/// <summary>
+	/// Thread Safe.
+	/// Checks if there are any resources waiting to be unloaded.
+	/// </summary>
+	/// <returns>True if the unload queue is not empty.</returns>
+	bool ResourceDatabase::HasQueuedUnloads()
+	{
+		m_unloaderLock.lock();
+		const bool hasQueuedUnloads = !m_unloadQueue.empty();
+		m_unloaderLock.unlock();
+		return hasQueuedUnloads;
+	}
+
 	/// <summary>
 	/// Thread Safe.
 	/// Increments the reference count of the entry with the given ResourceID.
@@ -265,6 +305,113 @@ namespace Exelius
 		return true;
 	}
 
+	/// <summary>
+	/// Thread Safe.
+	/// Claims the load of a resource. Creates the entry if it doesn't exist, and
+	/// marks it as loading unless it is already loading or loaded. A caller joining
+	/// a load in progress, or restarting one that failed, takes a reference on the entry.
+	/// 
+	/// The status is checked and changed under a single lock, so only one
+	/// caller ever loads a resource, however many threads request it at once.
+	/// </summary>
+	/// <param name="resourceID">- The resource to load.</param>
+	/// <returns>The status the entry had. Unless it was kLoading or kLoaded, the caller must now load the resource.</returns>
+	ResourceLoadStatus ResourceDatabase::BeginEntryLoad(const ResourceID& resourceID)
+	{
+		EXE_ASSERT(resourceID.IsValid());
+
+		m_mapLock.lock();
+		if (!IsFound(resourceID))
+		{
+			// New entries start with the caller's reference.
+			m_resourceMap.try_emplace(resourceID);
+			m_resourceMap.at(resourceID).SetStatus(ResourceLoadStatus::kLoading);
+			m_mapLock.unlock();
+			return ResourceLoadStatus::kInvalid;
+		}
+
+		ResourceEntry& resourceEntry = m_resourceMap.at(resourceID);
+		const ResourceLoadStatus previousStatus = resourceEntry.GetStatus();
+		if (previousStatus == ResourceLoadStatus::kLoading)
+		{
+			// Joining a load in progress.
+			resourceEntry.IncrementRefCount();
+		}
+		else if (previousStatus != ResourceLoadStatus::kLoaded)
+		{
+			// Restarting a load that failed or was cancelled, or an entry that was never loaded.
+			// The caller's reference keeps a cancelled entry from being unloaded under the new load.
+			resourceEntry.IncrementRefCount();
+			resourceEntry.SetStatus(ResourceLoadStatus::kLoading);
+		}
+		m_mapLock.unlock();
+
+		return previousStatus;
+	}
+
+	/// <summary>
+	/// Thread Safe.
+	/// Completes a load claimed with BeginEntryLoad, setting the resource
+	/// and its status in one step.
+	/// </summary>
+	/// <param name="resourceID">- The resource that was loaded.</param>
+	/// <param name="pResource">- The loaded resource, or nullptr if the load failed.</param>
+	/// <returns>True if the entry still existed. If not, the caller still owns pResource.</returns>
+	bool ResourceDatabase::FinishEntryLoad(const ResourceID& resourceID, Resource* pResource)
+	{
+		EXE_ASSERT(resourceID.IsValid());
+
+		m_mapLock.lock();
+		ResourceEntry* pResourceEntry = GetEntry(resourceID);
+		if (!pResourceEntry)
+		{
+			m_mapLock.unlock();
+			return false;
+		}
+
+		if (pResource)
+		{
+			pResourceEntry->SetResource(pResource);
+			pResourceEntry->SetStatus(ResourceLoadStatus::kLoaded);
+		}
+		else
+		{
+			// Left empty until the last reference is released.
+			pResourceEntry->SetStatus(ResourceLoadStatus::kUnloaded);
+		}
+		m_mapLock.unlock();
+
+		return true;
+	}
+
+	/// <summary>
+	/// Thread Safe.
+	/// Abandons a load claimed with BeginEntryLoad if nothing references
+	/// or locks the entry anymore. The entry is left empty, as if the load
+	/// had failed, so a later request starts a new load.
+	/// </summary>
+	/// <param name="resourceID">- The resource being loaded.</param>
+	/// <returns>True if the load was abandoned, false if it is still wanted.</returns>
+	bool ResourceDatabase::CancelEntryLoad(const ResourceID& resourceID)
+	{
+		EXE_ASSERT(resourceID.IsValid());
+
+		// Checked and changed under one lock, so a request joining the load
+		// either holds the entry in time or finds it empty and loads it again.
+		m_mapLock.lock();
+		auto found = m_resourceMap.find(resourceID);
+		if (found == m_resourceMap.end() || found->second.IsHeld() || found->second.GetStatus() != ResourceLoadStatus::kLoading)
+		{
+			m_mapLock.unlock();
+			return false;
+		}
+
+		found->second.SetStatus(ResourceLoadStatus::kUnloaded);
+		m_mapLock.unlock();
+
+		return true;
+	}
+
 	/// <summary>
 	/// Thread Safe.
 	/// Unloads a resource with the given ID.
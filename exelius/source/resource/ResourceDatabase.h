@@ -64,6 +64,10 @@ namespace Exelius
 		/// This happens once per frame.
 		/// Resources can unload more resources, so this acts as a
 		/// double buffered queue.
+		/// 
+		/// Entries that were referenced or locked again since they
+		/// were queued are left alone. Entries that are still loading
+		/// stay queued until their load finishes.
 		/// </summary>
 		void ProcessUnloadQueue();
 
@@ -137,6 +141,39 @@ namespace Exelius
 		/// <returns>True if the ResourceEntry was created, false if it already existed.</returns>
 		bool CreateEntry(const ResourceID& resourceID);
 
+		/// <summary>
+		/// Thread Safe.
+		/// Claims the load of a resource. Creates the entry if it doesn't exist, and
+		/// marks it as loading unless it is already loading or loaded. A caller joining
+		/// a load in progress, or restarting one that failed, takes a reference on the entry.
+		/// 
+		/// The status is checked and changed under a single lock, so only one
+		/// caller ever loads a resource, however many threads request it at once.
+		/// </summary>
+		/// <param name="resourceID">- The resource to load.</param>
+		/// <returns>The status the entry had. Unless it was kLoading or kLoaded, the caller must now load the resource.</returns>
+		ResourceLoadStatus BeginEntryLoad(const ResourceID& resourceID);
+
+		/// <summary>
+		/// Thread Safe.
+		/// Completes a load claimed with BeginEntryLoad, setting the resource
+		/// and its status in one step.
+		/// </summary>
+		/// <param name="resourceID">- The resource that was loaded.</param>
+		/// <param name="pResource">- The loaded resource, or nullptr if the load failed.</param>
+		/// <returns>True if the entry still existed. If not, the caller still owns pResource.</returns>
+		bool FinishEntryLoad(const ResourceID& resourceID, Resource* pResource);
+
+		/// <summary>
+		/// Thread Safe.
+		/// Abandons a load claimed with BeginEntryLoad if nothing references
+		/// or locks the entry anymore. The entry is left empty, as if the load
+		/// had failed, so a later request starts a new load.
+		/// </summary>
+		/// <param name="resourceID">- The resource being loaded.</param>
+		/// <returns>True if the load was abandoned, false if it is still wanted.</returns>
+		bool CancelEntryLoad(const ResourceID& resourceID);
+
 		/// <summary>
 		/// Thread Safe.
 		/// Unloads a resource with the given ID.
@@ -151,7 +188,15 @@ namespace Exelius
 		/// Resources can unload more resources, so this acts as a
 		/// double buffered queue.
 		/// </summary>
-		void InternalProcessUnloadQueue();
+		/// <param name="stillLoading">- Collects the entries that were still loading, to be queued again.</param>
+		void InternalProcessUnloadQueue(eastl::vector<ResourceID>& stillLoading);
+
+		/// <summary>
+		/// Thread Safe.
+		/// Checks if there are any resources waiting to be unloaded.
+		/// </summary>
+		/// <returns>True if the unload queue is not empty.</returns>
+		bool HasQueuedUnloads();
 
 		/// <summary>
 		/// Non-Thread-Safe.
@@ -116,6 +116,18 @@ namespace Exelius
 		m_pResource = pResource;
 	}
 
+	/// <summary>
+	/// Hand the resource over to the caller, leaving the entry empty.
+	/// The caller becomes responsible for unloading and deleting it.
+	/// </summary>
+	/// <returns>The resource held by this entry, or nullptr if there was none.</returns>
+	Resource* ResourceEntry::DetachResource()
+	{
+		Resource* pResource = m_pResource;
+		m_pResource = nullptr;
+		return pResource;
+	}
+
 	/// <summary>
 	/// Increment the reference count of this entry.
 	/// </summary>
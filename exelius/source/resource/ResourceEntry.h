@@ -79,6 +79,13 @@ namespace Exelius
 		/// <param name="pResource">- The resource to set.</param>
 		void SetResource(Resource* pResource);
 
+		/// <summary>
+		/// Hand the resource over to the caller, leaving the entry empty.
+		/// The caller becomes responsible for unloading and deleting it.
+		/// </summary>
+		/// <returns>The resource held by this entry, or nullptr if there was none.</returns>
+		Resource* DetachResource();
+
 		/// <summary>
 		/// Increment the reference count of this entry.
 		/// </summary>
@@ -111,6 +118,12 @@ namespace Exelius
 		/// <returns>True if there are locks, false otherwise.</returns>
 		bool IsLocked() const { return m_lockCount > 0; }
 
+		/// <summary>
+		/// Check to see if this entry has any references or locks.
+		/// </summary>
+		/// <returns>True if referenced or locked, false otherwise.</returns>
+		bool IsHeld() const { return m_refCount + m_lockCount > 0; }
+
 		/// <summary>
 		/// Get the current loading status of this resource.
 		/// </summary>
@@ -28,7 +28,7 @@ namespace Exelius
 	/// 
 	/// Finally, the constructor can force a resource to be loaded if
 	/// it is not loaded, which will automatically acquire the resource.
-	/// The load will happen immediately on the main thread.
+	/// The load will happen immediately on the calling thread.
 	/// </summary>
 	/// <param name="resourceID">- The resource ID the handle is meant to refer to.</param>
 	/// <param name="loadResource">- If the resource should be loaded. Default is false.</param>
@@ -38,11 +38,7 @@ namespace Exelius
 	{
 		// Check if the resource is already loaded.
 		if (!TryToAcquireResource() && loadResource)
-		{
-			ResourceLoader::GetInstance()->LoadNow(resourceID);
-			if (ResourceLoader::GetInstance()->IsResourceAcquirable(resourceID))
-				m_resourceHeld = true;
-		}
+			LoadAndAcquireResource();
 	}
 
 	ResourceHandle::ResourceHandle(const ResourceHandle& other)
@@ -90,7 +86,7 @@ namespace Exelius
 	/// Get the resource that is referred to by this handle.
 	/// If the resource has not yet been acquired, it will attempt to do so here.
 	/// </summary>
-	/// <param name="forceLoad">- True will load the resource immediately, on the main thread, if not already loaded. Default is false.</param>
+	/// <param name="forceLoad">- True will load the resource immediately, on the calling thread, if not already loaded. Default is false.</param>
 	/// <returns>The resource with the ID held by this ResourceHandle, or nullptr if the resource could not be retrieved.</returns>
 	Resource* ResourceHandle::Get(bool forceLoad)
 	{
@@ -102,12 +98,10 @@ namespace Exelius
 		if (!m_resourceID.IsValid())
 			return nullptr;
 
-		Resource* pResource = ResourceLoader::GetInstance()->GetResource(m_resourceID, forceLoad);
-
-		if (pResource && !m_resourceHeld)
-			m_resourceHeld = true; // Prevents double acquisition.
+		if (forceLoad && !ResourceLoader::GetInstance()->IsResourceAcquirable(m_resourceID))
+			LoadAndAcquireResource();
 
-		return pResource;
+		return ResourceLoader::GetInstance()->GetResource(m_resourceID);
 	}
 
 	bool ResourceHandle::CreateNew(const ResourceID& resourceID)
@@ -161,7 +155,9 @@ namespace Exelius
 	/// </summary>
 	/// <param name="signalLoaderThread">- Should signal the loader thread to begin. Default is false.</param>
 	/// <param name="pListener">- An object that inherets from ResourceListener to be notified of on load completion.</param>
-	void ResourceHandle::QueueLoad(bool signalLoaderThread, ResourceListenerPtr pListener)
+	/// <param name="priority">- How urgently the resource is needed. Default is kNormal.</param>
+	/// <param name="deadlineSeconds">- How many seconds from now the resource should be ready by. Default is 0, for no deadline.</param>
+	void ResourceHandle::QueueLoad(bool signalLoaderThread, ResourceListenerPtr pListener, ResourceLoadPriority priority, float deadlineSeconds)
 	{
 		if (m_resourceHeld)
 		{
@@ -181,12 +177,15 @@ namespace Exelius
 				return; // Return because we don't need to load.
 		}
 
-		ResourceLoader::GetInstance()->QueueLoad(m_resourceID, signalLoaderThread, pListener);
-		m_resourceHeld = true;
+		// The loader references the resource for us, unless it was already loaded.
+		if (ResourceLoader::GetInstance()->QueueLoad(m_resourceID, signalLoaderThread, pListener, priority, deadlineSeconds))
+			m_resourceHeld = true;
+		else
+			TryToAcquireResource();
 	}
 
 	/// <summary>
-	/// Loads the resource immediate on the main thread. This is a blocking
+	/// Loads the resource immediate on the calling thread. This is a blocking
 	/// function, and may be slow. Use with caution. This function
 	/// will acquire the resource automatically.
 	/// </summary>
@@ -211,8 +210,7 @@ namespace Exelius
 				return; // Return because we don't need to load.
 		}
 
-		ResourceLoader::GetInstance()->LoadNow(m_resourceID);
-		m_resourceHeld = true;
+		LoadAndAcquireResource(pListener);
 	}
 
 	/// <summary>
@@ -309,4 +307,30 @@ namespace Exelius
 		m_resourceHeld = true;
 		return true;
 	}
+
+	/// <summary>
+	/// Load the resource referenced by this handle on the calling thread, or wait
+	/// for its load in progress, and hold a reference to it once it is done.
+	/// The handle holds exactly one reference afterwards, even if the load failed.
+	/// </summary>
+	/// <param name="pListener">- An object that inherets from ResourceListener to be notified of on load completion.</param>
+	void ResourceHandle::LoadAndAcquireResource(ResourceListenerPtr pListener)
+	{
+		// The loader references the resource for us, unless it was already loaded.
+		if (!ResourceLoader::GetInstance()->LoadNow(m_resourceID, pListener))
+		{
+			if (!m_resourceHeld)
+				TryToAcquireResource();
+			return;
+		}
+
+		if (m_resourceHeld)
+		{
+			// Already holding a reference from an earlier load, so drop the new one.
+			ResourceLoader::GetInstance()->ReleaseResource(m_resourceID);
+			return;
+		}
+
+		m_resourceHeld = true;
+	}
 }
\ No newline at end of file
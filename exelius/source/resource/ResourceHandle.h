@@ -45,7 +45,7 @@ namespace Exelius
 		/// 
 		/// Finally, the constructor can force a resource to be loaded if
 		/// it is not loaded, which will automatically acquire the resource.
-		/// The load will happen immediately on the main thread.
+		/// The load will happen immediately on the calling thread.
 		/// </summary>
 		/// <param name="resourceID">- The resource ID the handle is meant to refer to.</param>
 		/// <param name="loadResource">- If the resource should be loaded. Default is false.</param>
@@ -65,7 +65,7 @@ namespace Exelius
 		/// Get the resource that is referred to by this handle.
 		/// If the resource has not yet been acquired, it will attempt to do so here.
 		/// </summary>
-		/// <param name="forceLoad">- True will load the resource immediately, on the main thread, if not already loaded. Default is false.</param>
+		/// <param name="forceLoad">- True will load the resource immediately, on the calling thread, if not already loaded. Default is false.</param>
 		/// <returns>The resource with the ID held by this ResourceHandle, or nullptr if the resource could not be retrieved.</returns>
 		Resource* Get(bool forceLoad = false);
 
@@ -75,7 +75,7 @@ namespace Exelius
 		/// If the resource has not yet been acquired, it will attempt to do so here.
 		/// </summary>
 		/// <typeparam name="Type">- The resource Subclass to be retrieved.</typeparam>
-		/// <param name="forceLoad">- True will load the resource immediately, on the main thread, if not already loaded. Default is false.</param>
+		/// <param name="forceLoad">- True will load the resource immediately, on the calling thread, if not already loaded. Default is false.</param>
 		/// <returns>The resource with the ID held by this ResourceHandle, or nullptr if the resource could not be retrieved.</returns>
 		template <class Type>
 		Type* GetAs(bool forceLoad = false)
@@ -94,10 +94,13 @@ namespace Exelius
 		/// </summary>
 		/// <param name="signalLoaderThread">- Should signal the loader thread to begin. Default is false.</param>
 		/// <param name="pListener">- An object that inherets from ResourceListener to be notified of on load completion.</param>
-		void QueueLoad(bool signalLoaderThread = false, ResourceListenerPtr pListener = ResourceListenerPtr());
+		/// <param name="priority">- How urgently the resource is needed. Default is kNormal.</param>
+		/// <param name="deadlineSeconds">- How many seconds from now the resource should be ready by. Default is 0, for no deadline.</param>
+		void QueueLoad(bool signalLoaderThread = false, ResourceListenerPtr pListener = ResourceListenerPtr(),
+			ResourceLoadPriority priority = ResourceLoadPriority::kNormal, float deadlineSeconds = 0.0f);
 
 		/// <summary>
-		/// Loads the resource immediate on the main thread. This is a blocking
+		/// Loads the resource immediate on the calling thread. This is a blocking
 		/// function, and may be slow. Use with caution. This function
 		/// will acquire the resource automatically.
 		/// </summary>
@@ -184,5 +187,13 @@ namespace Exelius
 		/// </summary>
 		/// <returns>True if acquired, false otherwise.</returns>
 		bool TryToAcquireResource();
+
+		/// <summary>
+		/// Load the resource referenced by this handle on the calling thread, or wait
+		/// for its load in progress, and hold a reference to it once it is done.
+		/// The handle holds exactly one reference afterwards, even if the load failed.
+		/// </summary>
+		/// <param name="pListener">- An object that inherets from ResourceListener to be notified of on load completion.</param>
+		void LoadAndAcquireResource(ResourceListenerPtr pListener = ResourceListenerPtr());
 	};
 }
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 #include "source/utility/string/StringIntern.h"
+#include "source/utility/string/StringID.h"
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
@@ -63,4 +64,18 @@ namespace Exelius
 		kUnloading,	/// Set when the loader thread begins unloading this resource.
 		kUnloaded,	/// Set when the loader thread finished unloading this resource.
 	};
+
+	/// <summary>
+	/// How urgently a queued resource is needed. Queued loads are started
+	/// and finalized in this order, then by deadline, then in the order
+	/// they were queued.
+	/// </summary>
+	enum class ResourceLoadPriority : uint8_t
+	{
+		kImmediate,	/// Needed now, such as content streaming in near the camera. Finalized regardless of the frame's budget.
+		kHigh,		/// Needed soon.
+		kNormal,	/// The default.
+		kPrefetch,	/// Speculative, and may never be used. Started only once nothing more urgent is waiting.
+		kCount
+	};
 }
\ No newline at end of file
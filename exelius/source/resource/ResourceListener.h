@@ -30,8 +30,8 @@ namespace Exelius
 		/// operations on/with the loaded resource.
 		/// 
 		/// @note
-		/// This function is typically called from the resource thread
-		/// and thus should be made thread safe.
+		/// Called on the main thread for queued loads. LoadNow notifies
+		/// on the thread that called it.
         /// </summary>
         /// <param name="resourceID">- The ID of the loaded resource.</param>
         /// <returns>True if the resource was flushed here, false if not.</returns>
@@ -3,25 +3,50 @@
 #include "source/resource/ResourceListener.h"
 #include "source/resource/ResourceFactory.h"
 #include "source/resource/Resource.h"
+#include "source/resource/ExpakArchive.h"
+#include "source/resource/ZipArchive.h"
 #include "source/utility/io/File.h"
-#include "source/utility/io/ZLIBStructs.h"
+#include "source/utility/generic/Timing.h"
 
-#include <zlib.h>
+#include <EASTL/sort.h>
+
+#include <chrono>
+#include <filesystem>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	/// <summary>
+	/// The time load deadlines are measured against.
+	/// </summary>
+	static uint64_t GetLoadTimeNanoseconds()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	/// <summary>
+	/// Convert a deadline relative to now into load time. No deadline unless it is positive.
+	/// </summary>
+	static uint64_t GetDeadlineNanoseconds(float deadlineSeconds)
+	{
+		if (deadlineSeconds <= 0.0f)
+			return UINT64_MAX; // ResourceLoader::s_kNoDeadline
+
+		return GetLoadTimeNanoseconds() + static_cast<uint64_t>(static_cast<double>(deadlineSeconds) * 1000000000.0);
+	}
+
 	/// <summary>
 	/// Constructor default initializes member data.
 	/// </summary>
 	ResourceLoader::ResourceLoader()
 		: m_pResourceFactory(nullptr)
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		, m_quitThread(false)
-		, m_successfulThreadShutdown(false)
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		, m_loadsInFlight(0)
+		, m_nextLoadSequence(0)
+		, m_isDeferredQueueSorted(true)
+		, m_isFinalizeQueueSorted(true)
+		, m_finalizeBudgetMilliseconds(s_kDefaultFinalizeBudgetMilliseconds)
 		, m_engineResourcePath("Invalid Engine Resource Path.")
 		, m_useRawAssets(false)
 	{
@@ -30,39 +55,39 @@ namespace Exelius
 
 	/// <summary>
 	/// Destructor handles the safe shutdown and destruction of
-	/// resources and the resource thread.
+	/// resources, waiting for any loads still in flight.
 	/// </summary>
 	ResourceLoader::~ResourceLoader()
 	{
 		// Remove resources to be loaded.
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_deferredQueueLock.lock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_deferredQueue.clear();
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_deferredQueueLock.unlock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
 		// Remove listeners waiting on resources.
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_listenerMapLock.lock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		m_deferredResourceListenersMap.clear();
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		m_pendingListenersMap.clear();
 		m_listenerMapLock.unlock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
-		// Tell the thread we are done.
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		m_quitThread = true;
-		SignalAndWaitForLoaderThread();
-		m_loaderThread.join();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		// Let the loads already on the workers finish.
+		if (s_pGlobalJobSystem)
+			s_pGlobalJobSystem->WaitForCounter(m_loadCounter);
+
+		// Finalize whatever they decoded, ignoring the budget.
+		eastl::vector<PendingFinalize> finalizeQueue;
+		m_finalizeQueueLock.lock();
+		finalizeQueue.swap(m_finalizeQueue);
+		m_finalizeQueueLock.unlock();
+
+		for (const PendingFinalize& pendingFinalize : finalizeQueue)
+			FinishLoad(pendingFinalize.m_request.m_resourceID, pendingFinalize.m_pResource);
 
 		// Unload any assets that were added to this queue during
 		// engine shutdown processes.
 		ProcessUnloadQueue();
 
+		UnmountArchives();
+
 		// Don't delete, this lives on the Application/Engine.
 		// I have decided that the destruction of the factory
 		// makes more sense to happen in the same class that
@@ -72,8 +97,8 @@ namespace Exelius
 
 	/// <summary>
 	/// Initialization sets the resource factory given by the application,
-	/// sets the path to the engine and client resources, determines the
-	/// way resources are retrieved and spins up the resource thread.
+	/// sets the path to the engine and client resources and determines the
+	/// way resources are retrieved.
 	/// The data provided for this function is retrieved from the config
 	/// file in, and this function is called from, the Application.
 	/// @see Application
@@ -96,27 +121,28 @@ namespace Exelius
 
 		m_useRawAssets = useRawAssets;
 
+		if (!m_useRawAssets && pEngineResourcePath)
+		{
+			// "EngineResources/" is packed as "EngineResources.expak", or "EngineResources.zip".
+			eastl::string archivePath = m_engineResourcePath;
+			while (!archivePath.empty() && (archivePath.back() == '/' || archivePath.back() == '\\'))
+				archivePath.pop_back();
+
+			const eastl::string packPath = archivePath + ".expak";
+			archivePath += std::filesystem::exists(packPath.c_str()) ? ".expak" : ".zip";
+
+			if (!MountArchive(archivePath.c_str()))
+				EXE_LOG_CATEGORY_WARN("ResourceLoader", "Engine resources could not be mounted from '{}'.", archivePath.c_str());
+		}
+
 		// Should not contain data, but just in case.
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_deferredQueueLock.lock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_deferredQueue.clear();
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_deferredQueueLock.unlock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		m_listenerMapLock.lock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		m_deferredResourceListenersMap.clear();
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		m_pendingListenersMap.clear();
 		m_listenerMapLock.unlock();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		// Spin up the loader thread.
-		m_loaderThread = std::thread(&ResourceLoader::ProcessResourceQueue, this);
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
 		return true;
 	}
@@ -135,15 +161,87 @@ namespace Exelius
 	}
 
 	/// <summary>
-	/// Queue the resource to be loaded. This will defer the load to
-	/// the resource thread if running in multithreaded mode. If a
-	/// resource is already being loaded then the resource listener
-	/// will be added to the list of listeners to be notified and
-	/// nothing further will happen. If the resource is loaded already
-	/// then the listener will be notified immediately.
-	/// @todo
-	/// Potential data race here, if the listener is added just after
-	/// the loader thread proccesses the listener queue.
+	/// Hand the most urgent queued loads to the job system's workers,
+	/// up to a few per worker. The workers start the next ones as they
+	/// finish. This happens once per frame, or straight away when a
+	/// load is queued with signalLoaderThread set.
+	/// </summary>
+	void ResourceLoader::ProcessLoadQueue()
+	{
+		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		if (!s_pGlobalJobSystem)
+			return;
+
+		m_deferredQueueLock.lock();
+		DispatchQueuedLoads();
+		m_deferredQueueLock.unlock();
+		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+	}
+
+	/// <summary>
+	/// Main thread only.
+	/// Finalize decoded resources, most urgent first, until the frame's
+	/// finalize budget is spent. Immediate loads, and loads past their
+	/// deadline, are finalized regardless of the budget.
+	/// This happens once per frame and should not be called by the client.
+	/// </summary>
+	void ResourceLoader::ProcessFinalizeQueue()
+	{
+		EXE_PROFILE_FUNCTION();
+
+		Timer budgetTimer(true);
+		bool hasFinalized = false;
+		while (true)
+		{
+			m_finalizeQueueLock.lock();
+			if (m_finalizeQueue.empty())
+			{
+				m_finalizeQueueLock.unlock();
+				break;
+			}
+
+			if (!m_isFinalizeQueueSorted)
+			{
+				eastl::sort(m_finalizeQueue.begin(), m_finalizeQueue.end(), [](const PendingFinalize& lhs, const PendingFinalize& rhs)
+					{
+						return IsLessUrgent(lhs.m_request, rhs.m_request);
+					});
+				m_isFinalizeQueueSorted = true;
+			}
+
+			// Always make some progress, so a small budget can't stall loading altogether.
+			const PendingFinalize pendingFinalize = m_finalizeQueue.back();
+			const bool isUrgent = pendingFinalize.m_request.m_priority == ResourceLoadPriority::kImmediate
+				|| pendingFinalize.m_request.m_deadlineNanoseconds <= GetLoadTimeNanoseconds();
+
+			if (hasFinalized && !isUrgent && budgetTimer.GetElapsedTimeAsMilliseconds() >= m_finalizeBudgetMilliseconds)
+			{
+				m_finalizeQueueLock.unlock();
+				break;
+			}
+
+			m_finalizeQueue.pop_back();
+			m_finalizeQueueLock.unlock();
+
+			FinalizeLoad(pendingFinalize);
+			hasFinalized = true;
+		}
+	}
+
+	/// <summary>
+	/// Queue the resource to be loaded by the job system's workers,
+	/// once the queue is next processed. If a resource is already
+	/// being loaded then the resource listener will be added to the
+	/// list of listeners to be notified and nothing further will happen.
+	/// If the resource is loaded already then the listener will be
+	/// notified immediately. Otherwise, it is notified on the main
+	/// thread once the load completes, whether it succeeded or not.
+	/// 
+	/// Queueing a resource that is already queued raises the priority
+	/// and deadline of its load to the more urgent of the two.
+	/// 
+	/// Without a job system, or with FORCE_SINGLE_THREADED_RESOURCE_LOADER
+	/// set, this is the same as LoadNow.
 	/// 
 	/// The loading time of a resource is not predictable, and thus
 	/// the use of the ResourceListener class is highly reccomended
@@ -155,90 +253,83 @@ namespace Exelius
 	/// so that multiple listeners can be notified of a resource being loaded.
 	/// </summary>
 	/// <param name="resourceID">- The filepath of the resource to load. This is a StringIntern for optimization.</param>
-	/// <param name="signalLoaderThread">- True if the loader thread should be signaled to begin loading. Does nothing in single threaded mode.</param>
+	/// <param name="signalLoaderThread">- True if the queue should be handed to the workers now, rather than at the next ProcessLoadQueue. Does nothing in single threaded mode.</param>
 	/// <param name="pListener">- The listener to be notified when a resource has completed the load process.</param>
-	void ResourceLoader::QueueLoad(const ResourceID& resourceID, [[maybe_unused]] bool signalLoaderThread, ResourceListenerPtr pListener)
+	/// <param name="priority">- How urgently the resource is needed.</param>
+	/// <param name="deadlineSeconds">- How many seconds from now the resource should be ready by. 0 for no deadline.</param>
+	/// <returns>True if the caller now holds a reference to the resource. False if it was already loaded, and no reference was taken.</returns>
+	bool ResourceLoader::QueueLoad(const ResourceID& resourceID, [[maybe_unused]] bool signalLoaderThread, ResourceListenerPtr pListener,
+		[[maybe_unused]] ResourceLoadPriority priority, [[maybe_unused]] float deadlineSeconds)
 	{
 		EXE_ASSERT(resourceID.IsValid());
+		EXE_ASSERT(priority < ResourceLoadPriority::kCount);
 		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		EXE_ASSERT(m_loaderThread.joinable());
+		if (!s_pGlobalJobSystem)
+			return LoadNow(resourceID, pListener);
 
 		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Queueing Resource: {}", resourceID.Get().c_str());
 
-		// Attempt to create a resource entry.
-		if (m_resourceDatabase.CreateEntry(resourceID))
-		{
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Created new resource entry.");
-
-			m_listenerMapLock.lock();
-			m_deferredResourceListenersMap[resourceID].emplace_back(pListener);
-			m_listenerMapLock.unlock();
-		}
-		else if (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoaded)
-		{
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Resource already loaded.");
+		const ResourceLoadStatus previousStatus = BeginLoad(resourceID, pListener);
+		if (previousStatus == ResourceLoadStatus::kLoaded)
+			return false;
 
-			// This may seem unnecessary, but it is a catch in case no listener was passed in.
-			if (!pListener.expired())
-				pListener.lock()->OnResourceLoaded(resourceID);
+		const uint64_t deadlineNanoseconds = GetDeadlineNanoseconds(deadlineSeconds);
 
-			return; // Bail here. We do NOT want to change the status of the resource.
-		}
-		else if (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoading)
+		if (previousStatus == ResourceLoadStatus::kLoading)
 		{
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Resource already queued.");
-			m_resourceDatabase.IncrementEntryRefCount(resourceID);
-			return; // Bail here. We do NOT want to change the status of the resource.
+			// Someone else owns the load, but this request may need it sooner.
+			UpdateLoadPriority(resourceID, priority, deadlineNanoseconds, true);
+			return true;
 		}
-		else
-		{
-			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Resource was unloaded or unloading. SEE TODO in ResourceLoader.cpp.");
-			/// TODO:
-			///		It is possible that neither of the 2 branches were entered.
-			///		This means that the Resource exists in the database && its
-			///		LoadStatus is neither Loaded or Loading, possibly Unloading
-			///		or Unloaded. This could cause an issue in the future if not
-			///		carefully protected against. For example: The pListener will
-			///		not be called in this case, which is already a bug. Hack fix
-			///		is as follows.
-			///	EDIT:
-			///		I *think* that the resource would have it's ref count incremented
-			///		already, but that may be something to think about here.
-			m_listenerMapLock.lock();
-			m_deferredResourceListenersMap[resourceID].emplace_back(pListener);
-			m_listenerMapLock.unlock();
-		}
-
-		// If we get here, then the resource is now loading.
-		m_resourceDatabase.SetEntryLoadStatus(resourceID, ResourceLoadStatus::kLoading);
-		
+
 		m_deferredQueueLock.lock();
-		m_deferredQueue.emplace_back(resourceID);
+		m_deferredQueue.push_back({ resourceID, priority, deadlineNanoseconds, m_nextLoadSequence++ });
+		m_isDeferredQueueSorted = false;
 		m_deferredQueueLock.unlock();
 
 		if (signalLoaderThread)
-			SignalLoaderThread();
+			ProcessLoadQueue();
 
 		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "QueueLoad Complete.");
+		return true;
 		#else
-		LoadNow(resourceID, pListener);
+		return LoadNow(resourceID, pListener);
 		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 	}
 
+	/// <summary>
+	/// Change the priority and deadline of a queued load, for example
+	/// when a prefetched resource is suddenly needed. Does nothing once
+	/// the resource has been finalized.
+	/// </summary>
+	/// <param name="resourceID">- The resource being loaded.</param>
+	/// <param name="priority">- How urgently the resource is needed.</param>
+	/// <param name="deadlineSeconds">- How many seconds from now the resource should be ready by. 0 for no deadline.</param>
+	/// <returns>True if the load was still queued or waiting to be finalized.</returns>
+	bool ResourceLoader::SetLoadPriority(const ResourceID& resourceID, ResourceLoadPriority priority, float deadlineSeconds)
+	{
+		EXE_ASSERT(resourceID.IsValid());
+		EXE_ASSERT(priority < ResourceLoadPriority::kCount);
+
+		const uint64_t deadlineNanoseconds = GetDeadlineNanoseconds(deadlineSeconds);
+
+		return UpdateLoadPriority(resourceID, priority, deadlineNanoseconds, false);
+	}
+
 	/// <summary>
 	/// Load the given resource immediately. This will happen on the
 	/// calling thread and will be blocking on that thread until the
-	/// resource has completed the load process. If a resource is
-	/// already being loaded then the resource listener will be added
-	/// to the list of listeners to be notified and nothing further
-	/// will happen. If the resource is loaded already then the
-	/// listener will be notified immediately.
-	/// @todo
-	/// Potential data race here, if the listener is added just after
-	/// the loader thread proccesses the listener queue.
-	/// @todo
-	/// A resource that is already queued should be removed from the
-	/// queue and forceloaded here.
+	/// resource has completed the load process. If the resource is
+	/// loaded already then the listener will be notified immediately.
+	/// 
+	/// If the resource is already queued or loading, this waits for
+	/// that load to complete, helping with other jobs in the meantime.
+	/// 
+	/// Called off the main thread, the resource is read and loaded on
+	/// the calling thread, but finalized by the main thread, which
+	/// notifies the listener. This still returns only once the resource
+	/// is finalized, so the main thread must be running its jobs, either
+	/// each frame or while it waits on a counter.
 	/// 
 	/// The loading time of a resource is not predictable, and thus
 	/// the use of the ResourceListener class is highly recomended
@@ -251,49 +342,26 @@ namespace Exelius
 	/// </summary>
 	/// <param name="resourceID">- The filepath of the resource to load. This is a StringIntern for optimization</param>
 	/// <param name="pListener">- The listener to be notified when a resource has completed the load process.</param>
-	void ResourceLoader::LoadNow(const ResourceID& resourceID, ResourceListenerPtr pListener)
+	/// <returns>True if the caller now holds a reference to the resource. False if it was already loaded, and no reference was taken.</returns>
+	bool ResourceLoader::LoadNow(const ResourceID& resourceID, ResourceListenerPtr pListener)
 	{
 		EXE_ASSERT(resourceID.IsValid());
-		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Loading Resource On Main Thread: {}", resourceID.Get().c_str());
-
-		// Check if the resource is already in the resource database.
-		if (m_resourceDatabase.CreateEntry(resourceID))
-		{
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Created new resource entry.");
+		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Loading Resource On Calling Thread: {}", resourceID.Get().c_str());
 
-			#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-			m_listenerMapLock.lock();
-			#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-			m_deferredResourceListenersMap[resourceID].emplace_back(pListener);
-			#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-			m_listenerMapLock.unlock();
-			#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		}
-		else if (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoaded)
-		{
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Resource already loaded.");
-
-			// This may seem unnecessary, but it is a catch in case no listener was passed in.
-			if (!pListener.expired())
-				pListener.lock()->OnResourceLoaded(resourceID);
+		const ResourceLoadStatus previousStatus = BeginLoad(resourceID, pListener);
+		if (previousStatus == ResourceLoadStatus::kLoaded)
+			return false;
 
-			return;
-		}
-		else if (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoading)
+		if (previousStatus == ResourceLoadStatus::kLoading)
 		{
 			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Resource already queued.");
-			// TODO: We may want to consider removing the queued load
-			//		 then forcing the load here.
-			return; // Bail here. We do NOT want to change the status of the resource.
+			WaitForLoad(resourceID);
+			return true;
 		}
 
-		m_resourceDatabase.SetEntryLoadStatus(resourceID, ResourceLoadStatus::kLoading);
-		LoadResource(resourceID); // TODO: Make this a boolean so we can bail on failure.
-
-		if (!pListener.expired()) // This may seem unnecessary, but it is a catch in case no listener was passed in.
-			pListener.lock()->OnResourceLoaded(resourceID);
-
-		//EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Load Complete.");
+		FinalizeNow({ resourceID, ResourceLoadPriority::kImmediate, s_kNoDeadline, 0 }, DecodeResource(resourceID));
+		WaitForLoad(resourceID);
+		return true;
 	}
 
 	void ResourceLoader::CreateNewResource(const ResourceID& resourceID)
@@ -362,7 +430,8 @@ namespace Exelius
 	/// Decrements the reference count on the given resource.
 	/// If there are no longer any references or locks on the
 	/// given resource it will be unloaded when the unload queue
-	/// is processed next.
+	/// is processed next. If it is still queued to load, the
+	/// load is cancelled.
 	/// </summary>
 	/// <param name="resourceID">- The resource to release.</param>
 	void ResourceLoader::ReleaseResource(const ResourceID& resourceID)
@@ -371,8 +440,29 @@ namespace Exelius
 
 		// Decrement the reference count of this resource.
 		// If there is no longer any references to this resource, then unload it.
-		if (m_resourceDatabase.DecrementEntryRefCount(resourceID))
-			m_resourceDatabase.UnloadEntry(resourceID);
+		if (!m_resourceDatabase.DecrementEntryRefCount(resourceID))
+			return;
+
+		m_resourceDatabase.UnloadEntry(resourceID);
+
+		// Nothing wants the resource anymore, so don't start loading it.
+		// Loads already on the workers are cancelled before they are finalized instead.
+		ResourceListeners listeners;
+		bool isCancelled = false;
+		m_deferredQueueLock.lock();
+		auto found = eastl::find_if(m_deferredQueue.begin(), m_deferredQueue.end(), [&resourceID](const LoadRequest& request)
+			{
+				return request.m_resourceID == resourceID;
+			});
+		if (found != m_deferredQueue.end() && TryCancelLoad(resourceID, listeners))
+		{
+			m_deferredQueue.erase(found);
+			isCancelled = true;
+		}
+		m_deferredQueueLock.unlock();
+
+		if (isCancelled)
+			NotifyListeners(resourceID, listeners);
 	}
 
 	/// <summary>
@@ -429,8 +519,14 @@ namespace Exelius
 
 		if (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoading)
 		{
-			EXE_LOG_CATEGORY_INFO("ResourceLoader", "Resource Request Denied: Resource Still Loading.");
-			return nullptr;
+			if (forceLoad)
+				WaitForLoad(resourceID);
+
+			if (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoading)
+			{
+				EXE_LOG_CATEGORY_INFO("ResourceLoader", "Resource Request Denied: Resource Still Loading.");
+				return nullptr;
+			}
 		}
 
 		Resource* pResource = m_resourceDatabase.GetEntryResource(resourceID);
@@ -488,160 +584,381 @@ namespace Exelius
 	}
 
 	/// <summary>
-	/// Signal the resource loader thread to wake up and begin
-	/// loading resources.
+	/// Claim the load of a resource, and add the listener to those
+	/// waiting on it. If the resource is already loaded, the listener
+	/// is notified immediately instead.
 	/// </summary>
-	void ResourceLoader::SignalLoaderThread()
+	/// <param name="resourceID">- The resource to load.</param>
+	/// <param name="pListener">- The listener to be notified when the load completes.</param>
+	/// <returns>The status the resource had. Unless it was kLoading or kLoaded, the caller must now load the resource.</returns>
+	ResourceLoadStatus ResourceLoader::BeginLoad(const ResourceID& resourceID, ResourceListenerPtr pListener)
 	{
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		EXE_ASSERT(m_loaderThread.joinable());
-		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Signaling Loader Thread.");
+		// FinishLoad takes the listeners under this lock too, so a
+		// listener added here is either notified there or sees kLoaded.
+		m_listenerMapLock.lock();
+		const ResourceLoadStatus previousStatus = m_resourceDatabase.BeginEntryLoad(resourceID);
+		if (previousStatus != ResourceLoadStatus::kLoaded && !pListener.expired())
+			m_pendingListenersMap[resourceID].emplace_back(pListener);
+		m_listenerMapLock.unlock();
 
-		m_signalThread.notify_one();
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		if (previousStatus == ResourceLoadStatus::kLoaded)
+		{
+			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Resource already loaded.");
+
+			// This may seem unnecessary, but it is a catch in case no listener was passed in.
+			if (!pListener.expired())
+				pListener.lock()->OnResourceLoaded(resourceID);
+		}
+
+		return previousStatus;
 	}
 
 	/// <summary>
-	/// Signal the resource loader thread to wake up and begin
-	/// loading resources. Sleeps the calling thread until the
-	/// loader thread signals upon completion.
+	/// Wait for a resource that is queued or loading on the workers
+	/// to be finalized. A load that no thread has started yet, queued or
+	/// handed to the workers, is taken and loaded on the calling thread instead.
+	/// 
+	/// Off the main thread, a decoded resource is handed to the main
+	/// thread to finalize as one of its jobs, and this waits until it has.
 	/// </summary>
-	void ResourceLoader::SignalAndWaitForLoaderThread()
+	/// <param name="resourceID">- The resource to wait for.</param>
+	void ResourceLoader::WaitForLoad(const ResourceID& resourceID)
 	{
 		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		SignalLoaderThread();
+		if (!s_pGlobalJobSystem)
+			return;
 
-		std::mutex waitMutex;
-		std::unique_lock<std::mutex> waitLock(waitMutex);
+		EXE_PROFILE_FUNCTION();
 
-		EXE_LOG_CATEGORY_INFO("ResourceLoader", "Waiting for response from LoaderThread.");
-		m_signalThread.wait(waitLock, [this]()
+		while (m_resourceDatabase.GetEntryLoadStatus(resourceID) == ResourceLoadStatus::kLoading)
 		{
-			return !m_quitThread || m_successfulThreadShutdown;
-		});
+			// A load no thread has started yet is quicker to do here than to wait for.
+			// Its job may be a background job that no thread is free to run.
+			LoadRequest unstartedRequest;
+			if (TakeUnstartedLoad(resourceID, unstartedRequest))
+			{
+				FinalizeNow(unstartedRequest, DecodeResource(resourceID));
+				continue;
+			}
+
+			// Finalize it as soon as a worker has decoded it, rather than within a later frame's budget.
+			PendingFinalize pendingFinalize;
+			bool wasDecoded = false;
+			m_finalizeQueueLock.lock();
+			auto foundFinalize = eastl::find_if(m_finalizeQueue.begin(), m_finalizeQueue.end(), [&resourceID](const PendingFinalize& pendingFinalize)
+				{
+					return pendingFinalize.m_request.m_resourceID == resourceID;
+				});
+			if (foundFinalize != m_finalizeQueue.end())
+			{
+				pendingFinalize = *foundFinalize;
+				m_finalizeQueue.erase(foundFinalize);
+				wasDecoded = true;
+			}
+			m_finalizeQueueLock.unlock();
+
+			if (wasDecoded)
+				FinalizeNow(pendingFinalize.m_request, pendingFinalize.m_pResource);
+			else
+				s_pGlobalJobSystem->CycleThread();
+		}
 		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 	}
 
 	/// <summary>
-	/// This is the instantiation function for the loader thread.
-	/// 
-	/// Double Buffered Resource Loading System:
-	/// 
-	/// The main thread will add resources and listners to a 
-	/// couple of queues to be loaded and called, respectively.
-	/// 
-	/// When signaled, the loader thread will swap the deferred
-	/// queues to be processed, allowing the main thread to continue
-	/// to queue resources and listeners.
-	/// 
-	/// After the swap, the loader thread will load any queued
-	/// resources from either raw asset files or a compressed
-	/// asset package. Once a resource is loaded, the listeners
-	/// attached to that resource will be called.
-	/// 
-	/// Once the loader thread has completed this process, it will
-	/// signal to the main thread that it has completed, and sleep
-	/// until the next signal to begin processing.
-	/// 
-	/// This thread will then have access to the following functions
-	/// and thus these functions should be used with this in mind:
-	///		ResourceLoader::LoadResource()
-	/// 	ResourceLoader::LoadRawData()
-	/// 	ResourceLoader::LoadFromDisk()
-	/// 	ResourceLoader::LoadFromZip()
-	/// 	ResourceDatabase::SetEntryLoadStatus()
-	///		ResourceDatabase::SetEntryResource()
-	///		ResourceDatabase::UnloadEntry()
-	///		ResourceEntry::SetResource()
-	/// 	ResourceEntry::SetStatus()
-	/// 	ResourceFactory::CreateResource()*
-	/// 	ResourceFactory::GetResourceType()*
-	/// 	ResourceListener::OnResourceLoaded()*
-	/// 	Resource::Load()*
-	/// 
-	/// *These can be inhereted from within client applications so
-	/// special care needs to be made here.
+	/// Take a load that no thread has started yet, whether it is still
+	/// queued or has been handed to the workers, so the caller can do it.
 	/// </summary>
-	void ResourceLoader::ProcessResourceQueue()
+	/// <param name="resourceID">- The resource being loaded.</param>
+	/// <param name="request">- Receives the load that was taken.</param>
+	/// <returns>True if the load was taken.</returns>
+	bool ResourceLoader::TakeUnstartedLoad(const ResourceID& resourceID, LoadRequest& request)
 	{
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-		EXE_LOG_CATEGORY_INFO("ResourceLoader", "Instantiating Resource Loader Thread.");
-		std::mutex waitMutex;
+		auto TakeRequest = [&resourceID, &request](eastl::vector<LoadRequest>& requests)
+			{
+				auto found = eastl::find_if(requests.begin(), requests.end(), [&resourceID](const LoadRequest& queuedRequest)
+					{
+						return queuedRequest.m_resourceID == resourceID;
+					});
+				if (found == requests.end())
+					return false;
+
+				request = *found;
+				requests.erase(found);
+				return true;
+			};
 
-		// TODO: Consider if this is the best container to use here.
-		eastl::deque<ResourceID> processingQueue;
-		ListenersMap processingResourceListenersMap;
-		std::unique_lock<std::mutex> waitLock(waitMutex);
+		m_deferredQueueLock.lock();
+		const bool isTaken = TakeRequest(m_deferredQueue) || TakeRequest(m_dispatchedLoads);
+		m_deferredQueueLock.unlock();
 
-		// While the thread is still active (Not shut down)
-		while (!m_quitThread)
-		{
-			// Wait until we are signaled to work.
-			m_signalThread.wait(waitLock, [this]()
+		return isTaken;
+	}
+
+	/// <summary>
+	/// Change the priority and deadline of a load still in the deferred or finalize queue.
+	/// </summary>
+	/// <param name="resourceID">- The resource being loaded.</param>
+	/// <param name="priority">- How urgently the resource is needed.</param>
+	/// <param name="deadlineNanoseconds">- When the resource should be ready by. s_kNoDeadline for none.</param>
+	/// <param name="onlyRaise">- Keep the current priority or deadline where it is more urgent.</param>
+	/// <returns>True if the load was found.</returns>
+	bool ResourceLoader::UpdateLoadPriority(const ResourceID& resourceID, ResourceLoadPriority priority, uint64_t deadlineNanoseconds, bool onlyRaise)
+	{
+		auto UpdateRequest = [priority, deadlineNanoseconds, onlyRaise](LoadRequest& request)
 			{
-				bool empty = true;
+				request.m_priority = onlyRaise ? eastl::min(request.m_priority, priority) : priority;
+				request.m_deadlineNanoseconds = onlyRaise ? eastl::min(request.m_deadlineNanoseconds, deadlineNanoseconds) : deadlineNanoseconds;
+			};
 
-				m_deferredQueueLock.lock();
-				empty = m_deferredQueue.empty();
-				m_deferredQueueLock.unlock();
+		bool isFound = false;
+		m_deferredQueueLock.lock();
+		for (LoadRequest& request : m_deferredQueue)
+		{
+			if (request.m_resourceID != resourceID)
+				continue;
 
-				return m_quitThread || !empty;
-			});
+			UpdateRequest(request);
+			m_isDeferredQueueSorted = false;
+			isFound = true;
+			break;
+		}
+		m_deferredQueueLock.unlock();
+
+		if (isFound)
+			return true;
+
+		m_finalizeQueueLock.lock();
+		for (PendingFinalize& pendingFinalize : m_finalizeQueue)
+		{
+			if (pendingFinalize.m_request.m_resourceID != resourceID)
+				continue;
+
+			UpdateRequest(pendingFinalize.m_request);
+			m_isFinalizeQueueSorted = false;
+			isFound = true;
+			break;
+		}
+		m_finalizeQueueLock.unlock();
+
+		return isFound;
+	}
+
+	/// <summary>
+	/// Push a job for each queued load the workers have room for.
+	/// Must be called with m_deferredQueueLock held.
+	/// </summary>
+	void ResourceLoader::DispatchQueuedLoads()
+	{
+		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		if (m_deferredQueue.empty())
+			return;
 
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Loader Thread Received Signal");
+		if (!m_isDeferredQueueSorted)
+		{
+			eastl::sort(m_deferredQueue.begin(), m_deferredQueue.end(), &ResourceLoader::IsLessUrgent);
+			m_isDeferredQueueSorted = true;
+		}
+
+		const uint32_t maxLoadsInFlight = eastl::max<uint32_t>(s_pGlobalJobSystem->GetWorkerCount(), 1) * s_kLoadsInFlightPerWorker;
 
-			// Don't do any work if we're exiting.
-			if (m_quitThread)
+		// Wake the workers once for every load started here.
+		ScopedJobBatch batch(*s_pGlobalJobSystem);
+		uint32_t dispatchedCount = 0;
+		while (!m_deferredQueue.empty())
+		{
+			// Immediate loads don't wait for room.
+			const LoadRequest request = m_deferredQueue.back();
+			if (m_loadsInFlight >= maxLoadsInFlight && request.m_priority != ResourceLoadPriority::kImmediate)
 				break;
 
-			/// Capture the deferred queue into the processing queue (swap buffers)
-			m_deferredQueueLock.lock();
-			processingQueue.swap(m_deferredQueue);
-			m_deferredQueueLock.unlock();
+			m_deferredQueue.pop_back();
+			++m_loadsInFlight;
+			++dispatchedCount;
+
+			const JobPriority jobPriority = request.m_priority == ResourceLoadPriority::kImmediate ? JobPriority::kNormal : JobPriority::kBackground;
+			m_dispatchedLoads.push_back(request);
+			s_pGlobalJobSystem->PushJob([this, request]()
+				{
+					// A thread waiting on the load may have taken it to do itself.
+					m_deferredQueueLock.lock();
+					auto found = eastl::find_if(m_dispatchedLoads.begin(), m_dispatchedLoads.end(), [&request](const LoadRequest& dispatchedRequest)
+						{
+							return dispatchedRequest.m_sequence == request.m_sequence;
+						});
+					const bool isTaken = (found == m_dispatchedLoads.end());
+					if (!isTaken)
+						m_dispatchedLoads.erase(found);
+					m_deferredQueueLock.unlock();
+
+					if (!isTaken)
+						QueueFinalize(request, DecodeResource(request.m_resourceID));
+
+					// Start the next most urgent load in its place.
+					m_deferredQueueLock.lock();
+					--m_loadsInFlight;
+					DispatchQueuedLoads();
+					m_deferredQueueLock.unlock();
+				}, &m_loadCounter, jobPriority);
+		}
 
-			m_listenerMapLock.lock();
-			processingResourceListenersMap.swap(m_deferredResourceListenersMap);
-			m_listenerMapLock.unlock();
+		if (dispatchedCount > 0)
+			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Dispatching {} resource loads.", dispatchedCount);
+		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+	}
 
-			// Process the queue
-			while (!processingQueue.empty())
-			{
-				EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Loader Thread Loading: {}", processingQueue.front().Get().c_str());
-				LoadResource(processingQueue.front());
+	/// <summary>
+	/// Hand a decoded resource to the main thread to be finalized.
+	/// </summary>
+	/// <param name="request">- The load the resource was decoded for.</param>
+	/// <param name="pResource">- The resource returned by DecodeResource. nullptr if the load failed.</param>
+	void ResourceLoader::QueueFinalize(const LoadRequest& request, Resource* pResource)
+	{
+		m_finalizeQueueLock.lock();
+		m_finalizeQueue.push_back({ request, pResource });
+		m_isFinalizeQueueSorted = false;
+		m_finalizeQueueLock.unlock();
+	}
 
-				// Notify all the listeners that we are done loading.
-				for (auto& listener : processingResourceListenersMap[processingQueue.front()])
+	/// <summary>
+	/// Finalize a resource the calling thread is waiting on. Off the
+	/// main thread, it is pushed to the main thread as a job instead,
+	/// to be finalized the next time the main thread runs its jobs.
+	/// </summary>
+	/// <param name="request">- The load the resource was decoded for.</param>
+	/// <param name="pResource">- The resource returned by DecodeResource. nullptr if the load failed.</param>
+	void ResourceLoader::FinalizeNow(const LoadRequest& request, Resource* pResource)
+	{
+		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		if (s_pGlobalJobSystem && !s_pGlobalJobSystem->IsMainThread())
+		{
+			s_pGlobalJobSystem->PushMainThreadJob([this, request, pResource]()
 				{
-					if (listener.expired())
-						continue;
+					FinalizeLoad({ request, pResource });
+				}, &m_loadCounter);
+			return;
+		}
+		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
-					listener.lock()->OnResourceLoaded(processingQueue.front());
-				}
-				processingResourceListenersMap[processingQueue.front()].clear();
+		FinishLoad(request.m_resourceID, pResource);
+	}
 
-				EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Loader Thread Loading Complete.");
-				processingQueue.pop_front();
-			}
+	/// <summary>
+	/// Main thread only.
+	/// Finalize a resource taken from the finalize queue, unless its load was cancelled.
+	/// </summary>
+	/// <param name="pendingFinalize">- The resource to finalize.</param>
+	void ResourceLoader::FinalizeLoad(const PendingFinalize& pendingFinalize)
+	{
+		const LoadRequest& request = pendingFinalize.m_request;
+
+		// Released while it was decoding, so skip the upload.
+		ResourceListeners listeners;
+		if (TryCancelLoad(request.m_resourceID, listeners))
+		{
+			delete pendingFinalize.m_pResource;
+			NotifyListeners(request.m_resourceID, listeners);
+			return;
+		}
+
+		if (request.m_deadlineNanoseconds != s_kNoDeadline)
+		{
+			const uint64_t nowNanoseconds = GetLoadTimeNanoseconds();
+			if (nowNanoseconds > request.m_deadlineNanoseconds)
+				EXE_LOG_CATEGORY_INFO("ResourceLoader", "'{}' missed its load deadline by {}ms.", request.m_resourceID.Get().c_str(), (nowNanoseconds - request.m_deadlineNanoseconds) / 1000000);
+		}
+
+		FinishLoad(request.m_resourceID, pendingFinalize.m_pResource);
+	}
 
-			// Done loading this pass, so signal the main thread in case it is waiting.
-			m_signalThread.notify_one();
-			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Signaled Main Thread: Queue Finished");
+	/// <summary>
+	/// Cancel a load if nothing holds its resource anymore. Its listeners
+	/// are handed back, to be notified with NotifyListeners as if the load
+	/// had failed once the caller holds no locks.
+	/// </summary>
+	/// <param name="resourceID">- The resource being loaded.</param>
+	/// <param name="listeners">- Receives the listeners waiting on the load.</param>
+	/// <returns>True if the load was cancelled.</returns>
+	bool ResourceLoader::TryCancelLoad(const ResourceID& resourceID, ResourceListeners& listeners)
+	{
+		// Under the same lock as BeginLoad, so a listener is either handed back here or starts a new load.
+		m_listenerMapLock.lock();
+		const bool isCancelled = m_resourceDatabase.CancelEntryLoad(resourceID);
+		if (isCancelled)
+		{
+			auto foundListeners = m_pendingListenersMap.find(resourceID);
+			if (foundListeners != m_pendingListenersMap.end())
+			{
+				listeners.swap(foundListeners->second);
+				m_pendingListenersMap.erase(foundListeners);
+			}
 		}
+		m_listenerMapLock.unlock();
 
-		// Let the main thread know we are fully exiting in case they are waiting.
-		m_successfulThreadShutdown = true;
-		EXE_LOG_CATEGORY_INFO("ResourceLoader", "Signaled Main Thread: Thread Terminating.");
-		m_signalThread.notify_one();
+		if (isCancelled)
+			EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Cancelled Loading: {}", resourceID.Get().c_str());
+
+		return isCancelled;
+	}
+
+	/// <summary>
+	/// Whether a load should be started or finalized after another.
+	/// Lower priorities, then later deadlines, then later requests, are less urgent.
+	/// </summary>
+	bool ResourceLoader::IsLessUrgent(const LoadRequest& lhs, const LoadRequest& rhs)
+	{
+		if (lhs.m_priority != rhs.m_priority)
+			return lhs.m_priority > rhs.m_priority;
+
+		if (lhs.m_deadlineNanoseconds != rhs.m_deadlineNanoseconds)
+			return lhs.m_deadlineNanoseconds > rhs.m_deadlineNanoseconds;
+
+		return lhs.m_sequence > rhs.m_sequence;
+	}
+
+	/// <summary>
+	/// Notify the listeners of a finished load. Off the main thread,
+	/// they are notified by the main thread instead.
+	/// </summary>
+	/// <param name="resourceID">- The resource that finished loading.</param>
+	/// <param name="listeners">- The listeners waiting on it.</param>
+	void ResourceLoader::NotifyListeners(const ResourceID& resourceID, ResourceListeners& listeners)
+	{
+		if (listeners.empty())
+			return;
+
+		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		if (s_pGlobalJobSystem && !s_pGlobalJobSystem->IsMainThread())
+		{
+			s_pGlobalJobSystem->PushMainThreadJob([this, resourceID, listeners = eastl::move(listeners)]() mutable
+				{
+					NotifyListeners(resourceID, listeners);
+				}, &m_loadCounter);
+			return;
+		}
 		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+
+		for (auto& listener : listeners)
+		{
+			if (listener.expired())
+				continue;
+
+			listener.lock()->OnResourceLoaded(resourceID);
+		}
 	}
 
 	/// <summary>
-	/// Load the given resource. Upon failure, ResourceDatabase::UnloadEntry
-	/// will be called, removing the entry from the database.
+	/// Read the raw data of the resource and create it through the
+	/// factory, then run Resource::Load. Safe to call from any thread,
+	/// as long as the factory and the resource's Load are.
 	/// </summary>
 	/// <param name="resourceID">- The resource to load.</param>
-	void ResourceLoader::LoadResource(const ResourceID& resourceID)
+	/// <returns>The loaded resource, waiting to be finalized. nullptr on failure.</returns>
+	Resource* ResourceLoader::DecodeResource(const ResourceID& resourceID)
 	{
+		EXE_PROFILE_FUNCTION();
+		ScopedMemoryTag memoryTag(MemoryTag::kResources);
+
 		EXE_ASSERT(resourceID.IsValid());
 		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Loading Resource Internally: {}", resourceID.Get().c_str());
 
@@ -652,41 +969,68 @@ namespace Exelius
 		if (rawData.empty())
 		{
 			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Raw file data was empty.");
-			m_resourceDatabase.UnloadEntry(resourceID);
-			m_resourceDatabase.DecrementEntryRefCount(resourceID);
-			// TODO: Can the resource state be set to unloading here? Reasonable?
-			//m_resourceDatabase.SetEntryLoadStatus(resourceID, ResourceLoadStatus::kUnloading);
-			return;
+			return nullptr;
 		}
 
 		Resource* pResource = m_pResourceFactory->CreateResource(resourceID);
 		if (!pResource)
 		{
 			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Failed to create resource from resource factory.");
-			m_resourceDatabase.UnloadEntry(resourceID);
-			m_resourceDatabase.DecrementEntryRefCount(resourceID);
-			// TODO: Can the resource state be set to unloading here? Reasonable?
-			//m_resourceDatabase.SetEntryLoadStatus(resourceID, ResourceLoadStatus::kUnloading);
-			return;
+			return nullptr;
 		}
 
-		if (pResource->Load(std::move(rawData)) != Resource::LoadResult::kFailed)
+		if (pResource->Load(std::move(rawData)) == Resource::LoadResult::kFailed)
 		{
-			m_resourceDatabase.SetEntryResource(resourceID, pResource);
+			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Failed to load resource from raw data.");
+			delete pResource;
+			return nullptr;
 		}
-		else
+
+		return pResource;
+	}
+
+	/// <summary>
+	/// Main thread only.
+	/// Run Resource::Finalize, publish the resource to the database
+	/// and notify everything listening for it.
+	/// </summary>
+	/// <param name="resourceID">- The resource that was loaded.</param>
+	/// <param name="pResource">- The resource returned by DecodeResource. nullptr if the load failed.</param>
+	void ResourceLoader::FinishLoad(const ResourceID& resourceID, Resource* pResource)
+	{
+		EXE_PROFILE_FUNCTION();
+		ScopedMemoryTag memoryTag(MemoryTag::kResources);
+
+		if (pResource && !pResource->Finalize())
 		{
-			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Failed to load resource from raw data.");
-			m_resourceDatabase.UnloadEntry(resourceID);
-			m_resourceDatabase.DecrementEntryRefCount(resourceID);
-			// TODO: Can the resource state be set to unloading here? Reasonable?
-			//m_resourceDatabase.SetEntryLoadStatus(resourceID, ResourceLoadStatus::kUnloading);
-			return;
+			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Failed to finalize resource '{}'.", resourceID.Get().c_str());
+			delete pResource;
+			pResource = nullptr;
 		}
 
-		m_resourceDatabase.SetEntryLoadStatus(resourceID, ResourceLoadStatus::kLoaded);
+		// A failed entry is left empty, and unloads once its last reference is released.
+		ResourceListeners listeners;
+		m_listenerMapLock.lock();
+		const bool hasEntry = m_resourceDatabase.FinishEntryLoad(resourceID, pResource);
+		auto foundListeners = m_pendingListenersMap.find(resourceID);
+		if (foundListeners != m_pendingListenersMap.end())
+		{
+			listeners.swap(foundListeners->second);
+			m_pendingListenersMap.erase(foundListeners);
+		}
+		m_listenerMapLock.unlock();
+
+		if (!hasEntry && pResource)
+		{
+			EXE_LOG_CATEGORY_WARN("ResourceLoader", "Resource '{}' was removed from the database while loading.", resourceID.Get().c_str());
+			pResource->Unload();
+			delete pResource;
+		}
 
-		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Completed Loading Internally.");
+		// Notify all the listeners that we are done loading.
+		NotifyListeners(resourceID, listeners);
+
+		EXE_LOG_CATEGORY_TRACE("ResourceLoader", "Completed Loading: {}", resourceID.Get().c_str());
 	}
 
 	/// <summary>
@@ -706,7 +1050,7 @@ namespace Exelius
 		}
 		else
 		{
-			return LoadFromZip(resourceID);
+			return LoadFromArchive(resourceID);
 		}
 	}
 
@@ -740,18 +1084,73 @@ namespace Exelius
 	}
 
 	/// <summary>
-	/// Load the given resource directly from a compressed file.
-	/// @todo
-	/// Currently unused.
+	/// Load the given resource from the mounted archives. Stored
+	/// files are copied straight out of the mapped archive, and
+	/// compressed files are decompressed straight into the returned data.
+	/// Safe to call from several threads at once.
 	/// </summary>
 	/// <param name="resourceID">- The resource to load.</param>
 	/// <returns>The loaded raw data in a vector of bytes. The vector will be empty on failure.</returns>
-	eastl::vector<std::byte> ResourceLoader::LoadFromZip(const ResourceID& resourceID)
+	eastl::vector<std::byte> ResourceLoader::LoadFromArchive(const ResourceID& resourceID)
 	{
-		eastl::string strPath = resourceID.Get();
-		// TODO: Do this.
+		EXE_ASSERT(resourceID.IsValid());
+
+		// Loads only read the archives, so any number can hold this at once.
+		std::shared_lock<std::shared_mutex> lock(m_archivesLock);
+
+		eastl::vector<std::byte> resourceData;
+		for (auto archiveIterator = m_archives.rbegin(); archiveIterator != m_archives.rend(); ++archiveIterator)
+		{
+			if ((*archiveIterator)->ReadResource(resourceID, resourceData))
+				return resourceData;
+		}
+
+		EXE_LOG_CATEGORY_WARN("ResourceLoader", "'{}' was not found in any mounted archive.", resourceID.Get().c_str());
+		return resourceData;
+	}
+
+	/// <summary>
+	/// Map an asset pack (.expak) or zip archive and read its contents,
+	/// so resources can be loaded from it when not using raw assets.
+	/// Files in archives mounted later take precedence over earlier ones.
+	/// Safe to call while resources are loading.
+	/// </summary>
+	/// <param name="pArchivePath">- The archive to mount.</param>
+	/// <returns>True if the archive was mounted.</returns>
+	bool ResourceLoader::MountArchive(const char* pArchivePath)
+	{
+		EXE_ASSERT(pArchivePath);
+		ScopedMemoryTag memoryTag(MemoryTag::kResources);
+
+		// Indexed before taking the lock, so loads aren't held up.
+		ResourceArchive* pArchive = nullptr;
+		if (File::GetFileExtension(pArchivePath) == "expak")
+			pArchive = EXELIUS_NEW(ExpakArchive());
+		else
+			pArchive = EXELIUS_NEW(ZipArchive());
+
+		if (!pArchive->Open(pArchivePath))
+		{
+			EXELIUS_DELETE(pArchive);
+			return false;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(m_archivesLock);
+		m_archives.emplace_back(pArchive);
+		return true;
+	}
 
-		return eastl::vector<std::byte>();
+	/// <summary>
+	/// Unmount every archive. Waits for any loads reading from them.
+	/// </summary>
+	void ResourceLoader::UnmountArchives()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_archivesLock);
+		for (ResourceArchive* pArchive : m_archives)
+		{
+			EXELIUS_DELETE(pArchive);
+		}
+		m_archives.clear();
 	}
 
 	void ResourceLoader::SaveToDisk(const ResourceID& resourceID, const eastl::vector<std::byte>& data)
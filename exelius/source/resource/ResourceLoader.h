@@ -1,20 +1,18 @@
 #pragma once
+#include "source/os/threads/JobSystem.h"
 #include "source/utility/generic/Singleton.h"
 #include "source/utility/generic/SmartPointers.h"
 #include "source/resource/ResourceDatabase.h"
 
-#include <EASTL/deque.h>
 #include <EASTL/vector.h>
 
-#define FORCE_SINGLE_THREADED_RESOURCE_LOADER 1
-
-#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
-	#include <thread>
-	#include <condition_variable>
-	#include <atomic>
-	#include <mutex>
-#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
+#include <mutex>
+#include <shared_mutex>
 
+// Set to 1 to load every resource on the calling thread, as if LoadNow had been called.
+#ifndef FORCE_SINGLE_THREADED_RESOURCE_LOADER
+	#define FORCE_SINGLE_THREADED_RESOURCE_LOADER 0
+#endif // FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
@@ -23,13 +21,25 @@ namespace Exelius
 {
 	class ResourceFactory;
 	class ResourceListener;
+	class ResourceArchive;
 	using ResourceListenerPtr = WeakPtr<ResourceListener>; // "Forward Declaring" ResourceListenerPtr from ResourceListener.h
 
 	/// <summary>
 	/// Loading of resources is managed by this class. Resources can
-	/// be loaded in the main thread or on a separate dedicated thread.
+	/// be loaded on the calling thread, or queued to be loaded by the
+	/// job system's workers.
+	/// 
+	/// Queued loads are handed to the workers as background jobs, a few
+	/// per worker at once, most urgent first. Each reads the raw data and
+	/// runs Resource::Load on its worker, then hands the resource back to
+	/// the main thread, which runs Resource::Finalize within a per-frame
+	/// budget, marks the resource as loaded and notifies its listeners.
+	/// Listeners of queued loads are therefore always notified on the main thread.
 	/// 
-	/// The threaded loading is implemented via a Double Buffered System.
+	/// Loads carry a ResourceLoadPriority and an optional deadline, which
+	/// can be changed until they are finalized. A load whose resource is
+	/// released by everything that requested it before it is started, or
+	/// before it is finalized, is cancelled.
 	/// 
 	/// The resource loader then calls on the resource factory to
 	/// create the specific type of resources based on criteria defined
@@ -38,6 +48,13 @@ namespace Exelius
 	/// @see ResourceFactory
 	/// @see ExeliusResourceFactory
 	/// 
+	/// Unless raw assets are used, raw data is read from the archives
+	/// mounted with MountArchive, rather than from loose files. The engine's
+	/// resources are expected in an archive next to their folder, for example:
+	/// "EngineResources.expak" or "EngineResources.zip" for "EngineResources/".
+	/// @see ExpakArchive
+	/// @see ZipArchive
+	/// 
 	/// Lastly, the loaded resource is then stored as a reference counted
 	/// object within a resource database. This allows for resources to
 	/// have a lifetime determined by their use.
@@ -52,8 +69,7 @@ namespace Exelius
 	/// 
 	/// @todo
 	/// The resource loader needs some additional functionality:
-	/// 1) The ability to load assets from a compressed file
-	/// is not functional.
+	/// 1) Saving assets to a compressed file is not functional.
 	/// 2) The use of engine and client resources is not in
 	/// use.
 	/// 3) The engine should be able to determine whether or
@@ -61,12 +77,10 @@ namespace Exelius
 	/// by the config file.
 	/// 4) The resource loader does not make use of the
 	/// config file currently.
-	/// 5) The resource loader should be capable of being
-	/// forced into single threaded mode.
-	/// 6) The resource loader should allow for hot-reloading
+	/// 5) The resource loader should allow for hot-reloading
 	/// of assets in some form, whether that is automatic or manual.
 	/// This could also be a user setting as well.
-	/// 7) The loader should allow multiple listeners of a resource
+	/// 6) The loader should allow multiple listeners of a resource
 	/// to be passed in to a single resource load call.
 	/// </summary>
 	class ResourceLoader
@@ -84,19 +98,16 @@ namespace Exelius
 		using ListenersMap = eastl::unordered_map<ResourceID, ResourceListeners>;
 
 		/// <summary>
-		/// A map of listeners keyed by resource ID, allowing multiple listeners
-		/// to listen for a single resource being loaded.
+		/// The listeners waiting on each resource that is loading.
 		/// </summary>
-		ListenersMap m_deferredResourceListenersMap;
+		ListenersMap m_pendingListenersMap;
 
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		/// <summary>
-		/// A mutex used to protect the listeners from data race conditions.
-		/// This allows the main thread and resource thread to swap maps
-		/// safely.
+		/// Guards the listeners. Held while claiming and completing loads,
+		/// so a listener can't be added just after its resource's listeners
+		/// have been notified.
 		/// </summary>
 		std::mutex m_listenerMapLock;
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
 		/// <summary>
 		/// The resource factory as defined by either the Engine or the Client.
@@ -104,59 +115,102 @@ namespace Exelius
 		/// </summary>
 		ResourceFactory* m_pResourceFactory;
 
-		#if !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 		/// <summary>
-		/// The dedicated resource loading thread.
+		/// The resource database containing all the managed resources.
+		/// Manages the lifetime of the resources automatically in
+		/// conjunction with the ResourceHandle.
+		/// @see ResourceDatabase
+		/// @see ResourceHandle
+		/// </summary>
+		ResourceDatabase m_resourceDatabase;
+
+		/// <summary>
+		/// A queued load, and how urgently it is needed.
 		/// </summary>
-		std::thread m_loaderThread;
+		struct LoadRequest
+		{
+			ResourceID m_resourceID;
+			ResourceLoadPriority m_priority;
+
+			/// <summary>
+			/// When the resource should be ready by, on the steady clock. s_kNoDeadline if it has none.
+			/// </summary>
+			uint64_t m_deadlineNanoseconds;
+
+			/// <summary>
+			/// Keeps requests of the same priority and deadline in the order they were queued.
+			/// </summary>
+			uint64_t m_sequence;
+		};
+
+		/// <summary>
+		/// A resource decoded by a worker, waiting to be finalized on the main thread.
+		/// </summary>
+		struct PendingFinalize
+		{
+			LoadRequest m_request;
+			Resource* m_pResource;
+		};
+
+		static constexpr uint64_t s_kNoDeadline = UINT64_MAX;
+
+		/// <summary>
+		/// How many loads each worker may have in flight. The rest wait in
+		/// the queue, where more urgent loads can still overtake them.
+		/// </summary>
+		static constexpr uint32_t s_kLoadsInFlightPerWorker = 4;
 
 		/// <summary>
-		/// To shutdown the loader thread or continue operations.
-		/// The thread will shutdown if this is true.
+		/// Milliseconds of finalization allowed each frame by default.
 		/// </summary>
-		std::atomic_bool m_quitThread;
+		static constexpr float s_kDefaultFinalizeBudgetMilliseconds = 2.0f;
 
 		/// <summary>
-		/// The loader thread will set this to true on successfully
-		/// shutting down. This prevents a deadlock in the case
-		/// that the thread shuts down prior to the main thread
-		/// signaling and waiting for the shutdown to complete.
+		/// Loads waiting to be handed to the workers. Sorted so the most
+		/// urgent is at the back, whenever m_isDeferredQueueSorted is false.
 		/// </summary>
-		std::atomic_bool m_successfulThreadShutdown;
+		eastl::vector<LoadRequest> m_deferredQueue;
 
 		/// <summary>
-		/// Signal for when the resource queue needs to be processed
-		/// or to signal the main thread that the resource thread has
-		/// completed processing.
+		/// The loads handed to the workers that they haven't decoded yet.
 		/// </summary>
-		std::condition_variable m_signalThread;
+		uint32_t m_loadsInFlight;
+
+		/// <summary>
+		/// Loads handed to the workers whose jobs haven't started yet.
+		/// A thread waiting on one takes it from here and does it itself.
+		/// </summary>
+		eastl::vector<LoadRequest> m_dispatchedLoads;
+
+		uint64_t m_nextLoadSequence;
+
+		bool m_isDeferredQueueSorted;
 
 		/// <summary>
-		/// A mutex used to protect the queue from data race conditions.
-		/// This allows the main thread and resource thread to swap queues
-		/// safely.
+		/// A mutex used to protect the queue, and the loads in flight, from data race conditions.
 		/// </summary>
 		std::mutex m_deferredQueueLock;
-		#endif // !FORCE_SINGLE_THREADED_RESOURCE_LOADER
 
 		/// <summary>
-		/// The resource database containing all the managed resources.
-		/// Manages the lifetime of the resources automatically in
-		/// conjunction with the ResourceHandle.
-		/// @see ResourceDatabase
-		/// @see ResourceHandle
+		/// Decoded resources waiting to be finalized by ProcessFinalizeQueue.
+		/// Sorted the same way as the deferred queue.
 		/// </summary>
-		ResourceDatabase m_resourceDatabase;
+		eastl::vector<PendingFinalize> m_finalizeQueue;
+
+		bool m_isFinalizeQueueSorted;
+
+		std::mutex m_finalizeQueueLock;
 
 		/// <summary>
-		/// The queue containing the resources to be loaded.
-		/// This will be swapped safely onto the resource
-		/// thread.
-		/// @todo
-		/// Consider whether or not this is the best container
-		/// to use here.
+		/// Milliseconds of finalization ProcessFinalizeQueue may run each frame.
 		/// </summary>
-		eastl::deque<ResourceID> m_deferredQueue;
+		float m_finalizeBudgetMilliseconds;
+
+		/// <summary>
+		/// Counts the loads handed to the workers that haven't been decoded
+		/// yet, and the notifications handed to the main thread.
+		/// </summary>
+		JobCounter m_loadCounter;
 
 		/// <summary>
 		/// The path containing the engine specific resources,
@@ -180,6 +234,18 @@ namespace Exelius
 		/// </summary>
 		bool m_useRawAssets;
 
+		/// <summary>
+		/// The archives resources are loaded from when not using raw
+		/// assets, searched from the most recently mounted.
+		/// </summary>
+		eastl::vector<ResourceArchive*> m_archives;
+
+		/// <summary>
+		/// Shared by the loads reading from the archives,
+		/// exclusive while mounting and unmounting them.
+		/// </summary>
+		std::shared_mutex m_archivesLock;
+
 	public:
 		/// <summary>
 		/// Constructor default initializes member data.
@@ -192,14 +258,14 @@ namespace Exelius
 
 		/// <summary>
 		/// Destructor handles the safe shutdown and destruction of
-		/// resources and the resource thread.
+		/// resources, waiting for any loads still in flight.
 		/// </summary>
 		~ResourceLoader();
 
 		/// <summary>
 		/// Initialization sets the resource factory given by the application,
-		/// sets the path to the engine and client resources, determines the
-		/// way resources are retrieved and spins up the resource thread.
+		/// sets the path to the engine and client resources and determines the
+		/// way resources are retrieved.
 		/// The data provided for this function is retrieved from the config
 		/// file in, and this function is called from, the Application.
 		/// @see Application
@@ -224,15 +290,49 @@ namespace Exelius
 		void ProcessUnloadQueue();
 
 		/// <summary>
-		/// Queue the resource to be loaded. This will defer the load to
-		/// the resource thread if running in multithreaded mode. If a
-		/// resource is already being loaded then the resource listener
-		/// will be added to the list of listeners to be notified and
-		/// nothing further will happen. If the resource is loaded already
-		/// then the listener will be notified immediately.
-		/// @todo
-		/// Potential data race here, if the listener is added just after
-		/// the loader thread proccesses the listener queue.
+		/// Hand the most urgent queued loads to the job system's workers,
+		/// up to a few per worker. The workers start the next ones as they
+		/// finish. This happens once per frame, or straight away when a
+		/// load is queued with signalLoaderThread set.
+		/// </summary>
+		void ProcessLoadQueue();
+
+		/// <summary>
+		/// Main thread only.
+		/// Finalize decoded resources, most urgent first, until the frame's
+		/// finalize budget is spent. Immediate loads, and loads past their
+		/// deadline, are finalized regardless of the budget.
+		/// This happens once per frame and should not be called by the client.
+		/// </summary>
+		void ProcessFinalizeQueue();
+
+		/// <summary>
+		/// Set how long ProcessFinalizeQueue may spend each frame. At least
+		/// one resource is finalized each frame, however small the budget.
+		/// </summary>
+		/// <param name="milliseconds">- The time allowed for finalizing resources each frame.</param>
+		void SetFinalizeBudget(float milliseconds) { m_finalizeBudgetMilliseconds = milliseconds; }
+
+		/// <summary>
+		/// Retrieve how long ProcessFinalizeQueue may spend each frame.
+		/// </summary>
+		/// <returns>The time allowed for finalizing resources each frame, in milliseconds.</returns>
+		float GetFinalizeBudget() const { return m_finalizeBudgetMilliseconds; }
+
+		/// <summary>
+		/// Queue the resource to be loaded by the job system's workers,
+		/// once the queue is next processed. If a resource is already
+		/// being loaded then the resource listener will be added to the
+		/// list of listeners to be notified and nothing further will happen.
+		/// If the resource is loaded already then the listener will be
+		/// notified immediately. Otherwise, it is notified on the main
+		/// thread once the load completes, whether it succeeded or not.
+		/// 
+		/// Queueing a resource that is already queued raises the priority
+		/// and deadline of its load to the more urgent of the two.
+		/// 
+		/// Without a job system, or with FORCE_SINGLE_THREADED_RESOURCE_LOADER
+		/// set, this is the same as LoadNow.
 		/// 
 		/// The loading time of a resource is not predictable, and thus
 		/// the use of the ResourceListener class is highly reccomended
@@ -244,24 +344,39 @@ namespace Exelius
 		/// so that multiple listeners can be notified of a resource being loaded.
 		/// </summary>
 		/// <param name="resourceID">- The filepath of the resource to load. This is a StringIntern for optimization.</param>
-		/// <param name="signalLoaderThread">- True if the loader thread should be signaled to begin loading. Does nothing in single threaded mode.</param>
+		/// <param name="signalLoaderThread">- True if the queue should be handed to the workers now, rather than at the next ProcessLoadQueue. Does nothing in single threaded mode.</param>
 		/// <param name="pListener">- The listener to be notified when a resource has completed the load process.</param>
-		void QueueLoad(const ResourceID& resourceID, bool signalLoaderThread = false, ResourceListenerPtr pListener = ResourceListenerPtr());
+		/// <param name="priority">- How urgently the resource is needed.</param>
+		/// <param name="deadlineSeconds">- How many seconds from now the resource should be ready by. 0 for no deadline.</param>
+		/// <returns>True if the caller now holds a reference to the resource. False if it was already loaded, and no reference was taken.</returns>
+		bool QueueLoad(const ResourceID& resourceID, bool signalLoaderThread = false, ResourceListenerPtr pListener = ResourceListenerPtr(),
+			ResourceLoadPriority priority = ResourceLoadPriority::kNormal, float deadlineSeconds = 0.0f);
+
+		/// <summary>
+		/// Change the priority and deadline of a queued load, for example
+		/// when a prefetched resource is suddenly needed. Does nothing once
+		/// the resource has been finalized.
+		/// </summary>
+		/// <param name="resourceID">- The resource being loaded.</param>
+		/// <param name="priority">- How urgently the resource is needed.</param>
+		/// <param name="deadlineSeconds">- How many seconds from now the resource should be ready by. 0 for no deadline.</param>
+		/// <returns>True if the load was still queued or waiting to be finalized.</returns>
+		bool SetLoadPriority(const ResourceID& resourceID, ResourceLoadPriority priority, float deadlineSeconds = 0.0f);
 
 		/// <summary>
 		/// Load the given resource immediately. This will happen on the
 		/// calling thread and will be blocking on that thread until the
-		/// resource has completed the load process. If a resource is
-		/// already being loaded then the resource listener will be added
-		/// to the list of listeners to be notified and nothing further
-		/// will happen. If the resource is loaded already then the
-		/// listener will be notified immediately.
-		/// @todo
-		/// Potential data race here, if the listener is added just after
-		/// the loader thread proccesses the listener queue.
-		/// @todo
-		/// A resource that is already queued should be removed from the
-		/// queue and forceloaded here.
+		/// resource has completed the load process. If the resource is
+		/// loaded already then the listener will be notified immediately.
+		/// 
+		/// If the resource is already queued or loading, this waits for
+		/// that load to complete, helping with other jobs in the meantime.
+		/// 
+		/// Called off the main thread, the resource is read and loaded on
+		/// the calling thread, but finalized by the main thread, which
+		/// notifies the listener. This still returns only once the resource
+		/// is finalized, so the main thread must be running its jobs, either
+		/// each frame or while it waits on a counter.
 		/// 
 		/// The loading time of a resource is not predictable, and thus
 		/// the use of the ResourceListener class is highly recomended
@@ -274,7 +389,8 @@ namespace Exelius
 		/// </summary>
 		/// <param name="resourceID">- The filepath of the resource to load. This is a StringIntern for optimization</param>
 		/// <param name="pListener">- The listener to be notified when a resource has completed the load process.</param>
-		void LoadNow(const ResourceID& resourceID, ResourceListenerPtr pListener = ResourceListenerPtr());
+		/// <returns>True if the caller now holds a reference to the resource. False if it was already loaded, and no reference was taken.</returns>
+		bool LoadNow(const ResourceID& resourceID, ResourceListenerPtr pListener = ResourceListenerPtr());
 
 		void CreateNewResource(const ResourceID& resourceID);
 
@@ -298,7 +414,8 @@ namespace Exelius
 		/// Decrements the reference count on the given resource.
 		/// If there are no longer any references or locks on the
 		/// given resource it will be unloaded when the unload queue
-		/// is processed next.
+		/// is processed next. If it is still queued to load, the
+		/// load is cancelled.
 		/// </summary>
 		/// <param name="resourceID">- The resource to release.</param>
 		void ReleaseResource(const ResourceID& resourceID);
@@ -354,6 +471,21 @@ namespace Exelius
 		/// <param name="useRawAssets">- If true, the system will use raw assets, false will use packed resources.</param>
 		void SetUsingRawAssets(bool useRawAssets) { m_useRawAssets = useRawAssets; }
 
+		/// <summary>
+		/// Map an asset pack (.expak) or zip archive and read its contents,
+		/// so resources can be loaded from it when not using raw assets.
+		/// Files in archives mounted later take precedence over earlier ones.
+		/// Safe to call while resources are loading.
+		/// </summary>
+		/// <param name="pArchivePath">- The archive to mount.</param>
+		/// <returns>True if the archive was mounted.</returns>
+		bool MountArchive(const char* pArchivePath);
+
+		/// <summary>
+		/// Unmount every archive. Waits for any loads reading from them.
+		/// </summary>
+		void UnmountArchives();
+
 		/// <summary>
 		/// Retrieve the path the system is using to load engine specific resources.
 		/// </summary>
@@ -374,66 +506,115 @@ namespace Exelius
 
 	private:
 		/// <summary>
-		/// Signal the resource loader thread to wake up and begin
-		/// loading resources.
+		/// Claim the load of a resource, and add the listener to those
+		/// waiting on it. If the resource is already loaded, the listener
+		/// is notified immediately instead.
 		/// </summary>
-		void SignalLoaderThread();
+		/// <param name="resourceID">- The resource to load.</param>
+		/// <param name="pListener">- The listener to be notified when the load completes.</param>
+		/// <returns>The status the resource had. Unless it was kLoading or kLoaded, the caller must now load the resource.</returns>
+		ResourceLoadStatus BeginLoad(const ResourceID& resourceID, ResourceListenerPtr pListener);
 
 		/// <summary>
-		/// Signal the resource loader thread to wake up and begin
-		/// loading resources. Sleeps the calling thread until the
-		/// loader thread signals upon completion.
+		/// Wait for a resource that is queued or loading on the workers
+		/// to be finalized. A load that no thread has started yet, queued or
+		/// handed to the workers, is taken and loaded on the calling thread instead.
+		/// 
+		/// Off the main thread, a decoded resource is handed to the main
+		/// thread to finalize as one of its jobs, and this waits until it has.
 		/// </summary>
-		void SignalAndWaitForLoaderThread();
+		/// <param name="resourceID">- The resource to wait for.</param>
+		void WaitForLoad(const ResourceID& resourceID);
 
 		/// <summary>
-		/// This is the instantiation function for the loader thread.
-		/// 
-		/// Double Buffered Resource Loading System:
-		/// 
-		/// The main thread will add resources and listners to a 
-		/// couple of queues to be loaded and called, respectively.
-		/// 
-		/// When signaled, the loader thread will swap the deferred
-		/// queues to be processed, allowing the main thread to continue
-		/// to queue resources and listeners.
-		/// 
-		/// After the swap, the loader thread will load any queued
-		/// resources from either raw asset files or a compressed
-		/// asset package. Once a resource is loaded, the listeners
-		/// attached to that resource will be called.
-		/// 
-		/// Once the loader thread has completed this process, it will
-		/// signal to the main thread that it has completed, and sleep
-		/// until the next signal to begin processing.
-		/// 
-		/// This thread will then have access to the following functions
-		/// and thus these functions should be used with this in mind:
-		///		ResourceLoader::LoadResource()
-		/// 	ResourceLoader::LoadRawData()
-		/// 	ResourceLoader::LoadFromDisk()
-		/// 	ResourceLoader::LoadFromZip()
-		/// 	ResourceDatabase::SetEntryLoadStatus()
-		///		ResourceDatabase::SetEntryResource()
-		///		ResourceDatabase::UnloadEntry()
-		///		ResourceEntry::SetResource()
-		/// 	ResourceEntry::SetStatus()
-		/// 	ResourceFactory::CreateResource()*
-		/// 	ResourceFactory::GetResourceType()*
-		/// 	ResourceListener::OnResourceLoaded()*
-		/// 	Resource::Load()*
-		/// 
-		/// *These can be inhereted from within client applications so
-		/// special care needs to be made here.
+		/// Take a load that no thread has started yet, whether it is still
+		/// queued or has been handed to the workers, so the caller can do it.
+		/// </summary>
+		/// <param name="resourceID">- The resource being loaded.</param>
+		/// <param name="request">- Receives the load that was taken.</param>
+		/// <returns>True if the load was taken.</returns>
+		bool TakeUnstartedLoad(const ResourceID& resourceID, LoadRequest& request);
+
+		/// <summary>
+		/// Change the priority and deadline of a load still in the deferred or finalize queue.
+		/// </summary>
+		/// <param name="resourceID">- The resource being loaded.</param>
+		/// <param name="priority">- How urgently the resource is needed.</param>
+		/// <param name="deadlineNanoseconds">- When the resource should be ready by. s_kNoDeadline for none.</param>
+		/// <param name="onlyRaise">- Keep the current priority or deadline where it is more urgent.</param>
+		/// <returns>True if the load was found.</returns>
+		bool UpdateLoadPriority(const ResourceID& resourceID, ResourceLoadPriority priority, uint64_t deadlineNanoseconds, bool onlyRaise);
+
+		/// <summary>
+		/// Push a job for each queued load the workers have room for.
+		/// Must be called with m_deferredQueueLock held.
+		/// </summary>
+		void DispatchQueuedLoads();
+
+		/// <summary>
+		/// Hand a decoded resource to the main thread to be finalized.
+		/// </summary>
+		/// <param name="request">- The load the resource was decoded for.</param>
+		/// <param name="pResource">- The resource returned by DecodeResource. nullptr if the load failed.</param>
+		void QueueFinalize(const LoadRequest& request, Resource* pResource);
+
+		/// <summary>
+		/// Finalize a resource the calling thread is waiting on. Off the
+		/// main thread, it is pushed to the main thread as a job instead,
+		/// to be finalized the next time the main thread runs its jobs.
+		/// </summary>
+		/// <param name="request">- The load the resource was decoded for.</param>
+		/// <param name="pResource">- The resource returned by DecodeResource. nullptr if the load failed.</param>
+		void FinalizeNow(const LoadRequest& request, Resource* pResource);
+
+		/// <summary>
+		/// Main thread only.
+		/// Finalize a resource taken from the finalize queue, unless its load was cancelled.
 		/// </summary>
-		void ProcessResourceQueue();
+		/// <param name="pendingFinalize">- The resource to finalize.</param>
+		void FinalizeLoad(const PendingFinalize& pendingFinalize);
 
 		/// <summary>
-		/// Load the given resource. Upon failure, ResourceDatabase::UnloadEntry
-		/// will be called, removing the entry from the database.
+		/// Cancel a load if nothing holds its resource anymore. Its listeners
+		/// are handed back, to be notified with NotifyListeners as if the load
+		/// had failed once the caller holds no locks.
+		/// </summary>
+		/// <param name="resourceID">- The resource being loaded.</param>
+		/// <param name="listeners">- Receives the listeners waiting on the load.</param>
+		/// <returns>True if the load was cancelled.</returns>
+		bool TryCancelLoad(const ResourceID& resourceID, ResourceListeners& listeners);
+
+		/// <summary>
+		/// Whether a load should be started or finalized after another.
+		/// Lower priorities, then later deadlines, then later requests, are less urgent.
+		/// </summary>
+		static bool IsLessUrgent(const LoadRequest& lhs, const LoadRequest& rhs);
+
+		/// <summary>
+		/// Notify the listeners of a finished load. Off the main thread,
+		/// they are notified by the main thread instead.
+		/// </summary>
+		/// <param name="resourceID">- The resource that finished loading.</param>
+		/// <param name="listeners">- The listeners waiting on it.</param>
+		void NotifyListeners(const ResourceID& resourceID, ResourceListeners& listeners);
+
+		/// <summary>
+		/// Read the raw data of the resource and create it through the
+		/// factory, then run Resource::Load. Safe to call from any thread,
+		/// as long as the factory and the resource's Load are.
 		/// </summary>
 		/// <param name="resourceID">- The resource to load.</param>
-		void LoadResource(const ResourceID& resourceID);
+		/// <returns>The loaded resource, waiting to be finalized. nullptr on failure.</returns>
+		Resource* DecodeResource(const ResourceID& resourceID);
+
+		/// <summary>
+		/// Main thread only.
+		/// Run Resource::Finalize, publish the resource to the database
+		/// and notify everything listening for it.
+		/// </summary>
+		/// <param name="resourceID">- The resource that was loaded.</param>
+		/// <param name="pResource">- The resource returned by DecodeResource. nullptr if the load failed.</param>
+		void FinishLoad(const ResourceID& resourceID, Resource* pResource);
 
 		/// <summary>
 		/// Selector that chooses to load the raw data of an asset
@@ -451,13 +632,14 @@ namespace Exelius
 		eastl::vector<std::byte> LoadFromDisk(const ResourceID& resourceID);
 
 		/// <summary>
-		/// Load the given resource directly from a compressed file.
-		/// @todo
-		/// Currently unused.
+		/// Load the given resource from the mounted archives. Stored
+		/// files are copied straight out of the mapped archive, and
+		/// compressed files are decompressed straight into the returned data.
+		/// Safe to call from several threads at once.
 		/// </summary>
 		/// <param name="resourceID">- The resource to load.</param>
 		/// <returns>The loaded raw data in a vector of bytes. The vector will be empty on failure.</returns>
-		eastl::vector<std::byte> LoadFromZip(const ResourceID& resourceID);
+		eastl::vector<std::byte> LoadFromArchive(const ResourceID& resourceID);
 
 		void SaveToDisk(const ResourceID& resourceID, const eastl::vector<std::byte>& data);
 
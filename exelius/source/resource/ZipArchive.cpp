@@ -0,0 +1,273 @@
+#include "EXEPCH.h"
+#include "source/resource/ZipArchive.h"
+#include "source/utility/io/ZLIBStructs.h"
+
+#include <zlib.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Zip marks fields that overflowed into a ZIP64 record with all bits set.
+	/// </summary>
+	static constexpr uint32_t s_kZip64Marker = 0xFFFFFFFF;
+
+	/// <summary>
+	/// General purpose flag set on encrypted files.
+	/// </summary>
+	static constexpr uint16_t s_kEncryptedFlag = 0x0001;
+
+	/// <summary>
+	/// Read a packed header from anywhere in the mapping, regardless of alignment.
+	/// </summary>
+	template <typename Header>
+	static Header ReadHeader(const std::byte* pData)
+	{
+		Header header;
+		::memcpy(&header, pData, sizeof(Header));
+		return header;
+	}
+
+	bool ZipArchive::Open(const char* pArchivePath)
+	{
+		EXE_ASSERT(pArchivePath);
+		Close();
+
+		if (!m_file.Open(pArchivePath))
+			return false;
+
+		m_archivePath = pArchivePath;
+
+		if (!IndexCentralDirectory())
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "'{}' is not a supported zip archive.", pArchivePath);
+			Close();
+			return false;
+		}
+
+		EXE_LOG_CATEGORY_INFO("ZipArchive", "Opened '{}' with {} files.", pArchivePath, m_entries.size());
+		return true;
+	}
+
+	void ZipArchive::Close()
+	{
+		m_entries.clear();
+		m_archivePath.clear();
+		m_file.Close();
+	}
+
+	bool ZipArchive::ReadResource(const ResourceID& resourceID, eastl::vector<std::byte>& resourceData) const
+	{
+		const Entry* pEntry = FindEntry(resourceID);
+		if (!pEntry)
+			return false;
+
+		if (pEntry->m_uncompressedSize == 0)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "'{}' is empty in '{}'.", resourceID.Get().c_str(), m_archivePath.c_str());
+			return true;
+		}
+
+		resourceData.resize(pEntry->m_uncompressedSize);
+		if (!Extract(*pEntry, eastl::span<std::byte>(resourceData.data(), resourceData.size())))
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "Failed to extract '{}' from '{}'.", resourceID.Get().c_str(), m_archivePath.c_str());
+			resourceData.clear();
+		}
+
+		return true;
+	}
+
+	const ZipArchive::Entry* ZipArchive::FindEntry(const ResourceID& resourceID) const
+	{
+		auto found = m_entries.find(resourceID);
+		if (found == m_entries.end())
+			return nullptr;
+
+		return &found->second;
+	}
+
+	eastl::span<const std::byte> ZipArchive::GetStoredData(const Entry& entry) const
+	{
+		if (entry.m_compression != 0)
+			return eastl::span<const std::byte>();
+
+		const std::byte* pData = GetEntryData(entry);
+		if (!pData)
+			return eastl::span<const std::byte>();
+
+		return eastl::span<const std::byte>(pData, entry.m_uncompressedSize);
+	}
+
+	bool ZipArchive::Extract(const Entry& entry, eastl::span<std::byte> destination) const
+	{
+		EXE_ASSERT(destination.size() == entry.m_uncompressedSize);
+
+		const std::byte* pData = GetEntryData(entry);
+		if (!pData)
+			return false;
+
+		if (entry.m_compression == 0)
+		{
+			::memcpy(destination.data(), pData, entry.m_uncompressedSize);
+			return true;
+		}
+
+		EXE_ASSERT(entry.m_compression == Z_DEFLATED);
+
+		// Every call gets its own stream, so files can be inflated on any number of threads.
+		z_stream stream = {};
+		if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "Failed to initialize zlib: {}", stream.msg ? stream.msg : "Unknown error.");
+			return false;
+		}
+
+		// The raw deflate stream has no header, the sizes come from the directory.
+		stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(pData));
+		stream.avail_in = entry.m_compressedSize;
+		stream.next_out = reinterpret_cast<Bytef*>(destination.data());
+		stream.avail_out = entry.m_uncompressedSize;
+
+		const int result = inflate(&stream, Z_FINISH);
+		const size_t inflatedSize = static_cast<size_t>(stream.total_out);
+		inflateEnd(&stream);
+
+		if (result != Z_STREAM_END || inflatedSize != entry.m_uncompressedSize)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "Failed to inflate a file in '{}'. Inflated {} of {} bytes.", m_archivePath.c_str(), inflatedSize, entry.m_uncompressedSize);
+			return false;
+		}
+
+#ifdef EXE_DEBUG
+		const uint32_t crc = static_cast<uint32_t>(crc32(0, reinterpret_cast<const Bytef*>(destination.data()), entry.m_uncompressedSize));
+		if (crc != entry.m_crc32)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "A file in '{}' failed its CRC check.", m_archivePath.c_str());
+			return false;
+		}
+#endif // EXE_DEBUG
+
+		return true;
+	}
+
+	bool ZipArchive::IndexCentralDirectory()
+	{
+		const std::byte* pArchive = m_file.GetData();
+		const size_t archiveSize = m_file.GetSize();
+
+		if (archiveSize < sizeof(ZipDirHeader))
+			return false;
+
+		// The end of central directory record is last, followed only by a comment of up to 64KB.
+		const size_t lastRecordOffset = archiveSize - sizeof(ZipDirHeader);
+		const size_t firstRecordOffset = lastRecordOffset > UINT16_MAX ? lastRecordOffset - UINT16_MAX : 0;
+
+		const std::byte* pDirHeader = nullptr;
+		for (size_t offset = lastRecordOffset + 1; offset-- > firstRecordOffset;)
+		{
+			if (ReadHeader<uint32_t>(pArchive + offset) == ZipDirHeader::kSignature)
+			{
+				pDirHeader = pArchive + offset;
+				break;
+			}
+		}
+
+		if (!pDirHeader)
+			return false;
+
+		const ZipDirHeader dirHeader = ReadHeader<ZipDirHeader>(pDirHeader);
+		if (dirHeader.nDisk != 0 || dirHeader.nStartDisk != 0 || dirHeader.nDirEntries != dirHeader.totalDirEntries || dirHeader.dirOffset == s_kZip64Marker)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "Multi-disk and ZIP64 archives are not supported.");
+			return false;
+		}
+
+		if (static_cast<size_t>(dirHeader.dirOffset) + dirHeader.dirSize > static_cast<size_t>(pDirHeader - pArchive))
+			return false;
+
+		const std::byte* pCurrent = pArchive + dirHeader.dirOffset;
+		const std::byte* pDirEnd = pCurrent + dirHeader.dirSize;
+
+		m_entries.reserve(dirHeader.totalDirEntries);
+
+		eastl::string name;
+		for (uint16_t entryIndex = 0; entryIndex < dirHeader.totalDirEntries; ++entryIndex)
+		{
+			if (pCurrent + sizeof(ZipDirFileHeader) > pDirEnd)
+				return false;
+
+			const ZipDirFileHeader fileHeader = ReadHeader<ZipDirFileHeader>(pCurrent);
+			if (fileHeader.sig != ZipDirFileHeader::kSignature)
+				return false;
+
+			const std::byte* pName = pCurrent + sizeof(ZipDirFileHeader);
+			const std::byte* pNext = pName + fileHeader.fnameLen + fileHeader.xtraLen + fileHeader.cmntLen;
+			if (pNext > pDirEnd)
+				return false;
+
+			pCurrent = pNext;
+
+			name.assign(reinterpret_cast<const char*>(pName), fileHeader.fnameLen);
+
+			// Directories have no data.
+			if (name.empty() || name.back() == '/')
+				continue;
+
+			if ((fileHeader.flag & s_kEncryptedFlag) != 0)
+			{
+				EXE_LOG_CATEGORY_WARN("ZipArchive", "Skipping '{}': Encrypted files are not supported.", name.c_str());
+				continue;
+			}
+
+			if (fileHeader.cSize == s_kZip64Marker || fileHeader.ucSize == s_kZip64Marker || fileHeader.hdrOffset == s_kZip64Marker)
+			{
+				EXE_LOG_CATEGORY_WARN("ZipArchive", "Skipping '{}': ZIP64 files are not supported.", name.c_str());
+				continue;
+			}
+
+			const bool isStored = fileHeader.compression == 0 && fileHeader.cSize == fileHeader.ucSize;
+			if (!isStored && fileHeader.compression != Z_DEFLATED)
+			{
+				EXE_LOG_CATEGORY_WARN("ZipArchive", "Skipping '{}': Compression method {} is not supported.", name.c_str(), fileHeader.compression);
+				continue;
+			}
+
+			Entry& entry = m_entries[ResourceID(name)];
+			entry.m_localHeaderOffset = fileHeader.hdrOffset;
+			entry.m_compressedSize = fileHeader.cSize;
+			entry.m_uncompressedSize = fileHeader.ucSize;
+			entry.m_crc32 = fileHeader.crc32;
+			entry.m_compression = fileHeader.compression;
+		}
+
+		return true;
+	}
+
+	const std::byte* ZipArchive::GetEntryData(const Entry& entry) const
+	{
+		const std::byte* pArchive = m_file.GetData();
+		const size_t archiveSize = m_file.GetSize();
+
+		if (static_cast<size_t>(entry.m_localHeaderOffset) + sizeof(ZipLocalHeader) > archiveSize)
+			return nullptr;
+
+		const ZipLocalHeader localHeader = ReadHeader<ZipLocalHeader>(pArchive + entry.m_localHeaderOffset);
+		if (localHeader.sig != ZipLocalHeader::kSignature)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "A file in '{}' has an invalid local header.", m_archivePath.c_str());
+			return nullptr;
+		}
+
+		const size_t dataOffset = static_cast<size_t>(entry.m_localHeaderOffset) + sizeof(ZipLocalHeader) + localHeader.fnameLen + localHeader.xtraLen;
+		if (dataOffset + entry.m_compressedSize > archiveSize)
+		{
+			EXE_LOG_CATEGORY_WARN("ZipArchive", "A file in '{}' runs past the end of the archive.", m_archivePath.c_str());
+			return nullptr;
+		}
+
+		return pArchive + dataOffset;
+	}
+}
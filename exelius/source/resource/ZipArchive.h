@@ -0,0 +1,115 @@
+#pragma once
+#include "source/resource/ResourceArchive.h"
+#include "source/utility/io/MappedFile.h"
+
+#include <EASTL/span.h>
+#include <EASTL/string.h>
+#include <EASTL/unordered_map.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A read-only zip archive of resources.
+	///
+	/// The archive is memory mapped once when it is opened, and its central
+	/// directory is parsed into an index keyed by the ResourceID of each file,
+	/// so finding a resource never touches the file system. Only stored and
+	/// deflated files are supported, and not ZIP64 or encrypted archives.
+	///
+	/// Once opened, an archive can be read from any number of threads at once.
+	/// @see ResourceLoader
+	/// </summary>
+	class ZipArchive
+		: public ResourceArchive
+	{
+	public:
+		/// <summary>
+		/// A file in the archive, as described by the central directory.
+		/// </summary>
+		struct Entry
+		{
+			uint32_t m_localHeaderOffset;
+			uint32_t m_compressedSize;
+			uint32_t m_uncompressedSize;
+			uint32_t m_crc32;
+			uint16_t m_compression;
+		};
+
+	private:
+		MappedFile m_file;
+		eastl::unordered_map<ResourceID, Entry> m_entries;
+		eastl::string m_archivePath;
+
+	public:
+		ZipArchive() = default;
+		ZipArchive(const ZipArchive&) = delete;
+		ZipArchive(ZipArchive&&) = delete;
+		ZipArchive& operator=(const ZipArchive&) = delete;
+		ZipArchive& operator=(ZipArchive&&) = delete;
+		virtual ~ZipArchive() = default;
+
+		/// <summary>
+		/// Map the archive and index its central directory.
+		/// </summary>
+		/// <param name="pArchivePath">- The archive to open.</param>
+		/// <returns>True if the archive was opened and its directory was valid.</returns>
+		virtual bool Open(const char* pArchivePath) final override;
+
+		/// <summary>
+		/// Close the archive. Spans returned by GetStoredData are no longer valid.
+		/// </summary>
+		virtual void Close() final override;
+
+		bool IsOpen() const { return m_file.IsOpen(); }
+		virtual const eastl::string& GetArchivePath() const final override { return m_archivePath; }
+		size_t GetEntryCount() const { return m_entries.size(); }
+
+		/// <summary>
+		/// Copy or inflate a resource's file into newly allocated data.
+		/// Safe to call from several threads at once.
+		/// </summary>
+		/// <param name="resourceID">- The resource, as its path inside the archive.</param>
+		/// <param name="resourceData">- Set to the resource's data. Left empty if it could not be read.</param>
+		/// <returns>True if the archive contains the resource, whether or not it could be read.</returns>
+		virtual bool ReadResource(const ResourceID& resourceID, eastl::vector<std::byte>& resourceData) const final override;
+
+		/// <summary>
+		/// Find the file for a resource.
+		/// </summary>
+		/// <param name="resourceID">- The resource, as its path inside the archive.</param>
+		/// <returns>The file's entry, or nullptr if the archive doesn't contain it.</returns>
+		const Entry* FindEntry(const ResourceID& resourceID) const;
+
+		/// <summary>
+		/// View the contents of a stored file in place, without copying them.
+		/// The span is valid until the archive is closed.
+		/// </summary>
+		/// <param name="entry">- An entry of this archive.</param>
+		/// <returns>The file's contents. Empty if the file is compressed or its header is invalid.</returns>
+		eastl::span<const std::byte> GetStoredData(const Entry& entry) const;
+
+		/// <summary>
+		/// Copy or inflate the contents of a file straight into the destination.
+		/// Safe to call from several threads at once.
+		/// </summary>
+		/// <param name="entry">- An entry of this archive.</param>
+		/// <param name="destination">- Exactly m_uncompressedSize bytes to write the file to.</param>
+		/// <returns>True if the whole file was written.</returns>
+		bool Extract(const Entry& entry, eastl::span<std::byte> destination) const;
+
+	private:
+		/// <summary>
+		/// Parse the central directory into m_entries.
+		/// </summary>
+		bool IndexCentralDirectory();
+
+		/// <summary>
+		/// Skip the local header of a file, which may differ in size from the central directory's copy.
+		/// </summary>
+		/// <returns>The start of the file's data, or nullptr if the header is invalid.</returns>
+		const std::byte* GetEntryData(const Entry& entry) const;
+	};
+}
@@ -1,84 +1,338 @@
 #pragma once
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
-    // Simple Thread safe ring buffer from:
-    // https://wickedengine.net/2018/11/24/simple-job-system-using-standard-c/
+    /// <summary>
+    /// Lock-free bounded ring buffer for exactly one producer thread and
+    /// one consumer thread.
+    ///
+    /// Indices only ever increase and are masked into the buffer, so Capacity
+    /// must be a power of two and every slot is usable. The producer and
+    /// consumer indices live on their own cache lines, alongside a cached copy
+    /// of the other side's index, so neither thread touches the other's line
+    /// unless the buffer looks full (or empty).
+    /// </summary>
+    template <typename T, size_t Capacity>
+    class SPSCRingBuffer
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "SPSCRingBuffer capacity must be a power of two.");
+
+        static constexpr size_t s_kCacheLineSize = 64;
+        static constexpr size_t s_kMask = Capacity - 1;
+
+        // Owned by the producer.
+        alignas(s_kCacheLineSize) std::atomic<size_t> m_tail = 0;
+        size_t m_cachedHead = 0;
+
+        // Owned by the consumer.
+        alignas(s_kCacheLineSize) std::atomic<size_t> m_head = 0;
+        size_t m_cachedTail = 0;
+
+        alignas(s_kCacheLineSize) T m_buffer[Capacity];
+
+    public:
+        /// <summary>
+        /// Push a single element. Producer thread only.
+        /// </summary>
+        /// <returns>False if the buffer is full.</returns>
+        bool PushBack(const T& elementToPush)
+        {
+            return PushBatch(&elementToPush, 1) == 1;
+        }
+
+        /// <summary>
+        /// Push as many of the elements as fit, publishing them all at once.
+        /// Producer thread only.
+        /// </summary>
+        /// <returns>The number of elements pushed.</returns>
+        size_t PushBatch(const T* pElementsToPush, size_t count)
+        {
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+
+            if (Capacity - (tail - m_cachedHead) < count)
+                m_cachedHead = m_head.load(std::memory_order_acquire);
+
+            const size_t freeSlots = Capacity - (tail - m_cachedHead);
+            if (count > freeSlots)
+                count = freeSlots;
+
+            for (size_t i = 0; i < count; ++i)
+                m_buffer[(tail + i) & s_kMask] = pElementsToPush[i];
+
+            if (count > 0)
+                m_tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /// <summary>
+        /// Pop a single element. Consumer thread only.
+        /// </summary>
+        /// <returns>False if the buffer is empty.</returns>
+        bool PopFront(T& elementToPop)
+        {
+            return PopBatch(&elementToPop, 1) == 1;
+        }
+
+        /// <summary>
+        /// Pop up to maxCount elements, releasing their slots all at once.
+        /// Consumer thread only.
+        /// </summary>
+        /// <returns>The number of elements popped.</returns>
+        size_t PopBatch(T* pElementsToPop, size_t maxCount)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+
+            if (m_cachedTail - head < maxCount)
+                m_cachedTail = m_tail.load(std::memory_order_acquire);
+
+            size_t count = m_cachedTail - head;
+            if (count > maxCount)
+                count = maxCount;
+
+            for (size_t i = 0; i < count; ++i)
+                pElementsToPop[i] = std::move(m_buffer[(head + i) & s_kMask]);
+
+            if (count > 0)
+                m_head.store(head + count, std::memory_order_release);
+            return count;
+        }
+
+        /// <summary>
+        /// Only exact when called from the producer or consumer while the other is idle.
+        /// </summary>
+        size_t GetSizeApprox() const
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            const size_t tail = m_tail.load(std::memory_order_relaxed);
+            return (tail > head) ? tail - head : 0;
+        }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
+    };
 
-    template <typename T, size_t size>
-    class RingBufferMT
+    /// <summary>
+    /// Lock-free bounded ring buffer for any number of producer and consumer threads.
+    /// Based on Dmitry Vyukov's bounded MPMC queue:
+    /// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+    ///
+    /// Each slot carries a sequence number saying whose turn it is, so producers
+    /// and consumers only contend on the position they are claiming, never on
+    /// each other. Capacity must be a power of two.
+    ///
+    /// @note Not linearizable when empty: a pop may fail while a push that
+    /// claimed an earlier slot is still writing it.
+    /// </summary>
+    template <typename T, size_t Capacity>
+    class MPMCRingBuffer
     {
-        T m_buffer[size];
-        size_t m_head = 0;
-        size_t m_tail = 0;
-        std::mutex m_bufferLock;
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "MPMCRingBuffer capacity must be a power of two.");
+
+        static constexpr size_t s_kCacheLineSize = 64;
+        static constexpr size_t s_kMask = Capacity - 1;
+
+        struct Slot
+        {
+            /// <summary>
+            /// Equal to the position when free to push to,
+            /// and to position + 1 when holding an element to pop.
+            /// </summary>
+            std::atomic<size_t> m_sequence;
+            T m_element;
+        };
+
+        alignas(s_kCacheLineSize) std::atomic<size_t> m_enqueuePosition;
+        alignas(s_kCacheLineSize) std::atomic<size_t> m_dequeuePosition;
+        alignas(s_kCacheLineSize) Slot m_slots[Capacity];
 
     public:
-        inline bool PushBack(const T& elementToPush)
+        MPMCRingBuffer()
+            : m_enqueuePosition(0)
+            , m_dequeuePosition(0)
         {
-            bool result = false;
-            m_bufferLock.lock();
-            size_t next = (m_head + 1) % size;
-            if (next != m_tail)
+            for (size_t i = 0; i < Capacity; ++i)
+                m_slots[i].m_sequence.store(i, std::memory_order_relaxed);
+        }
+
+        MPMCRingBuffer(const MPMCRingBuffer&) = delete;
+        MPMCRingBuffer(MPMCRingBuffer&&) = delete;
+        MPMCRingBuffer& operator=(const MPMCRingBuffer&) = delete;
+        MPMCRingBuffer& operator=(MPMCRingBuffer&&) = delete;
+
+        /// <summary>
+        /// Push a single element. Any thread.
+        /// </summary>
+        /// <returns>False if the buffer is full.</returns>
+        bool PushBack(const T& elementToPush)
+        {
+            return PushBatch(&elementToPush, 1) == 1;
+        }
+
+        /// <summary>
+        /// Push as many of the elements as there are free consecutive slots,
+        /// claiming them with a single CAS. Any thread.
+        /// </summary>
+        /// <returns>The number of elements pushed.</returns>
+        size_t PushBatch(const T* pElementsToPush, size_t count)
+        {
+            if (count == 0)
+                return 0;
+
+            size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+            size_t claimed = 0;
+            for (;;)
+            {
+                // Count the free slots from here, a slot can only stop being
+                // free once the position past it has been claimed.
+                claimed = 0;
+                bool isStale = false;
+                while (claimed < count)
+                {
+                    const size_t sequence = m_slots[(position + claimed) & s_kMask].m_sequence.load(std::memory_order_acquire);
+                    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + claimed);
+                    if (difference == 0)
+                    {
+                        ++claimed;
+                        continue;
+                    }
+
+                    // Another producer has already claimed this position.
+                    isStale = (difference > 0);
+                    break;
+                }
+
+                if (claimed == 0 && !isStale)
+                    return 0; // Full.
+
+                if (claimed > 0 && m_enqueuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+                    break;
+
+                if (isStale && claimed == 0)
+                    position = m_enqueuePosition.load(std::memory_order_relaxed);
+            }
+
+            for (size_t i = 0; i < claimed; ++i)
             {
-                m_buffer[m_head] = elementToPush;
-                m_head = next;
-                result = true;
+                Slot& slot = m_slots[(position + i) & s_kMask];
+                slot.m_element = pElementsToPush[i];
+                slot.m_sequence.store(position + i + 1, std::memory_order_release);
             }
-            m_bufferLock.unlock();
-            return result;
+
+            return claimed;
         }
 
-        inline bool PopFront(T& elementToPop)
+        /// <summary>
+        /// Pop a single element. Any thread.
+        /// </summary>
+        /// <returns>False if the buffer is empty.</returns>
+        bool PopFront(T& elementToPop)
         {
-            bool result = false;
-            m_bufferLock.lock();
-            if (m_tail != m_head)
+            return PopBatch(&elementToPop, 1) == 1;
+        }
+
+        /// <summary>
+        /// Pop up to maxCount elements from consecutive ready slots,
+        /// claiming them with a single CAS. Any thread.
+        /// </summary>
+        /// <returns>The number of elements popped.</returns>
+        size_t PopBatch(T* pElementsToPop, size_t maxCount)
+        {
+            if (maxCount == 0)
+                return 0;
+
+            size_t position = m_dequeuePosition.load(std::memory_order_relaxed);
+            size_t claimed = 0;
+            for (;;)
             {
-                elementToPop = m_buffer[m_tail];
-                m_tail = (m_tail + 1) % size;
-                result = true;
+                claimed = 0;
+                bool isStale = false;
+                while (claimed < maxCount)
+                {
+                    const size_t sequence = m_slots[(position + claimed) & s_kMask].m_sequence.load(std::memory_order_acquire);
+                    const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + claimed + 1);
+                    if (difference == 0)
+                    {
+                        ++claimed;
+                        continue;
+                    }
+
+                    // Another consumer has already claimed this position.
+                    isStale = (difference > 0);
+                    break;
+                }
+
+                if (claimed == 0 && !isStale)
+                    return 0; // Empty.
+
+                if (claimed > 0 && m_dequeuePosition.compare_exchange_weak(position, position + claimed, std::memory_order_relaxed))
+                    break;
+
+                if (isStale && claimed == 0)
+                    position = m_dequeuePosition.load(std::memory_order_relaxed);
+            }
+
+            for (size_t i = 0; i < claimed; ++i)
+            {
+                Slot& slot = m_slots[(position + i) & s_kMask];
+                pElementsToPop[i] = std::move(slot.m_element);
+                slot.m_sequence.store(position + i + Capacity, std::memory_order_release);
             }
-            m_bufferLock.unlock();
-            return result;
+
+            return claimed;
+        }
+
+        /// <summary>
+        /// May be stale by the time it returns if other threads are pushing or popping.
+        /// </summary>
+        size_t GetSizeApprox() const
+        {
+            const size_t dequeuePosition = m_dequeuePosition.load(std::memory_order_relaxed);
+            const size_t enqueuePosition = m_enqueuePosition.load(std::memory_order_relaxed);
+            return (enqueuePosition > dequeuePosition) ? enqueuePosition - dequeuePosition : 0;
         }
+
+        static constexpr size_t GetCapacity() { return Capacity; }
     };
 
-    template <typename T, size_t size>
+    /// <summary>
+    /// Ring buffer for use by a single thread. Capacity must be a power of two.
+    /// </summary>
+    template <typename T, size_t Capacity>
     class RingBuffer
     {
-        T m_buffer[size];
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "RingBuffer capacity must be a power of two.");
+
+        static constexpr size_t s_kMask = Capacity - 1;
+
+        T m_buffer[Capacity];
         size_t m_head = 0;
         size_t m_tail = 0;
 
     public:
         inline bool PushBack(const T& elementToPush)
         {
-            bool result = false;
-            size_t next = (m_head + 1) % size;
-            if (next != m_tail)
-            {
-                m_buffer[m_head] = elementToPush;
-                m_head = next;
-                result = true;
-            }
-            return result;
+            if (m_tail - m_head == Capacity)
+                return false;
+
+            m_buffer[m_tail & s_kMask] = elementToPush;
+            ++m_tail;
+            return true;
         }
 
         inline bool PopFront(T& elementToPop)
         {
-            bool result = false;
-            if (m_tail != m_head)
-            {
-                elementToPop = m_buffer[m_tail];
-                m_tail = (m_tail + 1) % size;
-                result = true;
-            }
-            return result;
+            if (m_tail == m_head)
+                return false;
+
+            elementToPop = std::move(m_buffer[m_head & s_kMask]);
+            ++m_head;
+            return true;
         }
     };
 }
\ No newline at end of file
@@ -0,0 +1,213 @@
+#pragma once
+#include "source/os/memory/MemoryOverloads.h"
+
+#include <EASTL/vector.h>
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Lock-free Chase-Lev work stealing deque. Based on:
+	/// "Correct and Efficient Work-Stealing for Weak Memory Models"
+	/// https://www.di.ens.fr/~zappa/readings/ppopp13.pdf
+	///
+	/// A single owner thread may Push() and Pop() from the bottom of
+	/// the deque (LIFO), while any number of other threads may Steal()
+	/// from the top of the deque (FIFO).
+	///
+	/// The deque grows when full, so pushes never fail or spin. Buffers
+	/// that have been outgrown are retired rather than freed, as a
+	/// thief may still be reading from them. They are released when the
+	/// deque is destroyed.
+	///
+	/// @note T must be trivially copyable, as elements are stored in atomics.
+	/// </summary>
+	template <typename T>
+	class WorkStealingQueue
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "WorkStealingQueue elements must be trivially copyable.");
+
+		static constexpr size_t s_kCacheLineSize = 64;
+
+		/// <summary>
+		/// Circular array of elements. Indices are never wrapped by the
+		/// caller, this will mask them into the valid range.
+		/// </summary>
+		struct CircularArray
+		{
+			int64_t m_capacity;
+			int64_t m_mask;
+			std::atomic<T>* m_pBuffer;
+
+			CircularArray(int64_t capacity)
+				: m_capacity(capacity)
+				, m_mask(capacity - 1)
+				, m_pBuffer(EXELIUS_NEW_ARRAY(std::atomic<T>, static_cast<size_t>(capacity)))
+			{
+				EXE_ASSERT(capacity > 0 && (capacity & (capacity - 1)) == 0); // Must be a power of two.
+			}
+
+			~CircularArray()
+			{
+				EXELIUS_DELETE_ARRAY(m_pBuffer);
+			}
+
+			T Get(int64_t index) const
+			{
+				return m_pBuffer[index & m_mask].load(std::memory_order_relaxed);
+			}
+
+			void Put(int64_t index, T element)
+			{
+				m_pBuffer[index & m_mask].store(element, std::memory_order_relaxed);
+			}
+
+			CircularArray* Grow(int64_t bottom, int64_t top) const
+			{
+				CircularArray* pNewArray = EXELIUS_NEW(CircularArray(m_capacity * 2));
+				for (int64_t i = top; i != bottom; ++i)
+					pNewArray->Put(i, Get(i));
+				return pNewArray;
+			}
+		};
+
+		// Top and bottom are modified by different threads, so keep them off the same cache line.
+		alignas(s_kCacheLineSize) std::atomic<int64_t> m_top;
+		alignas(s_kCacheLineSize) std::atomic<int64_t> m_bottom;
+		alignas(s_kCacheLineSize) std::atomic<CircularArray*> m_pArray;
+
+		/// <summary>
+		/// Arrays that have been replaced by a larger one. Only touched by the owner.
+		/// </summary>
+		eastl::vector<CircularArray*> m_retiredArrays;
+
+	public:
+		/// <summary>
+		/// Create the deque with an initial capacity.
+		/// </summary>
+		/// <param name="initialCapacity">- The starting capacity. Must be a power of two.</param>
+		WorkStealingQueue(int64_t initialCapacity = 256)
+			: m_top(0)
+			, m_bottom(0)
+			, m_pArray(EXELIUS_NEW(CircularArray(initialCapacity)))
+		{
+			//
+		}
+
+		WorkStealingQueue(const WorkStealingQueue&) = delete;
+		WorkStealingQueue(WorkStealingQueue&&) = delete;
+		WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+		WorkStealingQueue& operator=(WorkStealingQueue&&) = delete;
+
+		~WorkStealingQueue()
+		{
+			for (CircularArray* pArray : m_retiredArrays)
+			{
+				EXELIUS_DELETE(pArray);
+			}
+			m_retiredArrays.clear();
+
+			CircularArray* pArray = m_pArray.load(std::memory_order_relaxed);
+			EXELIUS_DELETE(pArray);
+		}
+
+		/// <summary>
+		/// Push an element onto the bottom of the deque.
+		/// Must only be called by the owning thread.
+		/// </summary>
+		/// <param name="element">- The element to push.</param>
+		void Push(T element)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_acquire);
+			CircularArray* pArray = m_pArray.load(std::memory_order_relaxed);
+
+			if (bottom - top > pArray->m_capacity - 1)
+			{
+				// Full, so grow the array. The old one may still be read by thieves.
+				m_retiredArrays.emplace_back(pArray);
+				pArray = pArray->Grow(bottom, top);
+				m_pArray.store(pArray, std::memory_order_release);
+			}
+
+			pArray->Put(bottom, element);
+			std::atomic_thread_fence(std::memory_order_release);
+			m_bottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		/// <summary>
+		/// Pop an element from the bottom of the deque (LIFO).
+		/// Must only be called by the owning thread.
+		/// </summary>
+		/// <param name="outElement">- The popped element, untouched on failure.</param>
+		/// <returns>True if an element was popped, false if the deque was empty.</returns>
+		bool Pop(T& outElement)
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			CircularArray* pArray = m_pArray.load(std::memory_order_relaxed);
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+
+			if (top > bottom)
+			{
+				// Empty, restore the bottom.
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			T element = pArray->Get(bottom);
+			if (top == bottom)
+			{
+				// Last element, race the thieves for it.
+				bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				if (!won)
+					return false;
+			}
+
+			outElement = element;
+			return true;
+		}
+
+		/// <summary>
+		/// Steal an element from the top of the deque (FIFO).
+		/// May be called by any thread.
+		/// </summary>
+		/// <param name="outElement">- The stolen element, untouched on failure.</param>
+		/// <returns>True if an element was stolen, false if the deque was empty or another thread won the race.</returns>
+		bool Steal(T& outElement)
+		{
+			int64_t top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t bottom = m_bottom.load(std::memory_order_acquire);
+
+			if (top >= bottom)
+				return false;
+
+			CircularArray* pArray = m_pArray.load(std::memory_order_acquire);
+			T element = pArray->Get(top);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return false;
+
+			outElement = element;
+			return true;
+		}
+
+		/// <summary>
+		/// Approximate check for emptiness. Only a hint when other threads are active.
+		/// </summary>
+		/// <returns>True if the deque appeared empty.</returns>
+		bool IsEmpty() const
+		{
+			int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+			int64_t top = m_top.load(std::memory_order_relaxed);
+			return bottom <= top;
+		}
+	};
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// ------------------------------------------------------------------------------------------
+	/// Cooked Asset Structs
+	///
+	/// Written by the exeliuscooker tool. A cooked asset keeps the name of its source
+	/// asset, so ResourceIDs don't change, and starts with one of these headers so the
+	/// resource loading it can tell it apart from the source format.
+	/// Everything is little endian.
+	///
+	/// Lua scripts are cooked to standard Lua bytecode, which has its own header.
+	/// ------------------------------------------------------------------------------------------
+	#pragma region COOKED_ASSET_STRUCTS
+		#pragma pack(1)
+			/// <summary>
+			/// Followed by every mip level's pixels, largest first, back to back.
+			/// Rows are bottom to top, as the renderer expects them.
+			/// </summary>
+			struct CookedTextureHeader
+			{
+				static constexpr uint32_t kSignature = 0x58545845; // "EXTX"
+				static constexpr uint16_t kVersion = 1;
+
+				uint32_t m_signature;
+				uint16_t m_version;
+				uint16_t m_headerSize;		// sizeof(CookedTextureHeader) when written.
+				uint32_t m_width;
+				uint32_t m_height;
+				uint32_t m_channels;		// Always 4, RGBA8.
+				uint32_t m_mipCount;		// At least 1.
+				uint64_t m_pixelsSize;		// Size of every mip level's pixels together.
+			};
+
+			/// <summary>
+			/// Followed by the root value, encoded as a CookedJsonTag and its payload:
+			///		Int64, Uint64, Double		- 8 bytes.
+			///		String						- uint32_t length, then the characters, not null terminated.
+			///		Array						- uint32_t count, then each element.
+			///		Object						- uint32_t count, then each member's name as a String payload and its value.
+			/// </summary>
+			struct CookedJsonHeader
+			{
+				static constexpr uint32_t kSignature = 0x534A5845; // "EXJS"
+				static constexpr uint16_t kVersion = 1;
+
+				uint32_t m_signature;
+				uint16_t m_version;
+				uint16_t m_headerSize;		// sizeof(CookedJsonHeader) when written.
+				uint64_t m_valueSize;		// Size of the encoded root value.
+			};
+
+			/// <summary>
+			/// Followed by the map's XML with every tile layer's data moved out, then
+			/// m_tileArrayCount arrays of tiles, each a uint32_t count and that many
+			/// global tile IDs with their flip flags, as they are stored in a TMX file.
+			///
+			/// A tile layer's data refers to its array as <data encoding="exelius" index="n"/>,
+			/// or for infinite maps as <chunk x="" y="" width="" height="" index="n"/>.
+			/// </summary>
+			struct CookedTilemapHeader
+			{
+				static constexpr uint32_t kSignature = 0x4D545845; // "EXTM"
+				static constexpr uint16_t kVersion = 1;
+
+				uint32_t m_signature;
+				uint16_t m_version;
+				uint16_t m_headerSize;		// sizeof(CookedTilemapHeader) when written.
+				uint32_t m_tileArrayCount;
+				uint32_t m_reserved;
+				uint64_t m_xmlSize;
+			};
+		#pragma pack()
+
+		static_assert(sizeof(CookedTextureHeader) == 32, "The cooked texture header is part of the file format.");
+		static_assert(sizeof(CookedJsonHeader) == 16, "The cooked JSON header is part of the file format.");
+		static_assert(sizeof(CookedTilemapHeader) == 24, "The cooked tilemap header is part of the file format.");
+
+		/// <summary>
+		/// The type of each value in a cooked JSON document.
+		/// </summary>
+		enum class CookedJsonTag : uint8_t
+		{
+			kNull,
+			kFalse,
+			kTrue,
+			kInt64,
+			kUint64,
+			kDouble,
+			kString,
+			kArray,
+			kObject,
+			kMax		/// Used for bounds checking. Not a valid tag.
+		};
+	#pragma endregion
+}
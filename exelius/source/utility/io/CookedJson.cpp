@@ -0,0 +1,309 @@
+#include "EXEPCH.h"
+#include "source/utility/io/CookedJson.h"
+#include "source/utility/io/CookedAssetStructs.h"
+
+#include <rapidjson/document.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Documents nested deeper than this are rejected rather than overflowing the stack.
+	/// </summary>
+	static constexpr uint32_t s_kMaxCookedJsonDepth = 256;
+
+	template <class Type>
+	static void WritePod(eastl::vector<std::byte>& cookedData, const Type& value)
+	{
+		const size_t offset = cookedData.size();
+		cookedData.resize(offset + sizeof(Type));
+		::memcpy(cookedData.data() + offset, &value, sizeof(Type));
+	}
+
+	static void WriteString(eastl::vector<std::byte>& cookedData, const char* pString, uint32_t length)
+	{
+		WritePod(cookedData, length);
+
+		const size_t offset = cookedData.size();
+		cookedData.resize(offset + length);
+		::memcpy(cookedData.data() + offset, pString, length);
+	}
+
+	static void WriteValue(eastl::vector<std::byte>& cookedData, const rapidjson::Value& value)
+	{
+		switch (value.GetType())
+		{
+			case rapidjson::kNullType:
+			{
+				WritePod(cookedData, CookedJsonTag::kNull);
+				break;
+			}
+
+			case rapidjson::kFalseType:
+			{
+				WritePod(cookedData, CookedJsonTag::kFalse);
+				break;
+			}
+
+			case rapidjson::kTrueType:
+			{
+				WritePod(cookedData, CookedJsonTag::kTrue);
+				break;
+			}
+
+			case rapidjson::kNumberType:
+			{
+				// Keep integers as integers, so they read back with the same Is*() results.
+				if (value.IsDouble())
+				{
+					WritePod(cookedData, CookedJsonTag::kDouble);
+					WritePod(cookedData, value.GetDouble());
+				}
+				else if (value.IsInt64())
+				{
+					WritePod(cookedData, CookedJsonTag::kInt64);
+					WritePod(cookedData, value.GetInt64());
+				}
+				else
+				{
+					WritePod(cookedData, CookedJsonTag::kUint64);
+					WritePod(cookedData, value.GetUint64());
+				}
+				break;
+			}
+
+			case rapidjson::kStringType:
+			{
+				WritePod(cookedData, CookedJsonTag::kString);
+				WriteString(cookedData, value.GetString(), value.GetStringLength());
+				break;
+			}
+
+			case rapidjson::kArrayType:
+			{
+				WritePod(cookedData, CookedJsonTag::kArray);
+				WritePod(cookedData, static_cast<uint32_t>(value.Size()));
+				for (auto element = value.Begin(); element != value.End(); ++element)
+					WriteValue(cookedData, *element);
+				break;
+			}
+
+			case rapidjson::kObjectType:
+			{
+				WritePod(cookedData, CookedJsonTag::kObject);
+				WritePod(cookedData, static_cast<uint32_t>(value.MemberCount()));
+				for (auto member = value.MemberBegin(); member != value.MemberEnd(); ++member)
+				{
+					WriteString(cookedData, member->name.GetString(), member->name.GetStringLength());
+					WriteValue(cookedData, member->value);
+				}
+				break;
+			}
+		}
+	}
+
+	/// <summary>
+	/// Walks the encoded value, checking every read stays inside the data.
+	/// </summary>
+	class CookedJsonReader
+	{
+		const std::byte* m_pCurrent;
+		const std::byte* m_pEnd;
+		rapidjson::Document::AllocatorType& m_allocator;
+
+	public:
+		CookedJsonReader(const std::byte* pBegin, const std::byte* pEnd, rapidjson::Document::AllocatorType& allocator)
+			: m_pCurrent(pBegin)
+			, m_pEnd(pEnd)
+			, m_allocator(allocator)
+		{
+			//
+		}
+
+		bool IsAtEnd() const { return m_pCurrent == m_pEnd; }
+
+		bool ReadValue(rapidjson::Value& value, uint32_t depth)
+		{
+			if (depth > s_kMaxCookedJsonDepth)
+				return false;
+
+			CookedJsonTag tag;
+			if (!ReadPod(tag))
+				return false;
+
+			switch (tag)
+			{
+				case CookedJsonTag::kNull:
+				{
+					value.SetNull();
+					return true;
+				}
+
+				case CookedJsonTag::kFalse:
+				case CookedJsonTag::kTrue:
+				{
+					value.SetBool(tag == CookedJsonTag::kTrue);
+					return true;
+				}
+
+				case CookedJsonTag::kInt64:
+				{
+					int64_t number;
+					if (!ReadPod(number))
+						return false;
+
+					value.SetInt64(number);
+					return true;
+				}
+
+				case CookedJsonTag::kUint64:
+				{
+					uint64_t number;
+					if (!ReadPod(number))
+						return false;
+
+					value.SetUint64(number);
+					return true;
+				}
+
+				case CookedJsonTag::kDouble:
+				{
+					double number;
+					if (!ReadPod(number))
+						return false;
+
+					value.SetDouble(number);
+					return true;
+				}
+
+				case CookedJsonTag::kString:
+				{
+					return ReadString(value);
+				}
+
+				case CookedJsonTag::kArray:
+				{
+					uint32_t count;
+					if (!ReadCount(count))
+						return false;
+
+					value.SetArray();
+					value.Reserve(count, m_allocator);
+					for (uint32_t elementIndex = 0; elementIndex < count; ++elementIndex)
+					{
+						rapidjson::Value element;
+						if (!ReadValue(element, depth + 1))
+							return false;
+
+						value.PushBack(element, m_allocator);
+					}
+					return true;
+				}
+
+				case CookedJsonTag::kObject:
+				{
+					uint32_t count;
+					if (!ReadCount(count))
+						return false;
+
+					value.SetObject();
+					for (uint32_t memberIndex = 0; memberIndex < count; ++memberIndex)
+					{
+						rapidjson::Value name;
+						rapidjson::Value member;
+						if (!ReadString(name) || !ReadValue(member, depth + 1))
+							return false;
+
+						value.AddMember(name, member, m_allocator);
+					}
+					return true;
+				}
+
+				default:
+					return false;
+			}
+		}
+
+	private:
+		template <class Type>
+		bool ReadPod(Type& value)
+		{
+			if (static_cast<size_t>(m_pEnd - m_pCurrent) < sizeof(Type))
+				return false;
+
+			::memcpy(&value, m_pCurrent, sizeof(Type));
+			m_pCurrent += sizeof(Type);
+			return true;
+		}
+
+		/// <summary>
+		/// Every element takes at least a byte, so a count larger than
+		/// what's left is corrupt, and is rejected before reserving for it.
+		/// </summary>
+		bool ReadCount(uint32_t& count)
+		{
+			return ReadPod(count) && count <= static_cast<size_t>(m_pEnd - m_pCurrent);
+		}
+
+		bool ReadString(rapidjson::Value& value)
+		{
+			uint32_t length;
+			if (!ReadCount(length))
+				return false;
+
+			value.SetString(reinterpret_cast<const char*>(m_pCurrent), length, m_allocator);
+			m_pCurrent += length;
+			return true;
+		}
+	};
+
+	bool CookedJson::IsCooked(const eastl::vector<std::byte>& data)
+	{
+		uint32_t signature = 0;
+		if (data.size() < sizeof(CookedJsonHeader))
+			return false;
+
+		::memcpy(&signature, data.data(), sizeof(signature));
+		return signature == CookedJsonHeader::kSignature;
+	}
+
+	void CookedJson::Write(const rapidjson::Value& value, eastl::vector<std::byte>& cookedData)
+	{
+		cookedData.clear();
+		cookedData.resize(sizeof(CookedJsonHeader));
+		WriteValue(cookedData, value);
+
+		CookedJsonHeader header = {};
+		header.m_signature = CookedJsonHeader::kSignature;
+		header.m_version = CookedJsonHeader::kVersion;
+		header.m_headerSize = sizeof(CookedJsonHeader);
+		header.m_valueSize = cookedData.size() - sizeof(CookedJsonHeader);
+		::memcpy(cookedData.data(), &header, sizeof(CookedJsonHeader));
+	}
+
+	bool CookedJson::Read(const eastl::vector<std::byte>& cookedData, rapidjson::Document& document)
+	{
+		if (!IsCooked(cookedData))
+			return false;
+
+		CookedJsonHeader header;
+		::memcpy(&header, cookedData.data(), sizeof(CookedJsonHeader));
+		if (header.m_version != CookedJsonHeader::kVersion || header.m_headerSize != sizeof(CookedJsonHeader)
+			|| header.m_valueSize != cookedData.size() - sizeof(CookedJsonHeader))
+		{
+			return false;
+		}
+
+		const std::byte* pValue = cookedData.data() + sizeof(CookedJsonHeader);
+		CookedJsonReader reader(pValue, pValue + header.m_valueSize, document.GetAllocator());
+		if (!reader.ReadValue(document, 0) || !reader.IsAtEnd())
+		{
+			document.SetNull();
+			return false;
+		}
+
+		return true;
+	}
+}
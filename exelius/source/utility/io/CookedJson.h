@@ -0,0 +1,41 @@
+#pragma once
+#include <rapidjson/fwd.h>
+
+#include <EASTL/vector.h>
+#include <cstddef>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Converts between JSON documents and the cooked binary form written by
+	/// the exeliuscooker tool. Reading a cooked document builds the same DOM
+	/// as parsing its text, without tokenizing, unescaping or converting numbers.
+	/// @see CookedAssetStructs.h
+	/// </summary>
+	class CookedJson
+	{
+	public:
+		/// <summary>
+		/// Whether the data starts with a cooked JSON header.
+		/// </summary>
+		static bool IsCooked(const eastl::vector<std::byte>& data);
+
+		/// <summary>
+		/// Encode a JSON value as a cooked document.
+		/// </summary>
+		/// <param name="value">- The root value to encode.</param>
+		/// <param name="cookedData">- Receives the header and the encoded value.</param>
+		static void Write(const rapidjson::Value& value, eastl::vector<std::byte>& cookedData);
+
+		/// <summary>
+		/// Decode a cooked document. Safe to call from any thread.
+		/// </summary>
+		/// <param name="cookedData">- Data starting with a cooked JSON header.</param>
+		/// <param name="document">- Receives the decoded DOM.</param>
+		/// <returns>True if the whole document was valid and decoded.</returns>
+		static bool Read(const eastl::vector<std::byte>& cookedData, rapidjson::Document& document);
+	};
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// ------------------------------------------------------------------------------------------
+	/// Exelius Asset Pack (.expak) Structs
+	///
+	/// Everything is little endian, and laid out as:
+	///		ExpakHeader
+	///		ExpakEntry[m_entryCount]	- Sorted by m_nameHash, then by name.
+	///		Names						- Every entry's name, back to back, not null terminated.
+	///		Data						- Every entry's data, each starting on a multiple of m_alignment.
+	///
+	/// Names are resource paths, such as "EngineResources/Textures/Logo.png",
+	/// and hashed with StringHash::HashString64, the same as StringIntern::GetHash.
+	/// ------------------------------------------------------------------------------------------
+	#pragma region EXPAK_STRUCTS
+		/// <summary>
+		/// How an entry's data is stored. Chosen per entry by the packer.
+		/// </summary>
+		enum class ExpakCompression : uint8_t
+		{
+			kNone,		/// Stored as is.
+			kLZ4,		/// A single LZ4 block.
+			kZstd,		/// A single zstd frame.
+			kMax		/// Used for bounds checking. Not a valid compression.
+		};
+
+		#pragma pack(1)
+			struct ExpakHeader
+			{
+				static constexpr uint32_t kSignature = 0x4B505845; // "EXPK"
+				static constexpr uint16_t kVersion = 1;
+
+				uint32_t m_signature;
+				uint16_t m_version;
+				uint16_t m_headerSize;		// sizeof(ExpakHeader) when written.
+				uint32_t m_entryCount;
+				uint32_t m_alignment;		// The page size the data was aligned to.
+				uint64_t m_tocOffset;		// Offset of the first ExpakEntry.
+				uint64_t m_namesOffset;
+				uint64_t m_namesSize;
+			};
+
+			struct ExpakEntry
+			{
+				uint64_t m_nameHash;
+				uint64_t m_offset;			// Offset of the data from the start of the pack.
+				uint64_t m_storedSize;		// Size of the data in the pack.
+				uint64_t m_size;			// Size of the data once decompressed.
+				uint32_t m_nameOffset;		// Offset of the name from the start of the names.
+				uint16_t m_nameLength;
+				ExpakCompression m_compression;
+				uint8_t m_reserved;
+			};
+		#pragma pack()
+
+		static_assert(sizeof(ExpakHeader) == 40, "The expak header is part of the file format.");
+		static_assert(sizeof(ExpakEntry) == 40, "The expak entry is part of the file format.");
+	#pragma endregion
+}
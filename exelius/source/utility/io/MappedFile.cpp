@@ -0,0 +1,129 @@
+#include "EXEPCH.h"
+#include "source/utility/io/MappedFile.h"
+
+#ifdef EXE_WINDOWS
+	#include <Windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif // EXE_WINDOWS
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	MappedFile::MappedFile()
+		: m_pData(nullptr)
+		, m_size(0)
+#ifdef EXE_WINDOWS
+		, m_pFileHandle(nullptr)
+		, m_pMappingHandle(nullptr)
+#endif // EXE_WINDOWS
+	{
+		//
+	}
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+	bool MappedFile::Open(const char* pFilePath)
+	{
+		EXE_ASSERT(pFilePath);
+		Close();
+
+#ifdef EXE_WINDOWS
+		HANDLE fileHandle = CreateFileA(pFilePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+		if (fileHandle == INVALID_HANDLE_VALUE)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "Failed to open '{}'.", pFilePath);
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "'{}' is empty or its size could not be read.", pFilePath);
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mappingHandle)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "Failed to create a mapping of '{}'.", pFilePath);
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		void* pView = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		if (!pView)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "Failed to map a view of '{}'.", pFilePath);
+			CloseHandle(mappingHandle);
+			CloseHandle(fileHandle);
+			return false;
+		}
+
+		m_pFileHandle = fileHandle;
+		m_pMappingHandle = mappingHandle;
+		m_pData = static_cast<const std::byte*>(pView);
+		m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+		const int fileDescriptor = open(pFilePath, O_RDONLY | O_CLOEXEC);
+		if (fileDescriptor < 0)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "Failed to open '{}'.", pFilePath);
+			return false;
+		}
+
+		struct stat fileStatus;
+		if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "'{}' is empty or its size could not be read.", pFilePath);
+			close(fileDescriptor);
+			return false;
+		}
+
+		const size_t fileSize = static_cast<size_t>(fileStatus.st_size);
+		void* pView = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+		// The mapping keeps the file alive.
+		close(fileDescriptor);
+
+		if (pView == MAP_FAILED)
+		{
+			EXE_LOG_CATEGORY_WARN("MappedFile", "Failed to map '{}'.", pFilePath);
+			return false;
+		}
+
+		m_pData = static_cast<const std::byte*>(pView);
+		m_size = fileSize;
+#endif // EXE_WINDOWS
+
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (!m_pData)
+			return;
+
+#ifdef EXE_WINDOWS
+		UnmapViewOfFile(m_pData);
+		CloseHandle(m_pMappingHandle);
+		CloseHandle(m_pFileHandle);
+		m_pMappingHandle = nullptr;
+		m_pFileHandle = nullptr;
+#else
+		munmap(const_cast<std::byte*>(m_pData), m_size);
+#endif // EXE_WINDOWS
+
+		m_pData = nullptr;
+		m_size = 0;
+	}
+}
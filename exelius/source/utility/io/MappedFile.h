@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A file mapped read-only into memory. Pages are read in by the OS as
+	/// they are first touched, so opening even a large file is cheap.
+	/// The contents may be read from any number of threads while it is open.
+	/// </summary>
+	class MappedFile
+	{
+		const std::byte* m_pData;
+		size_t m_size;
+
+#ifdef EXE_WINDOWS
+		void* m_pFileHandle;
+		void* m_pMappingHandle;
+#endif // EXE_WINDOWS
+
+	public:
+		MappedFile();
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&&) = delete;
+		~MappedFile();
+
+		/// <summary>
+		/// Map the whole file. Closes any file already mapped.
+		/// </summary>
+		/// <param name="pFilePath">- The file to map.</param>
+		/// <returns>True if the file was mapped. Empty files can't be mapped.</returns>
+		bool Open(const char* pFilePath);
+
+		/// <summary>
+		/// Unmap the file. Anything pointing into it is no longer valid.
+		/// </summary>
+		void Close();
+
+		bool IsOpen() const { return m_pData != nullptr; }
+
+		const std::byte* GetData() const { return m_pData; }
+		size_t GetSize() const { return m_size; }
+	};
+}
@@ -35,6 +35,7 @@ namespace Exelius
 				uint32_t sig;
 				uint16_t nDisk;
 				uint16_t nStartDisk;
+				uint16_t nDirEntries;	// Entries on this disk.
 				uint16_t totalDirEntries;
 				uint32_t dirSize;
 				uint32_t dirOffset;
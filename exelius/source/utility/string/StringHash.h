@@ -35,6 +35,19 @@ namespace Exelius
 			return hash;
 		}
 
+		template <class IntType, IntType kOffsetBasis, IntType kPrimeMultiplier>
+		static constexpr IntType Fnv1aHash(const char* pStringToHash, size_t length)
+		{
+			IntType hash = kOffsetBasis;
+			for (size_t i = 0; i < length; ++i)
+			{
+				hash ^= static_cast<IntType>(pStringToHash[i]);
+				hash *= kPrimeMultiplier;
+			}
+
+			return hash;
+		}
+
 	public:
 
 		static constexpr uint32_t HashString32(const char* pStringToHash)
@@ -56,5 +69,14 @@ namespace Exelius
 		{
 			return Fnv1aHash<uint64_t, s_kOffsetBasis64, s_kPrimeMultiplier64>(stringToHash.c_str());
 		}
+
+		/// <summary>
+		/// Hash the first length characters. Gives the same result as the
+		/// null terminated overload for a string of that length.
+		/// </summary>
+		static constexpr uint64_t HashString64(const char* pStringToHash, size_t length)
+		{
+			return Fnv1aHash<uint64_t, s_kOffsetBasis64, s_kPrimeMultiplier64>(pStringToHash, length);
+		}
 	};
 }
\ No newline at end of file
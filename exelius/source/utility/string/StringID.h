@@ -0,0 +1,64 @@
+#pragma once
+#include "source/utility/string/StringHash.h"
+#include "source/utility/string/StringIntern.h"
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A string literal and its hash, computed at compile time.
+	///
+	/// The hash is the same one the intern table uses, so interning a StringID
+	/// skips hashing, and StringID::GetHash() == StringIntern::GetHash() for
+	/// the same string. Hashes are stable across runs and may be used as IDs
+	/// in switch statements or data.
+	///
+	/// Prefer EXE_STRING_ID, which also interns the string once per call site.
+	///
+	/// @code{.cpp}
+	/// constexpr Exelius::StringID kQuadShader("assets/shaders/quadrenderer.glsl");
+	/// static_assert(kQuadShader.GetHash() != 0);
+	/// @endcode
+	/// </summary>
+	class StringID
+	{
+		const char* m_pString;
+		size_t m_length;
+		uint64_t m_hash;
+
+	public:
+		template <size_t kSize>
+		consteval StringID(const char (&string)[kSize])
+			: m_pString(string)
+			, m_length(kSize - 1)
+			, m_hash(StringHash::HashString64(string, kSize - 1))
+		{
+			//
+		}
+
+		constexpr const char* GetString() const { return m_pString; }
+		constexpr size_t GetLength() const { return m_length; }
+		constexpr uint64_t GetHash() const { return m_hash; }
+
+		constexpr bool operator==(const StringID& right) const { return m_hash == right.m_hash; }
+		constexpr bool operator!=(const StringID& right) const { return m_hash != right.m_hash; }
+	};
+}
+
+// Interns a string literal once per call site, the first time the line runs.
+// Every later run returns the cached StringIntern without hashing or looking
+// anything up. Usable anywhere a ResourceID or log category is expected.
+//
+// The hash is computed at compile time. Interning asserts if a different
+// string with the same hash is already in the intern table.
+#define EXE_STRING_ID(STRING_LITERAL) \
+	([]() -> const ::Exelius::StringIntern& \
+	{ \
+		static const ::Exelius::StringIntern s_kInterned(::Exelius::StringID(STRING_LITERAL)); \
+		return s_kInterned; \
+	}())
@@ -0,0 +1,266 @@
+#include "EXEPCH.h"
+#include "StringIntern.h"
+#include "source/utility/string/StringHash.h"
+#include "source/utility/string/StringID.h"
+#include "source/os/memory/ExeliusAllocator.h"
+
+#include <EASTL/vector.h>
+#include <mutex>
+#include <shared_mutex>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Bump allocator that grows in chunks and only frees everything at once.
+	/// Not thread safe, each shard only allocates from its own while holding its lock.
+	/// </summary>
+	class StringInternArena
+		: public ExeliusAllocator
+	{
+		static constexpr size_t s_kChunkSize = 16 * 1024;
+
+		struct Chunk
+		{
+			Chunk* m_pNext;
+			size_t m_size;
+		};
+
+		Chunk* m_pChunks;
+		std::byte* m_pCurrent;
+		std::byte* m_pEnd;
+
+	public:
+		StringInternArena()
+			: m_pChunks(nullptr)
+			, m_pCurrent(nullptr)
+			, m_pEnd(nullptr)
+		{
+			//
+		}
+
+		StringInternArena(const StringInternArena&) = delete;
+		StringInternArena(StringInternArena&&) = delete;
+		StringInternArena& operator=(const StringInternArena&) = delete;
+		StringInternArena& operator=(StringInternArena&&) = delete;
+
+		virtual ~StringInternArena()
+		{
+			Release();
+		}
+
+		virtual void* Allocate(size_t sizeToAllocate, size_t memoryAlignment, const char*, int) final override
+		{
+			EXE_ASSERT(memoryAlignment > 0 && (memoryAlignment & (memoryAlignment - 1)) == 0);
+
+			std::byte* pAligned = AlignUp(m_pCurrent, memoryAlignment);
+			if (!m_pCurrent || pAligned + sizeToAllocate > m_pEnd)
+			{
+				// Strings too long for a chunk get a chunk of their own.
+				const size_t chunkSize = eastl::max(s_kChunkSize, sizeof(Chunk) + memoryAlignment + sizeToAllocate);
+				Chunk* pChunk = reinterpret_cast<Chunk*>(EXELIUS_NEW_ARRAY(std::byte, chunkSize));
+				EXE_ASSERT(pChunk);
+
+				pChunk->m_pNext = m_pChunks;
+				pChunk->m_size = chunkSize;
+				m_pChunks = pChunk;
+
+				m_pCurrent = reinterpret_cast<std::byte*>(pChunk + 1);
+				m_pEnd = reinterpret_cast<std::byte*>(pChunk) + chunkSize;
+				pAligned = AlignUp(m_pCurrent, memoryAlignment);
+			}
+
+			m_pCurrent = pAligned + sizeToAllocate;
+			return pAligned;
+		}
+
+		/// <summary>
+		/// Memory is only released all at once.
+		/// </summary>
+		virtual void Free(void*, size_t, bool) final override
+		{
+			//
+		}
+
+		void Release()
+		{
+			while (m_pChunks)
+			{
+				Chunk* pNext = m_pChunks->m_pNext;
+				std::byte* pChunkMemory = reinterpret_cast<std::byte*>(m_pChunks);
+				EXELIUS_DELETE_ARRAY(pChunkMemory);
+				m_pChunks = pNext;
+			}
+
+			m_pCurrent = nullptr;
+			m_pEnd = nullptr;
+		}
+
+	private:
+		static std::byte* AlignUp(std::byte* pAddress, size_t memoryAlignment)
+		{
+			const uintptr_t address = reinterpret_cast<uintptr_t>(pAddress);
+			return reinterpret_cast<std::byte*>((address + memoryAlignment - 1) & ~(memoryAlignment - 1));
+		}
+	};
+
+	/// <summary>
+	/// One lock's worth of the intern table.
+	/// An open addressing hash table of entries, keyed on their precomputed hash.
+	/// </summary>
+	class StringInternShard
+	{
+		static constexpr size_t s_kInitialCapacity = 64;
+
+		using Entry = StringIntern::Entry;
+
+		std::shared_mutex m_lock;
+		eastl::vector<Entry*> m_slots; // Capacity is a power of two, nullptr is empty.
+		size_t m_entryCount = 0;
+		StringInternArena m_arena;
+
+	public:
+		~StringInternShard()
+		{
+			Clear();
+		}
+
+		const Entry* FindOrAdd(const char* pString, size_t length, uint64_t hash)
+		{
+			// Most strings are already interned, so look first without blocking other readers.
+			{
+				std::shared_lock<std::shared_mutex> lock(m_lock);
+				if (const Entry* pEntry = Find(pString, length, hash))
+					return pEntry;
+			}
+
+			std::unique_lock<std::shared_mutex> lock(m_lock);
+
+			// Another thread may have added it while we waited.
+			if (const Entry* pEntry = Find(pString, length, hash))
+				return pEntry;
+
+			return Add(pString, length, hash);
+		}
+
+		void Clear()
+		{
+			std::unique_lock<std::shared_mutex> lock(m_lock);
+
+			for (Entry* pEntry : m_slots)
+			{
+				if (pEntry)
+					pEntry->~Entry();
+			}
+
+			eastl::vector<Entry*>().swap(m_slots);
+			m_entryCount = 0;
+			m_arena.Release();
+		}
+
+	private:
+		const Entry* Find(const char* pString, size_t length, uint64_t hash) const
+		{
+			if (m_slots.empty())
+				return nullptr;
+
+			const size_t mask = m_slots.size() - 1;
+			for (size_t slot = static_cast<size_t>(hash) & mask; m_slots[slot]; slot = (slot + 1) & mask)
+			{
+				const Entry* pEntry = m_slots[slot];
+				if (pEntry->m_hash != hash)
+					continue;
+
+				if (pEntry->m_string.size() == length && ::memcmp(pEntry->m_string.data(), pString, length) == 0)
+					return pEntry;
+
+				// Two different strings share a hash. The table still tells them apart,
+				// but anything using StringID or GetHash() as an identifier can't.
+				// Can't log here, logging interns strings.
+				EXE_ASSERT(false);
+			}
+
+			return nullptr;
+		}
+
+		const Entry* Add(const char* pString, size_t length, uint64_t hash)
+		{
+			// Keep the table at most 3/4 full.
+			if ((m_entryCount + 1) * 4 > m_slots.size() * 3)
+				Grow();
+
+			// The entry, and the characters if they don't fit inline, sit next to each other in the arena.
+			void* pEntryMemory = m_arena.Allocate(sizeof(Entry), alignof(Entry), __FILE__, __LINE__);
+			Entry* pEntry = new (pEntryMemory) Entry{ eastl::string(pString, length, EASTLAllocatorWrapper(&m_arena, "StringIntern")), hash };
+
+			Insert(pEntry);
+			++m_entryCount;
+			return pEntry;
+		}
+
+		void Grow()
+		{
+			eastl::vector<Entry*> oldSlots;
+			oldSlots.swap(m_slots);
+			m_slots.resize(oldSlots.empty() ? s_kInitialCapacity : oldSlots.size() * 2, nullptr);
+
+			// The hashes are stored, so no strings need to be rehashed.
+			for (Entry* pEntry : oldSlots)
+			{
+				if (pEntry)
+					Insert(pEntry);
+			}
+		}
+
+		void Insert(Entry* pEntry)
+		{
+			const size_t mask = m_slots.size() - 1;
+			size_t slot = static_cast<size_t>(pEntry->m_hash) & mask;
+			while (m_slots[slot])
+				slot = (slot + 1) & mask;
+
+			m_slots[slot] = pEntry;
+		}
+	};
+
+	static constexpr uint32_t s_kStringInternShardBits = 4;
+	static constexpr size_t s_kStringInternShardCount = size_t(1) << s_kStringInternShardBits;
+
+	static StringInternShard* GetStringInternShards()
+	{
+		// Function local, so strings can be interned during static initialization.
+		static StringInternShard s_shards[s_kStringInternShardCount];
+		return s_shards;
+	}
+
+	StringIntern::StringIntern(const StringID& stringID)
+		: m_pEntry(nullptr)
+	{
+		FindOrAdd(stringID.GetString(), stringID.GetLength(), stringID.GetHash());
+	}
+
+	void StringIntern::FindOrAdd(const char* pString, size_t length)
+	{
+		EXE_ASSERT(pString || length == 0);
+		if (!pString)
+			pString = "";
+
+		FindOrAdd(pString, length, StringHash::HashString64(pString, length));
+	}
+
+	void StringIntern::FindOrAdd(const char* pString, size_t length, uint64_t hash)
+	{
+		// The shard is picked from the top bits, slots within it from the bottom bits.
+		StringInternShard& shard = GetStringInternShards()[hash >> (64 - s_kStringInternShardBits)];
+		m_pEntry = shard.FindOrAdd(pString, length, hash);
+	}
+
+	void StringIntern::_ClearStringInternSet()
+	{
+		StringInternShard* pShards = GetStringInternShards();
+		for (size_t i = 0; i < s_kStringInternShardCount; ++i)
+			pShards[i].Clear();
+	}
+}
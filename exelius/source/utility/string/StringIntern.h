@@ -1,69 +1,93 @@
 #pragma once
 #include "source/utility/generic/Macros.h"
-#include <EASTL/hash_set.h>
 #include <EASTL/string.h>
+#include <cstdint>
+#include <cstring>
 
 /// <summary>
 /// Engine namespace. Everything owned by the engine will be inside this namespace.
 /// </summary>
 namespace Exelius
 {
+	class StringID;
+
+	/// <summary>
+	/// A handle to the single shared copy of a string.
+	///
+	/// Strings are interned into a table split into shards, each with its own
+	/// lock, so threads only contend when interning into the same shard, and
+	/// looking up a string that is already interned only takes a shared lock.
+	/// Each shard stores its strings, with their hashes computed up front, in
+	/// its own arena. They never move, and are only freed when the table is
+	/// cleared at engine shutdown.
+	///
+	/// Comparing or hashing two StringInterns only compares or hashes their pointers.
+	/// </summary>
 	class StringIntern
 	{
 		friend bool operator<(const StringIntern& left, const StringIntern& right);
 
-		// Using a hash set here because it only requires 1 value, not a key value pair.
-		using StringInternSet = eastl::hash_set<eastl::string>;
-
-		// Using a pointer here because hash_set allocates memory
-		// and will cause the Memory Tracker to pick up false positive
-		// leaks unless deleted before the data dump at engine shutdown.
-		inline static StringInternSet* s_pStringSet = nullptr;
+	public:
+		/// <summary>
+		/// An interned string and its precomputed hash.
+		/// </summary>
+		struct Entry
+		{
+			eastl::string m_string;
+			uint64_t m_hash;
+		};
 
-		const eastl::string* m_pString;
+	private:
+		const Entry* m_pEntry;
 
 	public:
 		StringIntern()
-			: m_pString(nullptr)
+			: m_pEntry(nullptr)
 		{
 			//
 		}
 
 		StringIntern(const eastl::string& string)
-			: m_pString(nullptr)
+			: m_pEntry(nullptr)
 		{
-			FindOrAdd(string);
+			FindOrAdd(string.c_str(), string.size());
 		}
 
 		StringIntern(const char* pString)
-			: m_pString(nullptr)
+			: m_pEntry(nullptr)
 		{
-			FindOrAdd(pString);
+			FindOrAdd(pString, pString ? ::strlen(pString) : 0);
 		}
 
 		StringIntern(char character)
-			: m_pString(nullptr)
+			: m_pEntry(nullptr)
 		{
-			FindOrAdd(&character);
+			FindOrAdd(&character, 1);
 		}
 
+		/// <summary>
+		/// Intern a string whose hash was computed at compile time.
+		/// @see EXE_STRING_ID
+		/// </summary>
+		StringIntern(const StringID& stringID);
+
 		StringIntern(const StringIntern& stringIntern)
-			: m_pString(nullptr)
+			: m_pEntry(nullptr)
 		{
 			Set(stringIntern);
 		}
 
-		StringIntern(eastl::string&& string)
-			: m_pString(nullptr)
-		{
-			FindOrAdd(::std::move(string));
-		}
-
 		StringIntern(StringIntern&&) = default;
 
-		const eastl::string& Get() const { EXE_ASSERT(IsValid()); return (*m_pString); }
+		const eastl::string& Get() const { EXE_ASSERT(IsValid()); return m_pEntry->m_string; }
+
+		/// <summary>
+		/// The hash of the string's contents, computed once when it was interned.
+		/// The same across runs, unlike the hash used to key containers.
+		/// </summary>
+		uint64_t GetHash() const { EXE_ASSERT(IsValid()); return m_pEntry->m_hash; }
 
-		bool IsValid() const { return m_pString != nullptr; }
+		bool IsValid() const { return m_pEntry != nullptr; }
 
 		StringIntern& operator=(const StringIntern& right)
 		{
@@ -83,86 +107,61 @@ namespace Exelius
 			return (*this);
 		}
 
-		StringIntern& operator=(const eastl::string& right) { FindOrAdd(right); return (*this); }
-		StringIntern& operator=(eastl::string&& right) { FindOrAdd(std::move(right)); return (*this); }
-		StringIntern& operator=(const char* right) { FindOrAdd(right); return (*this); }
-		StringIntern& operator+=(const eastl::string& right) { FindOrAdd((*m_pString)+right); return (*this); }
+		StringIntern& operator=(const eastl::string& right) { FindOrAdd(right.c_str(), right.size()); return (*this); }
+		StringIntern& operator=(const char* right) { FindOrAdd(right, right ? ::strlen(right) : 0); return (*this); }
+		StringIntern& operator+=(const eastl::string& right) { const eastl::string combined = Get() + right; FindOrAdd(combined.c_str(), combined.size()); return (*this); }
 
-		bool operator==(const StringIntern& right) const { return m_pString == right.m_pString; }
-		bool operator!=(const StringIntern& right) const { return m_pString != right.m_pString; }
-		bool operator==(const eastl::string& right) const { return (*m_pString) == right; }
-		bool operator!=(const eastl::string& right) const { return (*m_pString) != right; }
-		bool operator==(const char* pRight) const { return ::strcmp(m_pString->c_str(), pRight) == 0; }
-		bool operator!=(const char* pRight) const { return ::strcmp(m_pString->c_str(), pRight) != 0; }
+		bool operator==(const StringIntern& right) const { return m_pEntry == right.m_pEntry; }
+		bool operator!=(const StringIntern& right) const { return m_pEntry != right.m_pEntry; }
+		bool operator==(const eastl::string& right) const { return Get() == right; }
+		bool operator!=(const eastl::string& right) const { return Get() != right; }
+		bool operator==(const char* pRight) const { return ::strcmp(Get().c_str(), pRight) == 0; }
+		bool operator!=(const char* pRight) const { return ::strcmp(Get().c_str(), pRight) != 0; }
 
-		operator const char* () const { EXE_ASSERT(m_pString); return (m_pString->c_str()); }
-		operator const eastl::string&() const { EXE_ASSERT(m_pString); return (*m_pString); }
+		operator const char* () const { EXE_ASSERT(m_pEntry); return (m_pEntry->m_string.c_str()); }
+		operator const eastl::string&() const { EXE_ASSERT(m_pEntry); return m_pEntry->m_string; }
 
+		/// <summary>
+		/// Used to key hash containers. Interned strings are unique, so the
+		/// address is enough and the contents never need to be read.
+		/// </summary>
+		size_t GetPointerHash() const
+		{
+			// The low bits of the address are always 0, mix them into the rest.
+			uint64_t hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(m_pEntry));
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			return static_cast<size_t>(hash);
+		}
 
 		/// <summary>
 		/// Clears the string intern set. This is an Exelius internal
 		/// function. DO NOT call this function, as the engine relies
 		/// on the string intern set.
-		/// 
+		///
 		/// This function is here to deallocate the memory of the set
 		/// upon engine shutdown.
 		/// </summary>
-		static void _ClearStringInternSet()
-		{
-			if (s_pStringSet)
-				s_pStringSet->clear();
-
-			EXELIUS_DELETE(s_pStringSet);
-		}
+		static void _ClearStringInternSet();
 
 	private:
 		void Set(const StringIntern& stringIntern)
 		{
-			m_pString = stringIntern.m_pString;
-		}
-
-		void FindOrAdd(const eastl::string& string)
-		{
-			if (!s_pStringSet)
-				s_pStringSet = EXELIUS_NEW(StringInternSet());
-
-			auto found = s_pStringSet->find(string);
-			if (found != s_pStringSet->end())
-			{
-				// Assign it the same data.
-				m_pString = &(*found);
-			}
-			else
-			{
-				// Add it to the set.
-				m_pString = &(*s_pStringSet->emplace(string).first);
-			}
-		}
-
-		void FindOrAdd(eastl::string&& string)
-		{
-			if (!s_pStringSet)
-				s_pStringSet = EXELIUS_NEW(StringInternSet());
-
-			// TODO: Access needs to be wrapping in a mutex
-			auto found = s_pStringSet->find(string);
-			if (found != s_pStringSet->end())
-			{
-				// Assign it the same data.
-				m_pString = &(*found);
-			}
-			else
-			{
-				// Add it to the set.
-				m_pString = &(*s_pStringSet->emplace(std::move(string)).first); //<-- STD::MOVE
-			}
+			m_pEntry = stringIntern.m_pEntry;
 		}
 
+		/// <summary>
+		/// Point at the interned copy of the string, interning it if this is the first time it was seen.
+		/// Safe to call from any thread.
+		/// </summary>
+		void FindOrAdd(const char* pString, size_t length);
+		void FindOrAdd(const char* pString, size_t length, uint64_t hash);
 	};
 
 	inline bool operator<(const Exelius::StringIntern& left, const Exelius::StringIntern& right)
 	{
-		return (left.m_pString < right.m_pString);
+		return (left.m_pEntry < right.m_pEntry);
 	}
 
 }
@@ -176,9 +175,7 @@ namespace eastl
 		// Used for storing a StringIntern as a key in EASTL hash maps.
 		size_t operator()(const Exelius::StringIntern& key) const noexcept
 		{
-			const char* stringPointer = key.Get().c_str();
-			const eastl::hash<const char8_t*> hashFunction;
-			return hashFunction(stringPointer);
+			return key.GetPointerHash();
 		}
 	};
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#pragma once
+#include <source/precompilation/EXEPCH.h>
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	struct BenchmarkSettings;
+
+	/// <summary>
+	/// Passed to every benchmark. Times the loop driven by KeepRunning().
+	///
+	/// @code{.cpp}
+	/// EXE_BENCHMARK(MyBenchmark)
+	/// {
+	///		MySetup setup; // Not timed.
+	///		while (state.KeepRunning())
+	///			DoNotOptimize(setup.DoWork());
+	/// }
+	/// @endcode
+	/// </summary>
+	class BenchmarkState
+	{
+		const BenchmarkSettings& m_settings;
+
+		uint64_t m_iterationCount;
+		uint64_t m_completedIterations;
+		uint64_t m_itemsPerIteration;
+
+		std::chrono::steady_clock::time_point m_startTime;
+		int64_t m_elapsedNanoseconds;
+		bool m_hasFinished;
+
+		const char* m_pSkipReason;
+
+	public:
+		BenchmarkState(uint64_t iterationCount, const BenchmarkSettings& settings)
+			: m_settings(settings)
+			, m_iterationCount(iterationCount)
+			, m_completedIterations(0)
+			, m_itemsPerIteration(1)
+			, m_elapsedNanoseconds(0)
+			, m_hasFinished(false)
+			, m_pSkipReason(nullptr)
+		{
+			EXE_ASSERT(m_iterationCount > 0);
+		}
+
+		/// <summary>
+		/// Starts the timer on the first call, and stops it once every iteration has run.
+		/// </summary>
+		/// <returns>True while there are iterations left to run.</returns>
+		inline bool KeepRunning()
+		{
+			if (m_completedIterations < m_iterationCount)
+			{
+				if (m_completedIterations++ == 0)
+					m_startTime = std::chrono::steady_clock::now();
+				return true;
+			}
+
+			if (!m_hasFinished)
+			{
+				m_elapsedNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+				m_hasFinished = true;
+			}
+
+			return false;
+		}
+
+		/// <summary>
+		/// True once KeepRunning() has run every iteration. A benchmark that returns early is reported as failed.
+		/// </summary>
+		bool HasFinished() const { return m_hasFinished; }
+
+		uint64_t GetIterationCount() const { return m_iterationCount; }
+
+		/// <summary>
+		/// For benchmarks processing many items per iteration, such as a batch of jobs.
+		/// Reported as items per second.
+		/// </summary>
+		void SetItemsPerIteration(uint64_t itemsPerIteration) { m_itemsPerIteration = itemsPerIteration; }
+		uint64_t GetItemsPerIteration() const { return m_itemsPerIteration; }
+
+		int64_t GetElapsedNanoseconds() const { return m_elapsedNanoseconds; }
+
+		/// <summary>
+		/// The settings the benchmarks are being run with, for benchmarks that take input.
+		/// </summary>
+		const BenchmarkSettings& GetSettings() const { return m_settings; }
+
+		/// <summary>
+		/// Return without running, for a benchmark missing its input.
+		/// Reported as skipped rather than failed.
+		/// </summary>
+		/// <param name="pReason">- Logged with the result. Must outlive the run.</param>
+		void Skip(const char* pReason) { m_pSkipReason = pReason; }
+		const char* GetSkipReason() const { return m_pSkipReason; }
+	};
+
+	using BenchmarkFunction = void(*)(BenchmarkState& state);
+
+	/// <summary>
+	/// A benchmark registered by EXE_BENCHMARK.
+	/// Registrations run before main, before the memory manager exists,
+	/// so they are kept in an intrusive list instead of a container.
+	/// </summary>
+	struct BenchmarkRegistration
+	{
+		inline static BenchmarkRegistration* s_pHead = nullptr;
+
+		const char* m_pName;
+		BenchmarkFunction m_function;
+
+		/// <summary>
+		/// Run exactly this many iterations instead of calibrating. 0 to calibrate.
+		/// For benchmarks whose iterations use up something finite, like interning new strings.
+		/// </summary>
+		uint64_t m_fixedIterationCount;
+
+		BenchmarkRegistration* m_pNext;
+
+		BenchmarkRegistration(const char* pName, BenchmarkFunction function, uint64_t fixedIterationCount = 0)
+			: m_pName(pName)
+			, m_function(function)
+			, m_fixedIterationCount(fixedIterationCount)
+			, m_pNext(s_pHead)
+		{
+			s_pHead = this;
+		}
+	};
+
+	/// <summary>
+	/// Keep the compiler from optimizing away a value that is otherwise unused.
+	/// </summary>
+	template <typename T>
+	inline void DoNotOptimize(const T& value)
+	{
+#ifdef _MSC_VER
+		static const volatile void* s_pSink = nullptr;
+		s_pSink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r,m"(value) : "memory");
+#endif
+	}
+
+	/// <summary>
+	/// Keep the compiler from assuming memory is unchanged across this point.
+	/// </summary>
+	inline void ClobberMemory()
+	{
+#ifdef _MSC_VER
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : : "memory");
+#endif
+	}
+}
+
+// Define and register a benchmark. The body receives a BenchmarkState& named state.
+#define EXE_BENCHMARK(NAME)\
+	static void NAME(::Exelius::BenchmarkState& state);\
+	static ::Exelius::BenchmarkRegistration s_##NAME##Registration(#NAME, &NAME);\
+	static void NAME(::Exelius::BenchmarkState& state)
+
+// Define and register a benchmark that always runs ITERATIONS iterations.
+#define EXE_BENCHMARK_ITERATIONS(NAME, ITERATIONS)\
+	static void NAME(::Exelius::BenchmarkState& state);\
+	static ::Exelius::BenchmarkRegistration s_##NAME##Registration(#NAME, &NAME, ITERATIONS);\
+	static void NAME(::Exelius::BenchmarkState& state)
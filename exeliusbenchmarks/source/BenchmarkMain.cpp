@@ -0,0 +1,106 @@
+#include "BenchmarkRunner.h"
+
+#include <source/debug/LogManager.h>
+#include <source/os/threads/JobSystem.h>
+#include <source/utility/string/StringIntern.h>
+
+#include <cstdlib>
+#include <cstring>
+
+/// <summary>
+/// Runs the engine's microbenchmarks without a window, and writes the results as JSON.
+///
+/// Usage: exeliusbenchmarks [--filter <text>] [--out <path>] [--samples <count>] [--min-time <ms>]
+///		[--allocator <system|trace|sizeclass>] [--alloc-trace <path>] [--list]
+///
+/// Compare allocators by running once per --allocator, replaying the same --alloc-trace.
+/// </summary>
+int main(int argc, char* argv[])
+{
+	using namespace Exelius;
+
+	BenchmarkSettings settings;
+	bool shouldListBenchmarks = false;
+
+	for (int argIndex = 1; argIndex < argc; ++argIndex)
+	{
+		const char* pArg = argv[argIndex];
+		const char* pValue = (argIndex + 1 < argc) ? argv[argIndex + 1] : nullptr;
+
+		if (::strcmp(pArg, "--list") == 0)
+		{
+			shouldListBenchmarks = true;
+			continue;
+		}
+
+		if (!pValue)
+		{
+			printf("Missing value for '%s'.\n", pArg);
+			return 1;
+		}
+
+		if (::strcmp(pArg, "--filter") == 0)
+			settings.m_pFilter = pValue;
+		else if (::strcmp(pArg, "--out") == 0)
+			settings.m_pOutputPath = pValue;
+		else if (::strcmp(pArg, "--samples") == 0)
+			settings.m_sampleCount = static_cast<uint32_t>(eastl::max(::atoi(pValue), 1));
+		else if (::strcmp(pArg, "--min-time") == 0)
+			settings.m_minSampleNanoseconds = static_cast<int64_t>(eastl::max(::atoi(pValue), 1)) * 1'000'000;
+		else if (::strcmp(pArg, "--alloc-trace") == 0)
+			settings.m_pAllocationTracePath = pValue;
+		else if (::strcmp(pArg, "--allocator") == 0)
+		{
+			if (::strcmp(pValue, "system") == 0)
+				settings.m_globalAllocatorType = GlobalAllocatorType::kSystem;
+			else if (::strcmp(pValue, "trace") == 0)
+				settings.m_globalAllocatorType = GlobalAllocatorType::kTrace;
+			else if (::strcmp(pValue, "sizeclass") == 0)
+				settings.m_globalAllocatorType = GlobalAllocatorType::kSizeClass;
+			else
+			{
+				printf("Unknown allocator '%s'.\n", pValue);
+				return 1;
+			}
+		}
+		else
+		{
+			printf("Unknown argument '%s'.\n", pArg);
+			return 1;
+		}
+
+		++argIndex;
+	}
+
+	// Defaults to the fastest allocator, whatever the build configuration.
+	MemoryManager::SetSingleton(new MemoryManager());
+	EXE_ASSERT(MemoryManager::GetInstance());
+	MemoryManager::GetInstance()->Initialize(settings.m_globalAllocatorType);
+
+	LogManager::SetSingleton(EXELIUS_NEW(LogManager()));
+	EXE_ASSERT(LogManager::GetInstance());
+	if (!LogManager::GetInstance()->PreInitialize())
+		return 1;
+
+	s_pGlobalJobSystem = EXELIUS_NEW(JobSystem());
+	s_pGlobalJobSystem->Initialize();
+
+	bool hasSucceeded = true;
+	if (shouldListBenchmarks)
+	{
+		BenchmarkRunner::LogBenchmarkNames();
+	}
+	else
+	{
+		BenchmarkRunner runner(settings);
+		hasSucceeded = runner.Run();
+		hasSucceeded = runner.WriteJson() && hasSucceeded;
+	}
+
+	EXELIUS_DELETE(s_pGlobalJobSystem);
+	LogManager::DestroySingleton();
+	StringIntern::_ClearStringInternSet();
+	MemoryManager::DestroySingleton();
+
+	return hasSucceeded ? 0 : 1;
+}
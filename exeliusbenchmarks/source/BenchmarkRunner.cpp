@@ -0,0 +1,253 @@
+#include "BenchmarkRunner.h"
+
+#include <source/utility/io/File.h>
+
+#include <EASTL/sort.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Calibration never runs a benchmark more times than this.
+	/// </summary>
+	static constexpr uint64_t s_kMaxIterationCount = 1'000'000'000;
+
+	BenchmarkRunner::BenchmarkRunner(const BenchmarkSettings& settings)
+		: m_settings(settings)
+	{
+		EXE_ASSERT(m_settings.m_pOutputPath);
+		EXE_ASSERT(m_settings.m_sampleCount > 0);
+	}
+
+	bool BenchmarkRunner::Run()
+	{
+		m_results.clear();
+
+		bool hasAllSucceeded = true;
+		for (const BenchmarkRegistration* pRegistration : GetSortedRegistrations())
+		{
+			if (m_settings.m_pFilter && !::strstr(pRegistration->m_pName, m_settings.m_pFilter))
+				continue;
+
+			const BenchmarkResult& result = m_results.emplace_back(RunBenchmark(*pRegistration));
+			if (result.m_pSkipReason)
+			{
+				EXE_LOG_CATEGORY_INFO("Benchmarks", "{:<40} skipped: {}", result.m_pName, result.m_pSkipReason);
+				continue;
+			}
+
+			if (result.m_hasFailed)
+			{
+				EXE_LOG_CATEGORY_ERROR("Benchmarks", "{} failed, it returned before running every iteration.", result.m_pName);
+				hasAllSucceeded = false;
+				continue;
+			}
+
+			EXE_LOG_CATEGORY_INFO("Benchmarks", "{:<40} {:>12.1f} ns  (min {:.1f}, max {:.1f}, {} iterations)", result.m_pName, result.m_median, result.m_min, result.m_max, result.m_iterationCount);
+		}
+
+		return hasAllSucceeded;
+	}
+
+	BenchmarkResult BenchmarkRunner::RunBenchmark(const BenchmarkRegistration& registration) const
+	{
+		BenchmarkResult result;
+		result.m_pName = registration.m_pName;
+
+		// Grow the iteration count until a run is long enough to time reliably.
+		uint64_t iterationCount = (registration.m_fixedIterationCount > 0) ? registration.m_fixedIterationCount : 1;
+		while (registration.m_fixedIterationCount == 0)
+		{
+			BenchmarkState state(iterationCount, m_settings);
+			registration.m_function(state);
+			if (state.GetSkipReason())
+			{
+				result.m_pSkipReason = state.GetSkipReason();
+				return result;
+			}
+
+			if (!state.HasFinished())
+			{
+				result.m_hasFailed = true;
+				return result;
+			}
+
+			const int64_t elapsedNanoseconds = state.GetElapsedNanoseconds();
+			if (elapsedNanoseconds >= m_settings.m_minSampleNanoseconds || iterationCount >= s_kMaxIterationCount)
+				break;
+
+			// Aim a little past the target so calibration doesn't creep up on it, but never jump too far on a noisy run.
+			const double growth = (elapsedNanoseconds > 0) ? (1.4 * static_cast<double>(m_settings.m_minSampleNanoseconds) / static_cast<double>(elapsedNanoseconds)) : 10.0;
+			const double clampedGrowth = eastl::clamp(growth, 2.0, 10.0);
+			iterationCount = eastl::min(static_cast<uint64_t>(static_cast<double>(iterationCount) * clampedGrowth), s_kMaxIterationCount);
+		}
+
+		eastl::vector<double> samples;
+		samples.reserve(m_settings.m_sampleCount);
+		for (uint32_t sampleIndex = 0; sampleIndex < m_settings.m_sampleCount; ++sampleIndex)
+		{
+			BenchmarkState state(iterationCount, m_settings);
+			registration.m_function(state);
+			if (state.GetSkipReason())
+			{
+				result.m_pSkipReason = state.GetSkipReason();
+				return result;
+			}
+
+			if (!state.HasFinished())
+			{
+				result.m_hasFailed = true;
+				return result;
+			}
+
+			samples.push_back(static_cast<double>(state.GetElapsedNanoseconds()) / static_cast<double>(iterationCount));
+			result.m_itemsPerIteration = state.GetItemsPerIteration();
+		}
+
+		eastl::sort(samples.begin(), samples.end());
+
+		const size_t middle = samples.size() / 2;
+		result.m_median = (samples.size() % 2 == 0) ? (samples[middle - 1] + samples[middle]) * 0.5 : samples[middle];
+		result.m_min = samples.front();
+		result.m_max = samples.back();
+
+		double total = 0.0;
+		for (double sample : samples)
+			total += sample;
+		result.m_mean = total / static_cast<double>(samples.size());
+
+		double variance = 0.0;
+		for (double sample : samples)
+			variance += (sample - result.m_mean) * (sample - result.m_mean);
+		result.m_standardDeviation = std::sqrt(variance / static_cast<double>(samples.size()));
+
+		result.m_iterationCount = iterationCount;
+		result.m_itemsPerSecond = (result.m_median > 0.0) ? static_cast<double>(result.m_itemsPerIteration) * 1'000'000'000.0 / result.m_median : 0.0;
+		return result;
+	}
+
+	bool BenchmarkRunner::WriteJson() const
+	{
+		char buffer[256];
+
+		eastl::string json;
+		json += "{\n\t\"context\":\n\t{\n";
+
+		const std::time_t now = std::time(nullptr);
+		std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+		json += "\t\t\"date\": \"";
+		json += buffer;
+		json += "\",\n";
+
+#ifdef EXE_DEBUG
+		json += "\t\t\"build\": \"Debug\",\n";
+#else
+		json += "\t\t\"build\": \"Release\",\n";
+#endif // EXE_DEBUG
+
+		snprintf(buffer, sizeof(buffer), "\t\t\"hardware_threads\": %u,\n", std::thread::hardware_concurrency());
+		json += buffer;
+		snprintf(buffer, sizeof(buffer), "\t\t\"samples\": %u,\n", m_settings.m_sampleCount);
+		json += buffer;
+		snprintf(buffer, sizeof(buffer), "\t\t\"global_allocator\": \"%s\",\n", GetGlobalAllocatorName(m_settings.m_globalAllocatorType));
+		json += buffer;
+		json += "\t\t\"time_unit\": \"ns\"\n\t},\n\t\"benchmarks\":\n\t[\n";
+
+		for (size_t resultIndex = 0; resultIndex < m_results.size(); ++resultIndex)
+		{
+			const BenchmarkResult& result = m_results[resultIndex];
+
+			// Benchmark names are C++ identifiers, so need no escaping.
+			json += "\t\t{ \"name\": \"";
+			json += result.m_pName;
+			json += "\"";
+
+			if (result.m_pSkipReason)
+			{
+				json += ", \"skipped\": true";
+			}
+			else if (result.m_hasFailed)
+			{
+				json += ", \"failed\": true";
+			}
+			else
+			{
+				snprintf(buffer, sizeof(buffer), ", \"iterations\": %llu, \"median\": %.3f, \"mean\": %.3f, \"min\": %.3f, \"max\": %.3f, \"stddev\": %.3f",
+					static_cast<unsigned long long>(result.m_iterationCount), result.m_median, result.m_mean, result.m_min, result.m_max, result.m_standardDeviation);
+				json += buffer;
+
+				snprintf(buffer, sizeof(buffer), ", \"items_per_iteration\": %llu, \"items_per_second\": %.1f",
+					static_cast<unsigned long long>(result.m_itemsPerIteration), result.m_itemsPerSecond);
+				json += buffer;
+			}
+
+			json += (resultIndex + 1 < m_results.size()) ? " },\n" : " }\n";
+		}
+
+		json += "\t]\n}\n";
+
+		File resultsFile;
+		if (!resultsFile.Open(m_settings.m_pOutputPath, File::AccessPermission::kWriteOnly, File::CreationType::kOverwriteFile))
+		{
+			EXE_LOG_CATEGORY_ERROR("Benchmarks", "Failed to open '{}' to write the results.", m_settings.m_pOutputPath);
+			return false;
+		}
+
+		eastl::vector<std::byte> data(json.size());
+		::memcpy(data.data(), json.data(), json.size());
+		const size_t writtenBytes = resultsFile.Write(data);
+		resultsFile.Close();
+
+		if (writtenBytes != data.size())
+		{
+			EXE_LOG_CATEGORY_ERROR("Benchmarks", "Failed to write the results to '{}'.", m_settings.m_pOutputPath);
+			return false;
+		}
+
+		EXE_LOG_CATEGORY_INFO("Benchmarks", "Wrote {} results to '{}'.", m_results.size(), m_settings.m_pOutputPath);
+		return true;
+	}
+
+	void BenchmarkRunner::LogBenchmarkNames()
+	{
+		for (const BenchmarkRegistration* pRegistration : GetSortedRegistrations())
+			EXE_LOG_CATEGORY_INFO("Benchmarks", "{}", pRegistration->m_pName);
+	}
+
+	eastl::vector<const BenchmarkRegistration*> BenchmarkRunner::GetSortedRegistrations()
+	{
+		eastl::vector<const BenchmarkRegistration*> registrations;
+		for (const BenchmarkRegistration* pRegistration = BenchmarkRegistration::s_pHead; pRegistration; pRegistration = pRegistration->m_pNext)
+			registrations.push_back(pRegistration);
+
+		eastl::sort(registrations.begin(), registrations.end(), [](const BenchmarkRegistration* pLeft, const BenchmarkRegistration* pRight)
+			{
+				return ::strcmp(pLeft->m_pName, pRight->m_pName) < 0;
+			});
+
+		return registrations;
+	}
+
+	const char* BenchmarkRunner::GetGlobalAllocatorName(GlobalAllocatorType globalAllocatorType)
+	{
+		switch (globalAllocatorType)
+		{
+		case GlobalAllocatorType::kSystem:
+			return "system";
+		case GlobalAllocatorType::kTrace:
+			return "trace";
+		case GlobalAllocatorType::kSizeClass:
+			return "sizeclass";
+		default:
+			return "unknown";
+		}
+	}
+}
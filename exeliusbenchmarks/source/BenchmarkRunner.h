@@ -0,0 +1,122 @@
+#pragma once
+#include "Benchmark.h"
+
+#include <source/os/memory/MemoryManager.h>
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// How the registered benchmarks are run.
+	/// </summary>
+	struct BenchmarkSettings
+	{
+		/// <summary>
+		/// Only run benchmarks whose name contains this. Runs everything if null.
+		/// </summary>
+		const char* m_pFilter = nullptr;
+
+		/// <summary>
+		/// The JSON results are written here.
+		/// </summary>
+		const char* m_pOutputPath = "benchmark_results.json";
+
+		/// <summary>
+		/// Timed runs per benchmark. Every run uses the same iteration count.
+		/// </summary>
+		uint32_t m_sampleCount = 10;
+
+		/// <summary>
+		/// The iteration count is raised until one run takes at least this long.
+		/// </summary>
+		int64_t m_minSampleNanoseconds = 50'000'000;
+
+		/// <summary>
+		/// The global allocator every benchmark runs with.
+		/// </summary>
+		GlobalAllocatorType m_globalAllocatorType = GlobalAllocatorType::kSizeClass;
+
+		/// <summary>
+		/// A file recorded by TraceAllocator::StartRecording, replayed by AllocationTraceReplay.
+		/// </summary>
+		const char* m_pAllocationTracePath = nullptr;
+	};
+
+	/// <summary>
+	/// The timings of one benchmark. All times are nanoseconds per iteration.
+	/// </summary>
+	struct BenchmarkResult
+	{
+		const char* m_pName = nullptr;
+		uint64_t m_iterationCount = 0;
+		uint64_t m_itemsPerIteration = 1;
+
+		double m_median = 0.0;
+		double m_mean = 0.0;
+		double m_min = 0.0;
+		double m_max = 0.0;
+		double m_standardDeviation = 0.0;
+
+		/// <summary>
+		/// Items per second at the median time.
+		/// </summary>
+		double m_itemsPerSecond = 0.0;
+
+		bool m_hasFailed = false;
+
+		/// <summary>
+		/// Why the benchmark didn't run, or null if it did.
+		/// </summary>
+		const char* m_pSkipReason = nullptr;
+	};
+
+	/// <summary>
+	/// Runs every benchmark registered with EXE_BENCHMARK, in name order, and reports the results as JSON.
+	///
+	/// Each benchmark first has its iteration count calibrated, which also warms
+	/// caches and pools, then is run m_sampleCount times with that count. The
+	/// median is the figure to compare between runs, min and max show the noise.
+	/// </summary>
+	class BenchmarkRunner
+	{
+		BenchmarkSettings m_settings;
+		eastl::vector<BenchmarkResult> m_results;
+
+	public:
+		explicit BenchmarkRunner(const BenchmarkSettings& settings);
+
+		/// <summary>
+		/// Run the benchmarks matching the filter.
+		/// </summary>
+		/// <returns>False if any benchmark failed.</returns>
+		bool Run();
+
+		/// <summary>
+		/// Write the results of the last Run() to the output path.
+		/// </summary>
+		/// <returns>True if the file was written.</returns>
+		bool WriteJson() const;
+
+		/// <summary>
+		/// Log the name of every registered benchmark.
+		/// </summary>
+		static void LogBenchmarkNames();
+
+		const eastl::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+	private:
+		/// <summary>
+		/// Every registered benchmark, sorted by name so runs are in a stable order.
+		/// </summary>
+		static eastl::vector<const BenchmarkRegistration*> GetSortedRegistrations();
+
+		static const char* GetGlobalAllocatorName(GlobalAllocatorType globalAllocatorType);
+
+		BenchmarkResult RunBenchmark(const BenchmarkRegistration& registration) const;
+	};
+}
@@ -0,0 +1,167 @@
+#include "Benchmark.h"
+#include "BenchmarkRunner.h"
+
+#include <source/os/memory/TraceAllocator.h>
+#include <source/utility/io/File.h>
+
+#include <EASTL/hash_map.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// One step of a replayed trace. Allocations and their frees share a slot,
+	/// so replaying needs no lookups.
+	/// </summary>
+	struct ReplayOperation
+	{
+		uint64_t m_size;
+		uint32_t m_slot;
+		uint32_t m_alignment;
+		bool m_isFree;
+	};
+
+	/// <summary>
+	/// An allocation trace recorded by TraceAllocator::StartRecording, converted for replaying.
+	/// </summary>
+	struct AllocationReplay
+	{
+		eastl::vector<ReplayOperation> m_operations;
+		uint32_t m_slotCount = 0;
+	};
+
+	static bool LoadAllocationReplay(const char* pTracePath, AllocationReplay& replay)
+	{
+		File traceFile;
+		if (!traceFile.Open(pTracePath, File::AccessPermission::kReadOnly, File::CreationType::kOpenFile))
+		{
+			EXE_LOG_CATEGORY_ERROR("Benchmarks", "Failed to open allocation trace '{}'.", pTracePath);
+			return false;
+		}
+
+		eastl::vector<std::byte> traceData(traceFile.GetSize());
+		if (traceFile.Read(traceData) != traceData.size())
+		{
+			EXE_LOG_CATEGORY_ERROR("Benchmarks", "Failed to read allocation trace '{}'.", pTracePath);
+			return false;
+		}
+
+		const size_t recordCount = traceData.size() / sizeof(AllocationTraceRecord);
+		replay.m_operations.reserve(recordCount);
+
+		// Slots are reused once freed, so the replay only needs as many as were ever live at once.
+		eastl::hash_map<uint64_t, uint32_t> liveSlots;
+		eastl::vector<uint32_t> freeSlots;
+
+		for (size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex)
+		{
+			AllocationTraceRecord record;
+			::memcpy(&record, traceData.data() + recordIndex * sizeof(AllocationTraceRecord), sizeof(AllocationTraceRecord));
+
+			ReplayOperation operation;
+			operation.m_size = record.m_size;
+			operation.m_alignment = record.m_alignment;
+			operation.m_isFree = record.m_isFree;
+
+			if (record.m_isFree)
+			{
+				// Freeing memory allocated before recording started.
+				auto found = liveSlots.find(record.m_address);
+				if (found == liveSlots.end())
+					continue;
+
+				operation.m_slot = found->second;
+				freeSlots.push_back(found->second);
+				liveSlots.erase(found);
+			}
+			else
+			{
+				if (freeSlots.empty())
+				{
+					operation.m_slot = replay.m_slotCount++;
+				}
+				else
+				{
+					operation.m_slot = freeSlots.back();
+					freeSlots.pop_back();
+				}
+
+				liveSlots[record.m_address] = operation.m_slot;
+			}
+
+			replay.m_operations.push_back(operation);
+		}
+
+		EXE_LOG_CATEGORY_INFO("Benchmarks", "Loaded {} allocations and frees from '{}', at most {} live at once.", replay.m_operations.size(), pTracePath, replay.m_slotCount);
+		return !replay.m_operations.empty();
+	}
+
+	/// <summary>
+	/// The trace passed with --alloc-trace, loaded on first use and kept for every run.
+	/// </summary>
+	/// <returns>The replay, or nullptr if there is no trace or it failed to load.</returns>
+	static const AllocationReplay* GetAllocationReplay(const char* pTracePath)
+	{
+		static AllocationReplay s_replay;
+		static bool s_hasLoaded = false;
+		static bool s_isValid = false;
+
+		if (!pTracePath)
+			return nullptr;
+
+		if (!s_hasLoaded)
+		{
+			s_isValid = LoadAllocationReplay(pTracePath, s_replay);
+			s_hasLoaded = true;
+		}
+
+		return s_isValid ? &s_replay : nullptr;
+	}
+
+	EXE_BENCHMARK(AllocationTraceReplay)
+	{
+		// Replays a session of the engine's own allocations through the global allocator.
+		// Traces are replayed on one thread, in the order they were recorded.
+		const AllocationReplay* pReplay = GetAllocationReplay(state.GetSettings().m_pAllocationTracePath);
+		if (!pReplay)
+		{
+			state.Skip("No allocation trace, record one with Memory.AllocationTrace and pass it with --alloc-trace.");
+			return;
+		}
+
+		state.SetItemsPerIteration(pReplay->m_operations.size());
+
+		ExeliusAllocator* pAllocator = MemoryManager::GetInstance()->GetGlobalAllocator();
+		EXE_ASSERT(pAllocator);
+
+		eastl::vector<void*> slots(pReplay->m_slotCount, nullptr);
+
+		while (state.KeepRunning())
+		{
+			for (const ReplayOperation& operation : pReplay->m_operations)
+			{
+				if (operation.m_isFree)
+				{
+					pAllocator->Free(slots[operation.m_slot]);
+					slots[operation.m_slot] = nullptr;
+				}
+				else
+				{
+					slots[operation.m_slot] = pAllocator->Allocate(static_cast<size_t>(operation.m_size), operation.m_alignment, __FILE__, __LINE__);
+				}
+			}
+
+			// Release what the session never freed, so every iteration starts empty.
+			for (void*& pMemory : slots)
+			{
+				if (pMemory)
+				{
+					pAllocator->Free(pMemory);
+					pMemory = nullptr;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include <source/os/threads/JobSystem.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr uint64_t s_kJobBatchSize = 256;
+
+	EXE_BENCHMARK(JobSystemPushAndWait)
+	{
+		EXE_ASSERT(s_pGlobalJobSystem);
+
+		// A single job's round trip: push, wake a worker, run, signal the counter.
+		JobCounter counter;
+		while (state.KeepRunning())
+		{
+			s_pGlobalJobSystem->PushJob([]() { ClobberMemory(); }, &counter);
+			s_pGlobalJobSystem->WaitForCounter(counter);
+		}
+	}
+
+	EXE_BENCHMARK(JobSystemBatchThroughput)
+	{
+		EXE_ASSERT(s_pGlobalJobSystem);
+		state.SetItemsPerIteration(s_kJobBatchSize);
+
+		// Every job is pushed from the calling thread, so the workers have to steal all of them.
+		JobCounter counter;
+		while (state.KeepRunning())
+		{
+			{
+				ScopedJobBatch batch(*s_pGlobalJobSystem);
+				for (uint64_t jobIndex = 0; jobIndex < s_kJobBatchSize; ++jobIndex)
+					s_pGlobalJobSystem->PushJob([]() { ClobberMemory(); }, &counter);
+			}
+
+			s_pGlobalJobSystem->WaitForCounter(counter);
+		}
+	}
+
+	EXE_BENCHMARK(JobSystemNestedPushThroughput)
+	{
+		EXE_ASSERT(s_pGlobalJobSystem);
+		state.SetItemsPerIteration(s_kJobBatchSize);
+
+		// Jobs pushed from workers, which land in the workers' own queues.
+		static constexpr uint64_t s_kParentJobCount = 8;
+		static constexpr uint64_t s_kChildJobCount = s_kJobBatchSize / s_kParentJobCount - 1;
+
+		JobCounter counter;
+		while (state.KeepRunning())
+		{
+			for (uint64_t parentIndex = 0; parentIndex < s_kParentJobCount; ++parentIndex)
+			{
+				s_pGlobalJobSystem->PushJob([&counter]()
+					{
+						for (uint64_t childIndex = 0; childIndex < s_kChildJobCount; ++childIndex)
+							s_pGlobalJobSystem->PushJob([]() { ClobberMemory(); }, &counter);
+					}, &counter);
+			}
+
+			s_pGlobalJobSystem->WaitForCounter(counter);
+		}
+	}
+}
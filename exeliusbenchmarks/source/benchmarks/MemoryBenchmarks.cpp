@@ -0,0 +1,65 @@
+#include "Benchmark.h"
+
+#include <source/os/memory/PoolAllocator.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr size_t s_kBlockSize = 64;
+	static constexpr size_t s_kChunkSize = 64 * 1024;
+	static constexpr size_t s_kBatchSize = 512;
+
+	using BenchmarkPoolAllocator = PoolAllocator<s_kBlockSize, s_kChunkSize>;
+
+	EXE_BENCHMARK(PoolAllocatorAllocateFree)
+	{
+		BenchmarkPoolAllocator* pAllocator = EXELIUS_NEW(BenchmarkPoolAllocator());
+
+		while (state.KeepRunning())
+		{
+			void* pBlock = pAllocator->Allocate(s_kBlockSize, alignof(std::max_align_t), __FILE__, __LINE__);
+			DoNotOptimize(pBlock);
+			pAllocator->Free(pBlock, s_kBlockSize, false);
+		}
+
+		EXELIUS_DELETE(pAllocator);
+	}
+
+	EXE_BENCHMARK(PoolAllocatorAllocateFreeBatch)
+	{
+		state.SetItemsPerIteration(s_kBatchSize);
+
+		BenchmarkPoolAllocator* pAllocator = EXELIUS_NEW(BenchmarkPoolAllocator());
+		void* blocks[s_kBatchSize];
+
+		// A burst of short lived objects, all allocated before any are freed.
+		while (state.KeepRunning())
+		{
+			for (size_t blockIndex = 0; blockIndex < s_kBatchSize; ++blockIndex)
+				blocks[blockIndex] = pAllocator->Allocate(s_kBlockSize, alignof(std::max_align_t), __FILE__, __LINE__);
+
+			ClobberMemory();
+
+			for (size_t blockIndex = 0; blockIndex < s_kBatchSize; ++blockIndex)
+				pAllocator->Free(blocks[blockIndex], s_kBlockSize, false);
+		}
+
+		EXELIUS_DELETE(pAllocator);
+	}
+
+	EXE_BENCHMARK(GlobalAllocatorAllocateFree)
+	{
+		// The same pattern through the global allocator, for comparison with the pool.
+		ExeliusAllocator* pAllocator = MemoryManager::GetInstance()->GetGlobalAllocator();
+		EXE_ASSERT(pAllocator);
+
+		while (state.KeepRunning())
+		{
+			void* pBlock = pAllocator->Allocate(s_kBlockSize, alignof(std::max_align_t), __FILE__, __LINE__);
+			DoNotOptimize(pBlock);
+			pAllocator->Free(pBlock, s_kBlockSize, false);
+		}
+	}
+}
@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+
+#include <source/messages/Message.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// A message with a typical mix of fields.
+	/// </summary>
+	class BenchmarkMessage final
+		: public Message
+	{
+	public:
+		BenchmarkMessage()
+			: Message(DEFINE_MESSAGE(BenchmarkMessage))
+		{
+			//
+		}
+
+		void Serialize(int32_t entityID, uint64_t frame, float x, float y, const eastl::string& name)
+		{
+			ClearDataPacket();
+			*this << entityID << frame << x << y << name;
+		}
+
+		void Deserialize(int32_t& entityID, uint64_t& frame, float& x, float& y, eastl::string& name)
+		{
+			*this >> entityID >> frame >> x >> y >> name;
+		}
+	};
+
+	EXE_BENCHMARK(MessageSerialize)
+	{
+		BenchmarkMessage message;
+		const eastl::string name("PlayerCharacter");
+
+		int32_t entityID = 0;
+		while (state.KeepRunning())
+		{
+			message.Serialize(entityID++, 1234, 1.5f, -2.5f, name);
+			DoNotOptimize(message.GetDataPacketSize());
+		}
+	}
+
+	EXE_BENCHMARK(MessageSerializeRoundTrip)
+	{
+		BenchmarkMessage message;
+		const eastl::string name("PlayerCharacter");
+
+		int32_t entityID = 0;
+		uint64_t frame = 0;
+		float x = 0.0f;
+		float y = 0.0f;
+		eastl::string readName;
+		readName.reserve(name.size());
+
+		while (state.KeepRunning())
+		{
+			message.Serialize(entityID + 1, 1234, 1.5f, -2.5f, name);
+			message.Deserialize(entityID, frame, x, y, readName);
+			DoNotOptimize(readName);
+		}
+	}
+}
@@ -0,0 +1,68 @@
+#include "Benchmark.h"
+
+#include <source/utility/random/noise/PerlinNoise.h>
+#include <source/utility/random/noise/SquirrelNoise.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Noise is usually sampled a grid at a time, such as a tilemap chunk.
+	/// </summary>
+	static constexpr int s_kGridSize = 64;
+
+	/// <summary>
+	/// Fixed, so every run samples the same values.
+	/// </summary>
+	static constexpr unsigned int s_kNoiseSeed = 1337;
+
+	EXE_BENCHMARK(PerlinNoiseGrid)
+	{
+		state.SetItemsPerIteration(s_kGridSize * s_kGridSize);
+
+		const PerlinNoise noise(s_kNoiseSeed);
+		while (state.KeepRunning())
+		{
+			float total = 0.0f;
+			for (int y = 0; y < s_kGridSize; ++y)
+			{
+				for (int x = 0; x < s_kGridSize; ++x)
+					total += noise.GetNoise(static_cast<float>(x) * 0.1f, static_cast<float>(y) * 0.1f);
+			}
+			DoNotOptimize(total);
+		}
+	}
+
+	EXE_BENCHMARK(SquirrelNoise1D)
+	{
+		state.SetItemsPerIteration(s_kGridSize * s_kGridSize);
+
+		const SquirrelNoise noise(s_kNoiseSeed);
+		while (state.KeepRunning())
+		{
+			unsigned int total = 0;
+			for (int x = 0; x < s_kGridSize * s_kGridSize; ++x)
+				total += noise.Get1DNoise(x);
+			DoNotOptimize(total);
+		}
+	}
+
+	EXE_BENCHMARK(SquirrelNoise2DGrid)
+	{
+		state.SetItemsPerIteration(s_kGridSize * s_kGridSize);
+
+		const SquirrelNoise noise(s_kNoiseSeed);
+		while (state.KeepRunning())
+		{
+			float total = 0.0f;
+			for (int y = 0; y < s_kGridSize; ++y)
+			{
+				for (int x = 0; x < s_kGridSize; ++x)
+					total += noise.GetUniform2DNoise(x, y);
+			}
+			DoNotOptimize(total);
+		}
+	}
+}
@@ -0,0 +1,91 @@
+#include "Benchmark.h"
+
+#include <source/engine/renderer/QuadBatch.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstdio>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr uint32_t s_kQuadsPerFrame = 10000;
+	static constexpr uint32_t s_kBenchmarkTextureCount = 8;
+
+	/// <summary>
+	/// The transform Renderer2D::DrawQuad builds from a position and size.
+	/// </summary>
+	static glm::mat4 GetQuadTransform(uint32_t quadIndex)
+	{
+		const glm::vec3 position((float)(quadIndex % 100), (float)(quadIndex / 100), 0.0f);
+		const glm::vec2 size(1.0f, 1.0f);
+
+		return glm::translate(glm::mat4(1.0f), position)
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
+	}
+
+	EXE_BENCHMARK(QuadBatchColoredQuads)
+	{
+		// The CPU side of Renderer2D::DrawQuad and Flush, without uploading or drawing the batch.
+		state.SetItemsPerIteration(s_kQuadsPerFrame);
+
+		QuadBatch batch;
+		const Color color(255, 128, 64);
+
+		while (state.KeepRunning())
+		{
+			batch.Reset();
+			for (uint32_t quadIndex = 0; quadIndex < s_kQuadsPerFrame; ++quadIndex)
+			{
+				const glm::mat4 transform = GetQuadTransform(quadIndex);
+				if (!batch.AddQuad(transform, color, -1))
+				{
+					batch.Reset();
+					batch.AddQuad(transform, color, -1);
+				}
+			}
+
+			DoNotOptimize(batch.GetVertices());
+			DoNotOptimize(batch.GetVertexDataSize());
+		}
+	}
+
+	EXE_BENCHMARK(QuadBatchTexturedQuads)
+	{
+		// Cycling through a handful of textures, so every quad searches the texture slots.
+		state.SetItemsPerIteration(s_kQuadsPerFrame);
+
+		QuadBatch batch;
+		batch.SetWhiteTexture(ResourceID("WhiteTexture"));
+
+		ResourceID textures[s_kBenchmarkTextureCount];
+		for (uint32_t textureIndex = 0; textureIndex < s_kBenchmarkTextureCount; ++textureIndex)
+		{
+			char textureName[32];
+			snprintf(textureName, sizeof(textureName), "BenchmarkTexture%u", textureIndex);
+			textures[textureIndex] = ResourceID(textureName);
+		}
+
+		const Color tintColor(255, 255, 255);
+
+		while (state.KeepRunning())
+		{
+			batch.Reset();
+			for (uint32_t quadIndex = 0; quadIndex < s_kQuadsPerFrame; ++quadIndex)
+			{
+				const glm::mat4 transform = GetQuadTransform(quadIndex);
+				const ResourceID& texture = textures[quadIndex % s_kBenchmarkTextureCount];
+				if (!batch.AddQuad(transform, texture, 1.0f, tintColor, -1))
+				{
+					batch.Reset();
+					batch.AddQuad(transform, texture, 1.0f, tintColor, -1);
+				}
+			}
+
+			DoNotOptimize(batch.GetVertices());
+			DoNotOptimize(batch.GetVertexDataSize());
+		}
+	}
+}
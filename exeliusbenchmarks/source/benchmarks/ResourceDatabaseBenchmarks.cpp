@@ -0,0 +1,67 @@
+#include "Benchmark.h"
+
+#include <source/resource/ResourceDatabase.h>
+
+#include <cstdio>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr size_t s_kEntryCount = 1024;
+
+	/// <summary>
+	/// A database with s_kEntryCount entries, none of them loaded.
+	/// </summary>
+	static eastl::vector<ResourceID> CreateEntries(ResourceDatabase& database)
+	{
+		eastl::vector<ResourceID> resourceIDs;
+		resourceIDs.reserve(s_kEntryCount);
+
+		char name[64];
+		for (size_t entryIndex = 0; entryIndex < s_kEntryCount; ++entryIndex)
+		{
+			snprintf(name, sizeof(name), "assets/benchmark/resource_%zu.png", entryIndex);
+			const ResourceID& resourceID = resourceIDs.emplace_back(name);
+			database.CreateEntry(resourceID);
+		}
+
+		return resourceIDs;
+	}
+
+	EXE_BENCHMARK(ResourceDatabaseRefCount)
+	{
+		ResourceDatabase* pDatabase = EXELIUS_NEW(ResourceDatabase());
+		const eastl::vector<ResourceID> resourceIDs = CreateEntries(*pDatabase);
+
+		// What every ResourceHandle copy and destruction costs.
+		size_t entryIndex = 0;
+		while (state.KeepRunning())
+		{
+			const ResourceID& resourceID = resourceIDs[entryIndex];
+			pDatabase->IncrementEntryRefCount(resourceID);
+			pDatabase->IncrementEntryRefCount(resourceID);
+			DoNotOptimize(pDatabase->DecrementEntryRefCount(resourceID));
+			DoNotOptimize(pDatabase->DecrementEntryRefCount(resourceID));
+			entryIndex = (entryIndex + 1) % s_kEntryCount;
+		}
+
+		EXELIUS_DELETE(pDatabase);
+	}
+
+	EXE_BENCHMARK(ResourceDatabaseGetLoadStatus)
+	{
+		ResourceDatabase* pDatabase = EXELIUS_NEW(ResourceDatabase());
+		const eastl::vector<ResourceID> resourceIDs = CreateEntries(*pDatabase);
+
+		size_t entryIndex = 0;
+		while (state.KeepRunning())
+		{
+			DoNotOptimize(pDatabase->GetEntryLoadStatus(resourceIDs[entryIndex]));
+			entryIndex = (entryIndex + 1) % s_kEntryCount;
+		}
+
+		EXELIUS_DELETE(pDatabase);
+	}
+}
@@ -0,0 +1,109 @@
+#include "Benchmark.h"
+
+#include <source/utility/containers/RingBuffer.h>
+
+#include <thread>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr size_t s_kRingBufferCapacity = 1024;
+
+	using BenchmarkSPSCRingBuffer = SPSCRingBuffer<uint64_t, s_kRingBufferCapacity>;
+	using BenchmarkMPMCRingBuffer = MPMCRingBuffer<uint64_t, s_kRingBufferCapacity>;
+
+	EXE_BENCHMARK(SPSCRingBufferPushPop)
+	{
+		// Heap allocated, the storage is too big for the stack in some configurations.
+		BenchmarkSPSCRingBuffer* pRingBuffer = EXELIUS_NEW(BenchmarkSPSCRingBuffer());
+
+		uint64_t value = 0;
+		while (state.KeepRunning())
+		{
+			pRingBuffer->PushBack(value);
+			pRingBuffer->PopFront(value);
+			DoNotOptimize(value);
+		}
+
+		EXELIUS_DELETE(pRingBuffer);
+	}
+
+	EXE_BENCHMARK(SPSCRingBufferThroughput)
+	{
+		BenchmarkSPSCRingBuffer* pRingBuffer = EXELIUS_NEW(BenchmarkSPSCRingBuffer());
+		const uint64_t iterationCount = state.GetIterationCount();
+
+		// The producer pushes one value per iteration, the calling thread consumes them.
+		std::thread producer([pRingBuffer, iterationCount]()
+			{
+				for (uint64_t value = 0; value < iterationCount; ++value)
+				{
+					while (!pRingBuffer->PushBack(value))
+						std::this_thread::yield();
+				}
+			});
+
+		uint64_t value = 0;
+		while (state.KeepRunning())
+		{
+			while (!pRingBuffer->PopFront(value))
+				std::this_thread::yield();
+			DoNotOptimize(value);
+		}
+
+		producer.join();
+		EXELIUS_DELETE(pRingBuffer);
+	}
+
+	EXE_BENCHMARK(MPMCRingBufferPushPop)
+	{
+		BenchmarkMPMCRingBuffer* pRingBuffer = EXELIUS_NEW(BenchmarkMPMCRingBuffer());
+
+		uint64_t value = 0;
+		while (state.KeepRunning())
+		{
+			pRingBuffer->PushBack(value);
+			pRingBuffer->PopFront(value);
+			DoNotOptimize(value);
+		}
+
+		EXELIUS_DELETE(pRingBuffer);
+	}
+
+	EXE_BENCHMARK(MPMCRingBufferContendedThroughput)
+	{
+		static constexpr uint64_t s_kProducerCount = 3;
+
+		BenchmarkMPMCRingBuffer* pRingBuffer = EXELIUS_NEW(BenchmarkMPMCRingBuffer());
+		const uint64_t iterationCount = state.GetIterationCount();
+
+		// Producers share the iterations, the calling thread consumes them all.
+		eastl::vector<std::thread> producers;
+		for (uint64_t producerIndex = 0; producerIndex < s_kProducerCount; ++producerIndex)
+		{
+			const uint64_t pushCount = iterationCount / s_kProducerCount + ((producerIndex < iterationCount % s_kProducerCount) ? 1 : 0);
+			producers.emplace_back([pRingBuffer, pushCount]()
+				{
+					for (uint64_t value = 0; value < pushCount; ++value)
+					{
+						while (!pRingBuffer->PushBack(value))
+							std::this_thread::yield();
+					}
+				});
+		}
+
+		uint64_t value = 0;
+		while (state.KeepRunning())
+		{
+			while (!pRingBuffer->PopFront(value))
+				std::this_thread::yield();
+			DoNotOptimize(value);
+		}
+
+		for (std::thread& producer : producers)
+			producer.join();
+		EXELIUS_DELETE(pRingBuffer);
+	}
+}
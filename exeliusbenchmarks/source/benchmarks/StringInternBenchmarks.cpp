@@ -0,0 +1,93 @@
+#include "Benchmark.h"
+
+#include <source/utility/string/StringIntern.h>
+#include <source/utility/string/StringID.h>
+
+#include <cstdio>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr size_t s_kInternedStringCount = 1024;
+
+	/// <summary>
+	/// Interned strings are never freed, so inserting is measured over a fixed number of new strings.
+	/// </summary>
+	static constexpr uint64_t s_kInsertIterationCount = 50'000;
+
+	/// <summary>
+	/// Names shaped like the resource paths most strings interned by the engine are.
+	/// </summary>
+	static eastl::vector<eastl::string> MakeStringNames(const char* pPrefix, size_t count)
+	{
+		eastl::vector<eastl::string> names;
+		names.reserve(count);
+
+		char name[128];
+		for (size_t nameIndex = 0; nameIndex < count; ++nameIndex)
+		{
+			snprintf(name, sizeof(name), "assets/%s/resource_%zu.png", pPrefix, nameIndex);
+			names.emplace_back(name);
+		}
+
+		return names;
+	}
+
+	EXE_BENCHMARK(StringInternLookup)
+	{
+		const eastl::vector<eastl::string> names = MakeStringNames("lookup", s_kInternedStringCount);
+		for (const eastl::string& name : names)
+			DoNotOptimize(StringIntern(name));
+
+		size_t nameIndex = 0;
+		while (state.KeepRunning())
+		{
+			StringIntern interned(names[nameIndex]);
+			DoNotOptimize(interned);
+			nameIndex = (nameIndex + 1) % s_kInternedStringCount;
+		}
+	}
+
+	EXE_BENCHMARK(StringInternLookupFromStringID)
+	{
+		// The hash is computed at compile time, lookup only has to find the entry.
+		static constexpr StringID s_kStringID = StringID("assets/lookup/resource_id.png");
+		DoNotOptimize(StringIntern(s_kStringID));
+
+		while (state.KeepRunning())
+		{
+			StringIntern interned(s_kStringID);
+			DoNotOptimize(interned);
+		}
+	}
+
+	EXE_BENCHMARK_ITERATIONS(StringInternInsert, s_kInsertIterationCount)
+	{
+		// Each run needs strings no previous run has interned.
+		static uint32_t s_runIndex = 0;
+		char prefix[32];
+		snprintf(prefix, sizeof(prefix), "insert%u", s_runIndex++);
+
+		const eastl::vector<eastl::string> names = MakeStringNames(prefix, static_cast<size_t>(state.GetIterationCount()));
+
+		size_t nameIndex = 0;
+		while (state.KeepRunning())
+		{
+			StringIntern interned(names[nameIndex++]);
+			DoNotOptimize(interned);
+		}
+	}
+
+	EXE_BENCHMARK(StringInternCopy)
+	{
+		const StringIntern source("assets/copy/resource.png");
+
+		while (state.KeepRunning())
+		{
+			StringIntern copy(source);
+			DoNotOptimize(copy);
+		}
+	}
+}
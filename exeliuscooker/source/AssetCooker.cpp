@@ -0,0 +1,413 @@
+#include "AssetCooker.h"
+
+#include <source/engine/resources/resourcetypes/tilemap/tilemapinternals/TileLayer.h>
+#include <source/os/threads/ParallelFor.h>
+#include <source/render/Texture.h>
+#include <source/utility/io/CookedAssetStructs.h>
+#include <source/utility/io/CookedJson.h>
+#include <source/utility/io/File.h>
+
+#include <pugixml.hpp>
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+#include <sol/sol.hpp>
+
+#include <cctype>
+#include <filesystem>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Appends everything pugixml writes to a buffer.
+	/// </summary>
+	class XmlBufferWriter
+		: public pugi::xml_writer
+	{
+		eastl::vector<std::byte>& m_buffer;
+
+	public:
+		explicit XmlBufferWriter(eastl::vector<std::byte>& buffer)
+			: m_buffer(buffer)
+		{
+			//
+		}
+
+		virtual void write(const void* pData, size_t size) final override
+		{
+			const size_t offset = m_buffer.size();
+			m_buffer.resize(offset + size);
+			::memcpy(m_buffer.data() + offset, pData, size);
+		}
+	};
+
+	static int WriteLuaChunk(lua_State*, const void* pData, size_t size, void* pUserData)
+	{
+		eastl::vector<std::byte>& cookedData = *static_cast<eastl::vector<std::byte>*>(pUserData);
+
+		const size_t offset = cookedData.size();
+		cookedData.resize(offset + size);
+		::memcpy(cookedData.data() + offset, pData, size);
+		return 0;
+	}
+
+	/// <summary>
+	/// Move the tile data of every tile layer under a node into flat arrays,
+	/// leaving each data node pointing at its array.
+	/// </summary>
+	static void MoveTileData(pugi::xml_node node, eastl::vector<eastl::vector<uint32_t>>& tileArrays)
+	{
+		auto AddTileArray = [&tileArrays](const eastl::vector<TileLayer::Tile>& tiles)
+			{
+				eastl::vector<uint32_t>& IDs = tileArrays.emplace_back();
+				IDs.reserve(tiles.size());
+				for (const TileLayer::Tile& tile : tiles)
+					IDs.push_back(tile.ID | (static_cast<uint32_t>(tile.flipFlags) << 28));
+
+				return static_cast<unsigned int>(tileArrays.size() - 1);
+			};
+
+		for (pugi::xml_node child : node.children())
+		{
+			const eastl::string childName = child.name();
+			if (childName == "group")
+			{
+				MoveTileData(child, tileArrays);
+				continue;
+			}
+
+			pugi::xml_node dataNode = child.child("data");
+			if (childName != "layer" || !dataNode)
+				continue;
+
+			// Decode the layer the same way the engine would, whatever its encoding and compression.
+			TileLayer layer(static_cast<size_t>(child.attribute("width").as_uint()) * child.attribute("height").as_uint());
+			layer.Parse(child, nullptr);
+
+			while (dataNode.first_child())
+				dataNode.remove_child(dataNode.first_child());
+			while (dataNode.first_attribute())
+				dataNode.remove_attribute(dataNode.first_attribute());
+
+			dataNode.append_attribute("encoding") = "exelius";
+
+			if (!layer.GetTiles().empty())
+				dataNode.append_attribute("index") = AddTileArray(layer.GetTiles());
+
+			for (const TileLayer::Chunk& chunk : layer.GetChunks())
+			{
+				pugi::xml_node chunkNode = dataNode.append_child("chunk");
+				chunkNode.append_attribute("x") = chunk.position.x;
+				chunkNode.append_attribute("y") = chunk.position.y;
+				chunkNode.append_attribute("width") = chunk.size.x;
+				chunkNode.append_attribute("height") = chunk.size.y;
+				chunkNode.append_attribute("index") = AddTileArray(chunk.tiles);
+			}
+		}
+	}
+
+	AssetCooker::AssetCooker(const CookerSettings& settings)
+		: m_settings(settings)
+	{
+		EXE_ASSERT(m_settings.m_pInputDirectory);
+		EXE_ASSERT(m_settings.m_pOutputDirectory);
+	}
+
+	bool AssetCooker::Cook()
+	{
+		if (!GatherEntries())
+			return false;
+
+		JobCounter counter;
+		ParallelFor(counter, 0, m_entries.size(), [this](size_t entryIndex)
+			{
+				CookAsset(m_entries[entryIndex]);
+			}, 1);
+		s_pGlobalJobSystem->WaitForCounter(counter);
+
+		uint32_t resultCounts[static_cast<size_t>(CookResult::kMax)] = {};
+		for (const CookEntry& entry : m_entries)
+			++resultCounts[static_cast<size_t>(entry.m_result)];
+
+		EXE_LOG_CATEGORY_INFO("Cooker", "{} cooked, {} copied, {} up to date, {} failed.",
+			resultCounts[static_cast<size_t>(CookResult::kCooked)],
+			resultCounts[static_cast<size_t>(CookResult::kCopied)],
+			resultCounts[static_cast<size_t>(CookResult::kUpToDate)],
+			resultCounts[static_cast<size_t>(CookResult::kFailed)]);
+
+		return resultCounts[static_cast<size_t>(CookResult::kFailed)] == 0;
+	}
+
+	bool AssetCooker::GatherEntries()
+	{
+		const std::filesystem::path inputDirectory(m_settings.m_pInputDirectory);
+		const std::filesystem::path outputDirectory(m_settings.m_pOutputDirectory);
+
+		std::error_code error;
+		if (!std::filesystem::is_directory(inputDirectory, error))
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "'{}' is not a directory.", m_settings.m_pInputDirectory);
+			return false;
+		}
+
+		for (const std::filesystem::directory_entry& directoryEntry : std::filesystem::recursive_directory_iterator(inputDirectory, error))
+		{
+			if (!directoryEntry.is_regular_file())
+				continue;
+
+			const std::filesystem::path relativePath = directoryEntry.path().lexically_relative(inputDirectory);
+			const std::filesystem::path outputPath = outputDirectory / relativePath;
+
+			CookEntry& entry = m_entries.emplace_back();
+			entry.m_name = relativePath.generic_string().c_str();
+			entry.m_inputPath = directoryEntry.path().generic_string().c_str();
+			entry.m_outputPath = outputPath.generic_string().c_str();
+			entry.m_result = CookResult::kFailed;
+
+			// Only cook assets that changed since they were last cooked.
+			std::error_code timeError;
+			if (!m_settings.m_shouldCookAll && std::filesystem::exists(outputPath, timeError)
+				&& std::filesystem::last_write_time(outputPath, timeError) >= directoryEntry.last_write_time(timeError) && !timeError)
+			{
+				entry.m_result = CookResult::kUpToDate;
+				continue;
+			}
+
+			// Directories are created here, as workers creating the same one at once can fail.
+			std::filesystem::create_directories(outputPath.parent_path(), error);
+			if (error)
+			{
+				EXE_LOG_CATEGORY_ERROR("Cooker", "Failed to create '{}'.", outputPath.parent_path().generic_string());
+				return false;
+			}
+		}
+
+		if (error)
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "Failed to read '{}'.", m_settings.m_pInputDirectory);
+			return false;
+		}
+
+		return true;
+	}
+
+	void AssetCooker::CookAsset(CookEntry& entry) const
+	{
+		if (entry.m_result == CookResult::kUpToDate)
+			return;
+
+		File sourceFile;
+		if (!sourceFile.Open(entry.m_inputPath.c_str(), File::AccessPermission::kReadOnly, File::CreationType::kOpenFile))
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "Failed to open '{}'.", entry.m_inputPath.c_str());
+			return;
+		}
+
+		eastl::vector<std::byte> sourceData(sourceFile.GetSize());
+		if (!sourceData.empty() && sourceFile.Read(sourceData) != sourceData.size())
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "Failed to read '{}'.", entry.m_inputPath.c_str());
+			return;
+		}
+		sourceFile.Close();
+
+		eastl::string extension = File::GetFileExtension(entry.m_name);
+		for (char& character : extension)
+			character = static_cast<char>(::tolower(static_cast<unsigned char>(character)));
+
+		eastl::vector<std::byte> cookedData;
+		bool hasCooked = true;
+		bool hasSucceeded = true;
+
+		if (extension == "png" || extension == "jpg" || extension == "bmp")
+			hasSucceeded = CookTexture(sourceData, cookedData);
+		else if (extension == "json" || extension == "excene" || extension == "exobj")
+			hasSucceeded = CookJson(sourceData, cookedData);
+		else if (extension == "lua")
+			hasSucceeded = CookLua(entry.m_name, sourceData, cookedData);
+		else if (extension == "tmx")
+			hasSucceeded = CookTilemap(sourceData, cookedData);
+		else
+			hasCooked = false;
+
+		if (!hasSucceeded)
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "Failed to cook '{}'.", entry.m_inputPath.c_str());
+			return;
+		}
+
+		File cookedFile;
+		const eastl::vector<std::byte>& outputData = hasCooked ? cookedData : sourceData;
+		if (!cookedFile.Open(entry.m_outputPath.c_str(), File::AccessPermission::kWriteOnly, File::CreationType::kOverwriteFile)
+			|| (!outputData.empty() && cookedFile.Write(outputData) != outputData.size()))
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "Failed to write '{}'.", entry.m_outputPath.c_str());
+			return;
+		}
+
+		entry.m_result = hasCooked ? CookResult::kCooked : CookResult::kCopied;
+	}
+
+	bool AssetCooker::CookTexture(const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const
+	{
+		// Decoded exactly as the engine would, so the pixels come out flipped the same way.
+		TextureImage image;
+		if (!Texture::DecodeImage(sourceData, image))
+			return false;
+
+		if (image.m_channels == 3)
+		{
+			const size_t pixelCount = static_cast<size_t>(image.m_width) * image.m_height;
+			eastl::vector<std::byte> rgbaPixels(pixelCount * 4);
+			for (size_t pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex)
+			{
+				::memcpy(&rgbaPixels[pixelIndex * 4], &image.m_pixels[pixelIndex * 3], 3);
+				rgbaPixels[pixelIndex * 4 + 3] = std::byte(0xFF);
+			}
+
+			image.m_pixels.swap(rgbaPixels);
+			image.m_channels = 4;
+		}
+
+		if (m_settings.m_shouldGenerateMips)
+			GenerateMips(image);
+
+		CookedTextureHeader header = {};
+		header.m_signature = CookedTextureHeader::kSignature;
+		header.m_version = CookedTextureHeader::kVersion;
+		header.m_headerSize = sizeof(CookedTextureHeader);
+		header.m_width = image.m_width;
+		header.m_height = image.m_height;
+		header.m_channels = image.m_channels;
+		header.m_mipCount = image.m_mipCount;
+		header.m_pixelsSize = image.m_pixels.size();
+
+		cookedData.resize(sizeof(CookedTextureHeader) + image.m_pixels.size());
+		::memcpy(cookedData.data(), &header, sizeof(CookedTextureHeader));
+		::memcpy(cookedData.data() + sizeof(CookedTextureHeader), image.m_pixels.data(), image.m_pixels.size());
+		return true;
+	}
+
+	bool AssetCooker::CookJson(const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const
+	{
+		rapidjson::Document document;
+		if (document.Parse(reinterpret_cast<const char*>(sourceData.data()), sourceData.size()).HasParseError())
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "JSON error at {}: {}", document.GetErrorOffset(), rapidjson::GetParseError_En(document.GetParseError()));
+			return false;
+		}
+
+		CookedJson::Write(document, cookedData);
+		return true;
+	}
+
+	bool AssetCooker::CookLua(const eastl::string& name, const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const
+	{
+		sol::state luaState;
+		lua_State* pLuaState = luaState.lua_state();
+
+		// Named like a file, so errors read "Path/Script.lua:12:".
+		const eastl::string chunkName = "@" + name;
+		if (luaL_loadbufferx(pLuaState, reinterpret_cast<const char*>(sourceData.data()), sourceData.size(), chunkName.c_str(), "t") != LUA_OK)
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "{}", lua_tostring(pLuaState, -1));
+			return false;
+		}
+
+		return lua_dump(pLuaState, &WriteLuaChunk, &cookedData, m_settings.m_shouldStripLua ? 1 : 0) == 0 && !cookedData.empty();
+	}
+
+	bool AssetCooker::CookTilemap(const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const
+	{
+		pugi::xml_document doc;
+		const pugi::xml_parse_result result = doc.load_buffer(sourceData.data(), sourceData.size());
+		if (!result)
+		{
+			EXE_LOG_CATEGORY_ERROR("Cooker", "XML error at {}: {}", result.offset, result.description());
+			return false;
+		}
+
+		pugi::xml_node mapNode = doc.child("map");
+		if (!mapNode)
+			return false;
+
+		eastl::vector<eastl::vector<uint32_t>> tileArrays;
+		MoveTileData(mapNode, tileArrays);
+
+		cookedData.resize(sizeof(CookedTilemapHeader));
+		XmlBufferWriter writer(cookedData);
+		doc.save(writer, "", pugi::format_raw | pugi::format_no_declaration);
+
+		CookedTilemapHeader header = {};
+		header.m_signature = CookedTilemapHeader::kSignature;
+		header.m_version = CookedTilemapHeader::kVersion;
+		header.m_headerSize = sizeof(CookedTilemapHeader);
+		header.m_tileArrayCount = static_cast<uint32_t>(tileArrays.size());
+		header.m_xmlSize = cookedData.size() - sizeof(CookedTilemapHeader);
+		::memcpy(cookedData.data(), &header, sizeof(CookedTilemapHeader));
+
+		for (const eastl::vector<uint32_t>& IDs : tileArrays)
+		{
+			const uint32_t tileCount = static_cast<uint32_t>(IDs.size());
+			const size_t offset = cookedData.size();
+			cookedData.resize(offset + sizeof(tileCount) + IDs.size() * sizeof(uint32_t));
+			::memcpy(cookedData.data() + offset, &tileCount, sizeof(tileCount));
+			::memcpy(cookedData.data() + offset + sizeof(tileCount), IDs.data(), IDs.size() * sizeof(uint32_t));
+		}
+
+		return true;
+	}
+
+	void AssetCooker::GenerateMips(TextureImage& image)
+	{
+		EXE_ASSERT(image.m_channels == 4 && image.m_mipCount == 1);
+
+		size_t levelOffset = 0;
+		uint32_t levelWidth = image.m_width;
+		uint32_t levelHeight = image.m_height;
+
+		while (levelWidth > 1 || levelHeight > 1)
+		{
+			const uint32_t mipWidth = eastl::max(levelWidth / 2, 1u);
+			const uint32_t mipHeight = eastl::max(levelHeight / 2, 1u);
+
+			const size_t mipOffset = image.m_pixels.size();
+			image.m_pixels.resize(mipOffset + static_cast<size_t>(mipWidth) * mipHeight * 4);
+
+			const std::byte* pLevel = image.m_pixels.data() + levelOffset;
+			std::byte* pMip = image.m_pixels.data() + mipOffset;
+
+			// Average each 2x2 block. An odd last row or column is dropped, as is usual for box filtered mips.
+			for (uint32_t y = 0; y < mipHeight; ++y)
+			{
+				const uint32_t y0 = eastl::min(y * 2, levelHeight - 1);
+				const uint32_t y1 = eastl::min(y * 2 + 1, levelHeight - 1);
+
+				for (uint32_t x = 0; x < mipWidth; ++x)
+				{
+					const uint32_t x0 = eastl::min(x * 2, levelWidth - 1);
+					const uint32_t x1 = eastl::min(x * 2 + 1, levelWidth - 1);
+
+					for (uint32_t channel = 0; channel < 4; ++channel)
+					{
+						const uint32_t sum = static_cast<uint32_t>(pLevel[(static_cast<size_t>(y0) * levelWidth + x0) * 4 + channel])
+							+ static_cast<uint32_t>(pLevel[(static_cast<size_t>(y0) * levelWidth + x1) * 4 + channel])
+							+ static_cast<uint32_t>(pLevel[(static_cast<size_t>(y1) * levelWidth + x0) * 4 + channel])
+							+ static_cast<uint32_t>(pLevel[(static_cast<size_t>(y1) * levelWidth + x1) * 4 + channel]);
+
+						pMip[(static_cast<size_t>(y) * mipWidth + x) * 4 + channel] = static_cast<std::byte>((sum + 2) / 4);
+					}
+				}
+			}
+
+			levelOffset = mipOffset;
+			levelWidth = mipWidth;
+			levelHeight = mipHeight;
+			++image.m_mipCount;
+		}
+
+		EXE_ASSERT(image.m_pixels.size() == image.GetPixelsSize());
+	}
+}
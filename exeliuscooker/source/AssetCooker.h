@@ -0,0 +1,109 @@
+#pragma once
+#include <source/precompilation/EXEPCH.h>
+
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	struct TextureImage;
+
+	/// <summary>
+	/// How assets are cooked.
+	/// </summary>
+	struct CookerSettings
+	{
+		/// <summary>
+		/// Every asset under this directory is cooked, keeping its path relative to it.
+		/// </summary>
+		const char* m_pInputDirectory = nullptr;
+		const char* m_pOutputDirectory = nullptr;
+
+		bool m_shouldGenerateMips = true;
+
+		/// <summary>
+		/// Strip debug information from Lua bytecode. Smaller, but errors lose their line numbers.
+		/// </summary>
+		bool m_shouldStripLua = false;
+
+		/// <summary>
+		/// Cook every asset, rather than only those changed since they were last cooked.
+		/// </summary>
+		bool m_shouldCookAll = false;
+	};
+
+	/// <summary>
+	/// Converts source assets into the forms the engine loads fastest, so a
+	/// shipped build doesn't decode, parse or compile them on every launch.
+	/// @see CookedAssetStructs.h
+	///
+	///		Images (png, jpg, bmp)			- RGBA8 pixels, flipped for the renderer, with mips.
+	///		JSON (json, excene, exobj)		- A binary encoding of the document.
+	///		Lua scripts (lua)				- Lua bytecode.
+	///		Tilemaps (tmx)					- Flat arrays of tiles, with the rest of the map as XML.
+	///
+	/// Cooked assets keep the name of their source, so ResourceIDs don't change,
+	/// and anything else is copied as is. Assets are cooked on the job system's workers.
+	/// </summary>
+	class AssetCooker
+	{
+		enum class CookResult
+		{
+			kCooked,
+			kCopied,
+			kUpToDate,
+			kFailed,
+			kMax
+		};
+
+		/// <summary>
+		/// An asset to be cooked.
+		/// </summary>
+		struct CookEntry
+		{
+			eastl::string m_name;
+			eastl::string m_inputPath;
+			eastl::string m_outputPath;
+			CookResult m_result;
+		};
+
+		CookerSettings m_settings;
+		eastl::vector<CookEntry> m_entries;
+
+	public:
+		explicit AssetCooker(const CookerSettings& settings);
+
+		/// <summary>
+		/// Cook every asset in the input directory into the output directory.
+		/// </summary>
+		/// <returns>True if every asset was cooked or copied.</returns>
+		bool Cook();
+
+	private:
+		/// <summary>
+		/// Find the assets to cook, and create the directories they will be written to.
+		/// </summary>
+		bool GatherEntries();
+
+		/// <summary>
+		/// Read, cook and write a single asset. Runs on the workers.
+		/// </summary>
+		void CookAsset(CookEntry& entry) const;
+
+		bool CookTexture(const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const;
+		bool CookJson(const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const;
+		bool CookLua(const eastl::string& name, const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const;
+		bool CookTilemap(const eastl::vector<std::byte>& sourceData, eastl::vector<std::byte>& cookedData) const;
+
+		/// <summary>
+		/// Append a box filtered mip chain, down to 1x1, to an RGBA8 image.
+		/// </summary>
+		static void GenerateMips(TextureImage& image);
+	};
+}
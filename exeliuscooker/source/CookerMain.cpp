@@ -0,0 +1,75 @@
+#include "AssetCooker.h"
+
+#include <source/debug/LogManager.h>
+#include <source/os/threads/JobSystem.h>
+#include <source/utility/string/StringIntern.h>
+
+#include <cstring>
+
+/// <summary>
+/// Cooks a directory of source assets into the forms the engine loads fastest.
+/// The output directory can then be packed with exeliuspacker.
+///
+/// Usage: exeliuscooker <input directory> <output directory> [--no-mips] [--strip-lua] [--all]
+/// </summary>
+int main(int argc, char* argv[])
+{
+	using namespace Exelius;
+
+	if (argc < 3)
+	{
+		printf("Usage: exeliuscooker <input directory> <output directory> [--no-mips] [--strip-lua] [--all]\n");
+		return 1;
+	}
+
+	CookerSettings settings;
+	settings.m_pInputDirectory = argv[1];
+	settings.m_pOutputDirectory = argv[2];
+
+	for (int argIndex = 3; argIndex < argc; ++argIndex)
+	{
+		const char* pArg = argv[argIndex];
+		if (::strcmp(pArg, "--no-mips") == 0)
+		{
+			settings.m_shouldGenerateMips = false;
+		}
+		else if (::strcmp(pArg, "--strip-lua") == 0)
+		{
+			settings.m_shouldStripLua = true;
+		}
+		else if (::strcmp(pArg, "--all") == 0)
+		{
+			settings.m_shouldCookAll = true;
+		}
+		else
+		{
+			printf("Unknown argument '%s'.\n", pArg);
+			return 1;
+		}
+	}
+
+	MemoryManager::SetSingleton(new MemoryManager());
+	EXE_ASSERT(MemoryManager::GetInstance());
+	MemoryManager::GetInstance()->Initialize(GlobalAllocatorType::kSizeClass);
+
+	LogManager::SetSingleton(EXELIUS_NEW(LogManager()));
+	EXE_ASSERT(LogManager::GetInstance());
+	if (!LogManager::GetInstance()->PreInitialize())
+		return 1;
+
+	s_pGlobalJobSystem = EXELIUS_NEW(JobSystem());
+	s_pGlobalJobSystem->Initialize();
+
+	bool hasSucceeded = false;
+	{
+		AssetCooker cooker(settings);
+		hasSucceeded = cooker.Cook();
+	}
+
+	EXELIUS_DELETE(s_pGlobalJobSystem);
+	LogManager::DestroySingleton();
+	StringIntern::_ClearStringInternSet();
+	MemoryManager::DestroySingleton();
+
+	return hasSucceeded ? 0 : 1;
+}
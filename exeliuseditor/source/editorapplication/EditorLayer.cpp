@@ -5,6 +5,7 @@
 #include "panels/DebugPanel.h"
 #include "panels/GameViewPanel.h"
 #include "panels/InspectorPanel.h"
+#include "panels/ProfilerPanel.h"
 #include "panels/SceneHierarchyPanel.h"
 #include "panels/SceneViewPanel.h"
 
@@ -36,6 +37,7 @@ namespace Exelius
 		m_editorPanels.emplace_back(EXELIUS_NEW(DebugPanel(this, m_pActiveScene)));
 		m_editorPanels.emplace_back(EXELIUS_NEW(GameViewPanel(this, m_pActiveScene)));
 		m_editorPanels.emplace_back(EXELIUS_NEW(InspectorPanel(this, m_pActiveScene)));
+		m_editorPanels.emplace_back(EXELIUS_NEW(ProfilerPanel(this, m_pActiveScene)));
 		m_editorPanels.emplace_back(EXELIUS_NEW(SceneHierarchyPanel(this, m_pActiveScene)));
 		m_editorPanels.emplace_back(EXELIUS_NEW(SceneViewPanel(this, m_pActiveScene)));
 
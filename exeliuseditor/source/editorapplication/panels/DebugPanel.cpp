@@ -40,6 +40,37 @@ namespace Exelius
 		ImGui::Text("Unscaled DeltaTime: %.3f", udt);
 		ImGui::Text("Unscaled FPS: %.1f", 1.0f / Time.DeltaTimeUnscaled);
 
+		ImGui::Separator();
+		FrameTimeRecorder& frameTimeRecorder = Application::GetInstance()->GetFrameTimeRecorder();
+		const FrameTimeStats frameStats = frameTimeRecorder.GetFrameStats();
+		ImGui::Text("Frame Time (last %zu frames):", frameStats.m_frameCount);
+		ImGui::Text("\tp50: %.3f  p95: %.3f  p99: %.3f  max: %.3f ms", frameStats.m_p50 * 0.001f, frameStats.m_p95 * 0.001f, frameStats.m_p99 * 0.001f, frameStats.m_max * 0.001f);
+
+		const ImVec4 hitchColor = (frameStats.m_hitchCount > 0) ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+		ImGui::TextColored(hitchColor, "\tHitches: %zu (%llu total)", frameStats.m_hitchCount, static_cast<unsigned long long>(frameTimeRecorder.GetTotalHitchCount()));
+
+		float frameBudget = frameTimeRecorder.GetFrameBudget() * 0.001f;
+		if (ImGui::DragFloat("Frame Budget (ms)", &frameBudget, 0.1f, 1.0f, 1000.0f, "%.2f"))
+			frameTimeRecorder.SetFrameBudget(static_cast<int64_t>(frameBudget * 1000.0f));
+
+		// Plotted oldest to newest, scaled so the budget sits half way up.
+		ImGui::PlotLines("##FrameTimes", [](void* pData, int index)
+			{
+				const FrameTimeRecorder* pRecorder = static_cast<const FrameTimeRecorder*>(pData);
+				return pRecorder->GetFrameDuration(static_cast<size_t>(index)) * 0.001f;
+			}, &frameTimeRecorder, static_cast<int>(frameTimeRecorder.GetFrameCount()), 0, nullptr, 0.0f, frameBudget * 2.0f, ImVec2(0.0f, 60.0f));
+
+		if (ImGui::TreeNode("Frame Stages"))
+		{
+			for (size_t stageIndex = 0; stageIndex < frameTimeRecorder.GetStageCount(); ++stageIndex)
+			{
+				const FrameTimeStats stageStats = frameTimeRecorder.GetStageStats(stageIndex);
+				ImGui::Text("%s:", frameTimeRecorder.GetStageName(stageIndex));
+				ImGui::Text("\tp50: %.3f  p95: %.3f  p99: %.3f  max: %.3f ms", stageStats.m_p50 * 0.001f, stageStats.m_p95 * 0.001f, stageStats.m_p99 * 0.001f, stageStats.m_max * 0.001f);
+			}
+			ImGui::TreePop();
+		}
+
 		ImGui::Separator();
 		float et = Time.ElapsedTime;
 		ImGui::Text("Elapsed Game Time: %.3f", et);
@@ -52,6 +83,35 @@ namespace Exelius
 		ImGui::Text("\tIndex Count: %d", stats.GetTotalIndexCount());
 		ImGui::Text("\tVertex Count: %d", stats.GetTotalVertexCount());
 
+		ImGui::Separator();
+		MemoryStats* pMemoryStats = MemoryManager::GetInstance()->GetMemoryStats();
+		ImGui::Text("Memory Statistics:");
+		if (!pMemoryStats->IsTracking())
+		{
+			ImGui::Text("\tOnly tracked with the Trace global allocator.");
+		}
+		else
+		{
+			for (uint8_t tagIndex = 0; tagIndex < static_cast<uint8_t>(MemoryTag::kCount); ++tagIndex)
+			{
+				const MemoryTag tag = static_cast<MemoryTag>(tagIndex);
+				const MemoryTagStats tagStats = pMemoryStats->GetTagStats(tag);
+				if (tagStats.m_peakBytes == 0)
+					continue;
+
+				ImGui::Text("\t%s:", GetMemoryTagName(tag));
+				ImGui::Text("\t\tLive: %.1f KB (%zu allocations)", tagStats.m_liveBytes / 1024.0f, tagStats.m_liveAllocations);
+				ImGui::Text("\t\tPeak: %.1f KB", tagStats.m_peakBytes / 1024.0f);
+				ImGui::Text("\t\tAllocations/s: %.0f", tagStats.m_allocationsPerSecond);
+
+				if (tagStats.m_budgetBytes > 0)
+				{
+					const ImVec4 budgetColor = (tagStats.m_liveBytes > tagStats.m_budgetBytes) ? ImVec4(1.0f, 0.3f, 0.3f, 1.0f) : ImVec4(1.0f, 1.0f, 1.0f, 1.0f);
+					ImGui::TextColored(budgetColor, "\t\tBudget: %.1f KB", tagStats.m_budgetBytes / 1024.0f);
+				}
+			}
+		}
+
 		ImGui::End();
 	}
 }
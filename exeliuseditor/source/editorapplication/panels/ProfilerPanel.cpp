@@ -0,0 +1,157 @@
+#include "ProfilerPanel.h"
+#include "editorapplication/EditorLayer.h"
+
+#include <imgui.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	static constexpr const char* s_kTraceFilePath = "profile_trace.json";
+	static constexpr float s_kEventHeight = 18.0f;
+	static constexpr float s_kThreadLabelHeight = 18.0f;
+
+	ProfilerPanel::ProfilerPanel(EditorLayer* pEditorLayer, const SharedPtr<Scene>& pActiveScene)
+		: EditorPanel(pEditorLayer, pActiveScene, "Profiler", false)
+		, m_frameStartNanoseconds(0)
+		, m_frameEndNanoseconds(0)
+		, m_isPaused(false)
+	{
+		//
+	}
+
+	void ProfilerPanel::OnImGuiRender()
+	{
+		ImGui::Begin("Profiler");
+
+		m_isPanelSelected = ImGui::IsWindowFocused();
+		m_isPanelHovered = ImGui::IsWindowHovered();
+
+		Profiler* pProfiler = Profiler::GetInstance();
+		EXE_ASSERT(pProfiler);
+
+		bool isRecording = Profiler::IsRecording();
+		if (ImGui::Checkbox("Record", &isRecording))
+			pProfiler->SetRecording(isRecording);
+
+		ImGui::SameLine();
+		ImGui::Checkbox("Pause", &m_isPaused);
+
+		ImGui::SameLine();
+		if (!pProfiler->IsCapturing())
+		{
+			if (ImGui::Button("Start Capture"))
+				pProfiler->StartCapture();
+		}
+		else if (ImGui::Button("Stop Capture"))
+		{
+			pProfiler->StopCapture();
+		}
+
+		ImGui::SameLine();
+		if (ImGui::Button("Export Chrome Trace"))
+			pProfiler->ExportChromeTrace(s_kTraceFilePath);
+
+		ImGui::Text("Captured Events: %zu", pProfiler->GetCapturedEventCount());
+		ImGui::SameLine();
+		ImGui::Text("Dropped Events: %llu", static_cast<unsigned long long>(pProfiler->GetDroppedEventCount()));
+
+		if (!m_isPaused)
+		{
+			m_frameEvents = pProfiler->GetFrameEvents();
+			m_frameThreads = pProfiler->GetThreads();
+			m_frameStartNanoseconds = pProfiler->GetFrameStartNanoseconds();
+			m_frameEndNanoseconds = pProfiler->GetFrameEndNanoseconds();
+		}
+
+		ImGui::Separator();
+		ImGui::Text("Frame: %.3f ms", static_cast<double>(m_frameEndNanoseconds - m_frameStartNanoseconds) / 1000000.0);
+
+		DrawFlameView();
+
+		ImGui::End();
+	}
+
+	void ProfilerPanel::DrawFlameView()
+	{
+		if (m_frameEvents.empty() || m_frameEndNanoseconds <= m_frameStartNanoseconds)
+		{
+			ImGui::Text("No events recorded last frame.");
+			return;
+		}
+
+		ImGui::BeginChild("FlameView", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+		ImDrawList* pDrawList = ImGui::GetWindowDrawList();
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		const float width = ImGui::GetContentRegionAvail().x;
+		const double frameNanoseconds = static_cast<double>(m_frameEndNanoseconds - m_frameStartNanoseconds);
+
+		const ImU32 textColor = ImGui::GetColorU32(ImGuiCol_Text);
+		const ImU32 borderColor = ImGui::GetColorU32(ImGuiCol_Border);
+
+		auto getX = [this, origin, width, frameNanoseconds](uint64_t nanoseconds)
+		{
+			// Events that began in the previous frame, like jobs still running, are clamped to the frame.
+			const uint64_t clamped = eastl::clamp(nanoseconds, m_frameStartNanoseconds, m_frameEndNanoseconds);
+			return origin.x + static_cast<float>(static_cast<double>(clamped - m_frameStartNanoseconds) / frameNanoseconds) * width;
+		};
+
+		// Events are grouped by thread, each thread gets a band as deep as its deepest event.
+		float bandTop = origin.y;
+		size_t eventIndex = 0;
+		while (eventIndex < m_frameEvents.size())
+		{
+			const uint16_t threadIndex = m_frameEvents[eventIndex].m_threadIndex;
+
+			size_t threadEnd = eventIndex;
+			uint16_t maxDepth = 0;
+			while (threadEnd < m_frameEvents.size() && m_frameEvents[threadEnd].m_threadIndex == threadIndex)
+			{
+				maxDepth = eastl::max(maxDepth, m_frameEvents[threadEnd].m_depth);
+				++threadEnd;
+			}
+
+			const char* pThreadName = (threadIndex < m_frameThreads.size()) ? m_frameThreads[threadIndex].m_name : "Unknown";
+			pDrawList->AddText(ImVec2(origin.x, bandTop), textColor, pThreadName);
+			const float eventsTop = bandTop + s_kThreadLabelHeight;
+
+			for (; eventIndex < threadEnd; ++eventIndex)
+			{
+				const ProfileEvent& event = m_frameEvents[eventIndex];
+
+				const ImVec2 min(getX(event.m_startNanoseconds), eventsTop + event.m_depth * s_kEventHeight);
+				const ImVec2 max(eastl::max(getX(event.m_endNanoseconds), min.x + 1.0f), min.y + s_kEventHeight - 1.0f);
+
+				// Color by name, so the same scope is the same color every frame.
+				const size_t nameHash = eastl::hash<const char*>()(event.m_pName);
+				const ImU32 eventColor = IM_COL32(80 + (nameHash & 0x7F), 80 + ((nameHash >> 8) & 0x7F), 80 + ((nameHash >> 16) & 0x7F), 255);
+
+				pDrawList->AddRectFilled(min, max, eventColor);
+				pDrawList->AddRect(min, max, borderColor);
+
+				// Only label events wide enough to read.
+				const ImVec2 textSize = ImGui::CalcTextSize(event.m_pName);
+				if (max.x - min.x > textSize.x + 4.0f)
+					pDrawList->AddText(ImVec2(min.x + 2.0f, min.y + 1.0f), textColor, event.m_pName);
+
+				if (ImGui::IsMouseHoveringRect(min, max))
+				{
+					ImGui::BeginTooltip();
+					ImGui::Text("%s", event.m_pName);
+					ImGui::Text("%.3f ms", static_cast<double>(event.m_endNanoseconds - event.m_startNanoseconds) / 1000000.0);
+					ImGui::Text("Thread: %s", pThreadName);
+					ImGui::EndTooltip();
+				}
+			}
+
+			bandTop = eventsTop + (maxDepth + 1) * s_kEventHeight + 4.0f;
+		}
+
+		// Reserve the space drawn into, so the child window scrolls.
+		ImGui::Dummy(ImVec2(width, bandTop - origin.y));
+
+		ImGui::EndChild();
+	}
+}
\ No newline at end of file
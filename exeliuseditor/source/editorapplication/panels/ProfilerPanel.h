@@ -0,0 +1,36 @@
+#pragma once
+#include "EditorPanel.h"
+
+#include <include/Exelius.h>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Flame view of the last frame's profile events, one band per thread,
+	/// and controls for capturing and exporting Chrome traces.
+	/// </summary>
+	class ProfilerPanel
+		: public EditorPanel
+	{
+		/// <summary>
+		/// The frame being shown. Kept while paused, so it can be inspected.
+		/// </summary>
+		eastl::vector<ProfileEvent> m_frameEvents;
+		eastl::vector<ProfileThread> m_frameThreads;
+		uint64_t m_frameStartNanoseconds;
+		uint64_t m_frameEndNanoseconds;
+
+		bool m_isPaused;
+
+	public:
+		ProfilerPanel(EditorLayer* pEditorLayer, const SharedPtr<Scene>& pActiveScene);
+
+		virtual void OnImGuiRender() final override;
+
+	private:
+		void DrawFlameView();
+	};
+}
\ No newline at end of file
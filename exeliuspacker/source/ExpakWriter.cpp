@@ -0,0 +1,388 @@
+#include "ExpakWriter.h"
+
+#include <source/os/threads/ParallelFor.h>
+#include <source/utility/io/File.h>
+#include <source/utility/string/StringHash.h>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+
+#include <filesystem>
+#include <fstream>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// Files are read and compressed this many at a time, so only a batch is held in memory.
+	/// </summary>
+	static constexpr size_t s_kBatchSize = 64;
+
+	/// <summary>
+	/// Packs are built offline and decompression speed barely depends on the level, so favor size.
+	/// </summary>
+	static constexpr int s_kDefaultZstdLevel = 19;
+
+	/// <summary>
+	/// Compressed data is only kept if it saves at least this fraction of the file.
+	/// </summary>
+	static constexpr size_t s_kMinSavingsDivisor = 16;
+
+	/// <summary>
+	/// In auto mode, zstd is only picked over LZ4 if it is at most this fraction of the LZ4 size.
+	/// LZ4 decompresses several times faster, so it wins unless zstd is much smaller.
+	/// </summary>
+	static constexpr double s_kZstdPreferenceRatio = 0.8;
+
+	static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	static void WriteZeros(std::ofstream& stream, uint64_t count)
+	{
+		static constexpr char s_kZeros[4096] = {};
+		for (; count > 0; count -= eastl::min<uint64_t>(count, sizeof(s_kZeros)))
+			stream.write(s_kZeros, static_cast<std::streamsize>(eastl::min<uint64_t>(count, sizeof(s_kZeros))));
+	}
+
+	ExpakWriter::ExpakWriter(const ExpakSettings& settings)
+		: m_settings(settings)
+	{
+		EXE_ASSERT(m_settings.m_pBaseDirectory);
+		EXE_ASSERT(m_settings.m_alignment > 0 && (m_settings.m_alignment & (m_settings.m_alignment - 1)) == 0);
+	}
+
+	bool ExpakWriter::Add(const char* pPath)
+	{
+		EXE_ASSERT(pPath);
+
+		std::error_code error;
+		if (std::filesystem::is_regular_file(pPath, error))
+			return AddFile(pPath);
+
+		if (!std::filesystem::is_directory(pPath, error))
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "'{}' is not a file or directory.", pPath);
+			return false;
+		}
+
+		bool hasSucceeded = true;
+		for (const std::filesystem::directory_entry& directoryEntry : std::filesystem::recursive_directory_iterator(pPath, error))
+		{
+			if (directoryEntry.is_regular_file())
+				hasSucceeded = AddFile(directoryEntry.path().generic_string().c_str()) && hasSucceeded;
+		}
+
+		return hasSucceeded;
+	}
+
+	bool ExpakWriter::Write(const char* pOutputPath)
+	{
+		EXE_ASSERT(pOutputPath);
+
+		if (m_entries.empty())
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "Nothing to pack.");
+			return false;
+		}
+
+		// Data is written in name order, so files in the same folder are close together.
+		eastl::sort(m_entries.begin(), m_entries.end(), [](const PendingEntry& left, const PendingEntry& right)
+			{
+				return left.m_name < right.m_name;
+			});
+
+		auto duplicate = eastl::unique(m_entries.begin(), m_entries.end(), [](const PendingEntry& left, const PendingEntry& right)
+			{
+				return left.m_name == right.m_name;
+			});
+		m_entries.erase(duplicate, m_entries.end());
+
+		eastl::string names;
+		for (PendingEntry& pendingEntry : m_entries)
+		{
+			pendingEntry.m_entry = {};
+			pendingEntry.m_entry.m_nameHash = StringHash::HashString64(pendingEntry.m_name.c_str(), pendingEntry.m_name.size());
+			pendingEntry.m_entry.m_nameOffset = static_cast<uint32_t>(names.size());
+			pendingEntry.m_entry.m_nameLength = static_cast<uint16_t>(pendingEntry.m_name.size());
+			names += pendingEntry.m_name;
+		}
+
+		ExpakHeader header = {};
+		header.m_signature = ExpakHeader::kSignature;
+		header.m_version = ExpakHeader::kVersion;
+		header.m_headerSize = sizeof(ExpakHeader);
+		header.m_entryCount = static_cast<uint32_t>(m_entries.size());
+		header.m_alignment = m_settings.m_alignment;
+		header.m_tocOffset = sizeof(ExpakHeader);
+		header.m_namesOffset = header.m_tocOffset + static_cast<uint64_t>(m_entries.size()) * sizeof(ExpakEntry);
+		header.m_namesSize = names.size();
+
+		std::ofstream pack(pOutputPath, std::ios::binary | std::ios::trunc);
+		if (!pack)
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "Failed to open '{}' to write the pack.", pOutputPath);
+			return false;
+		}
+
+		// The header and table of contents are written last, once every offset is known.
+		uint64_t packSize = AlignUp(header.m_namesOffset + header.m_namesSize, m_settings.m_alignment);
+		WriteZeros(pack, packSize);
+
+		uint64_t totalSize = 0;
+		uint32_t compressionCounts[static_cast<size_t>(ExpakCompression::kMax)] = {};
+		bool hasSucceeded = true;
+
+		for (size_t batchBegin = 0; batchBegin < m_entries.size() && hasSucceeded; batchBegin += s_kBatchSize)
+		{
+			const size_t batchEnd = eastl::min(batchBegin + s_kBatchSize, m_entries.size());
+
+			JobCounter counter;
+			ParallelFor(counter, batchBegin, batchEnd, [this](size_t entryIndex)
+				{
+					PackEntry(m_entries[entryIndex]);
+				}, 1);
+			s_pGlobalJobSystem->WaitForCounter(counter);
+
+			for (size_t entryIndex = batchBegin; entryIndex < batchEnd; ++entryIndex)
+			{
+				PendingEntry& pendingEntry = m_entries[entryIndex];
+				if (pendingEntry.m_hasFailed)
+				{
+					hasSucceeded = false;
+					break;
+				}
+
+				const uint64_t alignedOffset = AlignUp(packSize, m_settings.m_alignment);
+				WriteZeros(pack, alignedOffset - packSize);
+
+				pendingEntry.m_entry.m_offset = alignedOffset;
+				pack.write(reinterpret_cast<const char*>(pendingEntry.m_storedData.data()), static_cast<std::streamsize>(pendingEntry.m_storedData.size()));
+				packSize = alignedOffset + pendingEntry.m_entry.m_storedSize;
+
+				totalSize += pendingEntry.m_entry.m_size;
+				++compressionCounts[static_cast<size_t>(pendingEntry.m_entry.m_compression)];
+
+				// Free each file's data once it's written.
+				eastl::vector<std::byte>().swap(pendingEntry.m_storedData);
+			}
+		}
+
+		if (hasSucceeded)
+		{
+			// Lookups binary search the hashes, and compare names when hashes match.
+			eastl::vector<const PendingEntry*> tableOfContents;
+			tableOfContents.reserve(m_entries.size());
+			for (const PendingEntry& pendingEntry : m_entries)
+				tableOfContents.emplace_back(&pendingEntry);
+
+			eastl::sort(tableOfContents.begin(), tableOfContents.end(), [](const PendingEntry* pLeft, const PendingEntry* pRight)
+				{
+					if (pLeft->m_entry.m_nameHash != pRight->m_entry.m_nameHash)
+						return pLeft->m_entry.m_nameHash < pRight->m_entry.m_nameHash;
+					return pLeft->m_name < pRight->m_name;
+				});
+
+			pack.seekp(0);
+			pack.write(reinterpret_cast<const char*>(&header), sizeof(ExpakHeader));
+			for (const PendingEntry* pPendingEntry : tableOfContents)
+				pack.write(reinterpret_cast<const char*>(&pPendingEntry->m_entry), sizeof(ExpakEntry));
+			pack.write(names.data(), static_cast<std::streamsize>(names.size()));
+
+			pack.flush();
+			hasSucceeded = pack.good();
+		}
+
+		pack.close();
+
+		if (!hasSucceeded)
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "Failed to write '{}'.", pOutputPath);
+			std::error_code error;
+			std::filesystem::remove(pOutputPath, error);
+			return false;
+		}
+
+		EXE_LOG_CATEGORY_INFO("Packer", "Packed {} files, {} bytes into '{}', {} bytes. {} stored, {} LZ4, {} zstd.",
+			m_entries.size(), totalSize, pOutputPath, packSize,
+			compressionCounts[static_cast<size_t>(ExpakCompression::kNone)],
+			compressionCounts[static_cast<size_t>(ExpakCompression::kLZ4)],
+			compressionCounts[static_cast<size_t>(ExpakCompression::kZstd)]);
+
+		return true;
+	}
+
+	bool ExpakWriter::AddFile(const eastl::string& filePath)
+	{
+		std::error_code error;
+		const std::filesystem::path relativePath = std::filesystem::relative(filePath.c_str(), m_settings.m_pBaseDirectory, error);
+		const std::string name = relativePath.generic_string();
+
+		if (error || name.empty() || name.starts_with(".."))
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "'{}' is not inside the base directory '{}'.", filePath.c_str(), m_settings.m_pBaseDirectory);
+			return false;
+		}
+
+		if (name.size() > UINT16_MAX)
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "'{}' has too long a name to pack.", filePath.c_str());
+			return false;
+		}
+
+		PendingEntry& pendingEntry = m_entries.emplace_back();
+		pendingEntry.m_filePath = filePath;
+		pendingEntry.m_name = name.c_str();
+		pendingEntry.m_entry = {};
+		pendingEntry.m_hasFailed = false;
+		return true;
+	}
+
+	void ExpakWriter::PackEntry(PendingEntry& pendingEntry) const
+	{
+		File file;
+		if (!file.Open(pendingEntry.m_filePath.c_str(), File::AccessPermission::kReadOnly, File::CreationType::kOpenFile))
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "Failed to open '{}'.", pendingEntry.m_filePath.c_str());
+			pendingEntry.m_hasFailed = true;
+			return;
+		}
+
+		eastl::vector<std::byte> data(file.GetSize());
+		if (!data.empty() && file.Read(data) != data.size())
+		{
+			EXE_LOG_CATEGORY_ERROR("Packer", "Failed to read '{}'.", pendingEntry.m_filePath.c_str());
+			pendingEntry.m_hasFailed = true;
+			return;
+		}
+
+		pendingEntry.m_entry.m_size = data.size();
+
+		eastl::vector<std::byte> compressedData;
+		ExpakCompression compression = ExpakCompression::kNone;
+
+		switch (m_settings.m_compressionMode)
+		{
+			case ExpakCompressionMode::kLZ4:
+			{
+				compression = ExpakCompression::kLZ4;
+				compressedData = Compress(data, compression);
+				break;
+			}
+
+			case ExpakCompressionMode::kZstd:
+			{
+				compression = ExpakCompression::kZstd;
+				compressedData = Compress(data, compression);
+				break;
+			}
+
+			case ExpakCompressionMode::kAuto:
+			{
+				if (IsAlreadyCompressed(data))
+					break;
+
+				compression = ExpakCompression::kLZ4;
+				compressedData = Compress(data, ExpakCompression::kLZ4);
+
+				eastl::vector<std::byte> zstdData = Compress(data, ExpakCompression::kZstd);
+				if (!zstdData.empty() && (compressedData.empty() || static_cast<double>(zstdData.size()) <= static_cast<double>(compressedData.size()) * s_kZstdPreferenceRatio))
+				{
+					compression = ExpakCompression::kZstd;
+					compressedData.swap(zstdData);
+				}
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		// Not worth decompressing unless it saves a meaningful amount.
+		if (compressedData.empty() || compressedData.size() > data.size() - data.size() / s_kMinSavingsDivisor)
+		{
+			pendingEntry.m_entry.m_compression = ExpakCompression::kNone;
+			pendingEntry.m_entry.m_storedSize = data.size();
+			pendingEntry.m_storedData.swap(data);
+			return;
+		}
+
+		pendingEntry.m_entry.m_compression = compression;
+		pendingEntry.m_entry.m_storedSize = compressedData.size();
+		pendingEntry.m_storedData.swap(compressedData);
+	}
+
+	eastl::vector<std::byte> ExpakWriter::Compress(const eastl::vector<std::byte>& data, ExpakCompression compression) const
+	{
+		eastl::vector<std::byte> compressedData;
+		if (data.empty())
+			return compressedData;
+
+		switch (compression)
+		{
+			case ExpakCompression::kLZ4:
+			{
+				// LZ4 blocks are limited to 2GB, the bound is 0 for anything larger.
+				const int bound = data.size() <= INT32_MAX ? LZ4_compressBound(static_cast<int>(data.size())) : 0;
+				if (bound <= 0)
+					break;
+
+				const int level = m_settings.m_compressionLevel > 0 ? eastl::min(m_settings.m_compressionLevel, LZ4HC_CLEVEL_MAX) : LZ4HC_CLEVEL_DEFAULT;
+
+				compressedData.resize(static_cast<size_t>(bound));
+				const int compressedSize = LZ4_compress_HC(reinterpret_cast<const char*>(data.data()), reinterpret_cast<char*>(compressedData.data()),
+					static_cast<int>(data.size()), bound, level);
+
+				compressedData.resize(compressedSize > 0 ? static_cast<size_t>(compressedSize) : 0);
+				break;
+			}
+
+			case ExpakCompression::kZstd:
+			{
+				const int level = m_settings.m_compressionLevel > 0 ? eastl::min(m_settings.m_compressionLevel, ZSTD_maxCLevel()) : s_kDefaultZstdLevel;
+
+				compressedData.resize(ZSTD_compressBound(data.size()));
+				const size_t compressedSize = ZSTD_compress(compressedData.data(), compressedData.size(), data.data(), data.size(), level);
+
+				compressedData.resize(ZSTD_isError(compressedSize) ? 0 : compressedSize);
+				break;
+			}
+
+			default:
+				break;
+		}
+
+		return compressedData;
+	}
+
+	bool ExpakWriter::IsAlreadyCompressed(const eastl::vector<std::byte>& data)
+	{
+		// Checked by content rather than extension, as cooked images keep their names but not their format.
+		static constexpr eastl::string_view s_kCompressedSignatures[] =
+		{
+			eastl::string_view("\x89PNG", 4),
+			eastl::string_view("\xFF\xD8\xFF", 3),	// JPEG
+			eastl::string_view("OggS", 4),
+			eastl::string_view("fLaC", 4),
+			eastl::string_view("ID3", 3),			// MP3
+			eastl::string_view("PK\x03\x04", 4),	// Zip
+			eastl::string_view("EXPK", 4)
+		};
+
+		const eastl::string_view start(reinterpret_cast<const char*>(data.data()), data.size());
+		for (const eastl::string_view& signature : s_kCompressedSignatures)
+		{
+			if (start.starts_with(signature))
+				return true;
+		}
+
+		return false;
+	}
+}
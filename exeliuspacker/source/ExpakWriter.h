@@ -0,0 +1,117 @@
+#pragma once
+#include <source/precompilation/EXEPCH.h>
+#include <source/utility/io/ExpakStructs.h>
+
+#include <EASTL/string.h>
+#include <EASTL/string_view.h>
+#include <EASTL/vector.h>
+
+#include <cstddef>
+#include <cstdint>
+
+/// <summary>
+/// Engine namespace. Everything owned by the engine will be inside this namespace.
+/// </summary>
+namespace Exelius
+{
+	/// <summary>
+	/// How the packer chooses each entry's compression.
+	/// </summary>
+	enum class ExpakCompressionMode
+	{
+		kAuto,		/// Skip formats that are already compressed, and pick LZ4 or zstd per entry, favoring LZ4's faster decompression.
+		kNone,		/// Store every entry as is.
+		kLZ4,		/// LZ4 every entry that gets smaller.
+		kZstd,		/// zstd every entry that gets smaller.
+		kMax		/// Used for bounds checking. Not a valid mode.
+	};
+
+	/// <summary>
+	/// How a pack is built.
+	/// </summary>
+	struct ExpakSettings
+	{
+		ExpakCompressionMode m_compressionMode = ExpakCompressionMode::kAuto;
+
+		/// <summary>
+		/// Entry names are paths relative to this directory, so they match the ResourceIDs
+		/// the engine loads them by when run from it.
+		/// </summary>
+		const char* m_pBaseDirectory = ".";
+
+		/// <summary>
+		/// Every entry's data starts on a multiple of this, so each can be mapped and paged in on its own.
+		/// </summary>
+		uint32_t m_alignment = 4096;
+
+		/// <summary>
+		/// 0 uses each compressor's default.
+		/// </summary>
+		int m_compressionLevel = 0;
+	};
+
+	/// <summary>
+	/// Builds an Exelius asset pack (.expak) from files on disk.
+	/// @see ExpakStructs.h
+	///
+	/// Files are read and compressed on the job system's workers, a batch at a
+	/// time, and written in name order so files in the same folder stay together.
+	/// </summary>
+	class ExpakWriter
+	{
+		/// <summary>
+		/// A file to be packed.
+		/// </summary>
+		struct PendingEntry
+		{
+			eastl::string m_filePath;
+			eastl::string m_name;
+			ExpakEntry m_entry;
+
+			/// <summary>
+			/// The data to write. Only held while the entry's batch is being written.
+			/// </summary>
+			eastl::vector<std::byte> m_storedData;
+			bool m_hasFailed;
+		};
+
+		ExpakSettings m_settings;
+		eastl::vector<PendingEntry> m_entries;
+
+	public:
+		explicit ExpakWriter(const ExpakSettings& settings);
+
+		/// <summary>
+		/// Add every file under a directory, or a single file.
+		/// </summary>
+		/// <param name="pPath">- The directory or file to add.</param>
+		/// <returns>False if the path doesn't exist, or a name can't be stored.</returns>
+		bool Add(const char* pPath);
+
+		/// <summary>
+		/// Read, compress and write every added file.
+		/// </summary>
+		/// <param name="pOutputPath">- The pack to write. Overwritten if it exists.</param>
+		/// <returns>True if every file was packed.</returns>
+		bool Write(const char* pOutputPath);
+
+	private:
+		bool AddFile(const eastl::string& filePath);
+
+		/// <summary>
+		/// Read an entry's file and compress it. Runs on the workers.
+		/// </summary>
+		void PackEntry(PendingEntry& pendingEntry) const;
+
+		/// <summary>
+		/// Compress data with the given compression.
+		/// </summary>
+		/// <returns>The compressed data. Empty on failure.</returns>
+		eastl::vector<std::byte> Compress(const eastl::vector<std::byte>& data, ExpakCompression compression) const;
+
+		/// <summary>
+		/// Whether the file is in a format that is already compressed, such as PNG or Ogg.
+		/// </summary>
+		static bool IsAlreadyCompressed(const eastl::vector<std::byte>& data);
+	};
+}
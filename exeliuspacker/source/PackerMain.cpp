@@ -0,0 +1,121 @@
+#include "ExpakWriter.h"
+
+#include <source/debug/LogManager.h>
+#include <source/os/threads/JobSystem.h>
+#include <source/utility/string/StringIntern.h>
+
+#include <cstdlib>
+#include <cstring>
+
+/// <summary>
+/// Packs files and directories into an Exelius asset pack (.expak).
+///
+/// Usage: exeliuspacker <output.expak> <paths...> [--compression auto|none|lz4|zstd] [--level <level>] [--base <directory>] [--alignment <bytes>]
+/// </summary>
+int main(int argc, char* argv[])
+{
+	using namespace Exelius;
+
+	if (argc < 3)
+	{
+		printf("Usage: exeliuspacker <output.expak> <paths...> [--compression auto|none|lz4|zstd] [--level <level>] [--base <directory>] [--alignment <bytes>]\n");
+		return 1;
+	}
+
+	const char* pOutputPath = argv[1];
+	eastl::vector<const char*> inputPaths;
+	ExpakSettings settings;
+
+	for (int argIndex = 2; argIndex < argc; ++argIndex)
+	{
+		const char* pArg = argv[argIndex];
+		if (::strncmp(pArg, "--", 2) != 0)
+		{
+			inputPaths.emplace_back(pArg);
+			continue;
+		}
+
+		const char* pValue = (argIndex + 1 < argc) ? argv[argIndex + 1] : nullptr;
+		if (!pValue)
+		{
+			printf("Missing value for '%s'.\n", pArg);
+			return 1;
+		}
+
+		if (::strcmp(pArg, "--compression") == 0)
+		{
+			if (::strcmp(pValue, "auto") == 0)
+				settings.m_compressionMode = ExpakCompressionMode::kAuto;
+			else if (::strcmp(pValue, "none") == 0)
+				settings.m_compressionMode = ExpakCompressionMode::kNone;
+			else if (::strcmp(pValue, "lz4") == 0)
+				settings.m_compressionMode = ExpakCompressionMode::kLZ4;
+			else if (::strcmp(pValue, "zstd") == 0)
+				settings.m_compressionMode = ExpakCompressionMode::kZstd;
+			else
+			{
+				printf("Unknown compression '%s'.\n", pValue);
+				return 1;
+			}
+		}
+		else if (::strcmp(pArg, "--level") == 0)
+		{
+			settings.m_compressionLevel = eastl::max(::atoi(pValue), 0);
+		}
+		else if (::strcmp(pArg, "--base") == 0)
+		{
+			settings.m_pBaseDirectory = pValue;
+		}
+		else if (::strcmp(pArg, "--alignment") == 0)
+		{
+			const long alignment = ::atol(pValue);
+			if (alignment <= 0 || alignment > UINT32_MAX || (alignment & (alignment - 1)) != 0)
+			{
+				printf("Alignment must be a power of two.\n");
+				return 1;
+			}
+			settings.m_alignment = static_cast<uint32_t>(alignment);
+		}
+		else
+		{
+			printf("Unknown argument '%s'.\n", pArg);
+			return 1;
+		}
+
+		++argIndex;
+	}
+
+	if (inputPaths.empty())
+	{
+		printf("Nothing to pack.\n");
+		return 1;
+	}
+
+	MemoryManager::SetSingleton(new MemoryManager());
+	EXE_ASSERT(MemoryManager::GetInstance());
+	MemoryManager::GetInstance()->Initialize(GlobalAllocatorType::kSizeClass);
+
+	LogManager::SetSingleton(EXELIUS_NEW(LogManager()));
+	EXE_ASSERT(LogManager::GetInstance());
+	if (!LogManager::GetInstance()->PreInitialize())
+		return 1;
+
+	s_pGlobalJobSystem = EXELIUS_NEW(JobSystem());
+	s_pGlobalJobSystem->Initialize();
+
+	bool hasSucceeded = true;
+	{
+		ExpakWriter writer(settings);
+		for (const char* pInputPath : inputPaths)
+			hasSucceeded = writer.Add(pInputPath) && hasSucceeded;
+
+		hasSucceeded = hasSucceeded && writer.Write(pOutputPath);
+	}
+
+	EXELIUS_DELETE(s_pGlobalJobSystem);
+	LogManager::DestroySingleton();
+	StringIntern::_ClearStringInternSet();
+	MemoryManager::DestroySingleton();
+
+	return hasSucceeded ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+local dependencies = require("PremakeDependancyGenerator")
+local exeliusDefaultSettings = require("PremakeSettings")
+
+local lz4 = {}
+
+function lz4.GenerateDependencyProject(dependencyRootFolder)
+    project("lz4")
+        kind("StaticLib")
+
+        exeliusDefaultSettings.SetGlobalProjectDefaultSettings()
+
+        targetdir(exeliusDefaultSettings.BuildOutputDirectory)
+        objdir(exeliusDefaultSettings.TempOutputDirectory)
+
+        location(dependencyRootFolder)
+
+        warnings("Off")
+
+        filter {"system:linux"}
+            pic("On")
+
+        filter {}
+
+        files
+        {
+            "%{prj.location}/lib/*.h",
+            "%{prj.location}/lib/*.c"
+        }
+end
+
+function lz4.IncludeDependency(dependencyRootFolder)
+    includedirs
+    {
+        dependencyRootFolder .. "lib/"
+    }
+end
+
+function lz4.LinkDependency(dependencyRootFolder, exeliusLibDir)
+    links
+    {
+        "lz4"
+    }
+end
+
+dependencies.AddDependency("lz4", lz4)
\ No newline at end of file
@@ -0,0 +1,56 @@
+local dependencies = require("PremakeDependancyGenerator")
+local exeliusDefaultSettings = require("PremakeSettings")
+
+local zstd = {}
+
+function zstd.GenerateDependencyProject(dependencyRootFolder)
+    project("zstd")
+        kind("StaticLib")
+
+        exeliusDefaultSettings.SetGlobalProjectDefaultSettings()
+
+        targetdir(exeliusDefaultSettings.BuildOutputDirectory)
+        objdir(exeliusDefaultSettings.TempOutputDirectory)
+
+        location(dependencyRootFolder)
+
+        warnings("Off")
+
+        -- The x64 decoder has an assembly fast path that isn't in the file list below.
+        defines
+        {
+            "ZSTD_DISABLE_ASM"
+        }
+
+        filter {"system:linux"}
+            pic("On")
+
+        filter {}
+
+        files
+        {
+            "%{prj.location}/lib/zstd.h",
+            "%{prj.location}/lib/common/*.h",
+            "%{prj.location}/lib/common/*.c",
+            "%{prj.location}/lib/compress/*.h",
+            "%{prj.location}/lib/compress/*.c",
+            "%{prj.location}/lib/decompress/*.h",
+            "%{prj.location}/lib/decompress/*.c"
+        }
+end
+
+function zstd.IncludeDependency(dependencyRootFolder)
+    includedirs
+    {
+        dependencyRootFolder .. "lib/"
+    }
+end
+
+function zstd.LinkDependency(dependencyRootFolder, exeliusLibDir)
+    links
+    {
+        "zstd"
+    }
+end
+
+dependencies.AddDependency("zstd", zstd)
\ No newline at end of file